@@ -1,19 +1,104 @@
 #ifndef DEBUG_H
 #define DEBUG_H
 
+/**
+ * @file debug_print.h
+ * @brief Leveled logging with compile-time thresholds.
+ *
+ * Each translation unit may pick its threshold and tag before including this header:
+ *
+ *     #define LOG_TAG "dexcom"
+ *     #define LOG_MODULE_LEVEL LOG_LEVEL_DEXCOM_CLIENT
+ *     #include "debug_print.h"
+ *
+ * A call above the threshold is discarded at compile time, arguments included,
+ * so verbose logging can stay in hot paths. Thresholds are set from build flags,
+ * e.g. `-D LOG_LEVEL_DEFAULT=2 -D LOG_LEVEL_HTTP_CLIENT=4`.
+ *
+ * With `-D LOG_DEFERRED` enabled calls are queued in DeferredLog and written out
+ * by its background task instead of blocking on the serial port.
+ */
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+#define LOG_LEVEL_VERBOSE 5 // May print response bodies and session IDs
+
+#ifndef LOG_LEVEL_DEFAULT
+#define LOG_LEVEL_DEFAULT LOG_LEVEL_INFO
+#endif
+
+// Per-module thresholds, defaulting to the global one
+#ifndef LOG_LEVEL_DEXCOM_CLIENT
+#define LOG_LEVEL_DEXCOM_CLIENT LOG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_LEVEL_HTTP_CLIENT
+#define LOG_LEVEL_HTTP_CLIENT LOG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_LEVEL_SECURE_CLIENT
+#define LOG_LEVEL_SECURE_CLIENT LOG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_LEVEL_JSON_PARSER
+#define LOG_LEVEL_JSON_PARSER LOG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_LEVEL_GLUCOSE_PARSER
+#define LOG_LEVEL_GLUCOSE_PARSER LOG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_LEVEL_WIFI
+#define LOG_LEVEL_WIFI LOG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_LEVEL_DNS
+#define LOG_LEVEL_DNS LOG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_LEVEL_SENSORS
+#define LOG_LEVEL_SENSORS LOG_LEVEL_DEFAULT
+#endif
+
+#ifndef LOG_MODULE_LEVEL
+#define LOG_MODULE_LEVEL LOG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_TAG
+#define LOG_TAG "app"
+#endif
+
 #ifdef ARDUINO
 #include <Arduino.h>
-#define DEBUG_PRINT(x) Serial.println(x)
-#define DEBUG_PRINTF(format, ...) Serial.printf(format, __VA_ARGS__)
+#define LOG_SYNC_OUTPUT(format, ...) Serial.printf(format, ##__VA_ARGS__)
 #define PLATFORM_DELAY(ms) delay(ms)
 #else
-#include <iostream>
 #include <chrono>
 #include <thread>
 #include <cstdio>
-#define DEBUG_PRINT(x) std::cout << x << std::endl
-#define DEBUG_PRINTF(format, ...) printf(format, __VA_ARGS__)
+#define LOG_SYNC_OUTPUT(format, ...) std::printf(format, ##__VA_ARGS__)
 #define PLATFORM_DELAY(ms) std::this_thread::sleep_for(std::chrono::milliseconds(ms))
 #endif
 
-#endif // DEBUG_H
\ No newline at end of file
+#ifdef LOG_DEFERRED
+#include "deferred_log.h"
+#define LOG_OUTPUT(format, ...) DeferredLog::instance().write(format, ##__VA_ARGS__)
+#else
+#define LOG_OUTPUT(format, ...) LOG_SYNC_OUTPUT(format, ##__VA_ARGS__)
+#endif
+
+/// True if @p level is enabled for the current translation unit.
+#define LOG_ENABLED(level) ((level) <= (LOG_MODULE_LEVEL))
+
+// `if constexpr` keeps disabled calls type-checked but emits no code for them.
+#define LOG_AT(level, letter, format, ...)                                            \
+    do                                                                                \
+    {                                                                                 \
+        if constexpr (LOG_ENABLED(level))                                             \
+        {                                                                             \
+            LOG_OUTPUT("[" letter "][" LOG_TAG "] " format "\n", ##__VA_ARGS__);      \
+        }                                                                             \
+    } while (0)
+
+#define LOG_ERROR(format, ...) LOG_AT(LOG_LEVEL_ERROR, "E", format, ##__VA_ARGS__)
+#define LOG_WARN(format, ...) LOG_AT(LOG_LEVEL_WARN, "W", format, ##__VA_ARGS__)
+#define LOG_INFO(format, ...) LOG_AT(LOG_LEVEL_INFO, "I", format, ##__VA_ARGS__)
+#define LOG_DEBUG(format, ...) LOG_AT(LOG_LEVEL_DEBUG, "D", format, ##__VA_ARGS__)
+#define LOG_VERBOSE(format, ...) LOG_AT(LOG_LEVEL_VERBOSE, "V", format, ##__VA_ARGS__)
+
+#endif // DEBUG_H
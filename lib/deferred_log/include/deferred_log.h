@@ -0,0 +1,201 @@
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#ifdef ARDUINO
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <thread>
+#endif
+
+/**
+ * @file deferred_log.h
+ * @brief Binary log ring buffer that defers formatting and output to a background task.
+ *
+ * The producer only stores the format-string pointer and raw argument values, so a
+ * log call costs a few stores instead of a blocking UART write. Formatting happens
+ * when the ring is drained, either by the low-priority task started with start() or
+ * by calling drain() directly.
+ *
+ * The ring is lock-free for any number of producers and one consumer: a producer
+ * claims a slot with a CAS on the tail and publishes it through the slot's sequence
+ * number, so LOG_* may be called from any task. Format strings must have static
+ * storage (string literals); string arguments are copied, truncated to fit the record.
+ */
+
+#ifndef DEFERRED_LOG_CAPACITY
+#define DEFERRED_LOG_CAPACITY 32 // records, must be a power of two
+#endif
+
+class DeferredLog
+{
+public:
+    static constexpr size_t CAPACITY = DEFERRED_LOG_CAPACITY;
+    static constexpr size_t MAX_ARGS = 6;
+    static constexpr size_t STRING_POOL_SIZE = 64;
+    static constexpr size_t MAX_LINE_LENGTH = 256;
+
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "DEFERRED_LOG_CAPACITY must be a power of two");
+
+    /// Receives each formatted line; @p line is not null-terminated past @p length.
+    using Sink = void (*)(const char *line, size_t length);
+
+    enum class ArgType : uint8_t
+    {
+        Signed,
+        Unsigned,
+        Double,
+        String,
+        Pointer
+    };
+
+    union ArgValue
+    {
+        long long i;
+        unsigned long long u;
+        double d;
+        const void *p;
+        uint16_t stringOffset;
+    };
+
+    struct Record
+    {
+        const char *format;
+        uint8_t argCount;
+        uint8_t stringBytes;
+        ArgType types[MAX_ARGS];
+        ArgValue values[MAX_ARGS];
+        char strings[STRING_POOL_SIZE];
+    };
+
+    /**
+     * @brief Creates a ring writing formatted lines to @p sink.
+     * @param sink Output for drained lines, the serial port / stdout if nullptr
+     */
+    explicit DeferredLog(Sink sink = nullptr);
+    ~DeferredLog();
+
+    DeferredLog(const DeferredLog &) = delete;
+    DeferredLog &operator=(const DeferredLog &) = delete;
+
+    /// Process-wide instance used by the LOG_* macros when LOG_DEFERRED is defined.
+    static DeferredLog &instance();
+
+    /**
+     * @brief Queues one printf-style message without formatting it.
+     * @return false if the ring was full and the message was dropped
+     */
+    template <typename... Args>
+    bool write(const char *format, const Args &...args)
+    {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "Too many arguments for a deferred log record");
+
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        do
+        {
+            if (tail - _head.load(std::memory_order_acquire) >= CAPACITY)
+            {
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        } while (!_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed));
+
+        const size_t slot = tail & (CAPACITY - 1);
+        Record &record = _records[slot];
+        record.format = format;
+        record.argCount = 0;
+        record.stringBytes = 0;
+        (capture(record, args), ...);
+
+        _sequence[slot].store(tail + 1, std::memory_order_release); // hand the record to drain()
+        return true;
+    }
+
+    /**
+     * @brief Formats and emits every queued record. Consumer side only.
+     * @return Number of records emitted
+     */
+    size_t drain();
+
+    /**
+     * @brief Formats one record into @p out.
+     * @return Length of the formatted text, truncated to @p capacity - 1
+     */
+    static size_t format(const Record &record, char *out, size_t capacity);
+
+    /// Starts the background drain task (idle priority on the device, a thread natively).
+    void start();
+
+    /// Stops the background task and drains whatever is left.
+    void stop();
+
+    uint32_t dropped() const { return _dropped.load(std::memory_order_relaxed); }
+    size_t pending() const
+    {
+        return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+    }
+
+private:
+    Record _records[CAPACITY];
+    std::atomic<uint32_t> _sequence[CAPACITY]; // position + 1 once the record at position is complete
+    std::atomic<uint32_t> _head;
+    std::atomic<uint32_t> _tail;
+    std::atomic<uint32_t> _dropped;
+    std::atomic<bool> _running;
+    Sink _sink;
+
+#ifdef ARDUINO
+    std::atomic<bool> _taskActive;
+    static void drainTask(void *self);
+#else
+    std::thread _thread;
+#endif
+
+    static void defaultSink(const char *line, size_t length);
+    static void captureString(Record &record, const char *value);
+
+    template <typename T>
+    static void capture(Record &record, const T &value)
+    {
+        [[maybe_unused]] const uint8_t i = record.argCount++;
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, char *> || std::is_same_v<U, const char *>)
+        {
+            captureString(record, value);
+        }
+        else if constexpr (std::is_floating_point_v<U>)
+        {
+            record.types[i] = ArgType::Double;
+            record.values[i].d = value;
+        }
+        else if constexpr (std::is_enum_v<U>)
+        {
+            record.types[i] = ArgType::Signed;
+            record.values[i].i = static_cast<long long>(value);
+        }
+        else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>)
+        {
+            record.types[i] = ArgType::Signed;
+            record.values[i].i = value;
+        }
+        else if constexpr (std::is_integral_v<U>)
+        {
+            record.types[i] = ArgType::Unsigned;
+            record.values[i].u = value;
+        }
+        else
+        {
+            static_assert(std::is_pointer_v<U>, "Unsupported deferred log argument type");
+            record.types[i] = ArgType::Pointer;
+            record.values[i].p = value;
+        }
+    }
+};
+
+#endif // DEFERRED_LOG_H
@@ -0,0 +1,292 @@
+#include "deferred_log.h"
+#include <cstdio>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+namespace
+{
+    constexpr uint32_t DRAIN_INTERVAL_MS = 10;
+
+    bool isFlag(char c)
+    {
+        return c == '-' || c == '+' || c == ' ' || c == '#' || c == '0';
+    }
+
+    bool isLengthModifier(char c)
+    {
+        return c == 'h' || c == 'l' || c == 'L' || c == 'q' || c == 'j' || c == 'z' || c == 't';
+    }
+
+    // Appends snprintf output to out, clamping to the remaining space
+    template <typename T>
+    size_t appendFormatted(char *out, size_t capacity, size_t length, const char *spec, T value)
+    {
+        if (length + 1 >= capacity)
+        {
+            return length;
+        }
+        int written = std::snprintf(out + length, capacity - length, spec, value);
+        if (written < 0)
+        {
+            return length;
+        }
+        size_t next = length + static_cast<size_t>(written);
+        return next < capacity ? next : capacity - 1;
+    }
+}
+
+DeferredLog::DeferredLog(Sink sink)
+    : _head(0), _tail(0), _dropped(0), _running(false), _sink(sink ? sink : defaultSink)
+#ifdef ARDUINO
+      , _taskActive(false)
+#endif
+{
+    for (auto &sequence : _sequence)
+    {
+        sequence.store(0, std::memory_order_relaxed);
+    }
+}
+
+DeferredLog::~DeferredLog()
+{
+    stop();
+}
+
+DeferredLog &DeferredLog::instance()
+{
+    static DeferredLog log;
+    return log;
+}
+
+void DeferredLog::captureString(Record &record, const char *value)
+{
+    const uint8_t i = record.argCount - 1;
+    record.types[i] = ArgType::String;
+    if (value == nullptr)
+    {
+        value = "(null)";
+    }
+
+    size_t offset = record.stringBytes;
+    if (offset >= STRING_POOL_SIZE)
+    {
+        // Pool exhausted: point at the terminator of the previous string
+        record.values[i].stringOffset = STRING_POOL_SIZE - 1;
+        return;
+    }
+
+    size_t room = STRING_POOL_SIZE - offset - 1;
+    size_t length = std::strlen(value);
+    if (length > room)
+    {
+        length = room;
+    }
+    std::memcpy(record.strings + offset, value, length);
+    record.strings[offset + length] = '\0';
+    record.values[i].stringOffset = static_cast<uint16_t>(offset);
+    record.stringBytes = static_cast<uint8_t>(offset + length + 1);
+}
+
+size_t DeferredLog::format(const Record &record, char *out, size_t capacity)
+{
+    if (capacity == 0)
+    {
+        return 0;
+    }
+
+    size_t length = 0;
+    uint8_t arg = 0;
+    const char *p = record.format;
+    // Long enough for "%" + flags + width + precision + "ll" + conversion
+    char spec[24];
+
+    while (*p && length + 1 < capacity)
+    {
+        if (*p != '%')
+        {
+            out[length++] = *p++;
+            continue;
+        }
+        if (p[1] == '%')
+        {
+            out[length++] = '%';
+            p += 2;
+            continue;
+        }
+
+        // Copy flags, width and precision; drop length modifiers, we pick our own
+        size_t s = 0;
+        spec[s++] = *p++;
+        while (*p && (isFlag(*p) || (*p >= '0' && *p <= '9') || *p == '.') && s < sizeof(spec) - 4)
+        {
+            spec[s++] = *p++;
+        }
+        while (isLengthModifier(*p))
+        {
+            ++p;
+        }
+        const char conversion = *p;
+        if (conversion == '\0')
+        {
+            break;
+        }
+        ++p;
+
+        if (arg >= record.argCount)
+        {
+            continue; // More conversions than arguments: print nothing for them
+        }
+        const ArgType type = record.types[arg];
+        const ArgValue value = record.values[arg];
+        ++arg;
+
+        switch (conversion)
+        {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+        {
+            spec[s++] = 'l';
+            spec[s++] = 'l';
+            spec[s++] = conversion;
+            spec[s] = '\0';
+            long long v = type == ArgType::Double ? static_cast<long long>(value.d) : value.i;
+            length = appendFormatted(out, capacity, length, spec, v);
+            break;
+        }
+        case 'c':
+            spec[s++] = 'c';
+            spec[s] = '\0';
+            length = appendFormatted(out, capacity, length, spec, static_cast<int>(value.i));
+            break;
+        case 's':
+            spec[s++] = 's';
+            spec[s] = '\0';
+            length = appendFormatted(out, capacity, length, spec,
+                                     type == ArgType::String ? record.strings + value.stringOffset : "?");
+            break;
+        case 'p':
+            spec[s++] = 'p';
+            spec[s] = '\0';
+            length = appendFormatted(out, capacity, length, spec, value.p);
+            break;
+        default: // f, e, g, a and friends
+        {
+            spec[s++] = conversion;
+            spec[s] = '\0';
+            double v = type == ArgType::Double     ? value.d
+                       : type == ArgType::Unsigned ? static_cast<double>(value.u)
+                                                   : static_cast<double>(value.i);
+            length = appendFormatted(out, capacity, length, spec, v);
+            break;
+        }
+        }
+    }
+
+    out[length] = '\0';
+    return length;
+}
+
+size_t DeferredLog::drain()
+{
+    char line[MAX_LINE_LENGTH];
+    size_t count = 0;
+    uint32_t head = _head.load(std::memory_order_relaxed);
+    // Stops at the first claimed slot whose producer has not finished writing it
+    while (_sequence[head & (CAPACITY - 1)].load(std::memory_order_acquire) == head + 1)
+    {
+        size_t length = format(_records[head & (CAPACITY - 1)], line, sizeof(line));
+        _head.store(++head, std::memory_order_release);
+        _sink(line, length);
+        ++count;
+    }
+    return count;
+}
+
+void DeferredLog::defaultSink(const char *line, size_t length)
+{
+#ifdef ARDUINO
+    Serial.write(reinterpret_cast<const uint8_t *>(line), length);
+#else
+    std::fwrite(line, 1, length, stdout);
+#endif
+}
+
+#ifdef ARDUINO
+
+void DeferredLog::drainTask(void *self)
+{
+    DeferredLog *log = static_cast<DeferredLog *>(self);
+    while (log->_running.load())
+    {
+        log->drain();
+        vTaskDelay(pdMS_TO_TICKS(DRAIN_INTERVAL_MS));
+    }
+    log->_taskActive.store(false);
+    vTaskDelete(nullptr);
+}
+
+void DeferredLog::start()
+{
+    if (_running.exchange(true))
+    {
+        return;
+    }
+    _taskActive.store(true);
+    xTaskCreate(drainTask, "log_drain", 3072, this, tskIDLE_PRIORITY, nullptr);
+}
+
+void DeferredLog::stop()
+{
+    if (!_running.exchange(false))
+    {
+        return;
+    }
+    // The task exits on its next wake-up; wait for it so we own the ring again
+    while (_taskActive.load())
+    {
+        vTaskDelay(pdMS_TO_TICKS(DRAIN_INTERVAL_MS));
+    }
+    drain();
+}
+
+#else
+
+void DeferredLog::start()
+{
+    if (_running.exchange(true))
+    {
+        return;
+    }
+    _thread = std::thread([this]()
+                          {
+        while (_running.load())
+        {
+            if (drain() == 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(DRAIN_INTERVAL_MS));
+            }
+        } });
+}
+
+void DeferredLog::stop()
+{
+    if (!_running.exchange(false))
+    {
+        return;
+    }
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+    drain();
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define DEXCOM_CLIENT_H
 
 #include <cstdint>
+#include <ctime>
 #include <string>
 #include <vector>
 #include <optional>
@@ -13,6 +14,7 @@
 #include "dexcom_constants.h"
 #include "dexcom_errors.h"
 #include "glucose_reading.h"
+#include "share_requests.h"
 
 /**
  * @file dexcom_client.h
@@ -22,26 +24,38 @@
  * from the Dexcom API. It uses an IHttpClient for network communication.
  */
 
+/// Missing readings between two received ones, e.g. while WiFi was down.
+struct ReadingGap
+{
+    time_t after;     // older reading on the near side of the hole
+    time_t before;    // newer reading on the far side
+    uint16_t missing; // 5-minute readings expected in between
+};
+
 class DexcomClient {
 private:
     std::shared_ptr<IHttpClient> _httpClient;
     std::shared_ptr<IGlucoseReadingParser> _glucoseParser;
-    std::string _base_url;
-    std::string _password;
+    const char *_base_url;
     std::string _account_id;
-    std::string _username;
     std::string _session_id;
+    ShareRequests _requests; // also holds the username and password, escaped into the request bodies
+    bool _has_username;
 
     void createSession();
     std::string getAccountId();
     std::string getSessionId();
-    std::string post(const std::string &endpoint,
-                    const std::string &params = "",
-                    const std::string &json = "");
+    std::string post(const std::string &url, const std::string &json);
+    static void checkReadingsWindow(uint16_t minutes, uint16_t max_count);
+    static const std::map<std::string, std::string> &requestHeaders();
+    static std::string bodyOf(const HttpResponse &response);
     std::string getGlucoseReadingsRaw(uint16_t minutes = DexcomConst::MAX_MINUTES,
                                      uint16_t max_count = DexcomConst::MAX_MAX_COUNT);
 
 public:
+    /// Readings arrive every 5 minutes; a step over 1.5 intervals is a hole.
+    static constexpr uint32_t INTERVAL_S = 300;
+
     /**
      * @brief Constructs a DexcomClient and initializes a session with the Dexcom API.
      *
@@ -50,6 +64,11 @@ public:
      * @param account_id Dexcom account ID
      * @param username Dexcom username
      * @param ous Whether to use the out-of-US server (default: false)
+     * @param session_id Session restored from a previous run; when set, no login is
+     *        made up front and an expired session is replaced on first use
+     *
+     * Several clients may share one IHttpClient (e.g. one per followed account); a
+     * connection that is already open is reused rather than re-established.
      *
      * @throws AccountError if authentication fails
      * @throws SessionError if session creation fails
@@ -60,7 +79,8 @@ public:
         const std::string& username = "",
         const std::string& account_id = "",
         const std::string& password = "",
-        bool ous = false
+        bool ous = false,
+        const std::string& session_id = ""
     );
 
     ~DexcomClient();
@@ -96,6 +116,66 @@ public:
      */
     std::optional<GlucoseReading> getCurrentGlucoseReading();
 
+    /**
+     * @brief Logs in again, replacing a session the server has expired.
+     *
+     * For callers that learn of the expiry from glucoseReadingsFrom(), so the next fetch
+     * does not first retry with the stale session.
+     *
+     * @throws AccountError if authentication fails
+     * @throws SessionError if session creation fails
+     */
+    void refreshSession();
+
+    /**
+     * @brief Builds the readings request without sending it, e.g. to pipeline the
+     * requests of several clients that share one connection.
+     *
+     * The request carries the current session ID, so it cannot share a pipeline with the
+     * login that would replace that session. Unlike the URL itself, the returned request
+     * owns copies of the URL and headers, so building it allocates.
+     *
+     * @throws ArgumentError if parameters are invalid
+     */
+    HttpRequest glucoseReadingsRequest(uint16_t minutes = DexcomConst::MAX_MINUTES,
+                                       uint16_t max_count = DexcomConst::MAX_MAX_COUNT);
+
+    /**
+     * @brief Parses the response to a glucoseReadingsRequest().
+     *
+     * @throws SessionError if the session has expired; call refreshSession() before fetching again
+     * @throws AccountError if the credentials were rejected
+     */
+    std::vector<GlucoseReading> glucoseReadingsFrom(const HttpResponse &response);
+
+    /**
+     * @brief Finds holes in the 5-minute timestamp sequence.
+     *
+     * @param history Readings newest first, as returned by getGlucoseReadings()
+     * @return Gaps newest first; empty if the sequence is complete
+     */
+    static std::vector<ReadingGap> findGaps(const std::vector<GlucoseReading> &history);
+
+    /**
+     * @brief Fills holes in @p history with a single request.
+     *
+     * The Share API can only ask for "the last N minutes", so the request reaches back
+     * to just after the oldest hole and no further: nothing older than the hole is
+     * fetched again, and maxCount is capped at the 5-minute slots in that window.
+     * Fetched readings are merged in timestamp order; ones already held are skipped.
+     * A hole the server has no data for either (sensor signal loss) stays a hole.
+     *
+     * @param history Readings newest first; updated in place
+     * @param now Current time, seconds since the epoch
+     * @return Number of readings added; 0 without a request if there were no holes
+     *
+     * @throws SessionError if the session is invalid
+     */
+    size_t backfill(std::vector<GlucoseReading> &history, time_t now);
+
+    /// Current session ID, e.g. to keep it across deep sleep.
+    const std::string &sessionId() const { return _session_id; }
+
 };
 
 #endif // DEXCOM_CLIENT_H
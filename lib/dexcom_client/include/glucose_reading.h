@@ -27,6 +27,16 @@ public:
      */
     GlucoseReading(uint16_t value, const std::string& trend, const std::string& timestamp);
 
+    /**
+     * @brief Constructs a GlucoseReading from already-decoded fields.
+     *
+     * @param value The glucose value in mg/dL
+     * @param trend The trend direction
+     * @param timestamp The reading time in seconds since the epoch
+     */
+    GlucoseReading(uint16_t value, DexcomConst::TrendDirection trend, time_t timestamp) noexcept
+        : _value(value), _trend(trend), _timestamp(timestamp) {}
+
     /**
      * @brief Constructs a GlucoseReading directly from an ArduinoJson object.
      *
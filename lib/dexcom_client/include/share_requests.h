@@ -0,0 +1,60 @@
+#ifndef SHARE_REQUESTS_H
+#define SHARE_REQUESTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @file share_requests.h
+ * @brief Pre-built URLs and JSON bodies for the Share endpoints.
+ *
+ * The authenticate and login bodies are built (and JSON-escaped) once, when the
+ * credentials or account ID are set. The readings URL is built once per session with
+ * room reserved for its tail; each call only rewrites minutes and maxCount in place,
+ * so producing the URL does not allocate. Whatever the transport builds around it
+ * (e.g. the HttpRequest copies a pipelined fetch needs) is not covered by that.
+ */
+
+class ShareRequests
+{
+public:
+    /// Longest tail the readings URL reserves room for: "&minutes=1440&maxCount=288".
+    static constexpr size_t READINGS_TAIL_MAX = 32;
+
+    ShareRequests(const std::string &username, const std::string &accountId, const std::string &password);
+
+    /// Rebuilds the login body for @p accountId.
+    void setAccountId(const std::string &accountId);
+
+    /// Rebuilds the readings URL around @p sessionId.
+    void setSessionId(const std::string &sessionId);
+
+    /// Same for every account, so shared rather than held per instance.
+    static const std::string &authenticateUrl();
+    static const std::string &loginUrl();
+
+    const std::string &authenticateBody() const { return _authenticateBody; }
+    const std::string &loginBody() const { return _loginBody; }
+
+    /**
+     * @brief Readings URL for the current session with @p minutes and @p maxCount patched in.
+     *
+     * The returned reference stays valid, and its contents current, until the next call.
+     */
+    const std::string &readingsUrl(uint16_t minutes, uint16_t maxCount);
+
+    /// Appends @p value to @p out as a quoted JSON string, escaping quotes, backslashes and control characters.
+    static void appendJsonString(std::string &out, const std::string &value);
+
+private:
+    static std::string credentialsBody(const char *idField, const std::string &id, const std::string &tail);
+
+    std::string _authenticateBody;
+    size_t _credentialsTailAt; // where ",\"password\":" starts in the authenticate body
+    std::string _loginBody;
+    std::string _readingsUrl;
+    size_t _readingsTailAt; // where "&minutes=" starts
+};
+
+#endif // SHARE_REQUESTS_H
@@ -8,6 +8,9 @@
 
 #include "dexcom_client.h"
 #include "dexcom_utils.h"
+#include "phase_timer.h"
+#define LOG_TAG "dexcom"
+#define LOG_MODULE_LEVEL LOG_LEVEL_DEXCOM_CLIENT
 #include <debug_print.h>
 
 // Platform-specific delay macro
@@ -26,18 +29,25 @@ DexcomClient::DexcomClient(std::shared_ptr<IHttpClient> httpClient,
                            const std::string &username,
                            const std::string &account_id,
                            const std::string &password,
-                           bool ous)
+                           bool ous,
+                           const std::string &session_id)
     : _httpClient(std::move(httpClient)),
       _glucoseParser(std::move(glucoseParser)),
       _base_url(ous ? DexcomConst::DEXCOM_BASE_URL_OUS : DexcomConst::DEXCOM_BASE_URL),
-      _password(password),
       _account_id(account_id),
-      _username(username),
-      _session_id("")
+      _session_id(session_id),
+      _requests(username, account_id, password),
+      _has_username(!username.empty())
 {
-    // Try to connect first
-    if (!_httpClient->connect(_base_url, 443)) {
-        DEBUG_PRINT("Initial connection failed");
+    _requests.setSessionId(_session_id);
+    if (!_session_id.empty()) {
+        LOG_INFO("Reusing restored session");
+        return; // getGlucoseReadings() creates a new session if this one has expired
+    }
+
+    // Try to connect first, unless another client already holds the connection open
+    if (!_httpClient->isConnected() && !_httpClient->connect(_base_url, 443)) {
+        LOG_WARN("Initial connection failed");
         // Don't throw here, let createSession handle the error
     }
     createSession(); // This will handle both connection and authentication errors
@@ -68,6 +78,11 @@ std::vector<GlucoseReading> DexcomClient::getGlucoseReadings(uint16_t minutes, u
     return readings;
 }
 
+void DexcomClient::refreshSession()
+{
+    createSession();
+}
+
 std::optional<GlucoseReading> DexcomClient::getLatestGlucoseReading()
 {
     auto readings = getGlucoseReadings(DexcomConst::MAX_MINUTES, 1);
@@ -80,8 +95,73 @@ std::optional<GlucoseReading> DexcomClient::getCurrentGlucoseReading()
     return readings.empty() ? std::nullopt : std::make_optional(readings[0]);
 }
 
+std::vector<ReadingGap> DexcomClient::findGaps(const std::vector<GlucoseReading> &history)
+{
+    std::vector<ReadingGap> gaps;
+    for (size_t i = 1; i < history.size(); ++i)
+    {
+        const time_t before = history[i - 1].getTimestamp();
+        const time_t after = history[i].getTimestamp();
+        if (before - after > static_cast<time_t>(INTERVAL_S * 3 / 2))
+        {
+            const uint32_t intervals = static_cast<uint32_t>(before - after + INTERVAL_S / 2) / INTERVAL_S;
+            gaps.push_back(ReadingGap{after, before, static_cast<uint16_t>(intervals - 1)});
+        }
+    }
+    return gaps;
+}
+
+size_t DexcomClient::backfill(std::vector<GlucoseReading> &history, time_t now)
+{
+    const std::vector<ReadingGap> gaps = findGaps(history);
+    if (gaps.empty() || now <= gaps.back().after)
+    {
+        return 0;
+    }
+    // Window opens just inside the oldest hole, so its older edge is not fetched again
+    const uint32_t span = static_cast<uint32_t>(now - gaps.back().after - 1) / 60;
+    const uint16_t minutes = static_cast<uint16_t>(std::min<uint32_t>(std::max<uint32_t>(span, 1), DexcomConst::MAX_MINUTES));
+    const uint16_t maxCount = static_cast<uint16_t>(
+        std::min<uint32_t>(minutes * 60u / INTERVAL_S + 1, DexcomConst::MAX_MAX_COUNT));
+    const std::vector<GlucoseReading> fetched = getGlucoseReadings(minutes, maxCount);
+
+    // Both lists are newest first; readings within half an interval are the same one
+    constexpr time_t SAME_READING_S = INTERVAL_S / 2;
+    std::vector<GlucoseReading> merged;
+    merged.reserve(history.size() + fetched.size());
+    size_t i = 0;
+    size_t j = 0;
+    while (i < history.size() || j < fetched.size())
+    {
+        if (j == fetched.size() || (i < history.size() && history[i].getTimestamp() >= fetched[j].getTimestamp()))
+        {
+            merged.push_back(history[i++]);
+            continue;
+        }
+        const GlucoseReading &reading = fetched[j++];
+        const bool held = (!merged.empty() && merged.back().getTimestamp() - reading.getTimestamp() < SAME_READING_S) ||
+                          (i < history.size() && reading.getTimestamp() - history[i].getTimestamp() < SAME_READING_S);
+        if (!held)
+        {
+            merged.push_back(reading);
+        }
+    }
+    const size_t added = merged.size() - history.size();
+    history.swap(merged);
+
+    size_t missing = 0;
+    for (const ReadingGap &gap : gaps)
+    {
+        missing += gap.missing;
+    }
+    LOG_INFO("Backfill: %u minutes requested, %u readings added for %u missing", minutes,
+             static_cast<unsigned>(added), static_cast<unsigned>(missing));
+    return added;
+}
+
 void DexcomClient::createSession()
 {
+    ScopedPhaseTimer timer(Phase::SessionCreate);
     int retries = 0;
 
     while (retries < DexcomConst::MAX_CONNECT_RETRIES)
@@ -90,11 +170,12 @@ void DexcomClient::createSession()
         {
             if (_account_id.empty())
             {
-                if (_username.empty())
+                if (!_has_username)
                 {
                     throw ArgumentError(DexcomErrors::ArgumentError::USERNAME_INVALID);
                 }
                 _account_id = getAccountId();
+                _requests.setAccountId(_account_id);
             }
 
             if (_account_id.empty() || _account_id == DexcomConst::DEFAULT_UUID)
@@ -103,14 +184,15 @@ void DexcomClient::createSession()
             }
 
             _session_id = getSessionId();
+            _requests.setSessionId(_session_id);
 
             if (_session_id.empty() || _session_id == DexcomConst::DEFAULT_UUID)
             {
                 throw ArgumentError(DexcomErrors::ArgumentError::SESSION_ID_INVALID);
             }
 
-            DEBUG_PRINT("Session created successfully");
-            DEBUG_PRINTF("Session ID: %s\n", _session_id.c_str());
+            LOG_INFO("Session created successfully");
+            LOG_VERBOSE("Session ID: %s", _session_id.c_str());
             return;
         }
         catch (const DexcomError &e)
@@ -127,8 +209,7 @@ void DexcomClient::createSession()
 
 std::string DexcomClient::getAccountId()
 {
-    std::string json = "{\"accountName\":\"" + _username + "\",\"password\":\"" + _password + "\",\"applicationId\":\"" + DexcomConst::DEXCOM_APPLICATION_ID + "\"}";
-    std::string response = post(DexcomConst::DEXCOM_AUTHENTICATE_ENDPOINT, "", json);
+    std::string response = post(_requests.authenticateUrl(), _requests.authenticateBody());
 
     response.erase(std::remove_if(response.begin(), response.end(), [](char c)
                                   { return std::isspace(c) || c == '\"'; }),
@@ -139,8 +220,7 @@ std::string DexcomClient::getAccountId()
 
 std::string DexcomClient::getSessionId()
 {
-    std::string json = "{\"accountId\":\"" + _account_id + "\",\"password\":\"" + _password + "\",\"applicationId\":\"" + DexcomConst::DEXCOM_APPLICATION_ID + "\"}";
-    std::string response = post(DexcomConst::DEXCOM_LOGIN_ID_ENDPOINT, "", json);
+    std::string response = post(_requests.loginUrl(), _requests.loginBody());
 
     response.erase(std::remove_if(response.begin(), response.end(), [](char c)
                                   { return std::isspace(c) || c == '\"'; }),
@@ -149,53 +229,24 @@ std::string DexcomClient::getSessionId()
     return response;
 }
 
-std::string DexcomClient::post(const std::string &endpoint, const std::string &params, const std::string &json)
+std::string DexcomClient::post(const std::string &url, const std::string &json)
 {
+    ScopedPhaseTimer timer(Phase::DexcomRequest);
+
     // Check if connected first
     if (!_httpClient->isConnected()) {
         // Try to connect
         if (!_httpClient->connect(_base_url, 443)) {
-            DEBUG_PRINT("Connection failed");
+            LOG_ERROR("Connection failed");
             throw SessionError(DexcomErrors::SessionError::INVALID);
         }
     }
 
-    // Construct the URL
-    std::string url = "/ShareWebServices/Services/" + endpoint;
-    if (!params.empty()) {
-        url += "?" + params;
-    }
-
-    DEBUG_PRINTF("Sending request to %s\n", url.c_str());
-
-    // Prepare headers
-    std::map<std::string, std::string> headers = {
-        {"Content-Type", "application/json"},
-        {"Connection", "keep-alive"}
-    };
+    LOG_DEBUG("Sending request to %s", url.c_str());
 
     try {
         // Make a single call to _httpClient->post
-        HttpResponse response = _httpClient->post(url, json, headers);
-
-        DEBUG_PRINTF("Received status code: %d\n", response.statusCode);
-
-        // Return the body for successful responses
-        if (response.statusCode == 200) {
-            DEBUG_PRINTF("Response: %s\n", response.body.c_str());
-            return response.body;
-        } 
-        // Throw appropriate exception for error status codes
-        else if (response.statusCode == 401) {
-            throw AccountError(DexcomErrors::AccountError::FAILED_AUTHENTICATION);
-        } 
-        else if (response.statusCode == 500) {
-            throw SessionError(DexcomErrors::SessionError::INVALID);
-        }
-        // For any other non-200 status code, throw a generic SessionError
-        else {
-            throw SessionError(DexcomErrors::SessionError::INVALID);
-        }
+        return bodyOf(_httpClient->post(url, json, requestHeaders()));
     } 
     // Re-throw DexcomError exceptions
     catch (const DexcomError& e) {
@@ -203,12 +254,40 @@ std::string DexcomClient::post(const std::string &endpoint, const std::string &p
     } 
     // For other exceptions, throw a SessionError
     catch (const std::exception& e) {
-        DEBUG_PRINTF("Request failed: %s\n", e.what());
+        LOG_ERROR("Request failed: %s", e.what());
         throw SessionError(DexcomErrors::SessionError::INVALID);
     }
 }
 
-std::string DexcomClient::getGlucoseReadingsRaw(uint16_t minutes, uint16_t max_count)
+const std::map<std::string, std::string> &DexcomClient::requestHeaders()
+{
+    static const std::map<std::string, std::string> headers = {
+        {"Content-Type", "application/json"},
+        {"Connection", "keep-alive"}
+    };
+    return headers;
+}
+
+std::string DexcomClient::bodyOf(const HttpResponse &response)
+{
+    LOG_DEBUG("Received status code: %d", response.statusCode);
+
+    // Return the body for successful responses
+    if (response.statusCode == 200) {
+        LOG_VERBOSE("Response: %s", response.body.c_str());
+        return response.body;
+    } 
+    // Throw appropriate exception for error status codes
+    else if (response.statusCode == 401) {
+        throw AccountError(DexcomErrors::AccountError::FAILED_AUTHENTICATION);
+    } 
+    // 500 (expired session) and any other non-200 status code
+    else {
+        throw SessionError(DexcomErrors::SessionError::INVALID);
+    }
+}
+
+void DexcomClient::checkReadingsWindow(uint16_t minutes, uint16_t max_count)
 {
     if (minutes == 0 || minutes > DexcomConst::MAX_MINUTES)
     {
@@ -218,9 +297,22 @@ std::string DexcomClient::getGlucoseReadingsRaw(uint16_t minutes, uint16_t max_c
     {
         throw ArgumentError(DexcomErrors::ArgumentError::MAX_COUNT_INVALID);
     }
+}
 
-    std::string params = "sessionId=" + _session_id + "&minutes=" + std::to_string(minutes) + "&maxCount=" + std::to_string(max_count);
-    std::string response = post(DexcomConst::DEXCOM_GLUCOSE_READINGS_ENDPOINT, params);
+HttpRequest DexcomClient::glucoseReadingsRequest(uint16_t minutes, uint16_t max_count)
+{
+    checkReadingsWindow(minutes, max_count);
+    return HttpRequest{_requests.readingsUrl(minutes, max_count), "POST", requestHeaders(), std::string()};
+}
 
-    return response;
+std::vector<GlucoseReading> DexcomClient::glucoseReadingsFrom(const HttpResponse &response)
+{
+    return _glucoseParser->parse(bodyOf(response));
+}
+
+std::string DexcomClient::getGlucoseReadingsRaw(uint16_t minutes, uint16_t max_count)
+{
+    static const std::string NO_BODY;
+    checkReadingsWindow(minutes, max_count);
+    return post(_requests.readingsUrl(minutes, max_count), NO_BODY);
 }
@@ -0,0 +1,135 @@
+#include "share_requests.h"
+
+#include <cstring>
+
+#include "dexcom_constants.h"
+
+namespace
+{
+    constexpr char SERVICES_PREFIX[] = "/ShareWebServices/Services/";
+
+    std::string serviceUrl(const char *endpoint)
+    {
+        return std::string(SERVICES_PREFIX) + endpoint;
+    }
+
+    void appendNumber(std::string &out, uint16_t value)
+    {
+        char digits[5];
+        size_t count = 0;
+        do
+        {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        while (count > 0)
+        {
+            out += digits[--count];
+        }
+    }
+}
+
+ShareRequests::ShareRequests(const std::string &username, const std::string &accountId, const std::string &password)
+    : _credentialsTailAt(0),
+      _readingsTailAt(0)
+{
+    // The password is kept only as the escaped tail shared by both bodies
+    std::string tail = ",\"password\":";
+    appendJsonString(tail, password);
+    tail += ",\"applicationId\":";
+    appendJsonString(tail, DexcomConst::DEXCOM_APPLICATION_ID);
+    tail += '}';
+    _authenticateBody = credentialsBody("accountName", username, tail);
+    _credentialsTailAt = _authenticateBody.size() - tail.size();
+    setAccountId(accountId);
+    setSessionId("");
+}
+
+const std::string &ShareRequests::authenticateUrl()
+{
+    static const std::string url = serviceUrl(DexcomConst::DEXCOM_AUTHENTICATE_ENDPOINT);
+    return url;
+}
+
+const std::string &ShareRequests::loginUrl()
+{
+    static const std::string url = serviceUrl(DexcomConst::DEXCOM_LOGIN_ID_ENDPOINT);
+    return url;
+}
+
+void ShareRequests::setAccountId(const std::string &accountId)
+{
+    _loginBody = credentialsBody("accountId", accountId, _authenticateBody.substr(_credentialsTailAt));
+}
+
+void ShareRequests::setSessionId(const std::string &sessionId)
+{
+    std::string url = serviceUrl(DexcomConst::DEXCOM_GLUCOSE_READINGS_ENDPOINT);
+    url.reserve(url.size() + 11 + sessionId.size() + READINGS_TAIL_MAX);
+    url += "?sessionId=";
+    url += sessionId;
+    _readingsTailAt = url.size();
+    _readingsUrl = std::move(url);
+}
+
+const std::string &ShareRequests::readingsUrl(uint16_t minutes, uint16_t maxCount)
+{
+    // Stays within the capacity reserved by setSessionId(), so no reallocation
+    _readingsUrl.resize(_readingsTailAt);
+    _readingsUrl += "&minutes=";
+    appendNumber(_readingsUrl, minutes);
+    _readingsUrl += "&maxCount=";
+    appendNumber(_readingsUrl, maxCount);
+    return _readingsUrl;
+}
+
+std::string ShareRequests::credentialsBody(const char *idField, const std::string &id, const std::string &tail)
+{
+    std::string body;
+    body.reserve(strlen(idField) + id.size() + tail.size() + 8);
+    body += "{\"";
+    body += idField;
+    body += "\":";
+    appendJsonString(body, id);
+    body += tail;
+    return body;
+}
+
+void ShareRequests::appendJsonString(std::string &out, const std::string &value)
+{
+    static const char HEX[] = "0123456789abcdef";
+    out += '"';
+    for (char c : value)
+    {
+        switch (c)
+        {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\r':
+            out += "\\r";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                out += "\\u00";
+                out += HEX[(c >> 4) & 0x0F];
+                out += HEX[c & 0x0F];
+            }
+            else
+            {
+                out += c; // UTF-8 passes through unchanged
+            }
+        }
+    }
+    out += '"';
+}
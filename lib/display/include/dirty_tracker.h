@@ -0,0 +1,54 @@
+#ifndef DIRTY_TRACKER_H
+#define DIRTY_TRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "display_rect.h"
+
+/**
+ * @brief Collects the regions changed since the last panel update.
+ *
+ * Rectangles are widened to whole bytes horizontally, because panel partial-update
+ * windows are addressed in 8-pixel columns. Overlapping or touching regions are merged;
+ * when the list is full the pair whose union wastes the least area is merged, so the
+ * list never allocates and never loses a change.
+ */
+class DirtyTracker
+{
+public:
+    static constexpr size_t MAX_RECTS = 8;
+
+    DirtyTracker(int16_t width, int16_t height) : _width(width), _height(height), _rects(), _count(0) {}
+
+    /// Adds a changed region (clipped to the panel).
+    void mark(Rect rect);
+
+    /// Marks the whole panel.
+    void markAll() { mark(Rect{0, 0, _width, _height}); }
+
+    void clear() { _count = 0; }
+
+    bool any() const { return _count > 0; }
+    size_t count() const { return _count; }
+    const Rect &operator[](size_t index) const { return _rects[index]; }
+    const Rect *begin() const { return _rects; }
+    const Rect *end() const { return _rects + _count; }
+
+    /// Total pixels covered by the dirty list (regions never overlap).
+    int32_t area() const;
+
+    /// Smallest rectangle covering every dirty region.
+    Rect bounds() const;
+
+private:
+    void add(Rect rect);
+    void mergeCheapestPair();
+    void removeAt(size_t index);
+
+    int16_t _width;
+    int16_t _height;
+    Rect _rects[MAX_RECTS];
+    size_t _count;
+};
+
+#endif // DIRTY_TRACKER_H
@@ -0,0 +1,37 @@
+#ifndef DISPLAY_RECT_H
+#define DISPLAY_RECT_H
+
+#include <cstdint>
+
+/**
+ * @brief Axis-aligned pixel rectangle; empty when width or height is not positive.
+ */
+struct Rect
+{
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+
+    bool empty() const { return w <= 0 || h <= 0; }
+    int16_t right() const { return static_cast<int16_t>(x + w); }   // exclusive
+    int16_t bottom() const { return static_cast<int16_t>(y + h); }  // exclusive
+    int32_t area() const { return empty() ? 0 : static_cast<int32_t>(w) * h; }
+
+    bool operator==(const Rect &other) const
+    {
+        return x == other.x && y == other.y && w == other.w && h == other.h;
+    }
+    bool operator!=(const Rect &other) const { return !(*this == other); }
+
+    /// Overlap of two rectangles (empty if they do not overlap).
+    static Rect intersect(const Rect &a, const Rect &b);
+
+    /// Smallest rectangle containing both; an empty operand is ignored.
+    static Rect unite(const Rect &a, const Rect &b);
+
+    /// Whether the rectangles overlap or share an edge.
+    static bool touches(const Rect &a, const Rect &b);
+};
+
+#endif // DISPLAY_RECT_H
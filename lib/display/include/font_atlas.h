@@ -0,0 +1,73 @@
+#ifndef FONT_ATLAS_H
+#define FONT_ATLAS_H
+
+#include <cstddef>
+#include <cstdint>
+#include "framebuffer.h"
+
+#ifdef ARDUINO
+#include <pgmspace.h>
+#else
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#endif
+
+/**
+ * @file font_atlas.h
+ * @brief Pre-rendered glyph atlases compiled into flash, and the text renderer using them.
+ *
+ * The atlases are generated by scripts/build_font_atlas.py into font_atlases.cpp. Each
+ * glyph is trimmed to its ink box and stored as run-length-encoded 1-bit rows, which
+ * Framebuffer::drawRunLength() paints directly: there is no font library, no glyph
+ * cache and no intermediate bitmap in RAM. On the ESP32 flash is memory-mapped, so the
+ * PROGMEM tables are read through ordinary pointers.
+ */
+
+struct FontGlyph
+{
+    uint32_t codepoint;
+    uint32_t offset; // first run byte in FontAtlas::runs
+    uint8_t width;   // ink box
+    uint8_t height;
+    int8_t xOffset;  // ink box left relative to the pen
+    int8_t yOffset;  // ink box top relative to the baseline, negative is above it
+    uint8_t advance;
+};
+
+struct FontAtlas
+{
+    const FontGlyph *glyphs; // sorted by codepoint
+    uint16_t glyphCount;
+    const uint8_t *runs;
+    uint8_t lineHeight;
+    uint8_t ascent; // tallest glyph above the baseline
+};
+
+namespace Fonts
+{
+    extern const FontAtlas VALUE;  // digits, '.', '-', '?' for the glucose value
+    extern const FontAtlas ARROWS; // trend arrows from DexcomConst::TREND_ARROWS
+}
+
+class TextRenderer
+{
+public:
+    /// Glyph for @p codepoint, or nullptr if the atlas does not have it.
+    static const FontGlyph *find(const FontAtlas &atlas, uint32_t codepoint);
+
+    /**
+     * @brief Draws UTF-8 text with its baseline at @p y; missing glyphs are skipped.
+     * @return Pen position after the last glyph
+     */
+    static int16_t drawText(Framebuffer &fb, const FontAtlas &atlas, int16_t x, int16_t y, const char *utf8,
+                            Framebuffer::Color color);
+
+    /// Advance width of @p utf8 in pixels.
+    static int16_t measure(const FontAtlas &atlas, const char *utf8);
+
+    /// Decodes one UTF-8 sequence and advances @p text; malformed bytes decode as U+FFFD.
+    static uint32_t nextCodepoint(const char *&text);
+};
+
+#endif // FONT_ATLAS_H
@@ -0,0 +1,102 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "display_rect.h"
+#include "dirty_tracker.h"
+
+/**
+ * @file framebuffer.h
+ * @brief Packed 1-bit framebuffer for the 800x480 e-ink panel.
+ *
+ * Rows are STRIDE bytes, most significant bit leftmost, which is the order the panel
+ * controller takes over SPI, so a dirty region can be streamed straight out of the
+ * buffer. A set bit is black ink. Every drawing call clips to the panel and records
+ * what it touched in dirty(). No hardware access happens here.
+ */
+
+class Framebuffer
+{
+public:
+    static constexpr int16_t WIDTH = 800;
+    static constexpr int16_t HEIGHT = 480;
+    static constexpr size_t STRIDE = WIDTH / 8;
+    static constexpr size_t BUFFER_SIZE = STRIDE * HEIGHT; // 48000 bytes
+
+    enum class Color : uint8_t
+    {
+        White = 0,
+        Black = 1
+    };
+
+    /// How source bits combine with the framebuffer in blit().
+    enum class BlitMode : uint8_t
+    {
+        Copy,   // source 1 -> black, 0 -> white
+        Set,    // source 1 -> black, 0 leaves the pixel (transparent glyph)
+        Clear,  // source 1 -> white, 0 leaves the pixel (knock-out glyph)
+        Invert  // source 1 flips the pixel
+    };
+
+    Framebuffer();
+
+    /// Fills the whole buffer and marks everything dirty.
+    void clear(Color color);
+
+    void setPixel(int16_t x, int16_t y, Color color);
+    Color getPixel(int16_t x, int16_t y) const;
+
+    void fillRect(Rect rect, Color color);
+    void hLine(int16_t x, int16_t y, int16_t w, Color color) { fillRect(Rect{x, y, w, 1}, color); }
+    void vLine(int16_t x, int16_t y, int16_t h, Color color) { fillRect(Rect{x, y, 1, h}, color); }
+    void drawRect(Rect rect, Color color);
+
+    /// Integer Bresenham line between two inclusive endpoints, drawn only inside @p clip.
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Color color, Rect clip = bounds());
+
+    /**
+     * @brief Moves the contents of @p area left by @p dx pixels in place.
+     *
+     * Columns shifted out at the left are dropped; the @p dx columns uncovered at the
+     * right are cleared to white. Pixels outside @p area are untouched.
+     */
+    void scrollLeft(Rect area, int16_t dx);
+
+    /**
+     * @brief Copies a packed 1-bit bitmap (MSB-first rows) into the buffer.
+     *
+     * @param src Source bits
+     * @param srcStride Bytes per source row
+     * @param srcX Horizontal bit offset of the first source column
+     * @param dst Destination rectangle; its size is the size of the copied area
+     * @param mode How source bits combine with existing pixels
+     */
+    void blit(const uint8_t *src, size_t srcStride, int16_t srcX, Rect dst, BlitMode mode);
+
+    /**
+     * @brief Paints a run-length-encoded 1-bit image (the font atlas format).
+     *
+     * Each byte is one run over the image's rows, left to right and top to bottom:
+     * bit 7 set means ink, bits 0-6 hold the length minus one. Ink runs are drawn in
+     * @p color, others are transparent. Runs are decoded straight into the buffer.
+     */
+    void drawRunLength(const uint8_t *runs, int16_t w, int16_t h, int16_t x, int16_t y, Color color);
+
+    /// Draws a glyph bitmap with transparent background in @p color.
+    void drawGlyph(const uint8_t *bitmap, int16_t w, int16_t h, int16_t x, int16_t y, Color color);
+
+    const uint8_t *data() const { return _pixels; }
+    const uint8_t *row(int16_t y) const { return _pixels + static_cast<size_t>(y) * STRIDE; }
+
+    DirtyTracker &dirty() { return _dirty; }
+    const DirtyTracker &dirty() const { return _dirty; }
+
+    static Rect bounds() { return Rect{0, 0, WIDTH, HEIGHT}; }
+
+private:
+    uint8_t _pixels[BUFFER_SIZE];
+    DirtyTracker _dirty;
+};
+
+#endif // FRAMEBUFFER_H
@@ -0,0 +1,27 @@
+#ifndef FRAMEBUFFER_SNAPSHOT_H
+#define FRAMEBUFFER_SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "framebuffer.h"
+
+/**
+ * @brief PBM (P4) export of a framebuffer for golden-image tests and debugging.
+ *
+ * P4 stores MSB-first rows with 1 = black, exactly the framebuffer layout, so the
+ * image is the raw buffer behind a short text header. Any image viewer opens it.
+ */
+namespace FramebufferSnapshot
+{
+    std::vector<uint8_t> toPbm(const Framebuffer &fb);
+
+#ifndef ARDUINO
+    bool writePbm(const Framebuffer &fb, const std::string &path);
+
+    /// Reads a P4 image; returns an empty vector on error.
+    std::vector<uint8_t> readFile(const std::string &path);
+#endif
+}
+
+#endif // FRAMEBUFFER_SNAPSHOT_H
@@ -0,0 +1,88 @@
+#ifndef GLUCOSE_GRAPH_H
+#define GLUCOSE_GRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <vector>
+#include "framebuffer.h"
+#include "glucose_reading.h"
+
+/**
+ * @file glucose_graph.h
+ * @brief 24-hour glucose graph that scrolls in place instead of redrawing.
+ *
+ * The plot holds one slot per 5-minute reading, pitch pixels apart, with the newest
+ * on the right edge (older slots that do not fit are clipped). redraw() paints axes, target band and every segment; after
+ * that append() only scrolls the plot area left by one pitch and rasterizes the single
+ * new segment into the uncovered strip. Both paths produce identical pixels: the
+ * segment from the slot that just scrolled out is kept (clipped at the left edge) so
+ * the line still enters the plot the way a full redraw draws it.
+ */
+class GlucoseGraph
+{
+public:
+    static constexpr size_t SLOTS = 288; // 24 h of 5-minute readings
+    static constexpr uint32_t INTERVAL_S = 300;
+    static constexpr uint16_t MIN_MGDL = 40;
+    static constexpr uint16_t MAX_MGDL = 400;
+    static constexpr uint16_t NO_READING = 0;
+
+    /**
+     * @param fb Framebuffer to draw into
+     * @param plot Plot area; axis ticks are drawn just left of it
+     * @param pitch Horizontal pixels between slots
+     */
+    GlucoseGraph(Framebuffer &fb, Rect plot, uint8_t pitch, uint16_t lowTarget = 70, uint16_t highTarget = 180);
+
+    /// Replaces all slots from @p readings (any order) aligned on the newest one, then redraws.
+    void setHistory(const std::vector<GlucoseReading> &readings);
+
+    /**
+     * @brief Adds a reading newer than the last one.
+     *
+     * Missed intervals become gaps. Older or duplicate readings are ignored; a gap longer
+     * than the whole graph falls back to a redraw.
+     */
+    void append(const GlucoseReading &reading);
+
+    /// Pushes one slot (NO_READING for a gap) and draws it incrementally.
+    void push(uint16_t mgdl);
+
+    /// Paints the plot area, axis and every segment from scratch.
+    void redraw();
+
+    /// Row of @p mgdl inside the plot (clamped to the plotted range).
+    int16_t rowFor(uint16_t mgdl) const;
+
+    /// Slot value @p age intervals before the newest (0 = newest); age SLOTS is the hidden slot.
+    uint16_t slot(size_t age) const { return _values[(_head + SLOTS + 1 - age) % (SLOTS + 1)]; }
+
+    time_t newestTimestamp() const { return _newest; }
+    Rect plot() const { return _plot; }
+
+private:
+    /// Column of slot @p index counted from the oldest; the newest sits on the right edge.
+    int16_t xFor(size_t index) const
+    {
+        return static_cast<int16_t>(_plot.right() - 1 - static_cast<int16_t>(SLOTS - 1 - index) * _pitch);
+    }
+    void drawBand(Rect area);
+    void drawSegment(size_t index);
+
+    Framebuffer &_fb;
+    Rect _plot;
+    int16_t _pitch;
+    Rect _window; // part of the plot the visible slots span; what scrolls
+    uint16_t _lowTarget;
+    uint16_t _highTarget;
+    time_t _newest;
+
+    // Ring of SLOTS visible values plus the one just scrolled out; _head is the newest
+    uint16_t _values[SLOTS + 1];
+    size_t _head;
+
+    int16_t _rows[MAX_MGDL - MIN_MGDL + 1]; // mg/dL -> plot row, built once
+};
+
+#endif // GLUCOSE_GRAPH_H
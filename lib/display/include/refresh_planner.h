@@ -0,0 +1,75 @@
+#ifndef REFRESH_PLANNER_H
+#define REFRESH_PLANNER_H
+
+#include <cstdint>
+#include <ctime>
+#include "dirty_tracker.h"
+
+/**
+ * @file refresh_planner.h
+ * @brief Decides whether and how to refresh the e-ink panel.
+ *
+ * A refresh is skipped outright when the screen-state hash matches what is already on
+ * the panel. Otherwise partial refreshes are preferred, each adding to a ghosting
+ * budget in proportion to the area it redraws; once the budget is spent, too many
+ * partials have run, the change covers most of the panel or the last full refresh is
+ * too old, the next refresh is a full one which clears the ghosting.
+ * State is a POD for RTC memory, like WakePlannerState.
+ */
+
+enum class RefreshKind : uint8_t
+{
+    None,
+    Partial,
+    Full
+};
+
+struct RefreshPlannerState
+{
+    uint32_t shownHash;     // screen-state hash currently on the panel
+    time_t lastFullAt;      // 0 = never (forces a full refresh first)
+    uint16_t ghosting;      // accumulated partial-refresh cost since the last full one
+    uint8_t partials;       // partial refreshes since the last full one
+    uint8_t hashValid;      // non-zero once shownHash reflects the panel
+};
+
+class RefreshPlanner
+{
+public:
+    static constexpr uint16_t GHOSTING_LIMIT = 1000;
+    /// Fixed cost of any partial refresh, plus up to AREA_COST for redrawing the whole panel.
+    static constexpr uint16_t PARTIAL_COST = 60;
+    static constexpr uint16_t AREA_COST = 400;
+    static constexpr uint8_t MAX_PARTIALS = 12;
+    /// Changes covering at least this share of the panel (percent) look better as a full refresh.
+    static constexpr uint8_t FULL_AREA_PERCENT = 60;
+    static constexpr uint32_t MAX_FULL_INTERVAL_S = 24 * 3600;
+
+    RefreshPlanner(RefreshPlannerState &state, int32_t panelArea) : _state(state), _panelArea(panelArea) {}
+
+    void reset();
+
+    /// Whether a screen with @p hash differs from what the panel shows.
+    bool changed(uint32_t hash) const { return !_state.hashValid || hash != _state.shownHash; }
+
+    /**
+     * @brief Picks the refresh for a rendered frame.
+     * @param dirty Regions the render touched
+     * @param now Wall-clock time, 0 if unknown (the age limit is then not applied)
+     */
+    RefreshKind plan(const DirtyTracker &dirty, time_t now) const;
+
+    /// Records a completed refresh of @p kind showing @p hash.
+    void onRefreshed(RefreshKind kind, uint32_t hash, int32_t dirtyArea, time_t now);
+
+    /// Ghosting budget a partial refresh over @p dirtyArea pixels would use.
+    uint16_t partialCost(int32_t dirtyArea) const;
+
+    const RefreshPlannerState &state() const { return _state; }
+
+private:
+    RefreshPlannerState &_state;
+    int32_t _panelArea;
+};
+
+#endif // REFRESH_PLANNER_H
@@ -0,0 +1,33 @@
+#ifndef SCREEN_STATE_H
+#define SCREEN_STATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include "glucose_graph.h"
+#include "glucose_reading.h"
+
+/**
+ * @file screen_state.h
+ * @brief The logical content of the reading screen, reduced to what is visible.
+ *
+ * Two states with the same hash() draw the same pixels, so a wake that produces an
+ * unchanged hash can skip rendering and the panel refresh altogether.
+ */
+struct ScreenState
+{
+    static constexpr size_t GRAPH_TAIL = 12; // last hour of graph slots
+
+    uint16_t value;      // mg/dL, 0 when there is no reading
+    uint8_t trend;       // DexcomConst::TrendDirection
+    uint16_t ageMinutes; // whole minutes since the reading, as displayed
+    uint16_t graphTail[GRAPH_TAIL]; // newest first, GlucoseGraph::NO_READING for gaps
+
+    /// Captures what the screen would show at @p now.
+    static ScreenState capture(const GlucoseReading &reading, time_t now, const GlucoseGraph &graph);
+
+    /// FNV-1a over the fields; cheap enough to run every wake.
+    uint32_t hash() const;
+};
+
+#endif // SCREEN_STATE_H
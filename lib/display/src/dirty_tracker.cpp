@@ -0,0 +1,93 @@
+#include "dirty_tracker.h"
+
+void DirtyTracker::mark(Rect rect)
+{
+    rect = Rect::intersect(rect, Rect{0, 0, _width, _height});
+    if (rect.empty())
+    {
+        return;
+    }
+    // Widen to whole bytes: partial-update windows start and end on 8-pixel columns
+    const int16_t x0 = static_cast<int16_t>(rect.x & ~7);
+    int16_t x1 = static_cast<int16_t>((rect.right() + 7) & ~7);
+    if (x1 > _width)
+    {
+        x1 = _width;
+    }
+    add(Rect{x0, rect.y, static_cast<int16_t>(x1 - x0), rect.h});
+}
+
+void DirtyTracker::add(Rect rect)
+{
+    // Absorb everything the new region touches; a grown region may touch more
+    for (size_t i = 0; i < _count;)
+    {
+        if (Rect::touches(rect, _rects[i]))
+        {
+            rect = Rect::unite(rect, _rects[i]);
+            removeAt(i);
+            i = 0;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+    if (_count == MAX_RECTS)
+    {
+        mergeCheapestPair();
+        // The merged pair may now touch the new region
+        add(rect);
+        return;
+    }
+    _rects[_count++] = rect;
+}
+
+void DirtyTracker::mergeCheapestPair()
+{
+    size_t bestA = 0;
+    size_t bestB = 1;
+    int32_t bestWaste = INT32_MAX;
+    for (size_t a = 0; a < _count; ++a)
+    {
+        for (size_t b = a + 1; b < _count; ++b)
+        {
+            const int32_t waste = Rect::unite(_rects[a], _rects[b]).area() - _rects[a].area() - _rects[b].area();
+            if (waste < bestWaste)
+            {
+                bestWaste = waste;
+                bestA = a;
+                bestB = b;
+            }
+        }
+    }
+    const Rect merged = Rect::unite(_rects[bestA], _rects[bestB]);
+    removeAt(bestB); // higher index first so bestA stays valid
+    removeAt(bestA);
+    add(merged);
+}
+
+void DirtyTracker::removeAt(size_t index)
+{
+    _rects[index] = _rects[--_count];
+}
+
+int32_t DirtyTracker::area() const
+{
+    int32_t total = 0;
+    for (const Rect &rect : *this)
+    {
+        total += rect.area();
+    }
+    return total;
+}
+
+Rect DirtyTracker::bounds() const
+{
+    Rect result{0, 0, 0, 0};
+    for (const Rect &rect : *this)
+    {
+        result = Rect::unite(result, rect);
+    }
+    return result;
+}
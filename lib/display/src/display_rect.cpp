@@ -0,0 +1,42 @@
+#include "display_rect.h"
+
+#include <algorithm>
+
+Rect Rect::intersect(const Rect &a, const Rect &b)
+{
+    const int16_t x0 = std::max(a.x, b.x);
+    const int16_t y0 = std::max(a.y, b.y);
+    const int16_t x1 = std::min(a.right(), b.right());
+    const int16_t y1 = std::min(a.bottom(), b.bottom());
+    if (x1 <= x0 || y1 <= y0)
+    {
+        return Rect{0, 0, 0, 0};
+    }
+    return Rect{x0, y0, static_cast<int16_t>(x1 - x0), static_cast<int16_t>(y1 - y0)};
+}
+
+Rect Rect::unite(const Rect &a, const Rect &b)
+{
+    if (a.empty())
+    {
+        return b;
+    }
+    if (b.empty())
+    {
+        return a;
+    }
+    const int16_t x0 = std::min(a.x, b.x);
+    const int16_t y0 = std::min(a.y, b.y);
+    const int16_t x1 = std::max(a.right(), b.right());
+    const int16_t y1 = std::max(a.bottom(), b.bottom());
+    return Rect{x0, y0, static_cast<int16_t>(x1 - x0), static_cast<int16_t>(y1 - y0)};
+}
+
+bool Rect::touches(const Rect &a, const Rect &b)
+{
+    if (a.empty() || b.empty())
+    {
+        return false;
+    }
+    return a.x <= b.right() && b.x <= a.right() && a.y <= b.bottom() && b.y <= a.bottom();
+}
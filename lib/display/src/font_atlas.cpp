@@ -0,0 +1,93 @@
+#include "font_atlas.h"
+
+const FontGlyph *TextRenderer::find(const FontAtlas &atlas, uint32_t codepoint)
+{
+    size_t low = 0;
+    size_t high = atlas.glyphCount;
+    while (low < high)
+    {
+        const size_t mid = (low + high) / 2;
+        if (atlas.glyphs[mid].codepoint < codepoint)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low < atlas.glyphCount && atlas.glyphs[low].codepoint == codepoint ? &atlas.glyphs[low] : nullptr;
+}
+
+int16_t TextRenderer::drawText(Framebuffer &fb, const FontAtlas &atlas, int16_t x, int16_t y, const char *utf8,
+                               Framebuffer::Color color)
+{
+    while (utf8 != nullptr && *utf8 != '\0')
+    {
+        const FontGlyph *glyph = find(atlas, nextCodepoint(utf8));
+        if (glyph == nullptr)
+        {
+            continue;
+        }
+        fb.drawRunLength(atlas.runs + glyph->offset, glyph->width, glyph->height,
+                         static_cast<int16_t>(x + glyph->xOffset), static_cast<int16_t>(y + glyph->yOffset), color);
+        x = static_cast<int16_t>(x + glyph->advance);
+    }
+    return x;
+}
+
+int16_t TextRenderer::measure(const FontAtlas &atlas, const char *utf8)
+{
+    int16_t width = 0;
+    while (utf8 != nullptr && *utf8 != '\0')
+    {
+        const FontGlyph *glyph = find(atlas, nextCodepoint(utf8));
+        if (glyph != nullptr)
+        {
+            width = static_cast<int16_t>(width + glyph->advance);
+        }
+    }
+    return width;
+}
+
+uint32_t TextRenderer::nextCodepoint(const char *&text)
+{
+    constexpr uint32_t REPLACEMENT = 0xFFFD;
+    const uint8_t lead = static_cast<uint8_t>(*text++);
+    if (lead < 0x80)
+    {
+        return lead;
+    }
+    size_t extra;
+    uint32_t codepoint;
+    if ((lead & 0xE0) == 0xC0)
+    {
+        extra = 1;
+        codepoint = lead & 0x1F;
+    }
+    else if ((lead & 0xF0) == 0xE0)
+    {
+        extra = 2;
+        codepoint = lead & 0x0F;
+    }
+    else if ((lead & 0xF8) == 0xF0)
+    {
+        extra = 3;
+        codepoint = lead & 0x07;
+    }
+    else
+    {
+        return REPLACEMENT;
+    }
+    for (size_t i = 0; i < extra; ++i)
+    {
+        const uint8_t next = static_cast<uint8_t>(*text);
+        if ((next & 0xC0) != 0x80)
+        {
+            return REPLACEMENT; // truncated: leave the terminator or next lead byte in place
+        }
+        ++text;
+        codepoint = (codepoint << 6) | (next & 0x3F);
+    }
+    return codepoint;
+}
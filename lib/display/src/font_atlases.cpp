@@ -0,0 +1,154 @@
+// Generated by scripts/build_font_atlas.py - do not edit.
+#include "font_atlas.h"
+
+namespace
+{
+    // VALUE: 64 px from built-in outlines, 13 glyphs, 1331 bytes of runs (2883 packed)
+    constexpr uint8_t VALUE_RUNS[] PROGMEM = {
+        0x02, 0x99, 0x04, 0x9B, 0x02, 0x9D, 0x00, 0xBF, 0x00, 0x9D, 0x02, 0x9B, 0x04, 0x99, 0x02, 0xF8,
+        0x04, 0x99, 0x08, 0x9B, 0x06, 0x9D, 0x04, 0x9F, 0x02, 0xA1, 0x02, 0x9F, 0x04, 0x9D, 0x05, 0x9D,
+        0x04, 0x9F, 0x02, 0x86, 0x13, 0x86, 0x00, 0x88, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91,
+        0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91,
+        0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x88, 0x00, 0x86, 0x13, 0x86, 0x02, 0x84,
+        0x15, 0x84, 0x04, 0x82, 0x17, 0x82, 0x06, 0x80, 0x19, 0x80, 0x4F, 0x80, 0x19, 0x80, 0x06, 0x82,
+        0x17, 0x82, 0x04, 0x84, 0x15, 0x84, 0x02, 0x86, 0x13, 0x86, 0x00, 0x88, 0x11, 0x91, 0x11, 0x91,
+        0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91,
+        0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x88, 0x00, 0x86,
+        0x13, 0x86, 0x02, 0x9F, 0x04, 0x9D, 0x05, 0x9D, 0x04, 0x9F, 0x02, 0xA1, 0x02, 0x9F, 0x04, 0x9D,
+        0x06, 0x9B, 0x08, 0x99, 0x04, 0x03, 0x80, 0x06, 0x82, 0x04, 0x84, 0x02, 0x86, 0x00, 0xFF, 0x98,
+        0x00, 0x86, 0x02, 0x84, 0x04, 0x82, 0x06, 0x80, 0x19, 0x80, 0x06, 0x82, 0x04, 0x84, 0x02, 0x86,
+        0x00, 0xFF, 0x98, 0x00, 0x86, 0x02, 0x84, 0x04, 0x82, 0x06, 0x80, 0x03, 0x04, 0x99, 0x08, 0x9B,
+        0x06, 0x9D, 0x04, 0x9F, 0x02, 0xA1, 0x02, 0x9F, 0x04, 0x9D, 0x06, 0x9C, 0x07, 0x9C, 0x1D, 0x86,
+        0x1B, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88,
+        0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88,
+        0x1A, 0x88, 0x1B, 0x86, 0x05, 0x9C, 0x05, 0x9C, 0x05, 0x9D, 0x04, 0x9F, 0x03, 0x9F, 0x04, 0x9D,
+        0x05, 0x9C, 0x05, 0x9C, 0x05, 0x86, 0x1B, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88,
+        0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88,
+        0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1B, 0x86, 0x1D, 0x9C, 0x07, 0x9C, 0x06, 0x9D,
+        0x04, 0x9F, 0x02, 0xA1, 0x02, 0x9F, 0x04, 0x9D, 0x06, 0x9B, 0x08, 0x99, 0x04, 0x03, 0x99, 0x07,
+        0x9B, 0x05, 0x9D, 0x03, 0x9F, 0x01, 0xA1, 0x01, 0x9F, 0x03, 0x9D, 0x05, 0x9C, 0x06, 0x9C, 0x1C,
+        0x86, 0x1A, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19,
+        0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19,
+        0x88, 0x19, 0x88, 0x1A, 0x86, 0x04, 0x9C, 0x04, 0x9C, 0x04, 0x9D, 0x03, 0x9F, 0x02, 0x9F, 0x03,
+        0x9D, 0x05, 0x9C, 0x06, 0x9C, 0x1C, 0x86, 0x1A, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19,
+        0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19,
+        0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x1A, 0x86, 0x04, 0x9C, 0x04, 0x9C, 0x04,
+        0x9D, 0x03, 0x9F, 0x01, 0xA1, 0x01, 0x9F, 0x03, 0x9D, 0x05, 0x9B, 0x07, 0x99, 0x04, 0x03, 0x80,
+        0x19, 0x80, 0x06, 0x82, 0x17, 0x82, 0x04, 0x84, 0x15, 0x84, 0x02, 0x86, 0x13, 0x86, 0x00, 0x88,
+        0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91,
+        0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91,
+        0x11, 0x88, 0x00, 0x86, 0x13, 0x86, 0x02, 0x9F, 0x04, 0x9D, 0x05, 0x9D, 0x04, 0x9F, 0x03, 0x9F,
+        0x04, 0x9D, 0x06, 0x9C, 0x07, 0x9C, 0x1D, 0x86, 0x1B, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88,
+        0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88,
+        0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1B, 0x86, 0x1D, 0x84, 0x1F, 0x82,
+        0x21, 0x80, 0x03, 0x04, 0x99, 0x08, 0x9B, 0x06, 0x9D, 0x04, 0x9F, 0x02, 0xA1, 0x02, 0x9F, 0x04,
+        0x9D, 0x05, 0x9C, 0x05, 0x9C, 0x05, 0x86, 0x1B, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A,
+        0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A,
+        0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1B, 0x86, 0x1D, 0x9C, 0x07, 0x9C, 0x06,
+        0x9D, 0x04, 0x9F, 0x03, 0x9F, 0x04, 0x9D, 0x06, 0x9C, 0x07, 0x9C, 0x1D, 0x86, 0x1B, 0x88, 0x1A,
+        0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A,
+        0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1B,
+        0x86, 0x05, 0x9C, 0x05, 0x9C, 0x05, 0x9D, 0x04, 0x9F, 0x02, 0xA1, 0x02, 0x9F, 0x04, 0x9D, 0x06,
+        0x9B, 0x08, 0x99, 0x04, 0x04, 0x99, 0x08, 0x9B, 0x06, 0x9D, 0x04, 0x9F, 0x02, 0xA1, 0x02, 0x9F,
+        0x04, 0x9D, 0x05, 0x9C, 0x05, 0x9C, 0x05, 0x86, 0x1B, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88,
+        0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88,
+        0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1B, 0x86, 0x1D, 0x9C, 0x07, 0x9C,
+        0x06, 0x9D, 0x04, 0x9F, 0x03, 0x9F, 0x04, 0x9D, 0x05, 0x9D, 0x04, 0x9F, 0x02, 0x86, 0x13, 0x86,
+        0x00, 0x88, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91,
+        0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91,
+        0x11, 0x91, 0x11, 0x88, 0x00, 0x86, 0x13, 0x86, 0x02, 0x9F, 0x04, 0x9D, 0x05, 0x9D, 0x04, 0x9F,
+        0x02, 0xA1, 0x02, 0x9F, 0x04, 0x9D, 0x06, 0x9B, 0x08, 0x99, 0x04, 0x03, 0x99, 0x07, 0x9B, 0x05,
+        0x9D, 0x03, 0x9F, 0x01, 0xA1, 0x01, 0x9F, 0x03, 0x9D, 0x05, 0x9C, 0x06, 0x9C, 0x1C, 0x86, 0x1A,
+        0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19,
+        0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19,
+        0x88, 0x1A, 0x86, 0x1C, 0x84, 0x1E, 0x82, 0x20, 0x80, 0x67, 0x80, 0x20, 0x82, 0x1E, 0x84, 0x1C,
+        0x86, 0x1A, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19,
+        0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19,
+        0x88, 0x19, 0x88, 0x1A, 0x86, 0x1C, 0x84, 0x1E, 0x82, 0x20, 0x80, 0x03, 0x04, 0x99, 0x08, 0x9B,
+        0x06, 0x9D, 0x04, 0x9F, 0x02, 0xA1, 0x02, 0x9F, 0x04, 0x9D, 0x05, 0x9D, 0x04, 0x9F, 0x02, 0x86,
+        0x13, 0x86, 0x00, 0x88, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91,
+        0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91,
+        0x11, 0x91, 0x11, 0x91, 0x11, 0x88, 0x00, 0x86, 0x13, 0x86, 0x02, 0x9F, 0x04, 0x9D, 0x05, 0x9D,
+        0x04, 0x9F, 0x03, 0x9F, 0x04, 0x9D, 0x05, 0x9D, 0x04, 0x9F, 0x02, 0x86, 0x13, 0x86, 0x00, 0x88,
+        0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91,
+        0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91,
+        0x11, 0x88, 0x00, 0x86, 0x13, 0x86, 0x02, 0x9F, 0x04, 0x9D, 0x05, 0x9D, 0x04, 0x9F, 0x02, 0xA1,
+        0x02, 0x9F, 0x04, 0x9D, 0x06, 0x9B, 0x08, 0x99, 0x04, 0x04, 0x99, 0x08, 0x9B, 0x06, 0x9D, 0x04,
+        0x9F, 0x02, 0xA1, 0x02, 0x9F, 0x04, 0x9D, 0x05, 0x9D, 0x04, 0x9F, 0x02, 0x86, 0x13, 0x86, 0x00,
+        0x88, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11,
+        0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11, 0x91, 0x11,
+        0x91, 0x11, 0x88, 0x00, 0x86, 0x13, 0x86, 0x02, 0x9F, 0x04, 0x9D, 0x05, 0x9D, 0x04, 0x9F, 0x03,
+        0x9F, 0x04, 0x9D, 0x06, 0x9C, 0x07, 0x9C, 0x1D, 0x86, 0x1B, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A,
+        0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A,
+        0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1A, 0x88, 0x1B, 0x86, 0x05, 0x9C, 0x05,
+        0x9C, 0x05, 0x9D, 0x04, 0x9F, 0x02, 0xA1, 0x02, 0x9F, 0x04, 0x9D, 0x06, 0x9B, 0x08, 0x99, 0x04,
+        0x03, 0x99, 0x07, 0x9B, 0x05, 0x9D, 0x03, 0x9F, 0x01, 0xA1, 0x01, 0x9F, 0x03, 0x9D, 0x05, 0x9C,
+        0x06, 0x9C, 0x1C, 0x86, 0x1A, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88,
+        0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x19, 0x88,
+        0x19, 0x88, 0x19, 0x88, 0x19, 0x88, 0x1A, 0x86, 0x04, 0x9C, 0x04, 0x9C, 0x04, 0x9D, 0x03, 0x9F,
+        0x02, 0x9F, 0x03, 0x9D, 0x05, 0x9B, 0x07, 0x99, 0x7F, 0x7F, 0x7F, 0x7F, 0x63, 0x89, 0x18, 0x89,
+        0x18, 0x89, 0x18, 0x89, 0x18, 0x89, 0x18, 0x89, 0x18, 0x89, 0x18, 0x89, 0x18, 0x89, 0x18, 0x89,
+        0x18, 0x89, 0x0C,
+    };
+
+    constexpr FontGlyph VALUE_GLYPHS[] PROGMEM = {
+        {0x002D, 0, 32, 8, 7, -36, 46}, // -
+        {0x002E, 15, 11, 11, 5, -11, 21}, // .
+        {0x0030, 16, 36, 64, 5, -64, 46}, // 0
+        {0x0031, 165, 9, 52, 32, -58, 46}, // 1
+        {0x0032, 204, 36, 64, 5, -64, 46}, // 2
+        {0x0033, 333, 35, 64, 6, -64, 46}, // 3
+        {0x0034, 462, 36, 52, 5, -58, 46}, // 4
+        {0x0035, 579, 36, 64, 5, -64, 46}, // 5
+        {0x0036, 708, 36, 64, 5, -64, 46}, // 6
+        {0x0037, 843, 35, 58, 6, -64, 46}, // 7
+        {0x0038, 956, 36, 64, 5, -64, 46}, // 8
+        {0x0039, 1097, 36, 64, 5, -64, 46}, // 9
+        {0x003F, 1232, 35, 64, 6, -64, 46}, // ?
+    };
+
+    // ARROWS: 48 px from built-in outlines, 5 glyphs, 405 bytes of runs (836 packed)
+    constexpr uint8_t ARROWS_RUNS[] PROGMEM = {
+        0x10, 0x81, 0x21, 0x81, 0x20, 0x83, 0x1E, 0x85, 0x1C, 0x87, 0x1A, 0x89, 0x18, 0x8B, 0x16, 0x8D,
+        0x14, 0x8F, 0x12, 0x91, 0x10, 0x93, 0x0E, 0x95, 0x0D, 0x95, 0x0C, 0x97, 0x0A, 0x99, 0x08, 0x9B,
+        0x06, 0x9D, 0x04, 0x9F, 0x02, 0xA1, 0x00, 0xA3, 0x0C, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89,
+        0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89,
+        0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89,
+        0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x0C, 0x17, 0x80, 0x2A, 0x81, 0x29, 0x82, 0x28,
+        0x83, 0x27, 0x84, 0x26, 0x85, 0x25, 0x86, 0x24, 0x88, 0x22, 0x89, 0x21, 0x8A, 0x20, 0x8B, 0x1F,
+        0x8C, 0x1E, 0x8D, 0x05, 0xA6, 0x04, 0xA7, 0x03, 0xA8, 0x02, 0xA9, 0x01, 0xFF, 0x81, 0x01, 0xA8,
+        0x02, 0xA7, 0x03, 0xA6, 0x1C, 0x8D, 0x1D, 0x8C, 0x1E, 0x8B, 0x1F, 0x8A, 0x20, 0x89, 0x21, 0x88,
+        0x22, 0x86, 0x24, 0x85, 0x25, 0x84, 0x26, 0x83, 0x27, 0x82, 0x28, 0x81, 0x29, 0x80, 0x12, 0x0C,
+        0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19,
+        0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19,
+        0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x19, 0x89, 0x0C,
+        0xA3, 0x00, 0xA1, 0x02, 0x9F, 0x04, 0x9D, 0x06, 0x9B, 0x08, 0x99, 0x0A, 0x97, 0x0C, 0x95, 0x0D,
+        0x95, 0x0E, 0x93, 0x10, 0x91, 0x12, 0x8F, 0x14, 0x8D, 0x16, 0x8B, 0x18, 0x89, 0x1A, 0x87, 0x1C,
+        0x85, 0x1E, 0x83, 0x20, 0x81, 0x21, 0x81, 0x10, 0x1C, 0x81, 0x06, 0x97, 0x07, 0x95, 0x09, 0x94,
+        0x0A, 0x93, 0x0B, 0x92, 0x0C, 0x91, 0x0D, 0x90, 0x0E, 0x8F, 0x0F, 0x8E, 0x0E, 0x8F, 0x0D, 0x90,
+        0x0C, 0x91, 0x0B, 0x92, 0x0A, 0x93, 0x09, 0x94, 0x08, 0x8C, 0x00, 0x87, 0x07, 0x8C, 0x02, 0x86,
+        0x06, 0x8C, 0x04, 0x85, 0x05, 0x8C, 0x06, 0x84, 0x04, 0x8C, 0x08, 0x83, 0x03, 0x8C, 0x0A, 0x82,
+        0x02, 0x8C, 0x0C, 0x81, 0x01, 0x8C, 0x0E, 0x80, 0x00, 0x8C, 0x12, 0x8A, 0x14, 0x88, 0x16, 0x86,
+        0x18, 0x84, 0x1A, 0x82, 0x1C, 0x80, 0x17, 0x05, 0x80, 0x1C, 0x82, 0x1A, 0x84, 0x18, 0x86, 0x16,
+        0x88, 0x14, 0x8A, 0x12, 0x8C, 0x12, 0x8C, 0x0E, 0x80, 0x02, 0x8C, 0x0C, 0x81, 0x03, 0x8C, 0x0A,
+        0x82, 0x04, 0x8C, 0x08, 0x83, 0x05, 0x8C, 0x06, 0x84, 0x06, 0x8C, 0x04, 0x85, 0x07, 0x8C, 0x02,
+        0x86, 0x08, 0x8C, 0x00, 0x87, 0x09, 0x94, 0x0A, 0x93, 0x0B, 0x92, 0x0C, 0x91, 0x0D, 0x90, 0x0E,
+        0x8F, 0x0F, 0x8E, 0x0E, 0x8F, 0x0D, 0x90, 0x0C, 0x91, 0x0B, 0x92, 0x0A, 0x93, 0x09, 0x94, 0x08,
+        0x95, 0x07, 0x97, 0x1C, 0x81,
+    };
+
+    constexpr FontGlyph ARROWS_GLYPHS[] PROGMEM = {
+        {0x2191, 0, 36, 44, 6, -46, 54}, // ↑
+        {0x2192, 89, 44, 36, 2, -42, 54}, // →
+        {0x2193, 159, 36, 44, 6, -46, 54}, // ↓
+        {0x2197, 248, 31, 31, 7, -38, 54}, // ↗
+        {0x2198, 327, 31, 31, 7, -41, 54}, // ↘
+    };
+
+}
+
+namespace Fonts
+{
+    const FontAtlas VALUE = {VALUE_GLYPHS, 13, VALUE_RUNS, 80, 64};
+    const FontAtlas ARROWS = {ARROWS_GLYPHS, 5, ARROWS_RUNS, 60, 46};
+}
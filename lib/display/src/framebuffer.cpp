@@ -0,0 +1,337 @@
+#include "framebuffer.h"
+
+#include <cstring>
+
+namespace
+{
+    // Leading/trailing byte masks for a span of columns [x0, x1] inclusive
+    inline uint8_t leadMask(int16_t x0) { return static_cast<uint8_t>(0xFF >> (x0 & 7)); }
+    inline uint8_t trailMask(int16_t x1) { return static_cast<uint8_t>(0xFF << (7 - (x1 & 7))); }
+
+    // Eight source bits starting at @p bitPos (may be up to 7 bits before the row),
+    // MSB-first; bits outside the row read as 0
+    inline uint8_t fetch8(const uint8_t *row, size_t stride, int32_t bitPos)
+    {
+        if (bitPos < 0)
+        {
+            return static_cast<uint8_t>(fetch8(row, stride, 0) >> -bitPos);
+        }
+        const size_t index = static_cast<size_t>(bitPos) >> 3;
+        const unsigned shift = static_cast<unsigned>(bitPos) & 7;
+        const unsigned hi = index < stride ? row[index] : 0;
+        if (shift == 0)
+        {
+            return static_cast<uint8_t>(hi);
+        }
+        const unsigned lo = index + 1 < stride ? row[index + 1] : 0;
+        return static_cast<uint8_t>(((hi << 8) | lo) >> (8 - shift));
+    }
+
+    /// Sets or clears columns [x0, x1] of one row.
+    inline void fillSpan(uint8_t *row, int16_t x0, int16_t x1, bool ink)
+    {
+        const size_t b0 = static_cast<size_t>(x0 >> 3);
+        const size_t b1 = static_cast<size_t>(x1 >> 3);
+        uint8_t first = leadMask(x0);
+        const uint8_t last = trailMask(x1);
+        if (b0 == b1)
+        {
+            first &= last;
+        }
+        if (ink)
+        {
+            row[b0] |= first;
+        }
+        else
+        {
+            row[b0] &= static_cast<uint8_t>(~first);
+        }
+        if (b1 > b0)
+        {
+            std::memset(row + b0 + 1, ink ? 0xFF : 0x00, b1 - b0 - 1);
+            if (ink)
+            {
+                row[b1] |= last;
+            }
+            else
+            {
+                row[b1] &= static_cast<uint8_t>(~last);
+            }
+        }
+    }
+
+    inline void combine(uint8_t &dst, uint8_t src, uint8_t mask, Framebuffer::BlitMode mode)
+    {
+        switch (mode)
+        {
+        case Framebuffer::BlitMode::Copy:
+            dst = static_cast<uint8_t>((dst & ~mask) | (src & mask));
+            break;
+        case Framebuffer::BlitMode::Set:
+            dst |= src & mask;
+            break;
+        case Framebuffer::BlitMode::Clear:
+            dst &= static_cast<uint8_t>(~(src & mask));
+            break;
+        case Framebuffer::BlitMode::Invert:
+            dst ^= src & mask;
+            break;
+        }
+    }
+}
+
+Framebuffer::Framebuffer() : _dirty(WIDTH, HEIGHT)
+{
+    std::memset(_pixels, 0, sizeof(_pixels));
+}
+
+void Framebuffer::clear(Color color)
+{
+    std::memset(_pixels, color == Color::Black ? 0xFF : 0x00, sizeof(_pixels));
+    _dirty.clear();
+    _dirty.markAll();
+}
+
+void Framebuffer::setPixel(int16_t x, int16_t y, Color color)
+{
+    if (x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT)
+    {
+        return;
+    }
+    uint8_t &byte = _pixels[static_cast<size_t>(y) * STRIDE + (x >> 3)];
+    const uint8_t bit = static_cast<uint8_t>(0x80 >> (x & 7));
+    byte = color == Color::Black ? (byte | bit) : (byte & ~bit);
+    _dirty.mark(Rect{x, y, 1, 1});
+}
+
+Framebuffer::Color Framebuffer::getPixel(int16_t x, int16_t y) const
+{
+    if (x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT)
+    {
+        return Color::White;
+    }
+    const uint8_t byte = _pixels[static_cast<size_t>(y) * STRIDE + (x >> 3)];
+    return (byte & (0x80 >> (x & 7))) ? Color::Black : Color::White;
+}
+
+void Framebuffer::fillRect(Rect rect, Color color)
+{
+    const Rect r = Rect::intersect(rect, bounds());
+    if (r.empty())
+    {
+        return;
+    }
+    const int16_t x1 = static_cast<int16_t>(r.right() - 1);
+    const size_t b0 = static_cast<size_t>(r.x >> 3);
+    const size_t b1 = static_cast<size_t>(x1 >> 3);
+    const uint8_t fill = color == Color::Black ? 0xFF : 0x00;
+    uint8_t first = leadMask(r.x);
+    const uint8_t last = trailMask(x1);
+    if (b0 == b1)
+    {
+        first &= last;
+    }
+
+    for (int16_t y = r.y; y < r.bottom(); ++y)
+    {
+        uint8_t *p = _pixels + static_cast<size_t>(y) * STRIDE;
+        p[b0] = static_cast<uint8_t>((p[b0] & ~first) | (fill & first));
+        if (b1 > b0)
+        {
+            // Whole bytes in between: memset writes these a word at a time
+            std::memset(p + b0 + 1, fill, b1 - b0 - 1);
+            p[b1] = static_cast<uint8_t>((p[b1] & ~last) | (fill & last));
+        }
+    }
+    _dirty.mark(r);
+}
+
+void Framebuffer::drawRect(Rect rect, Color color)
+{
+    if (rect.empty())
+    {
+        return;
+    }
+    hLine(rect.x, rect.y, rect.w, color);
+    hLine(rect.x, static_cast<int16_t>(rect.bottom() - 1), rect.w, color);
+    vLine(rect.x, rect.y, rect.h, color);
+    vLine(static_cast<int16_t>(rect.right() - 1), rect.y, rect.h, color);
+}
+
+void Framebuffer::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Color color, Rect clip)
+{
+    clip = Rect::intersect(clip, bounds());
+    const int16_t dx = static_cast<int16_t>(x1 > x0 ? x1 - x0 : x0 - x1);
+    const int16_t dy = static_cast<int16_t>(y1 > y0 ? y0 - y1 : y1 - y0); // negative
+    const int16_t sx = x0 < x1 ? 1 : -1;
+    const int16_t sy = y0 < y1 ? 1 : -1;
+    int32_t err = dx + dy;
+    Rect touched{0, 0, 0, 0};
+
+    for (;;)
+    {
+        if (x0 >= clip.x && x0 < clip.right() && y0 >= clip.y && y0 < clip.bottom())
+        {
+            uint8_t &byte = _pixels[static_cast<size_t>(y0) * STRIDE + (x0 >> 3)];
+            const uint8_t bit = static_cast<uint8_t>(0x80 >> (x0 & 7));
+            byte = color == Color::Black ? (byte | bit) : (byte & ~bit);
+            touched = Rect::unite(touched, Rect{x0, y0, 1, 1});
+        }
+        if (x0 == x1 && y0 == y1)
+        {
+            break;
+        }
+        const int32_t e2 = 2 * err;
+        if (e2 >= dy)
+        {
+            err += dy;
+            x0 = static_cast<int16_t>(x0 + sx);
+        }
+        if (e2 <= dx)
+        {
+            err += dx;
+            y0 = static_cast<int16_t>(y0 + sy);
+        }
+    }
+    // One dirty region for the whole line rather than one per pixel
+    _dirty.mark(touched);
+}
+
+void Framebuffer::scrollLeft(Rect area, int16_t dx)
+{
+    const Rect r = Rect::intersect(area, bounds());
+    if (r.empty() || dx <= 0)
+    {
+        return;
+    }
+    if (dx >= r.w)
+    {
+        fillRect(r, Color::White);
+        return;
+    }
+
+    const int16_t x1 = static_cast<int16_t>(r.right() - 1);
+    const size_t b0 = static_cast<size_t>(r.x >> 3);
+    const size_t b1 = static_cast<size_t>(x1 >> 3);
+    const bool aligned = (r.x & 7) == 0 && (dx & 7) == 0 && (r.w & 7) == 0;
+
+    for (int16_t y = r.y; y < r.bottom(); ++y)
+    {
+        uint8_t *p = _pixels + static_cast<size_t>(y) * STRIDE;
+        if (aligned)
+        {
+            std::memmove(p + b0, p + b0 + (dx >> 3), b1 + 1 - b0 - (dx >> 3));
+            continue;
+        }
+        // Each destination byte reads only bytes at or right of itself, so ascending order
+        // never reads a byte that was already rewritten
+        int32_t bitPos = r.x - (r.x & 7) + dx;
+        for (size_t b = b0; b <= b1; ++b, bitPos += 8)
+        {
+            uint8_t mask = 0xFF;
+            if (b == b0)
+            {
+                mask &= leadMask(r.x);
+            }
+            if (b == b1)
+            {
+                mask &= trailMask(x1);
+            }
+            combine(p[b], fetch8(p, STRIDE, bitPos), mask, BlitMode::Copy);
+        }
+    }
+    // Clears the uncovered strip and marks it; the shifted part is marked here
+    _dirty.mark(r);
+    fillRect(Rect{static_cast<int16_t>(r.right() - dx), r.y, dx, r.h}, Color::White);
+}
+
+void Framebuffer::blit(const uint8_t *src, size_t srcStride, int16_t srcX, Rect dst, BlitMode mode)
+{
+    const Rect r = Rect::intersect(dst, bounds());
+    if (r.empty() || src == nullptr)
+    {
+        return;
+    }
+    // Source position of the clipped area's top-left pixel
+    const int32_t sx = srcX + (r.x - dst.x);
+    const int32_t sy = r.y - dst.y;
+
+    const int16_t x1 = static_cast<int16_t>(r.right() - 1);
+    const size_t b0 = static_cast<size_t>(r.x >> 3);
+    const size_t b1 = static_cast<size_t>(x1 >> 3);
+    const bool aligned = mode == BlitMode::Copy && (r.x & 7) == 0 && (sx & 7) == 0 && (r.w & 7) == 0;
+
+    for (int16_t row = 0; row < r.h; ++row)
+    {
+        const uint8_t *s = src + static_cast<size_t>(sy + row) * srcStride;
+        uint8_t *d = _pixels + static_cast<size_t>(r.y + row) * STRIDE;
+        if (aligned)
+        {
+            std::memcpy(d + b0, s + (sx >> 3), static_cast<size_t>(r.w >> 3));
+            continue;
+        }
+        // Source bit that lands on the first column of destination byte b
+        int32_t bitPos = sx - (r.x & 7);
+        for (size_t b = b0; b <= b1; ++b, bitPos += 8)
+        {
+            uint8_t mask = 0xFF;
+            if (b == b0)
+            {
+                mask &= leadMask(r.x);
+            }
+            if (b == b1)
+            {
+                mask &= trailMask(x1);
+            }
+            combine(d[b], fetch8(s, srcStride, bitPos), mask, mode);
+        }
+    }
+    _dirty.mark(r);
+}
+
+void Framebuffer::drawRunLength(const uint8_t *runs, int16_t w, int16_t h, int16_t x, int16_t y, Color color)
+{
+    const Rect r = Rect::intersect(Rect{x, y, w, h}, bounds());
+    if (r.empty() || runs == nullptr)
+    {
+        return;
+    }
+    const bool ink = color == Color::Black;
+    int16_t col = 0;
+    int16_t row = 0;
+    while (row < h)
+    {
+        const uint8_t run = *runs++;
+        int16_t remaining = static_cast<int16_t>((run & 0x7F) + 1);
+        while (remaining > 0 && row < h)
+        {
+            const int16_t n = remaining < w - col ? remaining : static_cast<int16_t>(w - col);
+            const int16_t py = static_cast<int16_t>(y + row);
+            if ((run & 0x80) && py >= r.y && py < r.bottom())
+            {
+                const int16_t x0 = static_cast<int16_t>(x + col) > r.x ? static_cast<int16_t>(x + col) : r.x;
+                const int16_t x1 = static_cast<int16_t>(x + col + n - 1) < r.right() - 1
+                                       ? static_cast<int16_t>(x + col + n - 1)
+                                       : static_cast<int16_t>(r.right() - 1);
+                if (x0 <= x1)
+                {
+                    fillSpan(_pixels + static_cast<size_t>(py) * STRIDE, x0, x1, ink);
+                }
+            }
+            remaining = static_cast<int16_t>(remaining - n);
+            col = static_cast<int16_t>(col + n);
+            if (col == w)
+            {
+                col = 0;
+                ++row;
+            }
+        }
+    }
+    _dirty.mark(r);
+}
+
+void Framebuffer::drawGlyph(const uint8_t *bitmap, int16_t w, int16_t h, int16_t x, int16_t y, Color color)
+{
+    blit(bitmap, static_cast<size_t>((w + 7) / 8), 0, Rect{x, y, w, h},
+         color == Color::Black ? BlitMode::Set : BlitMode::Clear);
+}
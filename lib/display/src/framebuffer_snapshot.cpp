@@ -0,0 +1,44 @@
+#include "framebuffer_snapshot.h"
+
+#include <cstdio>
+
+std::vector<uint8_t> FramebufferSnapshot::toPbm(const Framebuffer &fb)
+{
+    char header[32];
+    const int length = std::snprintf(header, sizeof(header), "P4\n%d %d\n", Framebuffer::WIDTH, Framebuffer::HEIGHT);
+    std::vector<uint8_t> image(header, header + length);
+    image.insert(image.end(), fb.data(), fb.data() + Framebuffer::BUFFER_SIZE);
+    return image;
+}
+
+#ifndef ARDUINO
+bool FramebufferSnapshot::writePbm(const Framebuffer &fb, const std::string &path)
+{
+    const std::vector<uint8_t> image = toPbm(fb);
+    FILE *file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    const bool ok = std::fwrite(image.data(), 1, image.size(), file) == image.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+std::vector<uint8_t> FramebufferSnapshot::readFile(const std::string &path)
+{
+    std::vector<uint8_t> content;
+    FILE *file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr)
+    {
+        return content;
+    }
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+    {
+        content.insert(content.end(), chunk, chunk + n);
+    }
+    std::fclose(file);
+    return content;
+}
+#endif
@@ -0,0 +1,132 @@
+#include "glucose_graph.h"
+
+#include <algorithm>
+
+GlucoseGraph::GlucoseGraph(Framebuffer &fb, Rect plot, uint8_t pitch, uint16_t lowTarget, uint16_t highTarget)
+    : _fb(fb), _plot(Rect::intersect(plot, Framebuffer::bounds())), _pitch(pitch > 0 ? pitch : 1),
+      _lowTarget(lowTarget), _highTarget(highTarget), _newest(0), _values(), _head(SLOTS)
+{
+    // Older history would otherwise linger left of the oldest slot when the plot is wider
+    const int16_t oldest = xFor(0);
+    _window = Rect::intersect(_plot, Rect{oldest, _plot.y, static_cast<int16_t>(_plot.right() - oldest), _plot.h});
+
+    // Rounded integer scale from the mg/dL range onto the plot rows, top = MAX_MGDL
+    const int32_t span = MAX_MGDL - MIN_MGDL;
+    const int32_t rows = _plot.h > 0 ? _plot.h - 1 : 0;
+    for (int32_t v = 0; v <= span; ++v)
+    {
+        _rows[v] = static_cast<int16_t>(_plot.bottom() - 1 - (v * rows + span / 2) / span);
+    }
+}
+
+int16_t GlucoseGraph::rowFor(uint16_t mgdl) const
+{
+    const uint16_t clamped = std::min(std::max(mgdl, MIN_MGDL), MAX_MGDL);
+    return _rows[clamped - MIN_MGDL];
+}
+
+void GlucoseGraph::setHistory(const std::vector<GlucoseReading> &readings)
+{
+    std::fill(std::begin(_values), std::end(_values), NO_READING);
+    _head = SLOTS;
+    _newest = 0;
+    for (const GlucoseReading &reading : readings)
+    {
+        _newest = std::max(_newest, reading.getTimestamp());
+    }
+    for (const GlucoseReading &reading : readings)
+    {
+        // Nearest slot: readings jitter a few seconds around the 5-minute grid
+        const time_t age = (_newest - reading.getTimestamp() + INTERVAL_S / 2) / INTERVAL_S;
+        if (age <= static_cast<time_t>(SLOTS))
+        {
+            _values[(_head + SLOTS + 1 - static_cast<size_t>(age)) % (SLOTS + 1)] = reading.getValue();
+        }
+    }
+    redraw();
+}
+
+void GlucoseGraph::append(const GlucoseReading &reading)
+{
+    if (_newest == 0)
+    {
+        setHistory({reading});
+        return;
+    }
+    if (reading.getTimestamp() <= _newest)
+    {
+        return;
+    }
+    const time_t steps = (reading.getTimestamp() - _newest + INTERVAL_S / 2) / INTERVAL_S;
+    if (steps == 0)
+    {
+        return; // same slot, already drawn
+    }
+    _newest = reading.getTimestamp();
+    if (steps > static_cast<time_t>(SLOTS))
+    {
+        std::fill(std::begin(_values), std::end(_values), NO_READING);
+        _values[_head] = reading.getValue();
+        redraw();
+        return;
+    }
+    for (time_t i = 1; i < steps; ++i)
+    {
+        push(NO_READING);
+    }
+    push(reading.getValue());
+}
+
+void GlucoseGraph::push(uint16_t mgdl)
+{
+    _head = (_head + 1) % (SLOTS + 1);
+    _values[_head] = mgdl;
+
+    // scrollLeft() leaves the uncovered strip white; only it needs the band again
+    _fb.scrollLeft(_window, _pitch);
+    drawBand(Rect{static_cast<int16_t>(_plot.right() - _pitch), _plot.y, _pitch, _plot.h});
+    drawSegment(SLOTS - 1);
+}
+
+void GlucoseGraph::redraw()
+{
+    _fb.fillRect(_plot, Framebuffer::Color::White);
+    drawBand(_plot);
+
+    // Axis with ticks every 100 mg/dL just outside the plot
+    _fb.vLine(static_cast<int16_t>(_plot.x - 1), _plot.y, _plot.h, Framebuffer::Color::Black);
+    for (uint16_t v = 100; v <= MAX_MGDL; v += 100)
+    {
+        _fb.hLine(static_cast<int16_t>(_plot.x - 5), rowFor(v), 4, Framebuffer::Color::Black);
+    }
+
+    for (size_t i = 0; i < SLOTS; ++i)
+    {
+        drawSegment(i);
+    }
+}
+
+void GlucoseGraph::drawBand(Rect area)
+{
+    _fb.fillRect(Rect{area.x, rowFor(_highTarget), area.w, 1}, Framebuffer::Color::Black);
+    _fb.fillRect(Rect{area.x, rowFor(_lowTarget), area.w, 1}, Framebuffer::Color::Black);
+}
+
+void GlucoseGraph::drawSegment(size_t index)
+{
+    // index counts from the oldest visible slot; index - 1 may be the hidden slot
+    const uint16_t value = slot(SLOTS - 1 - index);
+    if (value == NO_READING)
+    {
+        return;
+    }
+    const uint16_t previous = slot(SLOTS - index);
+    const int16_t x = xFor(index);
+    const int16_t y = rowFor(value);
+    if (previous == NO_READING)
+    {
+        _fb.drawLine(x, y, x, y, Framebuffer::Color::Black, _window);
+        return;
+    }
+    _fb.drawLine(static_cast<int16_t>(x - _pitch), rowFor(previous), x, y, Framebuffer::Color::Black, _window);
+}
@@ -0,0 +1,66 @@
+#include "refresh_planner.h"
+
+void RefreshPlanner::reset()
+{
+    _state.shownHash = 0;
+    _state.lastFullAt = 0;
+    _state.ghosting = 0;
+    _state.partials = 0;
+    _state.hashValid = 0;
+}
+
+uint16_t RefreshPlanner::partialCost(int32_t dirtyArea) const
+{
+    if (_panelArea <= 0)
+    {
+        return PARTIAL_COST + AREA_COST;
+    }
+    const int64_t area = dirtyArea < 0 ? 0 : (dirtyArea > _panelArea ? _panelArea : dirtyArea);
+    return static_cast<uint16_t>(PARTIAL_COST + area * AREA_COST / _panelArea);
+}
+
+RefreshKind RefreshPlanner::plan(const DirtyTracker &dirty, time_t now) const
+{
+    if (!dirty.any())
+    {
+        return RefreshKind::None;
+    }
+    if (_state.lastFullAt == 0)
+    {
+        return RefreshKind::Full; // panel content unknown after a cold start
+    }
+    const int32_t area = dirty.area();
+    if (static_cast<int64_t>(area) * 100 >= static_cast<int64_t>(_panelArea) * FULL_AREA_PERCENT)
+    {
+        return RefreshKind::Full;
+    }
+    if (_state.partials >= MAX_PARTIALS || _state.ghosting + partialCost(area) > GHOSTING_LIMIT)
+    {
+        return RefreshKind::Full;
+    }
+    if (now != 0 && _state.lastFullAt != 0 && now - _state.lastFullAt >= static_cast<time_t>(MAX_FULL_INTERVAL_S))
+    {
+        return RefreshKind::Full;
+    }
+    return RefreshKind::Partial;
+}
+
+void RefreshPlanner::onRefreshed(RefreshKind kind, uint32_t hash, int32_t dirtyArea, time_t now)
+{
+    switch (kind)
+    {
+    case RefreshKind::None:
+        return;
+    case RefreshKind::Full:
+        _state.ghosting = 0;
+        _state.partials = 0;
+        _state.lastFullAt = now != 0 ? now : 1; // still marks the panel as known
+        break;
+    case RefreshKind::Partial:
+        _state.ghosting = static_cast<uint16_t>(_state.ghosting + partialCost(dirtyArea));
+        ++_state.partials;
+        break;
+    }
+    _state.shownHash = hash;
+    _state.hashValid = 1;
+}
@@ -0,0 +1,40 @@
+#include "screen_state.h"
+
+namespace
+{
+    constexpr uint32_t FNV_OFFSET = 2166136261u;
+    constexpr uint32_t FNV_PRIME = 16777619u;
+
+    inline uint32_t mix(uint32_t hash, uint16_t value)
+    {
+        hash = (hash ^ (value & 0xFF)) * FNV_PRIME;
+        return (hash ^ (value >> 8)) * FNV_PRIME;
+    }
+}
+
+ScreenState ScreenState::capture(const GlucoseReading &reading, time_t now, const GlucoseGraph &graph)
+{
+    ScreenState state{};
+    state.value = reading.getValue();
+    state.trend = static_cast<uint8_t>(reading.getTrend());
+    const time_t age = now > reading.getTimestamp() ? now - reading.getTimestamp() : 0;
+    state.ageMinutes = static_cast<uint16_t>(age / 60 > UINT16_MAX ? UINT16_MAX : age / 60);
+    for (size_t i = 0; i < GRAPH_TAIL; ++i)
+    {
+        state.graphTail[i] = graph.slot(i);
+    }
+    return state;
+}
+
+uint32_t ScreenState::hash() const
+{
+    // Field by field rather than over the struct bytes, so padding never leaks in
+    uint32_t h = mix(FNV_OFFSET, value);
+    h = mix(h, trend);
+    h = mix(h, ageMinutes);
+    for (uint16_t slot : graphTail)
+    {
+        h = mix(h, slot);
+    }
+    return h;
+}
@@ -0,0 +1,78 @@
+#ifndef DNS_CACHE_H
+#define DNS_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include "i_dns_resolver.h"
+
+/**
+ * @file dns_cache.h
+ * @brief Small TTL-honouring cache of host name to IPv4 lookups.
+ *
+ * Expiry is kept in wall-clock seconds rather than millis() so entries stay meaningful
+ * across deep sleep; the entries are a POD struct the caller can place in RTC memory.
+ * When a refresh fails, an expired entry is still returned (serve-stale) because the
+ * Share host rarely moves and a stale answer beats no answer.
+ */
+
+struct DnsCacheEntry
+{
+    static constexpr size_t HOST_MAX = 47;
+
+    char host[HOST_MAX + 1]; // empty when the slot is free
+    uint32_t ip;
+    uint32_t expiresAt; // epoch seconds
+};
+
+struct DnsCacheState
+{
+    static constexpr size_t CAPACITY = 2;
+
+    DnsCacheEntry entries[CAPACITY];
+};
+
+class DnsCache
+{
+public:
+    /// Floor on the TTL, so a 0 s answer does not turn every connect into a lookup.
+    static constexpr uint32_t MIN_TTL_S = 60;
+    /// Ceiling on the TTL, so a bogus answer cannot pin an address for days.
+    static constexpr uint32_t MAX_TTL_S = 24 * 3600;
+
+    /**
+     * @param resolver Used on a miss or expired entry
+     * @param state Externally owned entries (e.g. in RTC memory); not cleared here
+     */
+    DnsCache(std::shared_ptr<IDnsResolver> resolver, DnsCacheState &state);
+
+    /// Frees every entry.
+    void clear();
+
+    /**
+     * @brief Returns the address of @p host, resolving only if needed.
+     *
+     * @param host Host name (longer than DnsCacheEntry::HOST_MAX is resolved but not cached)
+     * @param now Wall-clock time; 0 if unknown, which bypasses the cache
+     * @param ip Receives the address
+     * @return false if nothing could be resolved and no entry (even stale) exists
+     */
+    bool lookup(const char *host, time_t now, uint32_t &ip);
+
+    /// Forgets @p host, e.g. after connecting to its cached address failed.
+    void invalidate(const char *host);
+
+    /// Whether @p host has an unexpired entry at @p now.
+    bool contains(const char *host, time_t now) const;
+
+private:
+    DnsCacheEntry *find(const char *host);
+    const DnsCacheEntry *find(const char *host) const;
+    DnsCacheEntry &slotFor(const char *host);
+
+    std::shared_ptr<IDnsResolver> _resolver;
+    DnsCacheState &_state;
+};
+
+#endif // DNS_CACHE_H
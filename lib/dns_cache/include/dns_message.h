@@ -0,0 +1,37 @@
+#ifndef DNS_MESSAGE_H
+#define DNS_MESSAGE_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file dns_message.h
+ * @brief Minimal DNS wire format for a single A query, enough to learn the record TTL.
+ *
+ * The Arduino resolver only returns an address, so the device resolver sends its own
+ * query over UDP. Addresses are returned in network byte order packed into a uint32_t
+ * the way lwIP and IPAddress store them (first octet in the low byte).
+ */
+namespace DnsMessage
+{
+    constexpr uint16_t PORT = 53;
+    constexpr size_t MAX_MESSAGE_SIZE = 512;
+
+    /**
+     * @brief Builds a recursive A/IN query for @p host.
+     * @return Message length, or 0 if @p host is malformed or @p capacity too small
+     */
+    size_t buildQuery(const char *host, uint16_t id, uint8_t *out, size_t capacity);
+
+    /**
+     * @brief Extracts the first A record from a response to query @p id.
+     *
+     * CNAME chains are followed implicitly: the first A answer is taken. The TTL is the
+     * smallest TTL along the answer section, so an alias never outlives its target.
+     *
+     * @return false for a different id, an error rcode, a truncated message or no A record
+     */
+    bool parseResponse(const uint8_t *data, size_t size, uint16_t id, uint32_t &ip, uint32_t &ttlS);
+}
+
+#endif // DNS_MESSAGE_H
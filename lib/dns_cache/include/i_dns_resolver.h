@@ -0,0 +1,23 @@
+#ifndef I_DNS_RESOLVER_H
+#define I_DNS_RESOLVER_H
+
+#include <cstdint>
+
+/**
+ * @brief Resolves a host name to one IPv4 address and the TTL the server gave for it.
+ */
+class IDnsResolver
+{
+public:
+    virtual ~IDnsResolver() = default;
+
+    /**
+     * @param host Host name to resolve
+     * @param ip Receives the address in the platform's native uint32_t form
+     * @param ttlS Receives the record TTL in seconds
+     * @return false if the name could not be resolved
+     */
+    virtual bool resolve(const char *host, uint32_t &ip, uint32_t &ttlS) = 0;
+};
+
+#endif // I_DNS_RESOLVER_H
@@ -0,0 +1,107 @@
+#include "dns_cache.h"
+
+#include <cstring>
+#define LOG_TAG "dns"
+#define LOG_MODULE_LEVEL LOG_LEVEL_DNS
+#include <debug_print.h>
+
+DnsCache::DnsCache(std::shared_ptr<IDnsResolver> resolver, DnsCacheState &state)
+    : _resolver(std::move(resolver)), _state(state)
+{
+}
+
+void DnsCache::clear()
+{
+    std::memset(&_state, 0, sizeof(_state));
+}
+
+DnsCacheEntry *DnsCache::find(const char *host)
+{
+    return const_cast<DnsCacheEntry *>(static_cast<const DnsCache *>(this)->find(host));
+}
+
+const DnsCacheEntry *DnsCache::find(const char *host) const
+{
+    for (const auto &entry : _state.entries)
+    {
+        if (entry.host[0] != '\0' && std::strncmp(entry.host, host, sizeof(entry.host)) == 0)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+DnsCacheEntry &DnsCache::slotFor(const char *host)
+{
+    if (DnsCacheEntry *existing = find(host))
+    {
+        return *existing;
+    }
+    // Free slot, else the one expiring first
+    DnsCacheEntry *victim = &_state.entries[0];
+    for (auto &entry : _state.entries)
+    {
+        if (entry.host[0] == '\0')
+        {
+            return entry;
+        }
+        if (entry.expiresAt < victim->expiresAt)
+        {
+            victim = &entry;
+        }
+    }
+    return *victim;
+}
+
+bool DnsCache::contains(const char *host, time_t now) const
+{
+    const DnsCacheEntry *entry = find(host);
+    return entry != nullptr && now != 0 && now < static_cast<time_t>(entry->expiresAt);
+}
+
+bool DnsCache::lookup(const char *host, time_t now, uint32_t &ip)
+{
+    const bool cacheable = now != 0 && std::strlen(host) <= DnsCacheEntry::HOST_MAX;
+    DnsCacheEntry *entry = cacheable ? find(host) : nullptr;
+    if (entry != nullptr && now < static_cast<time_t>(entry->expiresAt))
+    {
+        ip = entry->ip;
+        return true;
+    }
+
+    uint32_t resolved = 0;
+    uint32_t ttl = 0;
+    if (!_resolver->resolve(host, resolved, ttl) || resolved == 0)
+    {
+        if (entry != nullptr)
+        {
+            LOG_WARN("Lookup of %s failed, using expired entry", host);
+            ip = entry->ip;
+            return true;
+        }
+        LOG_WARN("Lookup of %s failed", host);
+        return false;
+    }
+
+    ip = resolved;
+    if (cacheable)
+    {
+        ttl = ttl < MIN_TTL_S ? MIN_TTL_S : (ttl > MAX_TTL_S ? MAX_TTL_S : ttl);
+        DnsCacheEntry &slot = slotFor(host);
+        std::memset(&slot, 0, sizeof(slot));
+        std::memcpy(slot.host, host, std::strlen(host));
+        slot.ip = resolved;
+        slot.expiresAt = static_cast<uint32_t>(now + ttl);
+        LOG_DEBUG("Cached %s for %lu s", host, static_cast<unsigned long>(ttl));
+    }
+    return true;
+}
+
+void DnsCache::invalidate(const char *host)
+{
+    if (DnsCacheEntry *entry = find(host))
+    {
+        std::memset(entry, 0, sizeof(*entry));
+    }
+}
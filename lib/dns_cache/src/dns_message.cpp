@@ -0,0 +1,145 @@
+#include "dns_message.h"
+
+#include <cstring>
+
+namespace
+{
+    constexpr size_t HEADER_SIZE = 12;
+    constexpr uint16_t TYPE_A = 1;
+    constexpr uint16_t CLASS_IN = 1;
+    constexpr uint16_t FLAG_RESPONSE = 0x8000;
+    constexpr uint16_t FLAG_RECURSION_DESIRED = 0x0100;
+    constexpr uint16_t RCODE_MASK = 0x000F;
+
+    uint16_t read16(const uint8_t *p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+    uint32_t read32(const uint8_t *p)
+    {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+               (static_cast<uint32_t>(p[2]) << 8) | p[3];
+    }
+
+    // Advances past a (possibly compressed) name; returns false if it runs off the end
+    bool skipName(const uint8_t *data, size_t size, size_t &pos)
+    {
+        while (pos < size)
+        {
+            const uint8_t length = data[pos];
+            if (length == 0)
+            {
+                ++pos;
+                return true;
+            }
+            if ((length & 0xC0) == 0xC0)
+            {
+                // A pointer always ends the name in place
+                if (pos + 2 > size)
+                {
+                    return false;
+                }
+                pos += 2;
+                return true;
+            }
+            if (length & 0xC0)
+            {
+                return false;
+            }
+            pos += 1 + length;
+        }
+        return false;
+    }
+}
+
+size_t DnsMessage::buildQuery(const char *host, uint16_t id, uint8_t *out, size_t capacity)
+{
+    const size_t hostLength = host ? std::strlen(host) : 0;
+    // Header, labels (one length byte per label plus the root), type and class
+    const size_t total = HEADER_SIZE + hostLength + 2 + 4;
+    if (hostLength == 0 || hostLength > 253 || total > capacity)
+    {
+        return 0;
+    }
+
+    std::memset(out, 0, HEADER_SIZE);
+    out[0] = static_cast<uint8_t>(id >> 8);
+    out[1] = static_cast<uint8_t>(id);
+    out[2] = static_cast<uint8_t>(FLAG_RECURSION_DESIRED >> 8);
+    out[5] = 1; // one question
+
+    size_t pos = HEADER_SIZE;
+    const char *label = host;
+    while (*label != '\0')
+    {
+        const char *dot = std::strchr(label, '.');
+        const size_t length = dot ? static_cast<size_t>(dot - label) : std::strlen(label);
+        if (length == 0 || length > 63)
+        {
+            return 0;
+        }
+        out[pos++] = static_cast<uint8_t>(length);
+        std::memcpy(out + pos, label, length);
+        pos += length;
+        label += length + (dot ? 1 : 0);
+    }
+    out[pos++] = 0;
+    out[pos++] = 0;
+    out[pos++] = TYPE_A;
+    out[pos++] = 0;
+    out[pos++] = CLASS_IN;
+    return pos;
+}
+
+bool DnsMessage::parseResponse(const uint8_t *data, size_t size, uint16_t id, uint32_t &ip, uint32_t &ttlS)
+{
+    if (data == nullptr || size < HEADER_SIZE || read16(data) != id)
+    {
+        return false;
+    }
+    const uint16_t flags = read16(data + 2);
+    if (!(flags & FLAG_RESPONSE) || (flags & RCODE_MASK) != 0)
+    {
+        return false;
+    }
+    const uint16_t questions = read16(data + 4);
+    const uint16_t answers = read16(data + 6);
+
+    size_t pos = HEADER_SIZE;
+    for (uint16_t i = 0; i < questions; ++i)
+    {
+        if (!skipName(data, size, pos) || pos + 4 > size)
+        {
+            return false;
+        }
+        pos += 4;
+    }
+
+    uint32_t minTtl = UINT32_MAX;
+    for (uint16_t i = 0; i < answers; ++i)
+    {
+        if (!skipName(data, size, pos) || pos + 10 > size)
+        {
+            return false;
+        }
+        const uint16_t type = read16(data + pos);
+        const uint16_t cls = read16(data + pos + 2);
+        const uint32_t ttl = read32(data + pos + 4);
+        const uint16_t length = read16(data + pos + 8);
+        pos += 10;
+        if (pos + length > size)
+        {
+            return false;
+        }
+        if (ttl < minTtl)
+        {
+            minTtl = ttl;
+        }
+        if (type == TYPE_A && cls == CLASS_IN && length == 4)
+        {
+            // Keep wire order in memory, matching lwIP's ip4_addr_t
+            std::memcpy(&ip, data + pos, 4);
+            ttlS = minTtl;
+            return true;
+        }
+        pos += length;
+    }
+    return false;
+}
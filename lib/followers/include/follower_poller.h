@@ -0,0 +1,120 @@
+#ifndef FOLLOWER_POLLER_H
+#define FOLLOWER_POLLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dexcom_client.h"
+#include "glucose_reading.h"
+#include "i_glucose_reading_parser.h"
+#include "i_http_client.h"
+#include "wake_planner.h"
+
+/**
+ * @file follower_poller.h
+ * @brief Follows several Share accounts from one device over one connection.
+ *
+ * Each account keeps its own session, a short history and a WakePlanner that learns
+ * when its sensor uploads, so polls for different people land at different points in
+ * the 5-minute cycle instead of all at once. Every account talks through the same
+ * IHttpClient, i.e. one TLS connection to the regional Share host; pollDue() issues at
+ * most one account's request per call so accounts interleave on that connection and a
+ * slow or failing account does not hold up the rest, while pollAllDue() pipelines the
+ * accounts that are due together. Accounts on different regional hosts need a poller
+ * (and connection) each.
+ */
+
+struct FollowerAccount
+{
+    std::string username;  // or empty with accountId set
+    std::string accountId;
+    std::string password;
+    std::string sessionId; // restored session, empty to log in on the first poll
+};
+
+class FollowerPoller
+{
+public:
+    static constexpr size_t MAX_FOLLOWERS = 8;
+    /// Readings kept per account: the last 3 hours.
+    static constexpr size_t HISTORY_CAPACITY = 36;
+    static constexpr uint16_t HISTORY_MINUTES = HISTORY_CAPACITY * 5;
+
+    FollowerPoller(std::shared_ptr<IHttpClient> httpClient,
+                   std::shared_ptr<IGlucoseReadingParser> glucoseParser,
+                   bool ous = false);
+
+    ~FollowerPoller();
+
+    /**
+     * @brief Adds an account, due for its first poll immediately.
+     * @return Index of the account, or -1 if MAX_FOLLOWERS are already followed
+     */
+    int addAccount(const FollowerAccount &account);
+
+    size_t size() const { return _followers.size(); }
+
+    /**
+     * @brief Polls the most overdue account, if any is due.
+     *
+     * A failed login or fetch is logged and retried on that account's own backoff.
+     *
+     * @return Index of the account polled, or -1 if none was due
+     */
+    int pollDue(time_t now);
+
+    /**
+     * @brief Polls every due account, pipelining the readings requests of those with a
+     * session into one round trip on the shared connection.
+     *
+     * Accounts that still need to log in are polled one by one after the pipeline. An
+     * account whose session expired in the pipeline is left due, so the next call logs
+     * it in again and re-polls it; the other responses in the pipeline are unaffected.
+     * A request the connection dropped keeps its session and is retried on its backoff.
+     *
+     * @return Number of accounts polled
+     */
+    size_t pollAllDue(time_t now);
+
+    /// Earliest time any account is due, 0 if there are no accounts.
+    time_t nextPollAt() const;
+
+    /// Account @p index's readings, newest first.
+    const std::vector<GlucoseReading> &history(size_t index) const { return _followers[index]->history; }
+
+    /// Account @p index's session, e.g. to keep it across deep sleep; empty before login.
+    std::string sessionId(size_t index) const;
+
+    /// Learned upload phase of account @p index's sensor, seconds into the interval.
+    uint32_t phaseSeconds(size_t index) const { return WakePlanner(_followers[index]->planner).phaseSeconds(); }
+
+    /// Heap and object bytes held for the accounts, excluding the shared connection.
+    size_t footprintBytes() const;
+
+private:
+    struct Follower
+    {
+        FollowerAccount account; // cleared once the client holds the credentials
+        std::unique_ptr<DexcomClient> client;
+        std::vector<GlucoseReading> history;
+        WakePlannerState planner;
+        time_t dueAt;
+        bool sessionExpired; // log in again before the next fetch
+    };
+
+    void poll(Follower &follower, time_t now);
+    static void fetchWindow(const Follower &follower, time_t now, uint16_t &minutes, uint16_t &maxCount);
+    void schedule(Follower &follower, time_t now);
+    void merge(Follower &follower, const std::vector<GlucoseReading> &readings);
+
+    std::shared_ptr<IHttpClient> _httpClient;
+    std::shared_ptr<IGlucoseReadingParser> _glucoseParser;
+    bool _ous;
+    std::vector<std::unique_ptr<Follower>> _followers;
+};
+
+#endif // FOLLOWER_POLLER_H
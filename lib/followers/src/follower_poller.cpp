@@ -0,0 +1,221 @@
+#include "follower_poller.h"
+
+#include <algorithm>
+
+#include "dexcom_errors.h"
+#define LOG_TAG "followers"
+#define LOG_MODULE_LEVEL LOG_LEVEL_DEXCOM_CLIENT
+#include <debug_print.h>
+
+FollowerPoller::FollowerPoller(std::shared_ptr<IHttpClient> httpClient,
+                               std::shared_ptr<IGlucoseReadingParser> glucoseParser,
+                               bool ous)
+    : _httpClient(std::move(httpClient)),
+      _glucoseParser(std::move(glucoseParser)),
+      _ous(ous)
+{
+    _followers.reserve(MAX_FOLLOWERS);
+}
+
+FollowerPoller::~FollowerPoller() = default;
+
+int FollowerPoller::addAccount(const FollowerAccount &account)
+{
+    if (_followers.size() >= MAX_FOLLOWERS)
+    {
+        return -1;
+    }
+    auto follower = std::make_unique<Follower>();
+    follower->account = account;
+    follower->history.reserve(HISTORY_CAPACITY);
+    WakePlanner(follower->planner).reset();
+    follower->dueAt = 0;
+    follower->sessionExpired = false;
+    _followers.push_back(std::move(follower));
+    return static_cast<int>(_followers.size() - 1);
+}
+
+int FollowerPoller::pollDue(time_t now)
+{
+    int due = -1;
+    for (size_t i = 0; i < _followers.size(); ++i)
+    {
+        if (_followers[i]->dueAt <= now && (due < 0 || _followers[i]->dueAt < _followers[due]->dueAt))
+        {
+            due = static_cast<int>(i);
+        }
+    }
+    if (due >= 0)
+    {
+        poll(*_followers[due], now);
+    }
+    return due;
+}
+
+time_t FollowerPoller::nextPollAt() const
+{
+    time_t next = 0;
+    for (const auto &follower : _followers)
+    {
+        if (next == 0 || follower->dueAt < next)
+        {
+            next = follower->dueAt;
+        }
+    }
+    return next;
+}
+
+std::string FollowerPoller::sessionId(size_t index) const
+{
+    const Follower &follower = *_followers[index];
+    return follower.client ? follower.client->sessionId() : follower.account.sessionId;
+}
+
+size_t FollowerPoller::footprintBytes() const
+{
+    size_t bytes = _followers.capacity() * sizeof(_followers[0]);
+    for (const auto &follower : _followers)
+    {
+        bytes += sizeof(Follower) + follower->history.capacity() * sizeof(GlucoseReading);
+        if (follower->client)
+        {
+            bytes += sizeof(DexcomClient) + follower->client->sessionId().capacity();
+        }
+    }
+    return bytes;
+}
+
+size_t FollowerPoller::pollAllDue(time_t now)
+{
+    // Accounts with a live session share one pipelined round trip; the rest log in
+    // one by one afterwards, so a slow login does not hold up their readings
+    std::vector<Follower *> batch;
+    std::vector<Follower *> solo;
+    std::vector<HttpRequest> requests;
+    for (const auto &follower : _followers)
+    {
+        if (follower->dueAt > now)
+        {
+            continue;
+        }
+        if (!follower->client || follower->sessionExpired)
+        {
+            solo.push_back(follower.get());
+            continue;
+        }
+        uint16_t minutes = 0;
+        uint16_t maxCount = 0;
+        fetchWindow(*follower, now, minutes, maxCount);
+        batch.push_back(follower.get());
+        requests.push_back(follower->client->glucoseReadingsRequest(minutes, maxCount));
+    }
+
+    if (batch.size() == 1)
+    {
+        poll(*batch.front(), now);
+    }
+    else if (!batch.empty())
+    {
+        const std::vector<HttpResponse> responses = _httpClient->sendPipelined(requests);
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            Follower &follower = *batch[i];
+            if (HttpTransport::failed(responses[i]))
+            {
+                // The connection dropped, not the session; retry on the usual backoff
+                LOG_WARN("Poll failed: %s", responses[i].body.c_str());
+                schedule(follower, now);
+                continue;
+            }
+            try
+            {
+                merge(follower, follower.client->glucoseReadingsFrom(responses[i]));
+            }
+            catch (const SessionError &)
+            {
+                // Still due: the next call logs in again before fetching
+                LOG_INFO("Session expired, logging in again on the next poll");
+                follower.sessionExpired = true;
+                continue;
+            }
+            catch (const DexcomError &e)
+            {
+                LOG_WARN("Poll failed: %s", e.what());
+            }
+            schedule(follower, now);
+        }
+    }
+
+    for (Follower *follower : solo)
+    {
+        poll(*follower, now);
+    }
+    return batch.size() + solo.size();
+}
+
+void FollowerPoller::poll(Follower &follower, time_t now)
+{
+    try
+    {
+        if (!follower.client)
+        {
+            // Logs in unless a session was restored; shares the open connection
+            const FollowerAccount &account = follower.account;
+            follower.client = std::make_unique<DexcomClient>(_httpClient, _glucoseParser, account.username,
+                                                             account.accountId, account.password, _ous,
+                                                             account.sessionId);
+            follower.account = FollowerAccount{}; // the client keeps the credentials
+        }
+        else if (follower.sessionExpired)
+        {
+            follower.client->refreshSession();
+        }
+        follower.sessionExpired = false;
+        uint16_t minutes = 0;
+        uint16_t maxCount = 0;
+        fetchWindow(follower, now, minutes, maxCount);
+        merge(follower, follower.client->getGlucoseReadings(minutes, maxCount));
+    }
+    catch (const DexcomError &e)
+    {
+        LOG_WARN("Poll failed: %s", e.what());
+    }
+    schedule(follower, now);
+}
+
+void FollowerPoller::fetchWindow(const Follower &follower, time_t now, uint16_t &minutes, uint16_t &maxCount)
+{
+    // Only the window since the newest reading already held
+    uint32_t span = HISTORY_MINUTES;
+    if (!follower.history.empty() && now > follower.history.front().getTimestamp())
+    {
+        span = static_cast<uint32_t>(now - follower.history.front().getTimestamp() + 59) / 60;
+    }
+    minutes = static_cast<uint16_t>(std::min<uint32_t>(std::max<uint32_t>(span, 1), HISTORY_MINUTES));
+    maxCount = static_cast<uint16_t>(std::min<uint32_t>(minutes * 60u / WakePlanner::INTERVAL_S + 1, HISTORY_CAPACITY));
+}
+
+void FollowerPoller::schedule(Follower &follower, time_t now)
+{
+    const time_t newest = follower.history.empty() ? 0 : follower.history.front().getTimestamp();
+    follower.dueAt = now + WakePlanner(follower.planner).onWake(now, newest);
+}
+
+void FollowerPoller::merge(Follower &follower, const std::vector<GlucoseReading> &readings)
+{
+    // Both newest first; only readings newer than the held ones are new
+    const time_t newest = follower.history.empty() ? 0 : follower.history.front().getTimestamp();
+    size_t fresh = 0;
+    while (fresh < readings.size() && readings[fresh].getTimestamp() > newest)
+    {
+        ++fresh;
+    }
+    if (fresh == 0)
+    {
+        return;
+    }
+    fresh = std::min(fresh, HISTORY_CAPACITY);
+    const size_t kept = std::min(follower.history.size(), HISTORY_CAPACITY - fresh);
+    follower.history.erase(follower.history.begin() + kept, follower.history.end());
+    follower.history.insert(follower.history.begin(), readings.begin(), readings.begin() + fresh);
+}
@@ -0,0 +1,150 @@
+#ifndef GLUCOSE_HISTORY_CODEC_H
+#define GLUCOSE_HISTORY_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include "glucose_reading.h"
+
+/**
+ * @file glucose_history_codec.h
+ * @brief Compact binary codec for sequences of GlucoseReading.
+ *
+ * Readings are stored as a stream of records:
+ *  - timestamps as zig-zag varint delta-of-deltas (a steady 300 s cadence costs 1 byte),
+ *  - values as zig-zag varint deltas from the previous value,
+ *  - trends as 4-bit nibbles, packed two per byte ahead of every even record.
+ *
+ * The stream has no header; it ends where the encoded bytes end. Both sides work
+ * on caller-owned buffers so the codec never allocates.
+ */
+
+namespace GlucoseCodec
+{
+    /// Expected spacing between CGM readings, used as the implicit first delta.
+    constexpr int64_t NOMINAL_INTERVAL_S = 300;
+
+    /// Worst-case size of a single record (trend byte + two 10-byte varints).
+    constexpr size_t MAX_RECORD_SIZE = 1 + 10 + 10;
+
+    /// Upper bound on the encoded size of @p count readings.
+    constexpr size_t maxEncodedSize(size_t count) { return count * MAX_RECORD_SIZE; }
+
+    inline uint64_t zigZagEncode(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+    inline int64_t zigZagDecode(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+    /**
+     * @brief Writes @p value as a LEB128 varint.
+     * @return Number of bytes written, or 0 if @p capacity is too small.
+     */
+    size_t writeVarint(uint64_t value, uint8_t *out, size_t capacity);
+
+    /**
+     * @brief Reads a LEB128 varint.
+     * @return Number of bytes consumed, or 0 if the input is truncated or malformed.
+     */
+    size_t readVarint(const uint8_t *in, size_t size, uint64_t &value);
+}
+
+/**
+ * @brief Streaming encoder that appends readings to a fixed buffer.
+ */
+class GlucoseHistoryEncoder
+{
+public:
+    GlucoseHistoryEncoder(uint8_t *buffer, size_t capacity);
+
+    /**
+     * @brief Appends one reading to the stream.
+     *
+     * Readings should be appended oldest first. On failure the buffer is left
+     * exactly as it was before the call.
+     *
+     * @return false if the buffer has no room for the record
+     */
+    bool append(const GlucoseReading &reading);
+
+    /// Discards all encoded data, keeping the same buffer.
+    void reset();
+
+    const uint8_t *data() const noexcept { return _buffer; }
+    size_t size() const noexcept { return _size; }
+    size_t capacity() const noexcept { return _capacity; }
+    size_t count() const noexcept { return _count; }
+
+private:
+    uint8_t *_buffer;
+    size_t _capacity;
+    size_t _size;
+    size_t _count;
+    size_t _trendByteIndex;
+    int64_t _prevTimestamp;
+    int64_t _prevDelta;
+    int32_t _prevValue;
+};
+
+/**
+ * @brief Read-only view over an encoded stream, iterable with range-for.
+ */
+class GlucoseHistoryDecoder
+{
+public:
+    /**
+     * @brief Forward iterator decoding one record per increment.
+     *
+     * A malformed or truncated record ends the iteration; check
+     * GlucoseHistoryDecoder::valid() to tell that apart from a clean end.
+     */
+    class Iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = GlucoseReading;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const GlucoseReading *;
+        using reference = GlucoseReading;
+
+        GlucoseReading operator*() const noexcept
+        {
+            return GlucoseReading(_value, _trend, static_cast<time_t>(_timestamp));
+        }
+        Iterator &operator++();
+        bool operator==(const Iterator &other) const noexcept { return _pos == other._pos; }
+        bool operator!=(const Iterator &other) const noexcept { return _pos != other._pos; }
+
+    private:
+        friend class GlucoseHistoryDecoder;
+        Iterator(const uint8_t *data, size_t size, size_t pos);
+
+        bool decodeNext();
+
+        const uint8_t *_data;
+        size_t _size;
+        size_t _pos;  // start of the current record; _size when at end
+        size_t _next; // start of the following record
+        size_t _index;
+        bool _failed;
+        uint8_t _trendByte;
+        int64_t _timestamp;
+        int64_t _delta;
+        uint16_t _value;
+        DexcomConst::TrendDirection _trend;
+    };
+
+    GlucoseHistoryDecoder(const uint8_t *data, size_t size) noexcept : _data(data), _size(size) {}
+
+    Iterator begin() const { return Iterator(_data, _size, 0); }
+    Iterator end() const { return Iterator(_data, _size, _size); }
+
+    /**
+     * @brief Decodes the whole stream once to check it is well formed.
+     * @return true if every byte belongs to a complete record
+     */
+    bool valid() const;
+
+private:
+    const uint8_t *_data;
+    size_t _size;
+};
+
+#endif // GLUCOSE_HISTORY_CODEC_H
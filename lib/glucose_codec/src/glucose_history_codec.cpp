@@ -0,0 +1,201 @@
+#include "glucose_history_codec.h"
+
+namespace GlucoseCodec
+{
+size_t writeVarint(uint64_t value, uint8_t *out, size_t capacity)
+{
+    size_t n = 0;
+    do
+    {
+        if (n >= capacity)
+        {
+            return 0;
+        }
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        out[n++] = value ? (byte | 0x80) : byte;
+    } while (value);
+    return n;
+}
+
+size_t readVarint(const uint8_t *in, size_t size, uint64_t &value)
+{
+    value = 0;
+    for (size_t n = 0; n < size && n < 10; ++n)
+    {
+        value |= static_cast<uint64_t>(in[n] & 0x7F) << (7 * n);
+        if (!(in[n] & 0x80))
+        {
+            return n + 1;
+        }
+    }
+    return 0;
+}
+} // namespace GlucoseCodec
+
+GlucoseHistoryEncoder::GlucoseHistoryEncoder(uint8_t *buffer, size_t capacity)
+    : _buffer(buffer), _capacity(capacity)
+{
+    reset();
+}
+
+void GlucoseHistoryEncoder::reset()
+{
+    _size = 0;
+    _count = 0;
+    _trendByteIndex = 0;
+    _prevTimestamp = 0;
+    _prevDelta = GlucoseCodec::NOMINAL_INTERVAL_S;
+    _prevValue = 0;
+}
+
+bool GlucoseHistoryEncoder::append(const GlucoseReading &reading)
+{
+    const bool evenRecord = (_count % 2) == 0;
+    const uint8_t trend = static_cast<uint8_t>(reading.getTrend()) & 0x0F;
+    const int64_t timestamp = static_cast<int64_t>(reading.getTimestamp());
+    const int32_t value = reading.getValue();
+
+    // The first record carries the absolute timestamp; later ones only the
+    // change in spacing, which is 0 for an on-time reading.
+    const int64_t delta = timestamp - _prevTimestamp;
+    const int64_t timeField = (_count == 0) ? timestamp : delta - _prevDelta;
+
+    size_t pos = _size;
+    if (evenRecord)
+    {
+        if (pos >= _capacity)
+        {
+            return false;
+        }
+        _buffer[pos++] = trend;
+    }
+
+    size_t n = GlucoseCodec::writeVarint(GlucoseCodec::zigZagEncode(timeField), _buffer + pos, _capacity - pos);
+    if (n == 0)
+    {
+        return false;
+    }
+    pos += n;
+
+    n = GlucoseCodec::writeVarint(GlucoseCodec::zigZagEncode(value - _prevValue), _buffer + pos, _capacity - pos);
+    if (n == 0)
+    {
+        return false;
+    }
+    pos += n;
+
+    // Commit only once the whole record fits
+    if (evenRecord)
+    {
+        _trendByteIndex = _size;
+    }
+    else
+    {
+        _buffer[_trendByteIndex] |= static_cast<uint8_t>(trend << 4);
+    }
+    _prevDelta = (_count == 0) ? GlucoseCodec::NOMINAL_INTERVAL_S : delta;
+    _prevTimestamp = timestamp;
+    _prevValue = value;
+    _size = pos;
+    ++_count;
+    return true;
+}
+
+GlucoseHistoryDecoder::Iterator::Iterator(const uint8_t *data, size_t size, size_t pos)
+    : _data(data), _size(size), _pos(pos), _next(pos), _index(0), _failed(false), _trendByte(0),
+      _timestamp(0), _delta(GlucoseCodec::NOMINAL_INTERVAL_S), _value(0),
+      _trend(DexcomConst::TrendDirection::None)
+{
+    if (_pos >= _size)
+    {
+        _pos = _size;
+    }
+    else if (!decodeNext())
+    {
+        _failed = true;
+        _pos = _size;
+    }
+}
+
+GlucoseHistoryDecoder::Iterator &GlucoseHistoryDecoder::Iterator::operator++()
+{
+    _pos = _next;
+    ++_index;
+    if (_pos >= _size)
+    {
+        _pos = _size;
+    }
+    else if (!decodeNext())
+    {
+        _failed = true;
+        _pos = _size;
+    }
+    return *this;
+}
+
+bool GlucoseHistoryDecoder::Iterator::decodeNext()
+{
+    size_t pos = _pos;
+    uint8_t trend;
+    if ((_index % 2) == 0)
+    {
+        _trendByte = _data[pos++];
+        trend = _trendByte & 0x0F;
+    }
+    else
+    {
+        trend = _trendByte >> 4;
+    }
+    if (trend > DexcomConst::TrendDirection::RateOutOfRange)
+    {
+        return false;
+    }
+
+    uint64_t timeField;
+    size_t n = GlucoseCodec::readVarint(_data + pos, _size - pos, timeField);
+    if (n == 0)
+    {
+        return false;
+    }
+    pos += n;
+
+    uint64_t valueField;
+    n = GlucoseCodec::readVarint(_data + pos, _size - pos, valueField);
+    if (n == 0)
+    {
+        return false;
+    }
+    pos += n;
+
+    const int64_t value = static_cast<int64_t>(_value) + GlucoseCodec::zigZagDecode(valueField);
+    if (value < 0 || value > UINT16_MAX)
+    {
+        return false;
+    }
+
+    if (_index == 0)
+    {
+        _timestamp = GlucoseCodec::zigZagDecode(timeField);
+    }
+    else
+    {
+        _delta += GlucoseCodec::zigZagDecode(timeField);
+        _timestamp += _delta;
+    }
+    _value = static_cast<uint16_t>(value);
+    _trend = static_cast<DexcomConst::TrendDirection>(trend);
+    _next = pos;
+    return true;
+}
+
+bool GlucoseHistoryDecoder::valid() const
+{
+    Iterator it = begin();
+    const Iterator last = end();
+    while (it != last)
+    {
+        ++it;
+    }
+    return !it._failed;
+}
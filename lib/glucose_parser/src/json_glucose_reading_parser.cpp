@@ -1,6 +1,9 @@
 #include "json_glucose_reading_parser.h"
+#define LOG_TAG "glucose_parser"
+#define LOG_MODULE_LEVEL LOG_LEVEL_GLUCOSE_PARSER
 #include "debug_print.h"
 #include "dexcom_constants.h"
+#include "phase_timer.h"
 
 JsonGlucoseReadingParser::JsonGlucoseReadingParser(std::shared_ptr<IJsonParser> jsonParser)
     : _jsonParser(std::move(jsonParser))
@@ -9,17 +12,17 @@ JsonGlucoseReadingParser::JsonGlucoseReadingParser(std::shared_ptr<IJsonParser>
 
 std::vector<GlucoseReading> JsonGlucoseReadingParser::parse(const std::string &response)
 {
+    ScopedPhaseTimer timer(Phase::ReadingParse);
     std::vector<GlucoseReading> readings;
     readings.reserve(DexcomConst::MAX_MAX_COUNT);
 
-    DEBUG_PRINT("Parsing glucose readings. Raw response:");
-    DEBUG_PRINT(response.c_str());
+    LOG_VERBOSE("Parsing glucose readings. Raw response: %s", response.c_str());
 
     bool parseSuccess = _jsonParser->parseJsonArray(response, 
         [&](ArduinoJson::JsonObjectConst obj) -> bool {
             // Check if we have already reached the maximum number of readings
             if (readings.size() >= DexcomConst::MAX_MAX_COUNT) {
-                DEBUG_PRINT("Reached MAX_MAX_COUNT limit, stopping parse.");
+                LOG_WARN("Reached MAX_MAX_COUNT limit, stopping parse.");
                 return false; // Stop processing further elements
             }
 
@@ -29,8 +32,7 @@ std::vector<GlucoseReading> JsonGlucoseReadingParser::parse(const std::string &r
                 readings.emplace_back(obj); // Calls the new constructor GlucoseReading(JsonObjectConst)
             } catch (const std::exception& e) {
                 // Log the error but continue processing other elements
-                DEBUG_PRINT("Skipping invalid glucose reading object: ");
-                DEBUG_PRINT(e.what());
+                LOG_WARN("Skipping invalid glucose reading object: %s", e.what());
             }
 
             return true; // Continue processing the next element
@@ -38,11 +40,10 @@ std::vector<GlucoseReading> JsonGlucoseReadingParser::parse(const std::string &r
     );
 
     if (!parseSuccess) {
-        DEBUG_PRINT("Failed to parse JSON array");
+        LOG_ERROR("Failed to parse JSON array");
     }
 
-    DEBUG_PRINT("Total glucose readings parsed: ");
-    DEBUG_PRINTF("%d\n", readings.size());
+    LOG_DEBUG("Total glucose readings parsed: %u", static_cast<unsigned>(readings.size()));
 
     return readings;
 }
@@ -0,0 +1,105 @@
+#ifndef GLUCOSE_PREDICTOR_H
+#define GLUCOSE_PREDICTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <vector>
+#include "glucose_reading.h"
+
+/**
+ * @file glucose_predictor.h
+ * @brief Short-horizon glucose projection with predicted low/high alerts.
+ *
+ * Fits a least-squares line through the last few readings (optionally after an
+ * exponential moving average) and extrapolates it 15-30 minutes ahead. Everything is
+ * integer: values are kept in 1/16 mg/dL and the fit over at most MAX_POINTS readings
+ * is a handful of 64-bit multiply-adds, so an update is constant time and never
+ * allocates. GlucosePredictorState is kept in RTC_DATA_ATTR memory by main.cpp.
+ */
+
+enum class GlucoseAlert : uint8_t
+{
+    None,
+    PredictedLow,  // the lookahead projection just crossed below the low threshold
+    PredictedHigh, // ... or above the high threshold
+};
+
+struct GlucosePrediction
+{
+    bool valid;        // enough recent readings for a fit
+    int16_t slopeQ8;   // mg/dL per minute, x 256
+    uint16_t in15;     // projected mg/dL 15 minutes after the newest reading
+    uint16_t in30;     // ... and 30 minutes after
+    uint16_t ahead;    // ... and at the alert lookahead
+    GlucoseAlert alert;
+};
+
+struct GlucosePredictorState
+{
+    static constexpr size_t MAX_POINTS = 6;
+
+    uint32_t timestamps[MAX_POINTS];
+    int32_t valuesQ4[MAX_POINTS]; // smoothed, mg/dL x 16
+    uint8_t head;                 // oldest point
+    uint8_t count;
+    int32_t smoothedQ4;
+    uint8_t lowLatched;  // a predicted low has been raised and not yet cleared
+    uint8_t highLatched;
+};
+
+class GlucosePredictor
+{
+public:
+    static constexpr uint8_t MIN_POINTS = 3;
+    /// A gap longer than this starts a fresh fit (sensor warm-up, signal loss).
+    static constexpr uint32_t MAX_GAP_S = 15 * 60;
+    /// The projection must recover this far past a threshold before the alert re-arms.
+    static constexpr uint16_t HYSTERESIS_MGDL = 10;
+    static constexpr uint16_t DEFAULT_LOW = 70;
+    static constexpr uint16_t DEFAULT_HIGH = 250;
+    static constexpr uint8_t DEFAULT_LOOKAHEAD_MIN = 20;
+
+    /**
+     * @param points Readings in the fit, MIN_POINTS..MAX_POINTS (4 = last 15 minutes)
+     * @param smoothingQ8 EMA weight of the newest reading, 256 = no smoothing
+     */
+    explicit GlucosePredictor(GlucosePredictorState &state, uint16_t low = DEFAULT_LOW, uint16_t high = DEFAULT_HIGH,
+                              uint8_t lookaheadMin = DEFAULT_LOOKAHEAD_MIN, uint8_t points = 4,
+                              uint16_t smoothingQ8 = 256);
+
+    void clear();
+
+    /**
+     * @brief Folds in a reading and projects ahead from it.
+     *
+     * A reading that is not newer than the last one is ignored and returns an invalid
+     * prediction with no alert.
+     */
+    GlucosePrediction update(const GlucoseReading &reading);
+
+    /**
+     * @brief Folds in readings ordered newest first, as DexcomClient returns them.
+     *
+     * Every reading updates the fit and the alert latches, but only an alert raised by a
+     * reading from the last lookahead before @p now is returned, so a cold-boot backfill
+     * does not announce an excursion from hours ago.
+     * @return The newest such alert, None if there was none
+     */
+    GlucoseAlert addAll(const std::vector<GlucoseReading> &readings, time_t now);
+
+    /// Projection from the current fit without adding a reading.
+    GlucosePrediction predict() const;
+
+private:
+    uint32_t newest() const;
+
+    GlucosePredictorState &_state;
+    uint16_t _low;
+    uint16_t _high;
+    uint8_t _lookahead;
+    uint8_t _points;
+    uint16_t _smoothingQ8;
+};
+
+#endif // GLUCOSE_PREDICTOR_H
@@ -0,0 +1,103 @@
+#ifndef GLUCOSE_STATS_H
+#define GLUCOSE_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <vector>
+#include "glucose_reading.h"
+
+/**
+ * @file glucose_stats.h
+ * @brief Rolling 24 h glucose statistics, updated in O(1) per reading.
+ *
+ * The window is a ring of readings. Count, sum, sum of squares and the per-range counts
+ * are adjusted as readings enter and age out, so a summary never walks the history.
+ * Values are bounded integers, so the moments are kept as exact integer sums rather
+ * than a floating Welford accumulator: removing a reading restores the previous state
+ * bit for bit, and the variance cannot drift however long the window slides.
+ * GlucoseStatsState is a POD, like WakePlannerState, so it survives deep sleep.
+ */
+
+/// Glucose ranges from the international consensus on time in range.
+enum class GlucoseRange : uint8_t
+{
+    VeryLow,  // < 54 mg/dL
+    Low,      // 54-69
+    InRange,  // 70-180
+    High,     // 181-250
+    VeryHigh, // > 250
+    Count
+};
+
+struct GlucoseStatsState
+{
+    static constexpr size_t CAPACITY = 300; // 24 h at 5 min is 288
+
+    uint32_t timestamps[CAPACITY];
+    uint16_t values[CAPACITY];
+    uint16_t head;  // oldest entry
+    uint16_t count;
+    uint32_t sum;
+    uint32_t sumSquares; // at most 300 * 400^2, fits comfortably
+    uint16_t ranges[static_cast<size_t>(GlucoseRange::Count)];
+};
+
+/**
+ * @brief Derived figures, in fixed point.
+ */
+struct GlucoseSummary
+{
+    uint16_t count;
+    uint16_t meanTenths;    // mg/dL x 10
+    uint16_t sdTenths;      // sample standard deviation, mg/dL x 10
+    uint16_t cvPermille;    // SD / mean x 1000
+    uint16_t gmiHundredths; // glucose management indicator, % x 100
+    uint16_t rangePermille[static_cast<size_t>(GlucoseRange::Count)];
+
+    uint16_t timeInRangePermille() const { return rangePermille[static_cast<size_t>(GlucoseRange::InRange)]; }
+};
+
+class GlucoseStats
+{
+public:
+    static constexpr uint32_t WINDOW_S = 24 * 3600;
+
+    /**
+     * @brief Binds to externally owned state (e.g. an RTC_DATA_ATTR variable).
+     * @param state State to use; clear() is not called, so warm state is kept
+     */
+    explicit GlucoseStats(GlucoseStatsState &state) : _state(state) {}
+
+    void clear();
+
+    /**
+     * @brief Adds a reading newer than every reading already in the window.
+     *
+     * Readings 24 h or more older than it are evicted first. If the ring is still full
+     * the oldest reading makes room.
+     * @return false for a reading that is not newer (a re-fetch) or has no value
+     */
+    bool add(const GlucoseReading &reading);
+
+    /// Adds readings ordered newest first, as DexcomClient returns them; returns how many were new.
+    size_t addAll(const std::vector<GlucoseReading> &readings);
+
+    /// Drops readings that are 24 h or more older than @p now.
+    void evict(time_t now);
+
+    GlucoseSummary summary() const;
+
+    size_t count() const { return _state.count; }
+    /// Timestamp of the newest reading, 0 if empty.
+    time_t newest() const;
+
+    static GlucoseRange rangeOf(uint16_t mgdl);
+
+private:
+    void popOldest();
+
+    GlucoseStatsState &_state;
+};
+
+#endif // GLUCOSE_STATS_H
@@ -0,0 +1,166 @@
+#include "glucose_predictor.h"
+
+#include <cstring>
+
+namespace
+{
+    constexpr int32_t MAX_PROJECTION_MGDL = 600;
+
+    int64_t divRounded(int64_t numerator, int64_t denominator)
+    {
+        if (denominator < 0)
+        {
+            numerator = -numerator;
+            denominator = -denominator;
+        }
+        return numerator >= 0 ? (numerator + denominator / 2) / denominator
+                              : -((-numerator + denominator / 2) / denominator);
+    }
+
+    /// Least-squares line through (minutes relative to the newest point, value Q4).
+    struct LineFit
+    {
+        int64_t n;
+        int64_t sumX;
+        int64_t sumY;
+        int64_t slopeNumerator;   // n * Sxy - Sx * Sy
+        int64_t slopeDenominator; // n * Sxx - Sx^2
+
+        int32_t atQ4(int32_t minutes) const
+        {
+            // intercept + slope * minutes with a single rounding step
+            const int64_t scaled = sumY * slopeDenominator - slopeNumerator * sumX + slopeNumerator * minutes * n;
+            return static_cast<int32_t>(divRounded(scaled, n * slopeDenominator));
+        }
+    };
+
+    uint16_t toMgdl(int32_t q4)
+    {
+        const int32_t mgdl = (q4 + 8) >> 4;
+        return static_cast<uint16_t>(mgdl < 0 ? 0 : (mgdl > MAX_PROJECTION_MGDL ? MAX_PROJECTION_MGDL : mgdl));
+    }
+}
+
+GlucosePredictor::GlucosePredictor(GlucosePredictorState &state, uint16_t low, uint16_t high, uint8_t lookaheadMin,
+                                   uint8_t points, uint16_t smoothingQ8)
+    : _state(state), _low(low), _high(high), _lookahead(lookaheadMin),
+      _points(points < MIN_POINTS ? MIN_POINTS
+                                  : (points > GlucosePredictorState::MAX_POINTS ? GlucosePredictorState::MAX_POINTS
+                                                                                : points)),
+      _smoothingQ8(smoothingQ8 == 0 || smoothingQ8 > 256 ? 256 : smoothingQ8)
+{
+}
+
+void GlucosePredictor::clear()
+{
+    std::memset(&_state, 0, sizeof(_state));
+}
+
+uint32_t GlucosePredictor::newest() const
+{
+    return _state.timestamps[(_state.head + _state.count - 1) % GlucosePredictorState::MAX_POINTS];
+}
+
+GlucosePrediction GlucosePredictor::update(const GlucoseReading &reading)
+{
+    const uint32_t timestamp = static_cast<uint32_t>(reading.getTimestamp());
+    const int32_t valueQ4 = static_cast<int32_t>(reading.getMgDl()) << 4;
+    if (reading.getMgDl() == 0 || (_state.count > 0 && timestamp <= newest()))
+    {
+        return GlucosePrediction{};
+    }
+    if (_state.count > 0 && timestamp - newest() > MAX_GAP_S)
+    {
+        _state.count = 0; // too old to extrapolate across; keep the alert latches
+    }
+
+    _state.smoothedQ4 = _state.count == 0 ? valueQ4
+                                          : _state.smoothedQ4 + ((valueQ4 - _state.smoothedQ4) * _smoothingQ8) / 256;
+    if (_state.count == _points)
+    {
+        _state.head = static_cast<uint8_t>((_state.head + 1) % GlucosePredictorState::MAX_POINTS);
+        --_state.count;
+    }
+    const size_t slot = (_state.head + _state.count) % GlucosePredictorState::MAX_POINTS;
+    _state.timestamps[slot] = timestamp;
+    _state.valuesQ4[slot] = _state.smoothedQ4;
+    ++_state.count;
+
+    GlucosePrediction prediction = predict();
+    if (!prediction.valid)
+    {
+        return prediction;
+    }
+    // Raise each alert once when the projection crosses, re-arm when it recovers
+    const uint16_t current = reading.getMgDl();
+    if (!_state.lowLatched && prediction.ahead < _low)
+    {
+        _state.lowLatched = 1;
+        prediction.alert = current >= _low ? GlucoseAlert::PredictedLow : GlucoseAlert::None;
+    }
+    else if (_state.lowLatched && prediction.ahead >= _low + HYSTERESIS_MGDL && current >= _low)
+    {
+        _state.lowLatched = 0;
+    }
+    if (!_state.highLatched && prediction.ahead > _high)
+    {
+        _state.highLatched = 1;
+        prediction.alert = current <= _high ? GlucoseAlert::PredictedHigh : GlucoseAlert::None;
+    }
+    else if (_state.highLatched && prediction.ahead + HYSTERESIS_MGDL <= _high && current <= _high)
+    {
+        _state.highLatched = 0;
+    }
+    return prediction;
+}
+
+GlucoseAlert GlucosePredictor::addAll(const std::vector<GlucoseReading> &readings, time_t now)
+{
+    const time_t recent = now - static_cast<time_t>(_lookahead) * 60;
+    GlucoseAlert alert = GlucoseAlert::None;
+    for (auto it = readings.rbegin(); it != readings.rend(); ++it)
+    {
+        const GlucosePrediction prediction = update(*it);
+        if (prediction.alert != GlucoseAlert::None && it->getTimestamp() >= recent)
+        {
+            alert = prediction.alert;
+        }
+    }
+    return alert;
+}
+
+GlucosePrediction GlucosePredictor::predict() const
+{
+    GlucosePrediction prediction{};
+    if (_state.count < MIN_POINTS)
+    {
+        return prediction;
+    }
+    const uint32_t last = newest();
+    LineFit fit{_state.count, 0, 0, 0, 0};
+    int64_t sumXX = 0;
+    int64_t sumXY = 0;
+    for (size_t i = 0; i < _state.count; ++i)
+    {
+        const size_t slot = (_state.head + i) % GlucosePredictorState::MAX_POINTS;
+        const int64_t x = -static_cast<int64_t>((last - _state.timestamps[slot] + 30) / 60);
+        const int64_t y = _state.valuesQ4[slot];
+        fit.sumX += x;
+        fit.sumY += y;
+        sumXX += x * x;
+        sumXY += x * y;
+    }
+    fit.slopeNumerator = fit.n * sumXY - fit.sumX * fit.sumY;
+    fit.slopeDenominator = fit.n * sumXX - fit.sumX * fit.sumX;
+    if (fit.slopeDenominator == 0)
+    {
+        return prediction; // all points in the same minute
+    }
+    const int64_t slopeQ8 = divRounded(fit.slopeNumerator * 16, fit.slopeDenominator);
+    prediction.valid = true;
+    prediction.slopeQ8 = static_cast<int16_t>(slopeQ8 < INT16_MIN ? INT16_MIN : (slopeQ8 > INT16_MAX ? INT16_MAX : slopeQ8));
+    prediction.in15 = toMgdl(fit.atQ4(15));
+    prediction.in30 = toMgdl(fit.atQ4(30));
+    prediction.ahead = toMgdl(fit.atQ4(_lookahead));
+    return prediction;
+}
@@ -0,0 +1,151 @@
+#include "glucose_stats.h"
+
+#include <cstring>
+
+namespace
+{
+    constexpr uint16_t VERY_LOW_BELOW = 54;
+    constexpr uint16_t LOW_BELOW = 70;
+    constexpr uint16_t HIGH_ABOVE = 180;
+    constexpr uint16_t VERY_HIGH_ABOVE = 250;
+
+    uint64_t isqrtRounded(uint64_t x)
+    {
+        uint64_t root = 0;
+        uint64_t bit = uint64_t(1) << 62;
+        while (bit > x)
+        {
+            bit >>= 2;
+        }
+        while (bit != 0)
+        {
+            if (x >= root + bit)
+            {
+                x -= root + bit;
+                root = (root >> 1) + bit;
+            }
+            else
+            {
+                root >>= 1;
+            }
+            bit >>= 2;
+        }
+        return x > root ? root + 1 : root; // x is now the remainder
+    }
+
+    uint16_t ratio(uint64_t numerator, uint64_t denominator)
+    {
+        return static_cast<uint16_t>((numerator + denominator / 2) / denominator);
+    }
+}
+
+GlucoseRange GlucoseStats::rangeOf(uint16_t mgdl)
+{
+    if (mgdl < VERY_LOW_BELOW)
+    {
+        return GlucoseRange::VeryLow;
+    }
+    if (mgdl < LOW_BELOW)
+    {
+        return GlucoseRange::Low;
+    }
+    if (mgdl <= HIGH_ABOVE)
+    {
+        return GlucoseRange::InRange;
+    }
+    return mgdl <= VERY_HIGH_ABOVE ? GlucoseRange::High : GlucoseRange::VeryHigh;
+}
+
+void GlucoseStats::clear()
+{
+    std::memset(&_state, 0, sizeof(_state));
+}
+
+time_t GlucoseStats::newest() const
+{
+    if (_state.count == 0)
+    {
+        return 0;
+    }
+    return _state.timestamps[(_state.head + _state.count - 1) % GlucoseStatsState::CAPACITY];
+}
+
+bool GlucoseStats::add(const GlucoseReading &reading)
+{
+    const uint16_t value = reading.getMgDl();
+    const time_t timestamp = reading.getTimestamp();
+    if (value == 0 || timestamp <= 0 || (_state.count > 0 && timestamp <= newest()))
+    {
+        return false;
+    }
+    evict(timestamp);
+    if (_state.count == GlucoseStatsState::CAPACITY)
+    {
+        popOldest();
+    }
+    const size_t slot = (_state.head + _state.count) % GlucoseStatsState::CAPACITY;
+    _state.timestamps[slot] = static_cast<uint32_t>(timestamp);
+    _state.values[slot] = value;
+    ++_state.count;
+    _state.sum += value;
+    _state.sumSquares += static_cast<uint32_t>(value) * value;
+    ++_state.ranges[static_cast<size_t>(rangeOf(value))];
+    return true;
+}
+
+size_t GlucoseStats::addAll(const std::vector<GlucoseReading> &readings)
+{
+    size_t added = 0;
+    for (auto it = readings.rbegin(); it != readings.rend(); ++it)
+    {
+        added += add(*it) ? 1 : 0;
+    }
+    return added;
+}
+
+void GlucoseStats::evict(time_t now)
+{
+    while (_state.count > 0 && now - static_cast<time_t>(_state.timestamps[_state.head]) >= WINDOW_S)
+    {
+        popOldest();
+    }
+}
+
+void GlucoseStats::popOldest()
+{
+    const uint16_t value = _state.values[_state.head];
+    _state.sum -= value;
+    _state.sumSquares -= static_cast<uint32_t>(value) * value;
+    --_state.ranges[static_cast<size_t>(rangeOf(value))];
+    _state.head = static_cast<uint16_t>((_state.head + 1) % GlucoseStatsState::CAPACITY);
+    --_state.count;
+}
+
+GlucoseSummary GlucoseStats::summary() const
+{
+    GlucoseSummary s = {};
+    const uint64_t n = _state.count;
+    s.count = _state.count;
+    if (n == 0)
+    {
+        return s;
+    }
+    const uint64_t sum = _state.sum;
+    s.meanTenths = ratio(sum * 10, n);
+    if (n > 1)
+    {
+        // Sample variance, exact: (n * sum(x^2) - sum(x)^2) / (n (n - 1)), scaled to tenths^2
+        const uint64_t spread = n * _state.sumSquares - sum * sum;
+        s.sdTenths = static_cast<uint16_t>(isqrtRounded((spread * 100 + n * (n - 1) / 2) / (n * (n - 1))));
+        // CV^2 = variance / mean^2 = n * spread / ((n - 1) * sum^2); from the sums, not the rounded SD
+        const uint64_t denominator = (n - 1) * sum * sum;
+        s.cvPermille = static_cast<uint16_t>(isqrtRounded((n * spread * 1000000 + denominator / 2) / denominator));
+    }
+    // GMI (%) = 3.31 + 0.02392 * mean mg/dL
+    s.gmiHundredths = static_cast<uint16_t>(331 + ratio(sum * 2392, n * 1000));
+    for (size_t i = 0; i < static_cast<size_t>(GlucoseRange::Count); ++i)
+    {
+        s.rangePermille[i] = ratio(static_cast<uint64_t>(_state.ranges[i]) * 1000, n);
+    }
+    return s;
+}
@@ -4,6 +4,7 @@
 #include <string>
 #include <map>
 #include <optional>
+#include <vector>
 #include <cstdint> // Add this for uint16_t
 
 struct HttpResponse
@@ -13,6 +14,20 @@ struct HttpResponse
     std::map<std::string, std::string> headers;
 };
 
+/// The 500s a client makes up for a request that never got an answer from the server.
+namespace HttpTransport
+{
+    constexpr char CONNECT_FAILED[] = "Failed to connect";
+    constexpr char CONNECTION_CLOSED[] = "Connection closed";
+
+    /// True if @p response stands in for a failed connection rather than coming from the server.
+    inline bool failed(const HttpResponse &response)
+    {
+        return response.statusCode == 500 && response.headers.empty() &&
+               (response.body == CONNECT_FAILED || response.body == CONNECTION_CLOSED);
+    }
+}
+
 struct HttpRequest
 {
     std::string url;
@@ -39,6 +54,23 @@ public:
     virtual HttpResponse post(const std::string &url,
                               const std::string &body,
                               const std::map<std::string, std::string> &headers = {}) = 0;
+
+    /**
+     * @brief Sends independent requests and returns their responses in request order.
+     *
+     * The default sends them one after another; an implementation may pipeline them
+     * on one kept-alive connection instead.
+     */
+    virtual std::vector<HttpResponse> sendPipelined(const std::vector<HttpRequest> &requests)
+    {
+        std::vector<HttpResponse> responses;
+        responses.reserve(requests.size());
+        for (const auto &request : requests)
+        {
+            responses.push_back(send(request));
+        }
+        return responses;
+    }
 };
 
 #endif // I_HTTP_CLIENT_H
\ No newline at end of file
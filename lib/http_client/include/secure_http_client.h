@@ -1,14 +1,20 @@
 #ifndef SECURE_HTTP_CLIENT_H
 #define SECURE_HTTP_CLIENT_H
 
+#include "i_clock.h"
 #include "i_http_client.h"
 #include "i_secure_client.h"
 #include <memory>
+#include <vector>
 
 class SecureHttpClient : public IHttpClient
 {
 public:
-    explicit SecureHttpClient(std::shared_ptr<ISecureClient> client);
+    /**
+     * @param client TLS socket to send requests over
+     * @param clock Optional clock used to timestamp Date headers as they arrive
+     */
+    explicit SecureHttpClient(std::shared_ptr<ISecureClient> client, std::shared_ptr<IClock> clock = nullptr);
     ~SecureHttpClient() override;
 
     bool connect(const std::string &host, uint16_t port) override;
@@ -22,13 +28,39 @@ public:
                       const std::string &body,
                       const std::map<std::string, std::string> &headers = {}) override;
 
+    /**
+     * @brief HTTP/1.1 pipelining: writes up to MAX_PIPELINE_DEPTH requests back to back,
+     * then reads the responses, which the server returns in the same order.
+     *
+     * Responses are matched to requests through a FIFO of in-flight requests, so every
+     * response with another behind it needs a Content-Length. One without (e.g. chunked)
+     * cannot be told apart from the next, so the connection is dropped and the unanswered
+     * requests take the re-send path. A failure status only affects its own request. If
+     * the server closes the connection (or says `Connection: close`) before answering
+     * everything, the unanswered requests are re-sent once on a new connection; those
+     * still unanswered after that get a 500 response.
+     */
+    std::vector<HttpResponse> sendPipelined(const std::vector<HttpRequest> &requests) override;
+
+    /// Raw `Date` header of the most recent response that had one, empty if none yet.
+    const std::string &lastDateHeader() const { return _lastDate; }
+
+    /// Clock reading when lastDateHeader() was received, 0 without a clock.
+    uint32_t lastDateReceivedMs() const { return _lastDateAtMs; }
+
 private:
     std::shared_ptr<ISecureClient> _client;
+    std::shared_ptr<IClock> _clock;
     std::string _host;
     uint16_t _port;
+    std::string _lastDate;
+    uint32_t _lastDateAtMs;
     static constexpr uint32_t DEFAULT_TIMEOUT = 5000; // 5 seconds
+    static constexpr size_t MAX_PIPELINE_DEPTH = 8;
 
-    std::string readResponse();
+    void writeRequest(const HttpRequest &request);
+    bool readResponse(std::string &response, bool needLength = false);
+    void rememberDate(const HttpResponse &response);
     HttpResponse parseResponse(const std::string &rawResponse);
     void writeHeaders(const std::map<std::string, std::string> &headers);
 };
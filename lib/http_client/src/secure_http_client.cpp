@@ -1,9 +1,46 @@
 #include "secure_http_client.h"
+#define LOG_TAG "http"
+#define LOG_MODULE_LEVEL LOG_LEVEL_HTTP_CLIENT
 #include "debug_print.h"
+#include "phase_timer.h"
+#include <cctype>
+#include <deque>
 #include <sstream>
 
-SecureHttpClient::SecureHttpClient(std::shared_ptr<ISecureClient> client)
-    : _client(std::move(client)), _port(0)
+// Platform-specific delay macro
+#ifndef PLATFORM_DELAY
+#ifdef ARDUINO
+#define PLATFORM_DELAY(ms) delay(ms)
+#else
+#include <chrono>
+#include <thread>
+#define PLATFORM_DELAY(ms) std::this_thread::sleep_for(std::chrono::milliseconds(ms))
+#endif
+#endif
+
+namespace
+{
+    bool closesConnection(const HttpResponse &response)
+    {
+        static const char NAME[] = "connection";
+        for (const auto &[key, value] : response.headers)
+        {
+            bool match = key.size() == sizeof(NAME) - 1;
+            for (size_t i = 0; match && i < key.size(); ++i)
+            {
+                match = std::tolower(static_cast<unsigned char>(key[i])) == NAME[i];
+            }
+            if (match)
+            {
+                return value.find("close") != std::string::npos;
+            }
+        }
+        return false;
+    }
+}
+
+SecureHttpClient::SecureHttpClient(std::shared_ptr<ISecureClient> client, std::shared_ptr<IClock> clock)
+    : _client(std::move(client)), _clock(std::move(clock)), _port(0), _lastDateAtMs(0)
 {
     _client->setTimeout(DEFAULT_TIMEOUT);
 }
@@ -17,6 +54,7 @@ bool SecureHttpClient::connect(const std::string &host, uint16_t port)
 {
     _host = host;
     _port = port;
+    ScopedPhaseTimer timer(Phase::TlsConnect);
     return _client->connect(host.c_str(), port);
 }
 
@@ -39,30 +77,79 @@ HttpResponse SecureHttpClient::send(const HttpRequest &request)
     {
         if (!connect(_host, _port))
         {
-            return HttpResponse{500, "Failed to connect", {}};
+            return HttpResponse{500, HttpTransport::CONNECT_FAILED, {}};
         }
     }
 
-    // Write request line
-    _client->println(request.method + " " + request.url + " HTTP/1.1");
+    writeRequest(request);
 
-    // Write headers
-    _client->println("Host: " + _host);
-    writeHeaders(request.headers);
+    std::string raw;
+    readResponse(raw);
+    HttpResponse response = parseResponse(raw);
+    rememberDate(response);
+    return response;
+}
 
-    // Write body if present
-    if (request.body)
-    {
-        _client->println("Content-Length: " + std::to_string(request.body->length()));
-        _client->println();
-        _client->println(*request.body);
-    }
-    else
+std::vector<HttpResponse> SecureHttpClient::sendPipelined(const std::vector<HttpRequest> &requests)
+{
+    std::vector<HttpResponse> responses(requests.size(), HttpResponse{500, HttpTransport::CONNECTION_CLOSED, {}});
+    std::deque<size_t> inFlight; // written and not yet answered, oldest first
+    size_t next = 0;
+    bool resent = false;
+
+    while (next < requests.size() || !inFlight.empty())
     {
-        _client->println();
-    }
+        if (inFlight.empty())
+        {
+            if (!isConnected() && !connect(_host, _port))
+            {
+                for (; next < requests.size(); ++next)
+                {
+                    responses[next] = HttpResponse{500, HttpTransport::CONNECT_FAILED, {}};
+                }
+                break;
+            }
+            for (; next < requests.size() && inFlight.size() < MAX_PIPELINE_DEPTH; ++next)
+            {
+                writeRequest(requests[next]);
+                inFlight.push_back(next);
+            }
+            LOG_DEBUG("%u requests in flight", static_cast<unsigned>(inFlight.size()));
+        }
 
-    return parseResponse(readResponse());
+        std::string raw;
+        if (!readResponse(raw, inFlight.size() > 1))
+        {
+            // Dropped mid-pipeline; the server may or may not have acted on the rest
+            LOG_WARN("Connection lost with %u requests unanswered", static_cast<unsigned>(inFlight.size()));
+            _client->stop();
+            if (!resent)
+            {
+                resent = true;
+                next = inFlight.front();
+            }
+            inFlight.clear();
+            continue;
+        }
+
+        HttpResponse response = parseResponse(raw);
+        rememberDate(response);
+        const bool closing = closesConnection(response);
+        responses[inFlight.front()] = std::move(response);
+        inFlight.pop_front();
+
+        if (closing)
+        {
+            // The server will not answer past this response, so the rest are safe to re-send
+            _client->stop();
+            if (!inFlight.empty())
+            {
+                next = inFlight.front();
+                inFlight.clear();
+            }
+        }
+    }
+    return responses;
 }
 
 HttpResponse SecureHttpClient::get(const std::string &url,
@@ -88,19 +175,57 @@ HttpResponse SecureHttpClient::post(const std::string &url,
     return send(request);
 }
 
-std::string SecureHttpClient::readResponse()
+void SecureHttpClient::writeRequest(const HttpRequest &request)
+{
+    ScopedPhaseTimer writeTimer(Phase::RequestWrite);
+
+    // Write request line
+    _client->println(request.method + " " + request.url + " HTTP/1.1");
+
+    // Write headers
+    _client->println("Host: " + _host);
+    writeHeaders(request.headers);
+
+    // Write body if present
+    if (request.body)
+    {
+        _client->println("Content-Length: " + std::to_string(request.body->length()));
+        _client->println();
+        _client->print(*request.body); // exactly Content-Length bytes; the next pipelined request follows directly
+    }
+    else
+    {
+        _client->println();
+    }
+}
+
+bool SecureHttpClient::readResponse(std::string &response, bool needLength)
 {
-    std::string response;
     bool headers_complete = false;
+    bool first_line = true;
+    ScopedPhaseTimer timer(Phase::FirstByte);
 
     // Read headers
     while (_client->connected() && !headers_complete)
     {
         std::string line = _client->readStringUntil('\n');
+        if (line.empty())
+        {
+            break; // timed out
+        }
+        if (line.back() != '\n')
+        {
+            line += '\n'; // Arduino's readStringUntil drops the terminator
+        }
+        if (first_line)
+        {
+            first_line = false;
+            timer.lap(Phase::BodyRead);
+        }
         response += line;
 
         // Check for empty line that separates headers from body
-        if (line == "\r" || line == "\r\n")
+        if (line == "\r\n" || line == "\n")
         {
             headers_complete = true;
         }
@@ -111,6 +236,10 @@ std::string SecureHttpClient::readResponse()
             break;
         }
     }
+    if (!headers_complete)
+    {
+        return false;
+    }
 
     // Read body if there's data available
     int content_length = 0;
@@ -124,17 +253,40 @@ std::string SecureHttpClient::readResponse()
         }
     }
 
-    // Read exact content length if specified
+    if (needLength && (it == std::string::npos || response.find("Transfer-Encoding: chunked") != std::string::npos))
+    {
+        // Draining what is available would swallow the responses queued behind this one
+        LOG_WARN("Response without Content-Length in a pipeline");
+        return false;
+    }
+
+    // Read exact content length if specified, so a pipelined response that follows is left alone
     if (content_length > 0)
     {
-        while (_client->available() && content_length > 0)
+        uint32_t idleMs = 0;
+        while (content_length > 0 && idleMs < DEFAULT_TIMEOUT)
         {
-            char c = static_cast<char>(_client->read());
-            response += c;
+            if (_client->available() <= 0)
+            {
+                if (!_client->connected())
+                {
+                    break;
+                }
+                PLATFORM_DELAY(1);
+                ++idleMs;
+                continue;
+            }
+            int c = _client->read();
+            if (c < 0)
+            {
+                break;
+            }
+            response += static_cast<char>(c);
             content_length--;
+            idleMs = 0;
         }
     }
-    else
+    else if (it == std::string::npos)
     {
         // Read any remaining data
         while (_client->available())
@@ -144,12 +296,23 @@ std::string SecureHttpClient::readResponse()
         }
     }
 
-    return response;
+    return content_length == 0;
+}
+
+void SecureHttpClient::rememberDate(const HttpResponse &response)
+{
+    auto date = response.headers.find("Date");
+    if (date != response.headers.end())
+    {
+        _lastDate = date->second;
+        _lastDateAtMs = _clock ? _clock->millis() : 0;
+    }
 }
 
 HttpResponse SecureHttpClient::parseResponse(const std::string &rawResponse)
 {
     HttpResponse response;
+    response.statusCode = 500;
     std::istringstream responseStream(rawResponse);
     std::string line;
 
@@ -209,4 +372,4 @@ void SecureHttpClient::writeHeaders(const std::map<std::string, std::string> &he
     {
         _client->println(key + ": " + value);
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,74 @@
+#ifndef I2C_BUS_MANAGER_H
+#define I2C_BUS_MANAGER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "i_i2c_bus.h"
+
+#ifdef ARDUINO
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#else
+#include <mutex>
+#endif
+
+/**
+ * @file i2c_bus_manager.h
+ * @brief Shared I2C bus: serialises drivers on different tasks and batches their transactions.
+ */
+
+/**
+ * @brief II2cBus front end that owns the physical bus.
+ *
+ * Every call takes the bus mutex, so the sensor drivers can be handed this instead of
+ * the raw bus and used from any task. execute() runs a whole I2cBatch under a single
+ * lock and reads adjacent registers of a burst-capable device in one transaction,
+ * bridging gaps of up to MAX_GAP bytes (cheaper than a second start/address/stop).
+ * Writes are never merged (sensors like the BME280 need a register byte per value);
+ * consecutive writes to one device go to the backend's writeBatch().
+ */
+class I2cBusManager : public II2cBus
+{
+public:
+    static constexpr size_t MAX_BURST = 32;
+    static constexpr uint8_t MAX_GAP = 3;
+
+    explicit I2cBusManager(std::shared_ptr<II2cBus> backend);
+    ~I2cBusManager() override;
+
+    I2cBusManager(const I2cBusManager &) = delete;
+    I2cBusManager &operator=(const I2cBusManager &) = delete;
+
+    /// Marks a device whose register pointer auto-increments across reads.
+    void enableBursts(uint8_t address);
+
+    /// Runs the whole batch under one lock, coalescing reads of burst-capable devices.
+    bool execute(I2cBatch &batch) override;
+
+    bool write(uint8_t address, const uint8_t *data, size_t length) override;
+    bool writeRead(uint8_t address, const uint8_t *tx, size_t txLength, uint8_t *rx, size_t rxLength) override;
+    bool writeBatch(uint8_t address, const I2cWrite *writes, size_t count) override;
+
+    /// Reads saved by coalescing since construction.
+    uint32_t coalescedReads() const { return _coalescedReads; }
+
+private:
+    class Lock;
+
+    bool burstCapable(uint8_t address) const { return (_bursts[address >> 5] >> (address & 31)) & 1u; }
+    /// Runs ops [first, last) that were found coalescible as one read.
+    bool burstRead(I2cBatch &batch, size_t first, size_t last);
+
+    std::shared_ptr<II2cBus> _backend;
+    uint32_t _bursts[4];
+    uint32_t _coalescedReads;
+
+#ifdef ARDUINO
+    SemaphoreHandle_t _mutex;
+#else
+    std::mutex _mutex;
+#endif
+};
+
+#endif // I2C_BUS_MANAGER_H
@@ -0,0 +1,104 @@
+#ifndef I_I2C_BUS_H
+#define I_I2C_BUS_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief One register write: the register/command byte followed by its data.
+ */
+struct I2cWrite
+{
+    static constexpr size_t MAX_LENGTH = 4;
+
+    uint8_t bytes[MAX_LENGTH];
+    uint8_t length;
+};
+
+/**
+ * @brief Queued list of register reads and writes, run by II2cBus::execute().
+ *
+ * Fixed capacity so building a batch never allocates. Read destinations must stay
+ * valid until execute() returns.
+ */
+class I2cBatch
+{
+public:
+    static constexpr size_t CAPACITY = 16;
+
+    /// Queues a read of @p length bytes starting at @p reg; false if the batch is full.
+    bool read(uint8_t address, uint8_t reg, uint8_t *out, size_t length);
+
+    /// Queues a register write of up to I2cWrite::MAX_LENGTH - 1 data bytes.
+    bool write(uint8_t address, uint8_t reg, const uint8_t *data, size_t length);
+
+    size_t size() const { return _count; }
+    void clear() { _count = 0; }
+
+    /// Whether operation @p index succeeded in the last execute().
+    bool ok(size_t index) const { return index < _count && _ops[index].ok; }
+
+private:
+    friend class II2cBus;
+    friend class I2cBusManager;
+
+    struct Op
+    {
+        uint8_t address;
+        bool isRead;
+        bool ok;
+        uint8_t *rx;    // reads
+        uint8_t length; // reads
+        uint8_t reg;    // reads
+        I2cWrite tx;    // writes: register byte and data
+    };
+
+    Op _ops[CAPACITY];
+    size_t _count = 0;
+};
+
+/**
+ * @brief Minimal I2C master, so sensor drivers can be tested natively.
+ *
+ * Addresses are 7-bit. Every call is one complete transaction from start to stop.
+ */
+class II2cBus
+{
+public:
+    virtual ~II2cBus() = default;
+
+    /// Writes @p length bytes to the device at @p address.
+    virtual bool write(uint8_t address, const uint8_t *data, size_t length) = 0;
+
+    /// Writes @p tx (typically a register address), then reads @p rxLength bytes after a repeated start.
+    virtual bool writeRead(uint8_t address, const uint8_t *tx, size_t txLength, uint8_t *rx, size_t rxLength) = 0;
+
+    /**
+     * @brief Issues several register writes to one device back to back.
+     *
+     * Backends that can queue transactions override this to run them as one batch;
+     * the default simply loops and stops at the first failure.
+     */
+    virtual bool writeBatch(uint8_t address, const I2cWrite *writes, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!write(address, writes[i].bytes, writes[i].length))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Runs the queued operations in order.
+     *
+     * The default issues them one by one; I2cBusManager holds the bus for the whole
+     * batch and merges reads where the device allows.
+     * @return true if every operation succeeded; see I2cBatch::ok() for which did not
+     */
+    virtual bool execute(I2cBatch &batch);
+};
+
+#endif // I_I2C_BUS_H
@@ -0,0 +1,50 @@
+#ifndef TIMED_I2C_BUS_H
+#define TIMED_I2C_BUS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "i_i2c_bus.h"
+
+/**
+ * @file timed_i2c_bus.h
+ * @brief II2cBus decorator that estimates how long the wire is occupied.
+ *
+ * Counts bit times from the I2C framing: a start, the address byte, every data byte
+ * (each 8 bits plus ACK), a repeated start and second address byte for reads, and a
+ * stop. Wrapped around the register-map simulator it gives per-wake bus occupancy
+ * natively; on the device it can wrap the real bus to log the same figure.
+ */
+class TimedI2cBus : public II2cBus
+{
+public:
+    static constexpr uint32_t STANDARD_HZ = 100000;
+    static constexpr uint32_t FAST_HZ = 400000;
+
+    /// @param overheadUs Fixed per-transaction cost outside the wire time (driver, clock stretching)
+    explicit TimedI2cBus(std::shared_ptr<II2cBus> inner, uint32_t clockHz = STANDARD_HZ, uint32_t overheadUs = 0);
+
+    bool write(uint8_t address, const uint8_t *data, size_t length) override;
+    bool writeRead(uint8_t address, const uint8_t *tx, size_t txLength, uint8_t *rx, size_t rxLength) override;
+
+    /// Bit times a transaction with these byte counts takes; @p rxLength 0 means a plain write.
+    static uint32_t transactionBits(size_t txLength, size_t rxLength);
+
+    uint32_t transactions() const { return _transactions; }
+    uint32_t bits() const { return _bits; }
+    /// Estimated bus occupancy since the last reset().
+    uint32_t busTimeUs() const;
+
+    void reset();
+
+private:
+    void account(size_t txLength, size_t rxLength);
+
+    std::shared_ptr<II2cBus> _inner;
+    uint32_t _clockHz;
+    uint32_t _overheadUs;
+    uint32_t _transactions;
+    uint32_t _bits;
+};
+
+#endif // TIMED_I2C_BUS_H
@@ -0,0 +1,47 @@
+#include "i_i2c_bus.h"
+
+#include <cstring>
+
+bool I2cBatch::read(uint8_t address, uint8_t reg, uint8_t *out, size_t length)
+{
+    if (_count == CAPACITY || length == 0 || length > UINT8_MAX)
+    {
+        return false;
+    }
+    Op &op = _ops[_count++];
+    op.address = address;
+    op.isRead = true;
+    op.ok = false;
+    op.rx = out;
+    op.length = static_cast<uint8_t>(length);
+    op.reg = reg;
+    return true;
+}
+
+bool I2cBatch::write(uint8_t address, uint8_t reg, const uint8_t *data, size_t length)
+{
+    if (_count == CAPACITY || length >= I2cWrite::MAX_LENGTH)
+    {
+        return false;
+    }
+    Op &op = _ops[_count++];
+    op.address = address;
+    op.isRead = false;
+    op.ok = false;
+    op.tx.bytes[0] = reg;
+    std::memcpy(op.tx.bytes + 1, data, length);
+    op.tx.length = static_cast<uint8_t>(length + 1);
+    return true;
+}
+
+bool II2cBus::execute(I2cBatch &batch)
+{
+    bool allOk = true;
+    for (size_t i = 0; i < batch._count; ++i)
+    {
+        I2cBatch::Op &op = batch._ops[i];
+        op.ok = op.isRead ? writeRead(op.address, &op.reg, 1, op.rx, op.length) : writeBatch(op.address, &op.tx, 1);
+        allOk = allOk && op.ok;
+    }
+    return allOk;
+}
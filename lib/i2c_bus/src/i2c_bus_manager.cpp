@@ -0,0 +1,135 @@
+#include "i2c_bus_manager.h"
+
+#include <cstring>
+
+/// Holds the bus mutex for the lifetime of the object.
+class I2cBusManager::Lock
+{
+public:
+    explicit Lock(I2cBusManager &bus) : _bus(bus)
+    {
+#ifdef ARDUINO
+        xSemaphoreTake(_bus._mutex, portMAX_DELAY);
+#else
+        _bus._mutex.lock();
+#endif
+    }
+
+    ~Lock()
+    {
+#ifdef ARDUINO
+        xSemaphoreGive(_bus._mutex);
+#else
+        _bus._mutex.unlock();
+#endif
+    }
+
+private:
+    I2cBusManager &_bus;
+};
+
+I2cBusManager::I2cBusManager(std::shared_ptr<II2cBus> backend)
+    : _backend(std::move(backend)), _bursts(), _coalescedReads(0)
+{
+#ifdef ARDUINO
+    _mutex = xSemaphoreCreateMutex();
+#endif
+}
+
+I2cBusManager::~I2cBusManager()
+{
+#ifdef ARDUINO
+    vSemaphoreDelete(_mutex);
+#endif
+}
+
+void I2cBusManager::enableBursts(uint8_t address)
+{
+    _bursts[(address >> 5) & 3] |= 1u << (address & 31);
+}
+
+bool I2cBusManager::execute(I2cBatch &batch)
+{
+    Lock lock(*this);
+    bool allOk = true;
+    size_t i = 0;
+    while (i < batch._count)
+    {
+        const I2cBatch::Op &op = batch._ops[i];
+        size_t next = i + 1;
+        bool ok;
+        if (op.isRead)
+        {
+            if (burstCapable(op.address))
+            {
+                int end = op.reg + op.length;
+                while (next < batch._count)
+                {
+                    const I2cBatch::Op &candidate = batch._ops[next];
+                    const int candidateEnd = candidate.reg + candidate.length;
+                    if (!candidate.isRead || candidate.address != op.address || candidate.reg < end ||
+                        candidate.reg - end > MAX_GAP || candidateEnd - op.reg > static_cast<int>(MAX_BURST))
+                    {
+                        break;
+                    }
+                    end = candidateEnd;
+                    ++next;
+                }
+            }
+            ok = next - i > 1 ? burstRead(batch, i, next) : _backend->writeRead(op.address, &op.reg, 1, op.rx, op.length);
+        }
+        else
+        {
+            I2cWrite writes[I2cBatch::CAPACITY];
+            size_t count = 0;
+            writes[count++] = op.tx;
+            while (next < batch._count && !batch._ops[next].isRead && batch._ops[next].address == op.address)
+            {
+                writes[count++] = batch._ops[next++].tx;
+            }
+            ok = _backend->writeBatch(op.address, writes, count);
+        }
+        for (; i < next; ++i)
+        {
+            batch._ops[i].ok = ok;
+        }
+        allOk = allOk && ok;
+    }
+    return allOk;
+}
+
+bool I2cBusManager::burstRead(I2cBatch &batch, size_t first, size_t last)
+{
+    const I2cBatch::Op &head = batch._ops[first];
+    const I2cBatch::Op &tail = batch._ops[last - 1];
+    uint8_t buffer[MAX_BURST];
+    if (!_backend->writeRead(head.address, &head.reg, 1, buffer, tail.reg + tail.length - head.reg))
+    {
+        return false;
+    }
+    for (size_t i = first; i < last; ++i)
+    {
+        const I2cBatch::Op &op = batch._ops[i];
+        std::memcpy(op.rx, buffer + (op.reg - head.reg), op.length);
+    }
+    _coalescedReads += static_cast<uint32_t>(last - first - 1);
+    return true;
+}
+
+bool I2cBusManager::write(uint8_t address, const uint8_t *data, size_t length)
+{
+    Lock lock(*this);
+    return _backend->write(address, data, length);
+}
+
+bool I2cBusManager::writeRead(uint8_t address, const uint8_t *tx, size_t txLength, uint8_t *rx, size_t rxLength)
+{
+    Lock lock(*this);
+    return _backend->writeRead(address, tx, txLength, rx, rxLength);
+}
+
+bool I2cBusManager::writeBatch(uint8_t address, const I2cWrite *writes, size_t count)
+{
+    Lock lock(*this);
+    return _backend->writeBatch(address, writes, count);
+}
@@ -0,0 +1,53 @@
+#include "timed_i2c_bus.h"
+
+namespace
+{
+    constexpr uint32_t BYTE_BITS = 9; // 8 data bits and the ACK/NACK
+    constexpr uint32_t START_BITS = 1;
+    constexpr uint32_t STOP_BITS = 1;
+}
+
+TimedI2cBus::TimedI2cBus(std::shared_ptr<II2cBus> inner, uint32_t clockHz, uint32_t overheadUs)
+    : _inner(std::move(inner)), _clockHz(clockHz), _overheadUs(overheadUs), _transactions(0), _bits(0)
+{
+}
+
+bool TimedI2cBus::write(uint8_t address, const uint8_t *data, size_t length)
+{
+    account(length, 0);
+    return _inner->write(address, data, length);
+}
+
+bool TimedI2cBus::writeRead(uint8_t address, const uint8_t *tx, size_t txLength, uint8_t *rx, size_t rxLength)
+{
+    account(txLength, rxLength);
+    return _inner->writeRead(address, tx, txLength, rx, rxLength);
+}
+
+uint32_t TimedI2cBus::transactionBits(size_t txLength, size_t rxLength)
+{
+    uint32_t bits = START_BITS + BYTE_BITS * static_cast<uint32_t>(1 + txLength);
+    if (rxLength > 0)
+    {
+        bits += START_BITS + BYTE_BITS * static_cast<uint32_t>(1 + rxLength); // repeated start, address, data
+    }
+    return bits + STOP_BITS;
+}
+
+uint32_t TimedI2cBus::busTimeUs() const
+{
+    const uint64_t wireUs = (static_cast<uint64_t>(_bits) * 1000000ULL + _clockHz - 1) / _clockHz;
+    return static_cast<uint32_t>(wireUs) + _transactions * _overheadUs;
+}
+
+void TimedI2cBus::reset()
+{
+    _transactions = 0;
+    _bits = 0;
+}
+
+void TimedI2cBus::account(size_t txLength, size_t rxLength)
+{
+    ++_transactions;
+    _bits += transactionBits(txLength, rxLength);
+}
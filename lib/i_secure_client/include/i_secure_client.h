@@ -21,6 +21,7 @@ public:
     virtual void setTimeout(uint32_t timeout) = 0;
     
     // New methods
+    virtual void print(const std::string& data) = 0;
     virtual void println(const std::string& data) = 0;
     virtual void println() = 0;
     virtual std::string readStringUntil(char terminator) = 0;
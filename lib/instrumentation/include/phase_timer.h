@@ -0,0 +1,144 @@
+#ifndef PHASE_TIMER_H
+#define PHASE_TIMER_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file phase_timer.h
+ * @brief Scoped timers feeding fixed-bucket latency histograms, one per wake-cycle phase.
+ *
+ * Time comes from esp_timer_get_time() on the device and std::chrono::steady_clock
+ * natively. Histograms are plain counters and are meant to be updated from one task;
+ * build with `-D DISABLE_PHASE_TIMING` to compile every timer down to nothing.
+ */
+
+enum class Phase : uint8_t
+{
+    WifiAssociate,
+    WifiAddress,
+    DnsLookup,
+    TlsConnect,
+    RequestWrite,
+    FirstByte,
+    BodyRead,
+    JsonDeserialize,
+    ReadingParse,
+    DexcomRequest,
+    SessionCreate,
+    Count
+};
+
+/**
+ * @brief Latency histogram with power-of-two microsecond buckets.
+ *
+ * Bucket 0 holds [0, 2) us, bucket i holds [2^i, 2^(i+1)) us and the last bucket
+ * also takes everything above its range (~8 s and up).
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr size_t BUCKET_COUNT = 24;
+
+    LatencyHistogram() { reset(); }
+
+    void record(uint32_t micros);
+    void reset();
+
+    uint32_t count() const { return _count; }
+    uint64_t totalMicros() const { return _total; }
+    uint32_t minMicros() const { return _count ? _min : 0; }
+    uint32_t maxMicros() const { return _max; }
+    uint32_t meanMicros() const { return _count ? static_cast<uint32_t>(_total / _count) : 0; }
+    uint32_t bucket(size_t index) const { return _buckets[index]; }
+
+    /**
+     * @brief Upper bound of the bucket holding the given percentile.
+     * @param percent 0-100
+     */
+    uint32_t percentileMicros(uint8_t percent) const;
+
+    static size_t bucketFor(uint32_t micros);
+    /// Exclusive upper bound of bucket @p index in microseconds.
+    static uint32_t bucketLimit(size_t index) { return index + 1 >= 32 ? UINT32_MAX : (1u << (index + 1)); }
+
+private:
+    uint32_t _buckets[BUCKET_COUNT];
+    uint32_t _count;
+    uint32_t _min;
+    uint32_t _max;
+    uint64_t _total;
+};
+
+namespace PhaseTiming
+{
+    /// Receives one formatted dump line without a trailing newline.
+    using Sink = void (*)(const char *line, size_t length);
+
+    uint64_t nowMicros();
+    const char *phaseName(Phase phase);
+
+    LatencyHistogram &histogram(Phase phase);
+    void record(Phase phase, uint32_t micros);
+    void resetAll();
+
+    /// Writes one summary line per phase that has samples.
+    void dump(Sink sink);
+}
+
+#ifndef DISABLE_PHASE_TIMING
+
+/**
+ * @brief Records the time from construction to stop() or destruction into a phase histogram.
+ */
+class ScopedPhaseTimer
+{
+public:
+    explicit ScopedPhaseTimer(Phase phase) : _phase(phase), _start(PhaseTiming::nowMicros()), _stopped(false) {}
+    ~ScopedPhaseTimer() { stop(); }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer &) = delete;
+    ScopedPhaseTimer &operator=(const ScopedPhaseTimer &) = delete;
+
+    /// Records now instead of at scope exit; later calls are ignored.
+    void stop()
+    {
+        if (!_stopped)
+        {
+            _stopped = true;
+            PhaseTiming::record(_phase, static_cast<uint32_t>(PhaseTiming::nowMicros() - _start));
+        }
+    }
+
+    /// Records the current phase and starts timing @p next from the same instant.
+    void lap(Phase next)
+    {
+        const uint64_t now = PhaseTiming::nowMicros();
+        if (!_stopped)
+        {
+            PhaseTiming::record(_phase, static_cast<uint32_t>(now - _start));
+        }
+        _phase = next;
+        _start = now;
+        _stopped = false;
+    }
+
+private:
+    Phase _phase;
+    uint64_t _start;
+    bool _stopped;
+};
+
+#else
+
+class ScopedPhaseTimer
+{
+public:
+    explicit ScopedPhaseTimer(Phase) {}
+    void stop() {}
+    void lap(Phase) {}
+};
+
+#endif
+
+#endif // PHASE_TIMER_H
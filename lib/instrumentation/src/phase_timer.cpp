@@ -0,0 +1,156 @@
+#include "phase_timer.h"
+#include <cstdio>
+
+#ifdef ARDUINO
+#include <esp_timer.h>
+#else
+#include <chrono>
+#endif
+
+namespace
+{
+    constexpr const char *PHASE_NAMES[] = {
+        "WifiAssociate",
+        "WifiAddress",
+        "DnsLookup",
+        "TlsConnect",
+        "RequestWrite",
+        "FirstByte",
+        "BodyRead",
+        "JsonDeserialize",
+        "ReadingParse",
+        "DexcomRequest",
+        "SessionCreate"};
+
+    static_assert(sizeof(PHASE_NAMES) / sizeof(PHASE_NAMES[0]) == static_cast<size_t>(Phase::Count),
+                  "PHASE_NAMES must cover every Phase");
+
+    LatencyHistogram histograms[static_cast<size_t>(Phase::Count)];
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto &b : _buckets)
+    {
+        b = 0;
+    }
+    _count = 0;
+    _min = UINT32_MAX;
+    _max = 0;
+    _total = 0;
+}
+
+size_t LatencyHistogram::bucketFor(uint32_t micros)
+{
+    if (micros < 2)
+    {
+        return 0;
+    }
+    size_t index = 31 - __builtin_clz(micros);
+    return index < BUCKET_COUNT ? index : BUCKET_COUNT - 1;
+}
+
+void LatencyHistogram::record(uint32_t micros)
+{
+    ++_buckets[bucketFor(micros)];
+    ++_count;
+    _total += micros;
+    if (micros < _min)
+    {
+        _min = micros;
+    }
+    if (micros > _max)
+    {
+        _max = micros;
+    }
+}
+
+uint32_t LatencyHistogram::percentileMicros(uint8_t percent) const
+{
+    if (_count == 0)
+    {
+        return 0;
+    }
+    // Rank of the sample we are after, rounded up, at least 1
+    uint64_t rank = (static_cast<uint64_t>(_count) * percent + 99) / 100;
+    if (rank == 0)
+    {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i)
+    {
+        seen += _buckets[i];
+        if (seen >= rank)
+        {
+            return i == BUCKET_COUNT - 1 ? _max : bucketLimit(i);
+        }
+    }
+    return _max;
+}
+
+namespace PhaseTiming
+{
+uint64_t nowMicros()
+{
+#ifdef ARDUINO
+    return static_cast<uint64_t>(esp_timer_get_time());
+#else
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+const char *phaseName(Phase phase)
+{
+    return phase < Phase::Count ? PHASE_NAMES[static_cast<size_t>(phase)] : "Unknown";
+}
+
+LatencyHistogram &histogram(Phase phase)
+{
+    return histograms[static_cast<size_t>(phase)];
+}
+
+void record(Phase phase, uint32_t micros)
+{
+    if (phase < Phase::Count)
+    {
+        histograms[static_cast<size_t>(phase)].record(micros);
+    }
+}
+
+void resetAll()
+{
+    for (auto &h : histograms)
+    {
+        h.reset();
+    }
+}
+
+void dump(Sink sink)
+{
+    char line[128];
+    for (size_t i = 0; i < static_cast<size_t>(Phase::Count); ++i)
+    {
+        const LatencyHistogram &h = histograms[i];
+        if (h.count() == 0)
+        {
+            continue;
+        }
+        int length = std::snprintf(line, sizeof(line),
+                                   "%-15s n=%lu mean=%luus min=%luus p50<%luus p90<%luus max=%luus",
+                                   PHASE_NAMES[i],
+                                   static_cast<unsigned long>(h.count()),
+                                   static_cast<unsigned long>(h.meanMicros()),
+                                   static_cast<unsigned long>(h.minMicros()),
+                                   static_cast<unsigned long>(h.percentileMicros(50)),
+                                   static_cast<unsigned long>(h.percentileMicros(90)),
+                                   static_cast<unsigned long>(h.maxMicros()));
+        if (length > 0)
+        {
+            sink(line, static_cast<size_t>(length) < sizeof(line) ? length : sizeof(line) - 1);
+        }
+    }
+}
+} // namespace PhaseTiming
@@ -1,19 +1,23 @@
 #include "arduino_json_parser.h"
+#define LOG_TAG "json"
+#define LOG_MODULE_LEVEL LOG_LEVEL_JSON_PARSER
 #include "debug_print.h"
+#include "phase_timer.h"
 
 bool ArduinoJsonParser::parseJsonArray(const std::string& jsonString, 
                                      std::function<bool(ArduinoJson::JsonObjectConst)> elementProcessor) {
     DynamicJsonDocument doc(16384);
+    ScopedPhaseTimer timer(Phase::JsonDeserialize);
     DeserializationError error = deserializeJson(doc, jsonString);
+    timer.stop();
 
     if (error) {
-        DEBUG_PRINT("Failed to parse JSON array: ");
-        DEBUG_PRINT(error.c_str());
+        LOG_ERROR("Failed to parse JSON array: %s", error.c_str());
         return false;
     }
 
     if (!doc.is<JsonArrayConst>()) {
-        DEBUG_PRINT("JSON is not an array");
+        LOG_ERROR("JSON is not an array");
         return false;
     }
 
@@ -26,7 +30,7 @@ bool ArduinoJsonParser::parseJsonArray(const std::string& jsonString,
             }
         } else {
             // If the element is not an object, skip it but log a warning
-            DEBUG_PRINT("Skipping non-object element in array");
+            LOG_WARN("Skipping non-object element in array");
         }
     }
     
@@ -0,0 +1,29 @@
+#ifndef I_LED_PWM_H
+#define I_LED_PWM_H
+
+#include <cstdint>
+
+/**
+ * @brief Three PWM channels that can ramp to a duty on their own (e.g. ESP32 LEDC fades).
+ */
+class ILedPwm
+{
+public:
+    enum Channel : uint8_t
+    {
+        RED,
+        GREEN,
+        BLUE,
+        CHANNELS
+    };
+
+    virtual ~ILedPwm() = default;
+
+    /**
+     * @brief Starts a hardware fade from the current duty to @p duty and returns at once.
+     * @param durationMs 0 sets the duty immediately
+     */
+    virtual void fade(Channel channel, uint16_t duty, uint32_t durationMs) = 0;
+};
+
+#endif // I_LED_PWM_H
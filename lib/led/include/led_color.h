@@ -0,0 +1,165 @@
+#ifndef LED_COLOR_H
+#define LED_COLOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "dexcom_constants.h"
+
+/**
+ * @file led_color.h
+ * @brief Glucose value and trend to RGB LED PWM duties, all from compile-time tables.
+ *
+ * A color ramp over 40-400 mg/dL is interpolated from a few stops, and each channel then
+ * goes through a 10-bit lightness-to-duty LUT following the CIE 1931 lightness curve.
+ * The LUT is much finer than 8-bit gamma at the dark end, so a night-time LED can fade
+ * without visible steps. Both tables are built by constexpr functions and end up in
+ * flash. A lookup costs a few integer multiplies, with no floats and no pow().
+ */
+
+/**
+ * @brief 16-bit PWM duty per channel (0 = off, 65535 = fully on).
+ */
+struct LedDuty
+{
+    uint16_t r;
+    uint16_t g;
+    uint16_t b;
+
+    constexpr bool operator==(const LedDuty &other) const { return r == other.r && g == other.g && b == other.b; }
+    constexpr bool operator!=(const LedDuty &other) const { return !(*this == other); }
+};
+
+namespace LedColor
+{
+    struct Rgb8
+    {
+        uint8_t r;
+        uint8_t g;
+        uint8_t b;
+    };
+
+    struct RampStop
+    {
+        uint16_t mgdl;
+        Rgb8 color; // perceptual (lightness) units
+    };
+
+    constexpr uint16_t MIN_MGDL = 40;  // Dexcom reports "LOW" below this
+    constexpr uint16_t MAX_MGDL = 400; // and "HIGH" above this
+
+    /// Stops in ascending mg/dL, spanning MIN_MGDL..MAX_MGDL.
+    inline constexpr RampStop RAMP[] = {
+        {40, {255, 0, 0}},    // urgent low: red
+        {55, {255, 0, 0}},
+        {70, {255, 96, 0}},   // low: amber
+        {80, {0, 255, 48}},   // in range: green
+        {170, {0, 255, 48}},
+        {180, {200, 255, 0}}, // high: yellow
+        {250, {255, 120, 0}}, // orange
+        {300, {255, 0, 140}}, // very high: magenta
+        {400, {150, 0, 255}},
+    };
+
+    constexpr size_t RAMP_SIZE = MAX_MGDL - MIN_MGDL + 1;
+    constexpr uint16_t LIGHTNESS_STEPS = 1024;
+
+    constexpr uint8_t lerp(uint8_t a, uint8_t b, int pos, int span)
+    {
+        return static_cast<uint8_t>(a + ((b - a) * pos + (b >= a ? span / 2 : -span / 2)) / span);
+    }
+
+    constexpr std::array<Rgb8, RAMP_SIZE> buildRamp()
+    {
+        std::array<Rgb8, RAMP_SIZE> table{};
+        size_t stop = 0;
+        for (uint16_t mgdl = MIN_MGDL; mgdl <= MAX_MGDL; ++mgdl)
+        {
+            while (RAMP[stop + 1].mgdl < mgdl)
+            {
+                ++stop;
+            }
+            const RampStop &a = RAMP[stop];
+            const RampStop &b = RAMP[stop + 1];
+            const int span = b.mgdl - a.mgdl;
+            const int pos = mgdl - a.mgdl;
+            table[mgdl - MIN_MGDL] = {lerp(a.color.r, b.color.r, pos, span), lerp(a.color.g, b.color.g, pos, span),
+                                      lerp(a.color.b, b.color.b, pos, span)};
+        }
+        return table;
+    }
+
+    /// CIE 1931: relative luminance for lightness L* = 100 * step / (LIGHTNESS_STEPS - 1).
+    constexpr uint16_t lightnessToDuty(uint16_t step)
+    {
+        const double l = 100.0 * step / (LIGHTNESS_STEPS - 1);
+        const double f = (l + 16.0) / 116.0;
+        const double y = l <= 8.0 ? l / 903.3 : f * f * f;
+        return static_cast<uint16_t>(y * 65535.0 + 0.5);
+    }
+
+    constexpr std::array<uint16_t, LIGHTNESS_STEPS> buildLightnessLut()
+    {
+        std::array<uint16_t, LIGHTNESS_STEPS> table{};
+        for (uint16_t i = 0; i < LIGHTNESS_STEPS; ++i)
+        {
+            table[i] = lightnessToDuty(i);
+        }
+        return table;
+    }
+
+    inline constexpr std::array<Rgb8, RAMP_SIZE> RAMP_TABLE = buildRamp();
+    inline constexpr std::array<uint16_t, LIGHTNESS_STEPS> LIGHTNESS_LUT = buildLightnessLut();
+
+    /// mg/dL offset that shifts the color toward where the trend is heading (~10 minutes ahead).
+    constexpr int16_t trendShift(DexcomConst::TrendDirection trend)
+    {
+        switch (trend)
+        {
+        case DexcomConst::DoubleUp:
+            return 30;
+        case DexcomConst::SingleUp:
+            return 20;
+        case DexcomConst::FortyFiveUp:
+            return 10;
+        case DexcomConst::FortyFiveDown:
+            return -10;
+        case DexcomConst::SingleDown:
+            return -20;
+        case DexcomConst::DoubleDown:
+            return -30;
+        default:
+            return 0;
+        }
+    }
+
+    /// Ramp color for a value, clamped to MIN_MGDL..MAX_MGDL.
+    constexpr Rgb8 colorFor(int mgdl)
+    {
+        return RAMP_TABLE[(mgdl < MIN_MGDL ? MIN_MGDL : (mgdl > MAX_MGDL ? MAX_MGDL : mgdl)) - MIN_MGDL];
+    }
+
+    /// Duty for one channel of perceptual level @p level at @p brightness (both 0-255).
+    constexpr uint16_t channelDuty(uint8_t level, uint8_t brightness)
+    {
+        return LIGHTNESS_LUT[(level * brightness * (LIGHTNESS_STEPS - 1) + 32512) / 65025];
+    }
+
+    /**
+     * @brief PWM duties for a reading.
+     * @param mgdl Glucose value; 0 (no reading) turns the LED off
+     * @param brightness Overall perceptual brightness, 255 = full
+     */
+    constexpr LedDuty dutyFor(uint16_t mgdl, DexcomConst::TrendDirection trend, uint8_t brightness)
+    {
+        if (mgdl == 0)
+        {
+            return LedDuty{0, 0, 0};
+        }
+        const Rgb8 color = colorFor(mgdl + trendShift(trend));
+        return LedDuty{channelDuty(color.r, brightness), channelDuty(color.g, brightness),
+                       channelDuty(color.b, brightness)};
+    }
+}
+
+#endif // LED_COLOR_H
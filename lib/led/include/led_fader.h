@@ -0,0 +1,41 @@
+#ifndef LED_FADER_H
+#define LED_FADER_H
+
+#include <cstdint>
+#include <memory>
+#include "i_led_pwm.h"
+#include "led_color.h"
+
+/**
+ * @file led_fader.h
+ * @brief Cross-fades the RGB LED between colors using the PWM peripheral's own fades.
+ *
+ * All three channels are handed to the hardware in one go and fadeTo() returns how long
+ * the transition takes, so the caller can light-sleep for that long instead of stepping
+ * the duty from the CPU. Channels already at their target are left alone.
+ */
+class LedFader
+{
+public:
+    explicit LedFader(std::shared_ptr<ILedPwm> pwm);
+
+    /**
+     * @brief Fades to @p target over @p durationMs.
+     * @return Milliseconds until the fade is done, 0 if nothing changed
+     */
+    uint32_t fadeTo(const LedDuty &target, uint32_t durationMs);
+
+    /// Fades to the color for a reading; see LedColor::dutyFor().
+    uint32_t show(uint16_t mgdl, DexcomConst::TrendDirection trend, uint8_t brightness, uint32_t durationMs);
+
+    uint32_t off(uint32_t durationMs) { return fadeTo(LedDuty{0, 0, 0}, durationMs); }
+
+    const LedDuty &target() const { return _target; }
+    bool lit() const { return _target != LedDuty{0, 0, 0}; }
+
+private:
+    std::shared_ptr<ILedPwm> _pwm;
+    LedDuty _target;
+};
+
+#endif // LED_FADER_H
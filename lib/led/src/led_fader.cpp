@@ -0,0 +1,29 @@
+#include "led_fader.h"
+
+LedFader::LedFader(std::shared_ptr<ILedPwm> pwm) : _pwm(std::move(pwm)), _target{0, 0, 0}
+{
+}
+
+uint32_t LedFader::fadeTo(const LedDuty &target, uint32_t durationMs)
+{
+    if (target == _target)
+    {
+        return 0;
+    }
+    const uint16_t from[ILedPwm::CHANNELS] = {_target.r, _target.g, _target.b};
+    const uint16_t to[ILedPwm::CHANNELS] = {target.r, target.g, target.b};
+    for (uint8_t channel = 0; channel < ILedPwm::CHANNELS; ++channel)
+    {
+        if (from[channel] != to[channel])
+        {
+            _pwm->fade(static_cast<ILedPwm::Channel>(channel), to[channel], durationMs);
+        }
+    }
+    _target = target;
+    return durationMs;
+}
+
+uint32_t LedFader::show(uint16_t mgdl, DexcomConst::TrendDirection trend, uint8_t brightness, uint32_t durationMs)
+{
+    return fadeTo(LedColor::dutyFor(mgdl, trend, brightness), durationMs);
+}
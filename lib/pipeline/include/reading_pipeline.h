@@ -0,0 +1,107 @@
+#ifndef READING_PIPELINE_H
+#define READING_PIPELINE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "glucose_reading.h"
+#include "spsc_queue.h"
+
+#ifdef ARDUINO
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+/**
+ * @file reading_pipeline.h
+ * @brief Two-stage pipeline: network fetch on one core, rendering on the other.
+ *
+ * The producer (WiFi, TLS, Share API) runs on core 0 next to the WiFi stack and
+ * publishes each fetch as a ReadingBatch. The consumer runs on core 1 and is handed
+ * batches in order through an SpscQueue; batches are moved, so the readings vector
+ * allocated by the parser is the one the renderer reads. On the device the stages
+ * are pinned FreeRTOS tasks, natively they are std::threads, so the same code can
+ * be stress-tested and benchmarked on the desktop.
+ */
+
+struct ReadingBatch
+{
+    std::vector<GlucoseReading> readings; // newest first, as DexcomClient returns them
+    bool ok = false;                      // false when the fetch failed
+    uint32_t sequence = 0;                // set by publish(), counts from 1
+    uint64_t publishedAtUs = 0;           // ReadingPipeline::nowUs() at publish
+};
+
+class ReadingPipeline
+{
+public:
+    static constexpr size_t DEPTH = 4;
+    static constexpr int PRODUCER_CORE = 0; // shares the core with the WiFi/lwIP tasks
+    static constexpr int CONSUMER_CORE = 1;
+    static constexpr uint32_t PRODUCER_STACK = 12288; // TLS handshakes run here
+    static constexpr uint32_t CONSUMER_STACK = 6144;
+
+    /// Runs on the producer task until running() turns false; calls publish().
+    using Producer = std::function<void(ReadingPipeline &)>;
+    /// Handles one batch on the consumer task.
+    using Consumer = std::function<void(ReadingBatch &)>;
+
+    ReadingPipeline();
+    ~ReadingPipeline();
+
+    ReadingPipeline(const ReadingPipeline &) = delete;
+    ReadingPipeline &operator=(const ReadingPipeline &) = delete;
+
+    /// Starts both stages; false if already running or a task could not be created.
+    bool start(Producer producer, Consumer consumer);
+
+    /// Asks both stages to finish, lets the consumer drain the queue and waits for both.
+    void stop();
+
+    bool running() const { return _running.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Producer side: hands a batch to the consumer.
+     * @return false if the queue is full; the batch is then left with the caller
+     */
+    bool publish(ReadingBatch &&batch);
+
+    /// Batches refused because the consumer had fallen DEPTH behind.
+    uint32_t dropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+    /// Monotonic microseconds, the clock behind ReadingBatch::publishedAtUs.
+    static uint64_t nowUs();
+
+private:
+    void consumeLoop();
+    void notifyConsumer();
+    void waitForBatch();
+
+    SpscQueue<ReadingBatch, DEPTH> _queue;
+    Producer _producer;
+    Consumer _consumer;
+    std::atomic<bool> _running;
+    std::atomic<uint32_t> _dropped;
+    uint32_t _sequence;
+
+#ifdef ARDUINO
+    TaskHandle_t _consumerTask;
+    std::atomic<uint8_t> _activeTasks;
+    static void producerTask(void *self);
+    static void consumerTask(void *self);
+#else
+    std::thread _producerThread;
+    std::thread _consumerThread;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    bool _pending;
+#endif
+};
+
+#endif // READING_PIPELINE_H
@@ -0,0 +1,71 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @file spsc_queue.h
+ * @brief Bounded lock-free queue for exactly one producer and one consumer task.
+ *
+ * Items are moved in and moved out, never copied, so a queued std::vector hands its
+ * heap block from one task to the other. Head and tail are free-running counters;
+ * each is written by one side only and read by the other with acquire/release
+ * ordering, which is all the synchronization two cores need here.
+ */
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    SpscQueue() : _head(0), _tail(0), _slots() {}
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    /**
+     * @brief Producer side: moves @p item in.
+     * @return false if the queue is full; @p item is then left untouched
+     */
+    bool push(T &&item)
+    {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == Capacity)
+        {
+            return false;
+        }
+        _slots[tail & MASK] = std::move(item);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer side: moves the oldest item into @p out; false if empty.
+    bool pop(T &out)
+    {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        if (_tail.load(std::memory_order_acquire) == head)
+        {
+            return false;
+        }
+        out = std::move(_slots[head & MASK]);
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Approximate when called concurrently; exact from either side when the other is idle.
+    size_t size() const { return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire); }
+    bool empty() const { return size() == 0; }
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    // Separate lines so the two cores do not bounce one cache line between them
+    alignas(64) std::atomic<size_t> _head;
+    alignas(64) std::atomic<size_t> _tail;
+    alignas(64) T _slots[Capacity];
+};
+
+#endif // SPSC_QUEUE_H
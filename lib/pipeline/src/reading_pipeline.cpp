@@ -0,0 +1,194 @@
+#include "reading_pipeline.h"
+
+#ifdef ARDUINO
+#include <esp_timer.h>
+#else
+#include <chrono>
+#endif
+
+namespace
+{
+    // The consumer re-checks the queue this often even without a wake-up, as a backstop
+    constexpr uint32_t IDLE_POLL_MS = 1000;
+}
+
+ReadingPipeline::ReadingPipeline()
+    : _running(false), _dropped(0), _sequence(0)
+#ifdef ARDUINO
+      ,
+      _consumerTask(nullptr), _activeTasks(0)
+#else
+      ,
+      _pending(false)
+#endif
+{
+}
+
+ReadingPipeline::~ReadingPipeline()
+{
+    stop();
+}
+
+bool ReadingPipeline::publish(ReadingBatch &&batch)
+{
+    batch.sequence = _sequence + 1; // only counted once accepted
+    batch.publishedAtUs = nowUs();
+    if (!_queue.push(std::move(batch)))
+    {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    ++_sequence;
+    notifyConsumer();
+    return true;
+}
+
+void ReadingPipeline::consumeLoop()
+{
+    ReadingBatch batch;
+    // Keep going after stop() until everything published has been handled
+    while (running() || !_queue.empty())
+    {
+        if (_queue.pop(batch))
+        {
+            _consumer(batch);
+            continue;
+        }
+        waitForBatch();
+    }
+}
+
+#ifdef ARDUINO
+
+uint64_t ReadingPipeline::nowUs()
+{
+    return static_cast<uint64_t>(esp_timer_get_time());
+}
+
+void ReadingPipeline::producerTask(void *self)
+{
+    ReadingPipeline *pipeline = static_cast<ReadingPipeline *>(self);
+    pipeline->_producer(*pipeline);
+    pipeline->_activeTasks.fetch_sub(1);
+    vTaskDelete(nullptr);
+}
+
+void ReadingPipeline::consumerTask(void *self)
+{
+    ReadingPipeline *pipeline = static_cast<ReadingPipeline *>(self);
+    pipeline->consumeLoop();
+    pipeline->_activeTasks.fetch_sub(1);
+    vTaskDelete(nullptr);
+}
+
+bool ReadingPipeline::start(Producer producer, Consumer consumer)
+{
+    if (_running.exchange(true))
+    {
+        return false;
+    }
+    _producer = std::move(producer);
+    _consumer = std::move(consumer);
+    _activeTasks.store(2);
+    if (xTaskCreatePinnedToCore(consumerTask, "render", CONSUMER_STACK, this, 1, &_consumerTask, CONSUMER_CORE) != pdPASS)
+    {
+        _activeTasks.store(0);
+        _running.store(false);
+        return false;
+    }
+    if (xTaskCreatePinnedToCore(producerTask, "net", PRODUCER_STACK, this, 1, nullptr, PRODUCER_CORE) != pdPASS)
+    {
+        _activeTasks.fetch_sub(1);
+        stop();
+        return false;
+    }
+    return true;
+}
+
+void ReadingPipeline::stop()
+{
+    if (!_running.exchange(false))
+    {
+        return;
+    }
+    notifyConsumer();
+    while (_activeTasks.load() > 0)
+    {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    _consumerTask = nullptr;
+}
+
+void ReadingPipeline::notifyConsumer()
+{
+    if (_consumerTask != nullptr)
+    {
+        xTaskNotifyGive(_consumerTask);
+    }
+}
+
+void ReadingPipeline::waitForBatch()
+{
+    // Notifications count, so one given between the empty check and here is not lost
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(IDLE_POLL_MS));
+}
+
+#else
+
+uint64_t ReadingPipeline::nowUs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+bool ReadingPipeline::start(Producer producer, Consumer consumer)
+{
+    if (_running.exchange(true))
+    {
+        return false;
+    }
+    _producer = std::move(producer);
+    _consumer = std::move(consumer);
+    _consumerThread = std::thread([this]()
+                                  { consumeLoop(); });
+    _producerThread = std::thread([this]()
+                                  { _producer(*this); });
+    return true;
+}
+
+void ReadingPipeline::stop()
+{
+    if (!_running.exchange(false))
+    {
+        return;
+    }
+    if (_producerThread.joinable())
+    {
+        _producerThread.join();
+    }
+    notifyConsumer();
+    if (_consumerThread.joinable())
+    {
+        _consumerThread.join();
+    }
+}
+
+void ReadingPipeline::notifyConsumer()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending = true;
+    }
+    _wake.notify_one();
+}
+
+void ReadingPipeline::waitForBatch()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _wake.wait_for(lock, std::chrono::milliseconds(IDLE_POLL_MS), [this]()
+                   { return _pending; });
+    _pending = false;
+}
+
+#endif
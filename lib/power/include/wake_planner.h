@@ -0,0 +1,73 @@
+#ifndef WAKE_PLANNER_H
+#define WAKE_PLANNER_H
+
+#include <cstdint>
+#include <ctime>
+
+/**
+ * @file wake_planner.h
+ * @brief Predicts when the next CGM reading will be available and how long to sleep.
+ *
+ * The sensor produces a reading every 5 minutes at a fixed phase. The planner learns
+ * that phase from the `WT` timestamps the Share API returns, then schedules each wake
+ * a small margin after the next expected reading. When a wake finds no new reading the
+ * planner retries after short delays and widens the margin; on-time readings shrink it
+ * back. All state lives in a POD struct so it can be kept in RTC memory across deep sleep.
+ */
+
+struct WakePlannerState
+{
+    int32_t phaseQ8;     // learned reading phase within the interval, 1/256 s units
+    time_t lastReading;  // newest reading timestamp seen, 0 if none
+    uint16_t marginS;    // delay after the expected reading time before waking
+    uint8_t retries;     // consecutive wakes that found no new reading
+    uint8_t phaseKnown;  // non-zero once at least one reading has been observed
+};
+
+class WakePlanner
+{
+public:
+    static constexpr uint32_t INTERVAL_S = 300;
+    static constexpr uint16_t INITIAL_MARGIN_S = 20;
+    static constexpr uint16_t MIN_MARGIN_S = 8;
+    static constexpr uint16_t MAX_MARGIN_S = 90;
+    static constexpr uint16_t MARGIN_STEP_S = 5;
+    /// A reading further than this from the learned phase re-seeds it (new sensor session).
+    static constexpr uint32_t PHASE_RESET_S = 30;
+    static constexpr uint8_t MAX_RETRIES = 4;
+    static constexpr uint16_t RETRY_DELAYS_S[MAX_RETRIES] = {15, 30, 60, 120};
+
+    /**
+     * @brief Binds the planner to externally owned state (e.g. an RTC_DATA_ATTR variable).
+     * @param state State to use; reset() is not called, so warm state is kept
+     */
+    explicit WakePlanner(WakePlannerState &state) : _state(state) {}
+
+    /// Forgets the learned phase and retry history.
+    void reset();
+
+    /// Folds one reading timestamp into the phase estimate.
+    void observeReading(time_t timestamp);
+
+    /**
+     * @brief Decides how long to sleep after a wake.
+     *
+     * @param now Current wall-clock time
+     * @param latestReading Timestamp of the newest reading fetched this wake, 0 if none
+     * @return Seconds to sleep before the next fetch
+     */
+    uint32_t onWake(time_t now, time_t latestReading);
+
+    /// Next time at or after @p now when a fresh reading should be fetchable.
+    time_t nextExpectedAfter(time_t now) const;
+
+    /// Learned phase in whole seconds within the interval.
+    uint32_t phaseSeconds() const { return static_cast<uint32_t>(_state.phaseQ8 >> 8); }
+
+    const WakePlannerState &state() const { return _state; }
+
+private:
+    WakePlannerState &_state;
+};
+
+#endif // WAKE_PLANNER_H
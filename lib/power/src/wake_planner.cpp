@@ -0,0 +1,96 @@
+#include "wake_planner.h"
+
+namespace
+{
+    constexpr int32_t INTERVAL_Q8 = static_cast<int32_t>(WakePlanner::INTERVAL_S) << 8;
+
+    int32_t wrapPhase(int32_t q8)
+    {
+        q8 %= INTERVAL_Q8;
+        return q8 < 0 ? q8 + INTERVAL_Q8 : q8;
+    }
+
+    time_t later(time_t a, time_t b)
+    {
+        return a > b ? a : b;
+    }
+}
+
+void WakePlanner::reset()
+{
+    _state.phaseQ8 = 0;
+    _state.lastReading = 0;
+    _state.marginS = INITIAL_MARGIN_S;
+    _state.retries = 0;
+    _state.phaseKnown = 0;
+}
+
+void WakePlanner::observeReading(time_t timestamp)
+{
+    const int32_t offsetQ8 = static_cast<int32_t>(timestamp % INTERVAL_S) << 8;
+    if (!_state.phaseKnown)
+    {
+        _state.phaseQ8 = offsetQ8;
+        _state.phaseKnown = 1;
+        return;
+    }
+
+    // Shortest signed distance around the interval, in [-INTERVAL/2, INTERVAL/2)
+    int32_t diff = wrapPhase(offsetQ8 - _state.phaseQ8 + INTERVAL_Q8 / 2) - INTERVAL_Q8 / 2;
+    if (diff > static_cast<int32_t>(PHASE_RESET_S << 8) || diff < -static_cast<int32_t>(PHASE_RESET_S << 8))
+    {
+        _state.phaseQ8 = offsetQ8; // New sensor session or clock step: start over
+    }
+    else
+    {
+        _state.phaseQ8 = wrapPhase(_state.phaseQ8 + diff / 4);
+    }
+}
+
+time_t WakePlanner::nextExpectedAfter(time_t now) const
+{
+    if (!_state.phaseKnown)
+    {
+        return now + INTERVAL_S;
+    }
+    // Start one slot back: phase + margin can pass the end of the interval, so the reading
+    // due in the previous slot may still be fetchable after now
+    const time_t slotStart = now - (now % INTERVAL_S);
+    time_t candidate = slotStart - INTERVAL_S + (_state.phaseQ8 >> 8) + _state.marginS;
+    while (candidate < now)
+    {
+        candidate += INTERVAL_S;
+    }
+    return candidate;
+}
+
+uint32_t WakePlanner::onWake(time_t now, time_t latestReading)
+{
+    if (latestReading > _state.lastReading)
+    {
+        observeReading(latestReading);
+        if (_state.retries > 0)
+        {
+            _state.marginS = _state.marginS + MARGIN_STEP_S > MAX_MARGIN_S ? MAX_MARGIN_S : _state.marginS + MARGIN_STEP_S;
+        }
+        else if (_state.marginS > MIN_MARGIN_S)
+        {
+            --_state.marginS;
+        }
+        _state.retries = 0;
+        _state.lastReading = latestReading;
+
+        // Never target the slot of the reading we just got
+        time_t target = nextExpectedAfter(later(now, latestReading + INTERVAL_S / 2));
+        return target > now ? static_cast<uint32_t>(target - now) : 1;
+    }
+
+    // Reading is late (or missing): retry soon a few times before waiting a whole cycle
+    if (_state.retries < MAX_RETRIES)
+    {
+        return RETRY_DELAYS_S[_state.retries++];
+    }
+    _state.retries = 0;
+    time_t target = nextExpectedAfter(now + INTERVAL_S / 2);
+    return static_cast<uint32_t>(target - now);
+}
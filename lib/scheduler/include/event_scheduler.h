@@ -0,0 +1,113 @@
+#ifndef EVENT_SCHEDULER_H
+#define EVENT_SCHEDULER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include "i_clock.h"
+
+/**
+ * @file event_scheduler.h
+ * @brief Platform-neutral event/prerequisite scheduler for the main loop.
+ *
+ * Events are bits in a mask. A task names the events it requires and runs as soon
+ * as all of them are set, so independent work (e.g. DNS once WiFi is up) does not
+ * wait behind unrelated steps (e.g. NTP). A task may consume some of its events,
+ * which clears them when it runs; that is how edge-like events such as "reading
+ * due" are modelled. Timed events are posted with postAfter().
+ *
+ * post() and clear() may be called from other tasks or callbacks; everything else
+ * belongs to the thread that calls runOnce().
+ */
+
+using EventMask = uint32_t;
+
+class EventScheduler
+{
+public:
+    static constexpr size_t MAX_TASKS = 12;
+    static constexpr size_t MAX_TIMERS = 8;
+    static constexpr uint32_t NO_DEADLINE = UINT32_MAX;
+
+    using TaskFn = std::function<void()>;
+    using WakeHook = void (*)();
+
+    explicit EventScheduler(std::shared_ptr<IClock> clock);
+
+    /**
+     * @brief Registers a task.
+     *
+     * @param name Static string used for diagnostics
+     * @param prerequisites Events that must all be set for the task to run
+     * @param fn Work to run
+     * @param consumes Subset of @p prerequisites cleared just before @p fn runs
+     * @param oneShot Retire the task after its first run
+     * @return false if the task table is full
+     */
+    bool addTask(const char *name, EventMask prerequisites, TaskFn fn, EventMask consumes = 0, bool oneShot = false);
+
+    /// Sets events. Safe from other tasks and callbacks.
+    void post(EventMask events);
+
+    /// Clears events. Safe from other tasks and callbacks.
+    void clear(EventMask events);
+
+    EventMask events() const { return _events.load(std::memory_order_acquire); }
+    bool isSet(EventMask events) const { return (this->events() & events) == events; }
+
+    /**
+     * @brief Posts @p events once @p delayMs has elapsed.
+     *
+     * A pending timer for the same events is replaced rather than duplicated.
+     * @return false if the timer table is full
+     */
+    bool postAfter(EventMask events, uint32_t delayMs);
+
+    /// Drops pending timers for @p events.
+    void cancelTimer(EventMask events);
+
+    /**
+     * @brief Fires due timers and runs every ready task until nothing more is ready.
+     * @return Milliseconds until the next timer is due, or NO_DEADLINE if none is pending
+     */
+    uint32_t runOnce();
+
+    /// Called after post() so a sleeping loop can wake up early (e.g. a task notification).
+    void setWakeHook(WakeHook hook) { _wakeHook = hook; }
+
+    /// Name of the task that ran most recently, nullptr if none has run yet.
+    const char *lastTaskName() const { return _lastTask; }
+
+private:
+    struct Task
+    {
+        const char *name;
+        EventMask prerequisites;
+        EventMask consumes;
+        bool oneShot;
+        bool active;
+        TaskFn fn;
+    };
+
+    struct Timer
+    {
+        EventMask events;
+        uint32_t dueMs;
+        bool armed;
+    };
+
+    std::shared_ptr<IClock> _clock;
+    std::atomic<EventMask> _events;
+    Task _tasks[MAX_TASKS];
+    size_t _taskCount;
+    Timer _timers[MAX_TIMERS];
+    WakeHook _wakeHook;
+    const char *_lastTask;
+
+    void fireDueTimers(uint32_t now);
+    uint32_t msUntilNextTimer(uint32_t now) const;
+};
+
+#endif // EVENT_SCHEDULER_H
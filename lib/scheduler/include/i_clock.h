@@ -0,0 +1,18 @@
+#ifndef I_CLOCK_H
+#define I_CLOCK_H
+
+#include <cstdint>
+
+/**
+ * @brief Monotonic millisecond clock, so timing logic can run against a simulated clock.
+ */
+class IClock
+{
+public:
+    virtual ~IClock() = default;
+
+    /// Milliseconds since boot; wraps after ~49 days like Arduino millis().
+    virtual uint32_t millis() const = 0;
+};
+
+#endif // I_CLOCK_H
@@ -0,0 +1,144 @@
+#include "event_scheduler.h"
+
+namespace
+{
+    // Wrap-safe "a is at or after b" for millisecond timestamps
+    bool reached(uint32_t now, uint32_t due)
+    {
+        return static_cast<int32_t>(now - due) >= 0;
+    }
+}
+
+EventScheduler::EventScheduler(std::shared_ptr<IClock> clock)
+    : _clock(std::move(clock)), _events(0), _tasks(), _taskCount(0), _timers(), _wakeHook(nullptr), _lastTask(nullptr)
+{
+}
+
+bool EventScheduler::addTask(const char *name, EventMask prerequisites, TaskFn fn, EventMask consumes, bool oneShot)
+{
+    if (_taskCount >= MAX_TASKS)
+    {
+        return false;
+    }
+    _tasks[_taskCount++] = Task{name, prerequisites, consumes & prerequisites, oneShot, true, std::move(fn)};
+    return true;
+}
+
+void EventScheduler::post(EventMask events)
+{
+    _events.fetch_or(events, std::memory_order_acq_rel);
+    if (_wakeHook)
+    {
+        _wakeHook();
+    }
+}
+
+void EventScheduler::clear(EventMask events)
+{
+    _events.fetch_and(~events, std::memory_order_acq_rel);
+}
+
+bool EventScheduler::postAfter(EventMask events, uint32_t delayMs)
+{
+    const uint32_t due = _clock->millis() + delayMs;
+    Timer *freeSlot = nullptr;
+    for (auto &timer : _timers)
+    {
+        if (timer.armed && timer.events == events)
+        {
+            timer.dueMs = due;
+            return true;
+        }
+        if (!timer.armed && freeSlot == nullptr)
+        {
+            freeSlot = &timer;
+        }
+    }
+    if (freeSlot == nullptr)
+    {
+        return false;
+    }
+    *freeSlot = Timer{events, due, true};
+    return true;
+}
+
+void EventScheduler::cancelTimer(EventMask events)
+{
+    for (auto &timer : _timers)
+    {
+        if (timer.armed && timer.events == events)
+        {
+            timer.armed = false;
+        }
+    }
+}
+
+void EventScheduler::fireDueTimers(uint32_t now)
+{
+    for (auto &timer : _timers)
+    {
+        if (timer.armed && reached(now, timer.dueMs))
+        {
+            timer.armed = false;
+            post(timer.events);
+        }
+    }
+}
+
+uint32_t EventScheduler::msUntilNextTimer(uint32_t now) const
+{
+    uint32_t next = NO_DEADLINE;
+    for (const auto &timer : _timers)
+    {
+        if (!timer.armed)
+        {
+            continue;
+        }
+        uint32_t wait = reached(now, timer.dueMs) ? 0 : timer.dueMs - now;
+        if (wait < next)
+        {
+            next = wait;
+        }
+    }
+    return next;
+}
+
+uint32_t EventScheduler::runOnce()
+{
+    fireDueTimers(_clock->millis());
+
+    // Keep sweeping while tasks unlock each other; every pass either runs a task
+    // (consuming or retiring something) or ends the loop
+    bool ran = true;
+    for (size_t pass = 0; ran && pass <= MAX_TASKS * 2; ++pass)
+    {
+        ran = false;
+        for (size_t i = 0; i < _taskCount; ++i)
+        {
+            Task &task = _tasks[i];
+            if (!task.active || !isSet(task.prerequisites))
+            {
+                continue;
+            }
+            if (task.consumes == 0 && !task.oneShot)
+            {
+                // Level-triggered with nothing to consume would spin; run once per call
+                if (pass > 0)
+                {
+                    continue;
+                }
+            }
+            clear(task.consumes);
+            if (task.oneShot)
+            {
+                task.active = false;
+            }
+            _lastTask = task.name;
+            task.fn();
+            ran = true;
+        }
+        fireDueTimers(_clock->millis());
+    }
+
+    return msUntilNextTimer(_clock->millis());
+}
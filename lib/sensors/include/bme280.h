@@ -0,0 +1,127 @@
+#ifndef BME280_H
+#define BME280_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "i_i2c_bus.h"
+
+/**
+ * @file bme280.h
+ * @brief BME280 temperature/pressure/humidity driver using forced mode.
+ *
+ * The sensor sleeps until startMeasurement() triggers a single conversion, so it
+ * draws ~0.1 uA between samples. Results come back in one 8-byte burst and are
+ * compensated with Bosch's integer formulas (no float). The factory calibration
+ * lives in a POD block the caller can keep in RTC memory, so a wake only reads the
+ * chip ID, starts a conversion and reads the status and data. Multi-register reads
+ * go out as an I2cBatch, so an I2cBusManager with bursts enabled for the address
+ * runs each under one lock and merges the status and data reads.
+ */
+
+/**
+ * @brief Factory trimming parameters (registers 0x88..0xA1 and 0xE1..0xE7).
+ *
+ * Valid once loaded; keep it in RTC_DATA_ATTR memory and clear() it on a cold boot.
+ */
+struct Bme280Calibration
+{
+    static constexpr uint16_t MAGIC = 0xB280;
+
+    uint16_t magic; // MAGIC once the coefficients below have been read
+    uint16_t T1;
+    int16_t T2, T3;
+    uint16_t P1;
+    int16_t P2, P3, P4, P5, P6, P7, P8, P9;
+    uint8_t H1;
+    int16_t H2;
+    uint8_t H3;
+    int16_t H4, H5;
+    int8_t H6;
+
+    bool valid() const { return magic == MAGIC; }
+    void clear() { *this = Bme280Calibration(); }
+};
+
+/**
+ * @brief One compensated sample, in Bosch's fixed-point units.
+ */
+struct Bme280Reading
+{
+    int32_t temperature; // 0.01 degC
+    uint32_t pressure;   // Pa, Q24.8 (divide by 256)
+    uint32_t humidity;   // %RH, Q22.10 (divide by 1024)
+};
+
+class Bme280
+{
+public:
+    static constexpr uint8_t ADDRESS = 0x76; // SDO low; 0x77 with SDO high
+    static constexpr uint8_t CHIP_ID = 0x60;
+
+    static constexpr uint8_t REG_CALIB_TP = 0x88; // T1..P9, 24 bytes, then 0xA1 = H1
+    static constexpr size_t CALIB_TP_LENGTH = 26;
+    static constexpr uint8_t REG_ID = 0xD0;
+    static constexpr uint8_t REG_CALIB_H = 0xE1; // H2..H6, 7 bytes
+    static constexpr size_t CALIB_H_LENGTH = 7;
+    static constexpr uint8_t REG_CTRL_HUM = 0xF2;
+    static constexpr uint8_t REG_STATUS = 0xF3;
+    static constexpr uint8_t REG_CTRL_MEAS = 0xF4;
+    static constexpr uint8_t REG_CONFIG = 0xF5;
+    static constexpr uint8_t REG_DATA = 0xF7; // press_msb .. hum_lsb
+    static constexpr size_t DATA_LENGTH = 8;
+
+    static constexpr uint8_t STATUS_MEASURING = 0x08;
+    static constexpr uint8_t MODE_FORCED = 0x01;
+    // 1x oversampling everywhere, filter off: the "weather monitoring" setting from the datasheet
+    static constexpr uint8_t OSRS_X1 = 0x01;
+    static constexpr uint8_t CTRL_MEAS_FORCED = (OSRS_X1 << 5) | (OSRS_X1 << 2) | MODE_FORCED;
+
+    /// Worst-case conversion time for the setting above (datasheet 9.1: 1.25 + 3 * 2.3 + 2 * 0.575 ms).
+    static constexpr uint32_t MEASUREMENT_TIME_US = 9300;
+
+    Bme280(std::shared_ptr<II2cBus> bus, Bme280Calibration &calibration, uint8_t address = ADDRESS);
+
+    /**
+     * @brief Checks the chip ID and loads the calibration unless it is already cached.
+     *
+     * Also writes the humidity oversampling and filter settings, which the sensor keeps
+     * for as long as it is powered, so that is skipped too when the cache was valid.
+     * @return false if the sensor does not answer or is not a BME280
+     */
+    bool begin();
+
+    /// Triggers one forced-mode conversion; results are ready after MEASUREMENT_TIME_US.
+    bool startMeasurement();
+
+    /// True while a conversion is running (or if the status cannot be read).
+    bool measuring();
+
+    /**
+     * @brief Reads the status and the last conversion as one batch and compensates it.
+     * @return false if the bus fails, a conversion is still running or none has run yet
+     */
+    bool read(Bme280Reading &reading);
+
+    /**
+     * @name Bosch integer compensation (BME280 datasheet section 4.2.3)
+     * @{
+     */
+    /// @param tFine Set to the fine temperature that the other two formulas need
+    static int32_t compensateTemperature(int32_t adcT, const Bme280Calibration &cal, int32_t &tFine);
+    static uint32_t compensatePressure(int32_t adcP, const Bme280Calibration &cal, int32_t tFine);
+    static uint32_t compensateHumidity(int32_t adcH, const Bme280Calibration &cal, int32_t tFine);
+    /// @}
+
+    /// Parses the two raw calibration blocks as read from REG_CALIB_TP and REG_CALIB_H.
+    static void parseCalibration(const uint8_t *tp, const uint8_t *h, Bme280Calibration &cal);
+
+private:
+    bool readRegisters(uint8_t reg, uint8_t *data, size_t length);
+
+    std::shared_ptr<II2cBus> _bus;
+    Bme280Calibration &_calibration;
+    uint8_t _address;
+};
+
+#endif // BME280_H
@@ -0,0 +1,124 @@
+#ifndef VCNL4040_H
+#define VCNL4040_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "i_i2c_bus.h"
+
+/**
+ * @file vcnl4040.h
+ * @brief VCNL4040 proximity driver that reports approach/leave through its INT pin.
+ *
+ * The sensor measures on its own at the lowest duty cycle and compares against a
+ * near/far threshold pair in hardware, so the ESP32 can stay in deep sleep with the
+ * (active-low) INT pin armed as an ext0/ext1 wake source. Only the edge that matters
+ * in the current state is enabled: approach while far, leave while near. Registers
+ * are shadowed so only values that actually change are written, and a configuration
+ * goes out as one batch of writes.
+ */
+class Vcnl4040
+{
+public:
+    static constexpr uint8_t ADDRESS = 0x60;
+    static constexpr uint16_t DEVICE_ID = 0x0186;
+
+    // Command codes; every register is 16 bits, low byte first
+    static constexpr uint8_t REG_PS_CONF1_2 = 0x03;
+    static constexpr uint8_t REG_PS_CONF3_MS = 0x04;
+    static constexpr uint8_t REG_PS_THDL = 0x06;
+    static constexpr uint8_t REG_PS_THDH = 0x07;
+    static constexpr uint8_t REG_PS_DATA = 0x08;
+    static constexpr uint8_t REG_INT_FLAG = 0x0B;
+    static constexpr uint8_t REG_ID = 0x0C;
+
+    // PS_CONF1 (low byte of 0x03)
+    static constexpr uint16_t PS_DUTY_1_320 = 0x00C0; // lowest-power measurement rate
+    static constexpr uint16_t PS_PERS_2 = 0x0010;     // two consecutive hits before an interrupt
+    static constexpr uint16_t PS_IT_MASK = 0x000E;    // integration time, bits 3:1
+    static constexpr uint16_t PS_IT_2T = 0x0002 << 1;
+    static constexpr uint16_t PS_SD = 0x0001;         // shutdown
+    // PS_CONF2 (high byte of 0x03)
+    static constexpr uint16_t PS_INT_MASK = 0x0300;
+    static constexpr uint16_t PS_INT_CLOSE = 0x0100;
+    static constexpr uint16_t PS_INT_AWAY = 0x0200;
+    // PS_CONF3 / PS_MS (0x04)
+    static constexpr uint16_t PS_SMART_PERS = 0x0010;
+    static constexpr uint16_t LED_I_100MA = 0x0002 << 8;
+    // INT_FLAG (high byte of 0x0B); reading the register clears it
+    static constexpr uint16_t FLAG_PS_AWAY = 0x0100;
+    static constexpr uint16_t FLAG_PS_CLOSE = 0x0200;
+
+    static constexpr uint16_t DEFAULT_NEAR_COUNTS = 120;
+    static constexpr uint16_t DEFAULT_FAR_COUNTS = 80;
+
+    enum class Proximity : uint8_t
+    {
+        Far,
+        Near
+    };
+
+    enum class Event : uint8_t
+    {
+        None,
+        Approach,
+        Leave
+    };
+
+    explicit Vcnl4040(std::shared_ptr<II2cBus> bus, uint16_t nearCounts = DEFAULT_NEAR_COUNTS,
+                      uint16_t farCounts = DEFAULT_FAR_COUNTS);
+
+    /**
+     * @brief Checks the ID and programs the sensor for approach detection.
+     *
+     * Only needed after power-up; the sensor keeps its settings while the ESP32 sleeps.
+     * @return false if the sensor does not answer or is not a VCNL4040
+     */
+    bool begin();
+
+    /**
+     * @brief Adopts a sensor configured by an earlier boot without touching the bus.
+     * @param state What the previous boot last saw (e.g. kept in RTC memory)
+     */
+    void resume(Proximity state);
+
+    /**
+     * @brief Reads (and so clears) the interrupt flags and follows the transition.
+     *
+     * Call after an INT wake or edge. Switches the enabled interrupt to the opposite edge.
+     */
+    Event handleInterrupt();
+
+    /// Sets the hysteresis pair; @p farCounts must be below @p nearCounts.
+    bool setThresholds(uint16_t nearCounts, uint16_t farCounts);
+
+    /// Single proximity sample in raw counts.
+    bool readProximity(uint16_t &counts);
+
+    /// Stops measuring (a few uA); begin() resumes.
+    bool shutdown();
+
+    Proximity state() const { return _state; }
+
+private:
+    bool readRegister(uint8_t reg, uint16_t &value);
+    /// Queues a write into @p batch unless the shadow shows the value is already set.
+    void stage(I2cWrite *batch, size_t &count, uint8_t reg, uint16_t value) const;
+    /// Sends the batch and, once it succeeded, records the values in the shadow.
+    bool commit(const I2cWrite *batch, size_t count);
+    uint16_t psConf12() const;
+    int shadowIndex(uint8_t reg) const;
+
+    std::shared_ptr<II2cBus> _bus;
+    uint16_t _nearCounts;
+    uint16_t _farCounts;
+    Proximity _state;
+    bool _shutdown;
+
+    // Last written values of PS_CONF1_2, PS_CONF3_MS, PS_THDL, PS_THDH
+    static constexpr size_t SHADOWED = 4;
+    uint16_t _shadow[SHADOWED];
+    uint8_t _shadowValid; // bit per register: shadow matches the device
+};
+
+#endif // VCNL4040_H
@@ -0,0 +1,186 @@
+#include "bme280.h"
+
+#define LOG_TAG "bme280"
+#define LOG_MODULE_LEVEL LOG_LEVEL_SENSORS
+#include <debug_print.h>
+
+namespace
+{
+    uint16_t u16le(const uint8_t *p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+    int16_t s16le(const uint8_t *p) { return static_cast<int16_t>(u16le(p)); }
+
+    // An ADC channel that was skipped (or never converted) reads back as 0x80000
+    constexpr int32_t ADC_SKIPPED = 0x80000;
+}
+
+Bme280::Bme280(std::shared_ptr<II2cBus> bus, Bme280Calibration &calibration, uint8_t address)
+    : _bus(std::move(bus)), _calibration(calibration), _address(address)
+{
+}
+
+bool Bme280::begin()
+{
+    // On a cold boot the calibration comes in the same locked batch as the ID check
+    uint8_t id = 0;
+    uint8_t tp[CALIB_TP_LENGTH];
+    uint8_t h[CALIB_H_LENGTH];
+    const bool cached = _calibration.valid();
+    I2cBatch batch;
+    batch.read(_address, REG_ID, &id, 1);
+    if (!cached)
+    {
+        batch.read(_address, REG_CALIB_TP, tp, sizeof(tp));
+        batch.read(_address, REG_CALIB_H, h, sizeof(h));
+    }
+    const bool ok = _bus->execute(batch);
+    if (!batch.ok(0) || id != CHIP_ID)
+    {
+        LOG_ERROR("not found (id 0x%02x)", id);
+        return false;
+    }
+    if (cached)
+    {
+        return true;
+    }
+    if (!ok)
+    {
+        LOG_ERROR("calibration read failed");
+        return false;
+    }
+    parseCalibration(tp, h, _calibration);
+    LOG_DEBUG("calibration loaded");
+
+    // ctrl_hum only takes effect with the next ctrl_meas write, which startMeasurement() does
+    const I2cWrite settings[] = {
+        {{REG_CTRL_HUM, OSRS_X1}, 2},
+        {{REG_CONFIG, 0x00}, 2}, // filter off, no standby (unused in forced mode)
+    };
+    if (!_bus->writeBatch(_address, settings, sizeof(settings) / sizeof(settings[0])))
+    {
+        _calibration.clear();
+        return false;
+    }
+    return true;
+}
+
+bool Bme280::startMeasurement()
+{
+    const uint8_t command[] = {REG_CTRL_MEAS, CTRL_MEAS_FORCED};
+    return _bus->write(_address, command, sizeof(command));
+}
+
+bool Bme280::measuring()
+{
+    uint8_t status = STATUS_MEASURING;
+    readRegisters(REG_STATUS, &status, 1);
+    return (status & STATUS_MEASURING) != 0;
+}
+
+bool Bme280::read(Bme280Reading &reading)
+{
+    if (!_calibration.valid())
+    {
+        return false;
+    }
+    // Status and results are 3 bytes apart, so a burst-capable bus reads both at once
+    uint8_t status = STATUS_MEASURING;
+    uint8_t data[DATA_LENGTH];
+    I2cBatch batch;
+    batch.read(_address, REG_STATUS, &status, 1);
+    batch.read(_address, REG_DATA, data, sizeof(data));
+    if (!_bus->execute(batch))
+    {
+        return false;
+    }
+    if (status & STATUS_MEASURING)
+    {
+        LOG_DEBUG("conversion still running");
+        return false;
+    }
+    const int32_t adcP = (data[0] << 12) | (data[1] << 4) | (data[2] >> 4);
+    const int32_t adcT = (data[3] << 12) | (data[4] << 4) | (data[5] >> 4);
+    const int32_t adcH = (data[6] << 8) | data[7];
+    if (adcT == ADC_SKIPPED)
+    {
+        LOG_WARN("no conversion result");
+        return false;
+    }
+
+    int32_t tFine = 0;
+    reading.temperature = compensateTemperature(adcT, _calibration, tFine);
+    reading.pressure = compensatePressure(adcP, _calibration, tFine);
+    reading.humidity = compensateHumidity(adcH, _calibration, tFine);
+    return true;
+}
+
+bool Bme280::readRegisters(uint8_t reg, uint8_t *data, size_t length)
+{
+    return _bus->writeRead(_address, &reg, 1, data, length);
+}
+
+void Bme280::parseCalibration(const uint8_t *tp, const uint8_t *h, Bme280Calibration &cal)
+{
+    cal.T1 = u16le(tp + 0);
+    cal.T2 = s16le(tp + 2);
+    cal.T3 = s16le(tp + 4);
+    cal.P1 = u16le(tp + 6);
+    cal.P2 = s16le(tp + 8);
+    cal.P3 = s16le(tp + 10);
+    cal.P4 = s16le(tp + 12);
+    cal.P5 = s16le(tp + 14);
+    cal.P6 = s16le(tp + 16);
+    cal.P7 = s16le(tp + 18);
+    cal.P8 = s16le(tp + 20);
+    cal.P9 = s16le(tp + 22);
+    cal.H1 = tp[25]; // 0xA1; 0xA0 is unused
+    cal.H2 = s16le(h + 0);
+    cal.H3 = h[2];
+    // H4 and H5 are signed 12-bit values sharing the nibbles of 0xE5
+    cal.H4 = static_cast<int16_t>(static_cast<int8_t>(h[3]) * 16 | (h[4] & 0x0F));
+    cal.H5 = static_cast<int16_t>(static_cast<int8_t>(h[5]) * 16 | (h[4] >> 4));
+    cal.H6 = static_cast<int8_t>(h[6]);
+    cal.magic = Bme280Calibration::MAGIC;
+}
+
+// The formulas below follow the datasheet line by line. Left shifts of values that may
+// be negative are written as multiplications to keep them well defined.
+
+int32_t Bme280::compensateTemperature(int32_t adcT, const Bme280Calibration &cal, int32_t &tFine)
+{
+    const int32_t var1 = (((adcT >> 3) - (static_cast<int32_t>(cal.T1) << 1)) * cal.T2) >> 11;
+    const int32_t delta = (adcT >> 4) - static_cast<int32_t>(cal.T1);
+    const int32_t var2 = (((delta * delta) >> 12) * cal.T3) >> 14;
+    tFine = var1 + var2;
+    return (tFine * 5 + 128) >> 8;
+}
+
+uint32_t Bme280::compensatePressure(int32_t adcP, const Bme280Calibration &cal, int32_t tFine)
+{
+    int64_t var1 = static_cast<int64_t>(tFine) - 128000;
+    int64_t var2 = var1 * var1 * cal.P6;
+    var2 += var1 * cal.P5 * (int64_t(1) << 17);
+    var2 += static_cast<int64_t>(cal.P4) * (int64_t(1) << 35);
+    var1 = ((var1 * var1 * cal.P3) >> 8) + var1 * cal.P2 * (int64_t(1) << 12);
+    var1 = (((int64_t(1) << 47) + var1) * cal.P1) >> 33;
+    if (var1 == 0)
+    {
+        return 0; // avoid dividing by zero on a blank calibration
+    }
+    int64_t p = 1048576 - adcP;
+    p = ((p * (int64_t(1) << 31) - var2) * 3125) / var1;
+    var1 = (static_cast<int64_t>(cal.P9) * (p >> 13) * (p >> 13)) >> 25;
+    var2 = (static_cast<int64_t>(cal.P8) * p) >> 19;
+    p = ((p + var1 + var2) >> 8) + static_cast<int64_t>(cal.P7) * 16;
+    return static_cast<uint32_t>(p);
+}
+
+uint32_t Bme280::compensateHumidity(int32_t adcH, const Bme280Calibration &cal, int32_t tFine)
+{
+    int32_t x = tFine - 76800;
+    x = (((adcH * 16384) - (static_cast<int32_t>(cal.H4) * 1048576) - (cal.H5 * x) + 16384) >> 15) *
+        (((((((x * cal.H6) >> 10) * (((x * cal.H3) >> 11) + 32768)) >> 10) + 2097152) * cal.H2 + 8192) >> 14);
+    x -= ((((x >> 15) * (x >> 15)) >> 7) * cal.H1) >> 4;
+    x = x < 0 ? 0 : x;
+    x = x > 419430400 ? 419430400 : x;
+    return static_cast<uint32_t>(x >> 12);
+}
@@ -0,0 +1,188 @@
+#include "vcnl4040.h"
+
+#define LOG_TAG "vcnl"
+#define LOG_MODULE_LEVEL LOG_LEVEL_SENSORS
+#include <debug_print.h>
+
+namespace
+{
+    constexpr uint8_t SHADOWED_REGS[] = {Vcnl4040::REG_PS_CONF1_2, Vcnl4040::REG_PS_CONF3_MS, Vcnl4040::REG_PS_THDL,
+                                         Vcnl4040::REG_PS_THDH};
+}
+
+Vcnl4040::Vcnl4040(std::shared_ptr<II2cBus> bus, uint16_t nearCounts, uint16_t farCounts)
+    : _bus(std::move(bus)), _nearCounts(nearCounts), _farCounts(farCounts < nearCounts ? farCounts : nearCounts),
+      _state(Proximity::Far), _shutdown(true), _shadow(), _shadowValid(0)
+{
+}
+
+bool Vcnl4040::begin()
+{
+    uint16_t id = 0;
+    if (!readRegister(REG_ID, id) || id != DEVICE_ID)
+    {
+        LOG_ERROR("not found (id 0x%04x)", id);
+        return false;
+    }
+    _state = Proximity::Far;
+    _shutdown = false;
+    _shadowValid = 0; // after power-up nothing on the device is known
+
+    I2cWrite batch[SHADOWED];
+    size_t count = 0;
+    stage(batch, count, REG_PS_THDL, _farCounts);
+    stage(batch, count, REG_PS_THDH, _nearCounts);
+    stage(batch, count, REG_PS_CONF3_MS, PS_SMART_PERS | LED_I_100MA);
+    stage(batch, count, REG_PS_CONF1_2, psConf12()); // last: starts measuring with the thresholds in place
+    if (!commit(batch, count))
+    {
+        return false;
+    }
+    uint16_t flags;
+    return readRegister(REG_INT_FLAG, flags); // drop anything latched before configuration
+}
+
+void Vcnl4040::resume(Proximity state)
+{
+    _state = state;
+    _shutdown = false;
+    _shadow[0] = psConf12();
+    _shadow[1] = PS_SMART_PERS | LED_I_100MA;
+    _shadow[2] = _farCounts;
+    _shadow[3] = _nearCounts;
+    _shadowValid = (1u << SHADOWED) - 1;
+}
+
+Vcnl4040::Event Vcnl4040::handleInterrupt()
+{
+    uint16_t flags = 0;
+    if (!readRegister(REG_INT_FLAG, flags))
+    {
+        return Event::None;
+    }
+    Event event = Event::None;
+    if ((flags & FLAG_PS_CLOSE) && _state == Proximity::Far)
+    {
+        _state = Proximity::Near;
+        event = Event::Approach;
+    }
+    else if ((flags & FLAG_PS_AWAY) && _state == Proximity::Near)
+    {
+        _state = Proximity::Far;
+        event = Event::Leave;
+    }
+    if (event != Event::None)
+    {
+        // Arm the opposite edge so the next wake is the next meaningful change
+        I2cWrite batch[1];
+        size_t count = 0;
+        stage(batch, count, REG_PS_CONF1_2, psConf12());
+        commit(batch, count);
+        LOG_DEBUG("%s", event == Event::Approach ? "approach" : "leave");
+    }
+    return event;
+}
+
+bool Vcnl4040::setThresholds(uint16_t nearCounts, uint16_t farCounts)
+{
+    if (farCounts >= nearCounts)
+    {
+        return false;
+    }
+    I2cWrite batch[2];
+    size_t count = 0;
+    stage(batch, count, REG_PS_THDL, farCounts);
+    stage(batch, count, REG_PS_THDH, nearCounts);
+    if (!commit(batch, count))
+    {
+        return false;
+    }
+    _nearCounts = nearCounts;
+    _farCounts = farCounts;
+    return true;
+}
+
+bool Vcnl4040::readProximity(uint16_t &counts)
+{
+    return readRegister(REG_PS_DATA, counts);
+}
+
+bool Vcnl4040::shutdown()
+{
+    _shutdown = true;
+    I2cWrite batch[1];
+    size_t count = 0;
+    stage(batch, count, REG_PS_CONF1_2, psConf12());
+    return commit(batch, count);
+}
+
+uint16_t Vcnl4040::psConf12() const
+{
+    const uint16_t interrupt = _state == Proximity::Far ? PS_INT_CLOSE : PS_INT_AWAY;
+    return PS_DUTY_1_320 | PS_PERS_2 | PS_IT_2T | interrupt | (_shutdown ? PS_SD : 0);
+}
+
+bool Vcnl4040::readRegister(uint8_t reg, uint16_t &value)
+{
+    uint8_t data[2];
+    if (!_bus->writeRead(ADDRESS, &reg, 1, data, sizeof(data)))
+    {
+        return false;
+    }
+    value = static_cast<uint16_t>(data[0] | (data[1] << 8));
+    return true;
+}
+
+int Vcnl4040::shadowIndex(uint8_t reg) const
+{
+    for (size_t i = 0; i < SHADOWED; ++i)
+    {
+        if (SHADOWED_REGS[i] == reg)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void Vcnl4040::stage(I2cWrite *batch, size_t &count, uint8_t reg, uint16_t value) const
+{
+    const int index = shadowIndex(reg);
+    if (index >= 0 && (_shadowValid & (1u << index)) && _shadow[index] == value)
+    {
+        return;
+    }
+    batch[count++] = I2cWrite{{reg, static_cast<uint8_t>(value & 0xFF), static_cast<uint8_t>(value >> 8), 0}, 3};
+}
+
+bool Vcnl4040::commit(const I2cWrite *batch, size_t count)
+{
+    if (count == 0)
+    {
+        return true;
+    }
+    if (!_bus->writeBatch(ADDRESS, batch, count))
+    {
+        // Unknown how far the batch got: make the next write of each register unconditional
+        for (size_t i = 0; i < count; ++i)
+        {
+            const int index = shadowIndex(batch[i].bytes[0]);
+            if (index >= 0)
+            {
+                _shadowValid &= static_cast<uint8_t>(~(1u << index));
+            }
+        }
+        LOG_ERROR("register write failed");
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        const int index = shadowIndex(batch[i].bytes[0]);
+        if (index >= 0)
+        {
+            _shadow[index] = static_cast<uint16_t>(batch[i].bytes[1] | (batch[i].bytes[2] << 8));
+            _shadowValid |= static_cast<uint8_t>(1u << index);
+        }
+    }
+    return true;
+}
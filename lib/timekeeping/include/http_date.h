@@ -0,0 +1,18 @@
+#ifndef HTTP_DATE_H
+#define HTTP_DATE_H
+
+#include <ctime>
+
+namespace HttpDate
+{
+    /**
+     * @brief Parses an HTTP `Date` header in IMF-fixdate form ("Sun, 06 Nov 1994 08:49:37 GMT").
+     * @return Epoch seconds, or 0 if @p value is not a valid IMF-fixdate
+     */
+    time_t parse(const char *value);
+
+    /// Days since 1970-01-01 for a proleptic Gregorian date (month 1-12).
+    long daysFromCivil(int year, unsigned month, unsigned day);
+}
+
+#endif // HTTP_DATE_H
@@ -0,0 +1,90 @@
+#ifndef TIME_KEEPER_H
+#define TIME_KEEPER_H
+
+#include <cstdint>
+#include <ctime>
+
+/**
+ * @file time_keeper.h
+ * @brief Decides when the RTC needs an NTP sync, from its measured drift.
+ *
+ * Each NTP sync reports how far the local clock had wandered since the previous one,
+ * which gives a drift rate in ppm. Between syncs the predicted drift is corrected
+ * locally and an error bound grows with the (much smaller) residual rate; an NTP round
+ * trip is only needed once that bound passes MAX_ERROR_MS. HTTP `Date` headers from
+ * the Share API are a free, coarse (1 s) cross-check: one that agrees tightens the bound,
+ * one that clearly disagrees steps the clock and forces a sync. State is a POD so it can
+ * be kept in RTC memory.
+ */
+
+struct TimeKeeperState
+{
+    uint32_t lastSyncAt;    // epoch s of the last NTP sync, 0 if never
+    uint32_t lastCheckAt;   // epoch s the error bound was last reset (NTP or HTTP Date)
+    uint32_t checkErrorMs;  // error bound at lastCheckAt
+    int32_t driftPpm;       // true time gained on the RTC per second, in ppm
+    int32_t appliedMs;      // drift correction applied since lastSyncAt
+    uint8_t driftKnown;     // non-zero once two syncs far enough apart were seen
+};
+
+class TimeKeeper
+{
+public:
+    static constexpr uint32_t NTP_ERROR_MS = 100;
+    /// Date has 1 s resolution and was stamped before the response reached us.
+    static constexpr uint32_t HTTP_DATE_ERROR_MS = 1500;
+    /// Assumed drift until measured; the ESP32 RTC slow clock is an uncalibrated RC oscillator.
+    static constexpr uint32_t DEFAULT_DRIFT_PPM = 1000;
+    /// Uncertainty left after correcting for measured drift.
+    static constexpr uint32_t RESIDUAL_DRIFT_PPM = 50;
+    static constexpr uint32_t MAX_ERROR_MS = 5000;
+    static constexpr uint32_t MAX_SYNC_INTERVAL_S = 7 * 24 * 3600;
+    /// Syncs closer together than this give too noisy a drift estimate to use.
+    static constexpr uint32_t MIN_DRIFT_BASELINE_S = 1800;
+
+    struct DateCheck
+    {
+        bool consistent; // the Date agreed with the local clock within both error bounds
+        int32_t stepMs;  // correction to apply to the local clock, 0 if none
+    };
+
+    explicit TimeKeeper(TimeKeeperState &state) : _state(state) {}
+
+    void reset();
+
+    /**
+     * @brief Records an NTP sync.
+     * @param syncedAt Time after the sync
+     * @param offsetMs NTP time minus local time just before the sync
+     * @param offsetKnown false if the local clock was not valid before the sync
+     */
+    void onNtpSync(time_t syncedAt, int32_t offsetMs, bool offsetKnown = true);
+
+    /// Upper bound on the local clock error at @p now, UINT32_MAX if never synced.
+    uint32_t estimatedErrorMs(time_t now) const;
+
+    /// Whether an NTP sync is due at @p now (0 meaning the clock is not valid).
+    bool needsSync(time_t now) const;
+
+    /**
+     * @brief Drift correction that should be added to the clock now.
+     *
+     * Call noteCorrection() with the amount actually applied.
+     */
+    int32_t pendingCorrectionMs(time_t now) const;
+    void noteCorrection(int32_t ms) { _state.appliedMs += ms; }
+
+    /**
+     * @brief Cross-checks the clock against an HTTP Date header.
+     * @param serverTime Parsed Date value
+     * @param localNowMs Local time in ms when the response was read
+     */
+    DateCheck onHttpDate(time_t serverTime, int64_t localNowMs);
+
+    const TimeKeeperState &state() const { return _state; }
+
+private:
+    TimeKeeperState &_state;
+};
+
+#endif // TIME_KEEPER_H
@@ -0,0 +1,49 @@
+#include "http_date.h"
+
+#include <cstdio>
+#include <cstring>
+
+long HttpDate::daysFromCivil(int year, unsigned month, unsigned day)
+{
+    // Howard Hinnant's algorithm; avoids timegm(), which newlib lacks
+    year -= month <= 2;
+    const long era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(year - era * 400);
+    const unsigned doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<long>(doe) - 719468;
+}
+
+time_t HttpDate::parse(const char *value)
+{
+    static const char MONTHS[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+    if (value == nullptr)
+    {
+        return 0;
+    }
+
+    char weekday[4] = {};
+    char month[4] = {};
+    char zone[4] = {};
+    int day = 0, year = 0, hour = 0, minute = 0, second = 0;
+    if (std::sscanf(value, "%3[A-Za-z], %d %3s %d %d:%d:%d %3s", weekday, &day, month, &year, &hour, &minute, &second,
+                    zone) != 8 ||
+        std::strcmp(zone, "GMT") != 0 || std::strlen(month) != 3)
+    {
+        return 0;
+    }
+    const char *found = std::strstr(MONTHS, month);
+    if (found == nullptr || (found - MONTHS) % 3 != 0)
+    {
+        return 0;
+    }
+    const unsigned monthNumber = static_cast<unsigned>((found - MONTHS) / 3 + 1);
+    if (year < 1970 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60 || hour < 0 ||
+        minute < 0 || second < 0)
+    {
+        return 0;
+    }
+
+    const long days = daysFromCivil(year, monthNumber, static_cast<unsigned>(day));
+    return static_cast<time_t>(days) * 86400 + hour * 3600 + minute * 60 + second;
+}
@@ -0,0 +1,100 @@
+#include "time_keeper.h"
+
+namespace
+{
+    uint32_t saturate(uint64_t v)
+    {
+        return v > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(v);
+    }
+}
+
+void TimeKeeper::reset()
+{
+    _state = TimeKeeperState{};
+}
+
+void TimeKeeper::onNtpSync(time_t syncedAt, int32_t offsetMs, bool offsetKnown)
+{
+    if (offsetKnown && _state.lastSyncAt != 0 && syncedAt > static_cast<time_t>(_state.lastSyncAt))
+    {
+        const int64_t elapsedS = syncedAt - static_cast<time_t>(_state.lastSyncAt);
+        if (elapsedS >= MIN_DRIFT_BASELINE_S)
+        {
+            // What the clock lost over the interval, including what was already corrected
+            const int64_t totalMs = static_cast<int64_t>(offsetMs) + _state.appliedMs;
+            const int32_t measured = static_cast<int32_t>(totalMs * 1000 / elapsedS);
+            _state.driftPpm = _state.driftKnown ? (3 * _state.driftPpm + measured) / 4 : measured;
+            _state.driftKnown = 1;
+        }
+    }
+    _state.lastSyncAt = static_cast<uint32_t>(syncedAt);
+    _state.lastCheckAt = static_cast<uint32_t>(syncedAt);
+    _state.checkErrorMs = NTP_ERROR_MS;
+    _state.appliedMs = 0;
+}
+
+uint32_t TimeKeeper::estimatedErrorMs(time_t now) const
+{
+    if (now == 0 || _state.lastSyncAt == 0)
+    {
+        return UINT32_MAX;
+    }
+    const uint64_t elapsedS = now > static_cast<time_t>(_state.lastCheckAt) ? now - _state.lastCheckAt : 0;
+    const uint64_t rate = _state.driftKnown ? RESIDUAL_DRIFT_PPM : DEFAULT_DRIFT_PPM;
+    return saturate(_state.checkErrorMs + rate * elapsedS / 1000);
+}
+
+bool TimeKeeper::needsSync(time_t now) const
+{
+    if (now == 0 || _state.lastSyncAt == 0 || _state.lastCheckAt == 0)
+    {
+        return true;
+    }
+    if (now - static_cast<time_t>(_state.lastSyncAt) > static_cast<time_t>(MAX_SYNC_INTERVAL_S))
+    {
+        return true;
+    }
+    return estimatedErrorMs(now) > MAX_ERROR_MS;
+}
+
+int32_t TimeKeeper::pendingCorrectionMs(time_t now) const
+{
+    if (!_state.driftKnown || _state.lastSyncAt == 0 || now <= static_cast<time_t>(_state.lastSyncAt))
+    {
+        return 0;
+    }
+    const int64_t elapsedS = now - static_cast<time_t>(_state.lastSyncAt);
+    const int64_t predictedMs = static_cast<int64_t>(_state.driftPpm) * elapsedS / 1000;
+    return static_cast<int32_t>(predictedMs - _state.appliedMs);
+}
+
+TimeKeeper::DateCheck TimeKeeper::onHttpDate(time_t serverTime, int64_t localNowMs)
+{
+    if (serverTime == 0 || localNowMs <= 0)
+    {
+        return DateCheck{false, 0};
+    }
+    // The server stamped somewhere within its whole second; assume the middle
+    const int64_t diffMs = static_cast<int64_t>(serverTime) * 1000 + 500 - localNowMs;
+    const uint64_t absDiff = static_cast<uint64_t>(diffMs < 0 ? -diffMs : diffMs);
+    const time_t localNow = static_cast<time_t>(localNowMs / 1000);
+    const uint32_t bound = estimatedErrorMs(localNow);
+
+    if (absDiff <= HTTP_DATE_ERROR_MS)
+    {
+        if (bound > HTTP_DATE_ERROR_MS && _state.lastSyncAt != 0)
+        {
+            _state.lastCheckAt = static_cast<uint32_t>(localNow);
+            _state.checkErrorMs = HTTP_DATE_ERROR_MS;
+        }
+        return DateCheck{true, 0};
+    }
+    if (absDiff > static_cast<uint64_t>(bound) + HTTP_DATE_ERROR_MS)
+    {
+        // Off by more than both bounds allow: step now, and have NTP confirm soon
+        _state.appliedMs += static_cast<int32_t>(diffMs);
+        _state.lastCheckAt = 0;
+        return DateCheck{false, static_cast<int32_t>(diffMs)};
+    }
+    return DateCheck{false, 0};
+}
@@ -0,0 +1,87 @@
+#ifndef WARM_STATE_H
+#define WARM_STATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <vector>
+#include "glucose_reading.h"
+#include "glucose_history_codec.h"
+#include "wifi_cache.h"
+#include "dns_cache.h"
+#include "time_keeper.h"
+
+/**
+ * @file warm_state.h
+ * @brief State carried across deep sleep so a wake can skip work that is still valid.
+ *
+ * WarmState is the logical snapshot. save()/load() turn it into a compact, versioned
+ * and CRC-protected byte image small enough for RTC slow memory; a snapshot from another
+ * firmware version or a corrupted one is simply rejected and the device cold-starts.
+ */
+
+/**
+ * @brief Which boot steps a wake can skip, derived from a WarmState.
+ */
+struct WarmStartPlan
+{
+    bool reuseSession;   // log in with the cached session ID
+    uint16_t fetchMinutes; // history window that still needs fetching
+};
+
+struct WarmState
+{
+    static constexpr uint8_t VERSION = 4;
+    static constexpr size_t SESSION_ID_MAX = 36;
+    static constexpr size_t HISTORY_CAPACITY = 768; // ~24 h of packed readings
+    static constexpr size_t MAX_SNAPSHOT_SIZE = 96 + SESSION_ID_MAX + sizeof(DnsCacheState) + HISTORY_CAPACITY;
+
+    static constexpr uint32_t SESSION_MAX_AGE_S = 6 * 3600;
+
+    char sessionId[SESSION_ID_MAX + 1];
+    uint32_t sessionCreatedAt;
+    DnsCacheState dns; // resolved hosts with their expiry, see DnsCache
+    WifiCache wifi; // last AP and lease, see WifiConnector
+    TimeKeeperState time; // NTP sync history and measured RTC drift
+    uint16_t historyCount;
+    uint16_t historySize;
+    uint8_t history[HISTORY_CAPACITY]; // GlucoseHistoryEncoder stream, oldest first
+
+    WarmState() { clear(); }
+
+    void clear();
+
+    /// Stores the session ID; IDs longer than SESSION_ID_MAX are dropped.
+    void setSession(const char *id, time_t now);
+
+    /**
+     * @brief Replaces the packed history with the newest readings that fit.
+     * @param readings Readings in any order
+     * @return Number of readings stored
+     */
+    size_t setHistory(std::vector<GlucoseReading> readings);
+
+    /// Adds readings newer than the stored history, evicting the oldest if needed.
+    size_t mergeHistory(const std::vector<GlucoseReading> &readings);
+
+    GlucoseHistoryDecoder historyReadings() const { return GlucoseHistoryDecoder(history, historySize); }
+
+    /// Timestamp of the newest stored reading, 0 if the history is empty.
+    time_t newestReading() const;
+
+    WarmStartPlan plan(time_t now, bool clockValid) const;
+
+    /**
+     * @brief Serializes into @p out.
+     * @return Bytes written, or 0 if @p capacity is too small
+     */
+    size_t save(uint8_t *out, size_t capacity) const;
+
+    /**
+     * @brief Restores from a snapshot image.
+     * @return false (leaving this state cleared) if the image is missing, stale or corrupt
+     */
+    bool load(const uint8_t *in, size_t size);
+};
+
+#endif // WARM_STATE_H
@@ -0,0 +1,324 @@
+#include "warm_state.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    constexpr uint8_t MAGIC[2] = {'W', 'S'};
+    constexpr size_t HEADER_SIZE = 2 + 1 + 2; // magic, version, payload length
+    constexpr size_t CRC_SIZE = 4;
+
+    // Bitwise CRC-32 (IEEE); the snapshot is small, so a table is not worth the flash
+    uint32_t crc32(const uint8_t *data, size_t size)
+    {
+        uint32_t crc = 0xFFFFFFFFu;
+        for (size_t i = 0; i < size; ++i)
+        {
+            crc ^= data[i];
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+            }
+        }
+        return ~crc;
+    }
+
+    // Little-endian field writer that stops (and remembers) on overflow
+    class Writer
+    {
+    public:
+        Writer(uint8_t *out, size_t capacity) : _out(out), _capacity(capacity), _pos(0), _ok(true) {}
+
+        void bytes(const void *src, size_t n)
+        {
+            if (!_ok || _capacity - _pos < n)
+            {
+                _ok = false;
+                return;
+            }
+            std::memcpy(_out + _pos, src, n);
+            _pos += n;
+        }
+        void u8(uint8_t v) { bytes(&v, 1); }
+        void u16(uint16_t v)
+        {
+            uint8_t b[2] = {static_cast<uint8_t>(v), static_cast<uint8_t>(v >> 8)};
+            bytes(b, sizeof(b));
+        }
+        void u32(uint32_t v)
+        {
+            uint8_t b[4] = {static_cast<uint8_t>(v), static_cast<uint8_t>(v >> 8),
+                            static_cast<uint8_t>(v >> 16), static_cast<uint8_t>(v >> 24)};
+            bytes(b, sizeof(b));
+        }
+
+        size_t pos() const { return _pos; }
+        bool ok() const { return _ok; }
+        uint8_t *at(size_t pos) { return _out + pos; }
+
+    private:
+        uint8_t *_out;
+        size_t _capacity;
+        size_t _pos;
+        bool _ok;
+    };
+
+    class Reader
+    {
+    public:
+        Reader(const uint8_t *in, size_t size) : _in(in), _size(size), _pos(0), _ok(true) {}
+
+        void bytes(void *dst, size_t n)
+        {
+            if (!_ok || _size - _pos < n)
+            {
+                _ok = false;
+                return;
+            }
+            std::memcpy(dst, _in + _pos, n);
+            _pos += n;
+        }
+        uint8_t u8()
+        {
+            uint8_t v = 0;
+            bytes(&v, 1);
+            return v;
+        }
+        uint16_t u16()
+        {
+            uint8_t b[2] = {};
+            bytes(b, sizeof(b));
+            return static_cast<uint16_t>(b[0] | (b[1] << 8));
+        }
+        uint32_t u32()
+        {
+            uint8_t b[4] = {};
+            bytes(b, sizeof(b));
+            return static_cast<uint32_t>(b[0]) | (static_cast<uint32_t>(b[1]) << 8) |
+                   (static_cast<uint32_t>(b[2]) << 16) | (static_cast<uint32_t>(b[3]) << 24);
+        }
+
+        size_t pos() const { return _pos; }
+        bool ok() const { return _ok; }
+
+    private:
+        const uint8_t *_in;
+        size_t _size;
+        size_t _pos;
+        bool _ok;
+    };
+
+    uint32_t age(time_t now, uint32_t then)
+    {
+        return now > static_cast<time_t>(then) ? static_cast<uint32_t>(now - then) : 0;
+    }
+}
+
+void WarmState::clear()
+{
+    std::memset(sessionId, 0, sizeof(sessionId));
+    sessionCreatedAt = 0;
+    std::memset(&dns, 0, sizeof(dns));
+    std::memset(&wifi, 0, sizeof(wifi));
+    time = TimeKeeperState{};
+    historyCount = 0;
+    historySize = 0;
+}
+
+void WarmState::setSession(const char *id, time_t now)
+{
+    size_t length = id ? std::strlen(id) : 0;
+    if (length == 0 || length > SESSION_ID_MAX)
+    {
+        std::memset(sessionId, 0, sizeof(sessionId));
+        sessionCreatedAt = 0;
+        return;
+    }
+    std::memcpy(sessionId, id, length + 1);
+    sessionCreatedAt = static_cast<uint32_t>(now);
+}
+
+size_t WarmState::setHistory(std::vector<GlucoseReading> readings)
+{
+    std::sort(readings.begin(), readings.end(), [](const GlucoseReading &a, const GlucoseReading &b)
+              { return a.getTimestamp() < b.getTimestamp(); });
+
+    // Drop the oldest readings until the rest fits; a steady series packs to ~2.5 B/reading,
+    // so start from a guess and only rarely need another pass
+    size_t first = readings.size() > HISTORY_CAPACITY / 2 ? readings.size() - HISTORY_CAPACITY / 2 : 0;
+    GlucoseHistoryEncoder encoder(history, HISTORY_CAPACITY);
+    while (true)
+    {
+        encoder.reset();
+        size_t i = first;
+        while (i < readings.size() && encoder.append(readings[i]))
+        {
+            ++i;
+        }
+        if (i == readings.size())
+        {
+            break;
+        }
+        first += std::max<size_t>(1, (readings.size() - i));
+    }
+    historyCount = static_cast<uint16_t>(encoder.count());
+    historySize = static_cast<uint16_t>(encoder.size());
+    return encoder.count();
+}
+
+size_t WarmState::mergeHistory(const std::vector<GlucoseReading> &readings)
+{
+    std::vector<GlucoseReading> merged(historyReadings().begin(), historyReadings().end());
+    const time_t newest = merged.empty() ? 0 : merged.back().getTimestamp();
+    for (const auto &reading : readings)
+    {
+        if (reading.getTimestamp() > newest)
+        {
+            merged.push_back(reading);
+        }
+    }
+    return setHistory(std::move(merged));
+}
+
+time_t WarmState::newestReading() const
+{
+    time_t newest = 0;
+    for (const auto &reading : historyReadings())
+    {
+        newest = reading.getTimestamp();
+    }
+    return newest;
+}
+
+WarmStartPlan WarmState::plan(time_t now, bool clockValid) const
+{
+    WarmStartPlan result{};
+    result.reuseSession = clockValid && sessionId[0] != '\0' && age(now, sessionCreatedAt) < SESSION_MAX_AGE_S;
+
+    result.fetchMinutes = DexcomConst::MAX_MINUTES;
+    const time_t newest = clockValid ? newestReading() : 0;
+    if (newest != 0)
+    {
+        // Only the gap since the newest cached reading, plus one interval of slack
+        uint32_t minutes = age(now, static_cast<uint32_t>(newest)) / 60 + 5;
+        result.fetchMinutes = static_cast<uint16_t>(std::min<uint32_t>(minutes, DexcomConst::MAX_MINUTES));
+    }
+    return result;
+}
+
+size_t WarmState::save(uint8_t *out, size_t capacity) const
+{
+    Writer w(out, capacity);
+    w.bytes(MAGIC, sizeof(MAGIC));
+    w.u8(VERSION);
+    w.u16(0); // payload length, patched below
+
+    const size_t payloadStart = w.pos();
+    const uint8_t sessionLength = static_cast<uint8_t>(strnlen(sessionId, SESSION_ID_MAX));
+    w.u8(sessionLength);
+    w.bytes(sessionId, sessionLength);
+    w.u32(sessionCreatedAt);
+    for (const auto &entry : dns.entries)
+    {
+        const uint8_t hostLength = static_cast<uint8_t>(strnlen(entry.host, DnsCacheEntry::HOST_MAX));
+        w.u8(hostLength);
+        w.bytes(entry.host, hostLength);
+        w.u32(entry.ip);
+        w.u32(entry.expiresAt);
+    }
+    w.bytes(wifi.bssid, sizeof(wifi.bssid));
+    w.u8(wifi.channel);
+    w.u32(wifi.lease.ip);
+    w.u32(wifi.lease.gateway);
+    w.u32(wifi.lease.subnet);
+    w.u32(wifi.lease.dns);
+    w.u32(wifi.lease.obtainedAt);
+    w.u32(time.lastSyncAt);
+    w.u32(time.lastCheckAt);
+    w.u32(time.checkErrorMs);
+    w.u32(static_cast<uint32_t>(time.driftPpm));
+    w.u32(static_cast<uint32_t>(time.appliedMs));
+    w.u8(time.driftKnown);
+    w.u16(historyCount);
+    w.u16(historySize);
+    w.bytes(history, historySize);
+    if (!w.ok())
+    {
+        return 0;
+    }
+
+    const size_t payloadLength = w.pos() - payloadStart;
+    w.at(3)[0] = static_cast<uint8_t>(payloadLength);
+    w.at(3)[1] = static_cast<uint8_t>(payloadLength >> 8);
+    w.u32(crc32(out, w.pos()));
+    return w.ok() ? w.pos() : 0;
+}
+
+bool WarmState::load(const uint8_t *in, size_t size)
+{
+    clear();
+    if (in == nullptr || size < HEADER_SIZE + CRC_SIZE || in[0] != MAGIC[0] || in[1] != MAGIC[1] || in[2] != VERSION)
+    {
+        return false;
+    }
+    const size_t payloadLength = static_cast<size_t>(in[3] | (in[4] << 8));
+    const size_t total = HEADER_SIZE + payloadLength + CRC_SIZE;
+    if (total > size)
+    {
+        return false;
+    }
+    Reader crcReader(in + total - CRC_SIZE, CRC_SIZE);
+    if (crcReader.u32() != crc32(in, total - CRC_SIZE))
+    {
+        return false;
+    }
+
+    Reader r(in + HEADER_SIZE, payloadLength);
+    const uint8_t sessionLength = r.u8();
+    if (sessionLength > SESSION_ID_MAX)
+    {
+        return false;
+    }
+    r.bytes(sessionId, sessionLength);
+    sessionCreatedAt = r.u32();
+    for (auto &entry : dns.entries)
+    {
+        const uint8_t hostLength = r.u8();
+        if (hostLength > DnsCacheEntry::HOST_MAX)
+        {
+            clear();
+            return false;
+        }
+        r.bytes(entry.host, hostLength);
+        entry.ip = r.u32();
+        entry.expiresAt = r.u32();
+    }
+    r.bytes(wifi.bssid, sizeof(wifi.bssid));
+    wifi.channel = r.u8();
+    wifi.lease.ip = r.u32();
+    wifi.lease.gateway = r.u32();
+    wifi.lease.subnet = r.u32();
+    wifi.lease.dns = r.u32();
+    wifi.lease.obtainedAt = r.u32();
+    time.lastSyncAt = r.u32();
+    time.lastCheckAt = r.u32();
+    time.checkErrorMs = r.u32();
+    time.driftPpm = static_cast<int32_t>(r.u32());
+    time.appliedMs = static_cast<int32_t>(r.u32());
+    time.driftKnown = r.u8();
+    historyCount = r.u16();
+    historySize = r.u16();
+    if (historySize > HISTORY_CAPACITY)
+    {
+        clear();
+        return false;
+    }
+    r.bytes(history, historySize);
+    if (!r.ok() || r.pos() != payloadLength || !historyReadings().valid())
+    {
+        clear();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,50 @@
+#ifndef I_WIFI_DRIVER_H
+#define I_WIFI_DRIVER_H
+
+#include <cstdint>
+#include "wifi_cache.h"
+
+enum class WifiLinkStatus : uint8_t
+{
+    Idle,
+    Connecting, // association in progress
+    Associated, // joined the AP, no IP yet
+    GotIp,
+    Failed      // association rejected or lost
+};
+
+/**
+ * @brief Thin station-mode WiFi backend, so connection policy can be tested natively.
+ *
+ * Credentials are owned by the implementation. begin*() calls return immediately;
+ * progress is observed through status().
+ */
+class IWifiDriver
+{
+public:
+    virtual ~IWifiDriver() = default;
+
+    /// Joins the given AP on the given channel, skipping the scan.
+    virtual void beginDirect(uint8_t channel, const uint8_t bssid[6]) = 0;
+
+    /// Scans all channels for the configured SSID and joins the best AP.
+    virtual void beginScan() = 0;
+
+    /// Applies @p lease as a static configuration for the next connection.
+    virtual void useStaticIp(const WifiLease &lease) = 0;
+
+    /// Obtains the address by DHCP on the next connection.
+    virtual void useDhcp() = 0;
+
+    virtual void disconnect() = 0;
+
+    virtual WifiLinkStatus status() = 0;
+
+    /**
+     * @brief Reads back the BSSID, channel and addressing of the current link.
+     * @return false if not connected
+     */
+    virtual bool currentLink(WifiCache &out) = 0;
+};
+
+#endif // I_WIFI_DRIVER_H
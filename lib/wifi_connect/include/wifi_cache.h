@@ -0,0 +1,31 @@
+#ifndef WIFI_CACHE_H
+#define WIFI_CACHE_H
+
+#include <cstdint>
+
+/**
+ * @brief DHCP lease remembered so a wake can configure a static IP instead of asking again.
+ *
+ * Addresses are IPv4 in the platform's native uint32_t form (as IPAddress converts them).
+ */
+struct WifiLease
+{
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+    uint32_t obtainedAt; // epoch seconds, 0 when unknown
+};
+
+/**
+ * @brief Everything needed to rejoin the last access point without scanning. POD so it
+ *        can be embedded in RTC-resident state.
+ */
+struct WifiCache
+{
+    uint8_t bssid[6];
+    uint8_t channel; // 0 when nothing is cached
+    WifiLease lease;
+};
+
+#endif // WIFI_CACHE_H
@@ -0,0 +1,98 @@
+#ifndef WIFI_CONNECTOR_H
+#define WIFI_CONNECTOR_H
+
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include "i_clock.h"
+#include "i_wifi_driver.h"
+#include "wifi_cache.h"
+
+/**
+ * @file wifi_connector.h
+ * @brief Station bring-up that reuses the last AP and lease, falling back to a full scan.
+ *
+ * Connection paths, fastest first:
+ *  - DirectStatic: cached BSSID/channel plus the cached lease as a static IP (no scan, no DHCP),
+ *  - DirectDhcp: cached BSSID/channel with DHCP, used when the lease is missing or old,
+ *  - Scan: full scan with DHCP.
+ *
+ * A direct attempt that fails or times out drops the cache and goes straight to Scan; on
+ * success the cache is refreshed from the live link. The connector is non-blocking: call
+ * poll() on WiFi events and at least every POLL_INTERVAL_MS until it settles.
+ */
+
+struct WifiConnectReport
+{
+    enum class Path : uint8_t
+    {
+        None,
+        DirectStatic,
+        DirectDhcp,
+        Scan
+    };
+
+    Path path;           // path that succeeded (or was last tried)
+    uint8_t fallbacks;   // direct attempts abandoned before @p path
+    uint32_t associateMs; // begin to association on the successful path
+    uint32_t addressMs;   // association to IP on the successful path
+    uint32_t totalMs;     // start() to connected or failed
+};
+
+class WifiConnector
+{
+public:
+    enum class State : uint8_t
+    {
+        Idle,
+        Connecting,
+        Connected,
+        Failed
+    };
+
+    static constexpr uint32_t POLL_INTERVAL_MS = 50;
+    /// A direct join normally completes in a few hundred ms; give up well before a scan would.
+    static constexpr uint32_t DIRECT_TIMEOUT_MS = 2000;
+    static constexpr uint32_t SCAN_TIMEOUT_MS = 15000;
+    /// Leases older than this are renewed by DHCP rather than reused.
+    static constexpr uint32_t LEASE_MAX_AGE_S = 12 * 3600;
+
+    /**
+     * @param driver Platform WiFi backend
+     * @param clock Monotonic clock for timeouts and timings
+     * @param cache Externally owned cache (e.g. inside RTC-resident state), updated in place
+     */
+    WifiConnector(std::shared_ptr<IWifiDriver> driver, std::shared_ptr<IClock> clock, WifiCache &cache);
+
+    /**
+     * @brief Starts (or restarts) a connection attempt.
+     * @param now Wall-clock time used to age the cached lease; 0 if the clock is not valid yet
+     */
+    void start(time_t now);
+
+    /// Advances the attempt; returns the resulting state.
+    State poll();
+
+    State state() const { return _state; }
+    const WifiConnectReport &report() const { return _report; }
+
+    static const char *pathName(WifiConnectReport::Path path);
+
+private:
+    void beginPath(WifiConnectReport::Path path);
+    void fallBack();
+    void finishConnected(uint32_t nowMs);
+
+    std::shared_ptr<IWifiDriver> _driver;
+    std::shared_ptr<IClock> _clock;
+    WifiCache &_cache;
+    State _state;
+    WifiConnectReport _report;
+    time_t _wallClock;
+    uint32_t _startMs;
+    uint32_t _pathStartMs;
+    uint32_t _associatedMs;
+    bool _associated;
+};
+
+#endif // WIFI_CONNECTOR_H
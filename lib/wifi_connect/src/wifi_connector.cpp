@@ -0,0 +1,154 @@
+#include "wifi_connector.h"
+
+#include <cstring>
+#include "phase_timer.h"
+#define LOG_TAG "wifi"
+#define LOG_MODULE_LEVEL LOG_LEVEL_WIFI
+#include <debug_print.h>
+
+using Path = WifiConnectReport::Path;
+
+WifiConnector::WifiConnector(std::shared_ptr<IWifiDriver> driver, std::shared_ptr<IClock> clock, WifiCache &cache)
+    : _driver(std::move(driver)), _clock(std::move(clock)), _cache(cache), _state(State::Idle), _report(),
+      _wallClock(0), _startMs(0), _pathStartMs(0), _associatedMs(0), _associated(false)
+{
+}
+
+const char *WifiConnector::pathName(Path path)
+{
+    switch (path)
+    {
+    case Path::DirectStatic:
+        return "direct+static";
+    case Path::DirectDhcp:
+        return "direct+dhcp";
+    case Path::Scan:
+        return "scan";
+    default:
+        return "none";
+    }
+}
+
+void WifiConnector::start(time_t now)
+{
+    _wallClock = now;
+    _startMs = _clock->millis();
+    _report = WifiConnectReport{};
+    _state = State::Connecting;
+
+    if (_cache.channel == 0)
+    {
+        beginPath(Path::Scan);
+        return;
+    }
+    const bool leaseFresh = _cache.lease.ip != 0 && now != 0 && _cache.lease.obtainedAt != 0 &&
+                            now >= static_cast<time_t>(_cache.lease.obtainedAt) &&
+                            now - static_cast<time_t>(_cache.lease.obtainedAt) < static_cast<time_t>(LEASE_MAX_AGE_S);
+    beginPath(leaseFresh ? Path::DirectStatic : Path::DirectDhcp);
+}
+
+void WifiConnector::beginPath(Path path)
+{
+    _report.path = path;
+    _pathStartMs = _clock->millis();
+    _associated = false;
+    LOG_DEBUG("Connecting via %s", pathName(path));
+
+    if (path == Path::DirectStatic)
+    {
+        _driver->useStaticIp(_cache.lease);
+    }
+    else
+    {
+        _driver->useDhcp();
+    }
+
+    if (path == Path::Scan)
+    {
+        _driver->beginScan();
+    }
+    else
+    {
+        _driver->beginDirect(_cache.channel, _cache.bssid);
+    }
+}
+
+void WifiConnector::fallBack()
+{
+    LOG_INFO("%s failed, falling back to scan", pathName(_report.path));
+    // The cached AP or lease is no good; don't try it again on the next wake either
+    std::memset(&_cache, 0, sizeof(_cache));
+    ++_report.fallbacks;
+    _driver->disconnect();
+    beginPath(Path::Scan);
+}
+
+void WifiConnector::finishConnected(uint32_t nowMs)
+{
+    if (!_associated)
+    {
+        // Association and address arrived between two polls
+        _associatedMs = nowMs;
+    }
+    _report.associateMs = _associatedMs - _pathStartMs;
+    _report.addressMs = nowMs - _associatedMs;
+    _report.totalMs = nowMs - _startMs;
+    PhaseTiming::record(Phase::WifiAssociate, _report.associateMs * 1000);
+    PhaseTiming::record(Phase::WifiAddress, _report.addressMs * 1000);
+
+    const WifiLease previous = _cache.lease;
+    if (_driver->currentLink(_cache))
+    {
+        if (_report.path == Path::DirectStatic)
+        {
+            _cache.lease.obtainedAt = previous.obtainedAt; // static reuse does not renew the lease
+        }
+        else
+        {
+            _cache.lease.obtainedAt = _wallClock != 0 ? static_cast<uint32_t>(_wallClock + _report.totalMs / 1000) : 0;
+        }
+    }
+    _state = State::Connected;
+    LOG_INFO("Connected via %s in %lu ms (associate %lu ms, address %lu ms)", pathName(_report.path),
+             static_cast<unsigned long>(_report.totalMs), static_cast<unsigned long>(_report.associateMs),
+             static_cast<unsigned long>(_report.addressMs));
+}
+
+WifiConnector::State WifiConnector::poll()
+{
+    if (_state != State::Connecting)
+    {
+        return _state;
+    }
+
+    const uint32_t nowMs = _clock->millis();
+    const WifiLinkStatus status = _driver->status();
+    if (status == WifiLinkStatus::GotIp)
+    {
+        finishConnected(nowMs);
+        return _state;
+    }
+    if (status == WifiLinkStatus::Associated && !_associated)
+    {
+        _associated = true;
+        _associatedMs = nowMs;
+    }
+
+    const bool direct = _report.path != Path::Scan;
+    const bool timedOut = nowMs - _pathStartMs >= (direct ? DIRECT_TIMEOUT_MS : SCAN_TIMEOUT_MS);
+    if (status == WifiLinkStatus::Failed || timedOut)
+    {
+        if (direct)
+        {
+            fallBack();
+        }
+        else
+        {
+            LOG_WARN("Scan connect %s", timedOut ? "timed out" : "failed");
+            _driver->disconnect();
+            _report.totalMs = nowMs - _startMs;
+            _state = State::Failed;
+        }
+    }
+    return _state;
+}
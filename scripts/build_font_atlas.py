@@ -0,0 +1,264 @@
+#!/usr/bin/env python3
+"""Builds the run-length-encoded 1-bpp glyph atlases in lib/display/src/font_atlases.cpp.
+
+Each glyph is rasterized, trimmed to its ink box and packed as a stream of runs over
+its rows (see Framebuffer::drawRunLength): one byte per run, bit 7 set for ink, bits
+0-6 holding the run length minus one. Runs may wrap from one row to the next.
+
+    python3 scripts/build_font_atlas.py [--value-ttf FONT.ttf] [--arrow-ttf FONT.ttf]
+
+With a TTF the glyphs are rendered with Pillow. Without one, built-in outlines are used
+(segment digits and block arrows) so the tree needs no font file or Pillow to build.
+
+Listed in platformio.ini as a pre-build script: there it regenerates the atlases when
+assets/fonts/value.ttf or assets/fonts/arrows.ttf exists and is newer than the output,
+and does nothing otherwise.
+"""
+
+import argparse
+import math
+import os
+
+# SCons runs pre-scripts without __file__; the hook at the bottom sets ROOT from the env
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__))) if "__file__" in globals() else os.getcwd()
+OUTPUT = os.path.join(ROOT, "lib", "display", "src", "font_atlases.cpp")
+FONT_DIR = os.path.join(ROOT, "assets", "fonts")
+
+# name, pixel size, characters
+ATLASES = [
+    ("VALUE", 64, "0123456789.-?"),
+    ("ARROWS", 48, "↑↗→↘↓"),  # up, up-right, right, down-right, down
+]
+
+MAX_RUN = 128
+
+
+class Glyph:
+    def __init__(self, char, rows, x_offset, y_offset, advance):
+        self.char = char
+        self.rows = rows  # list of lists of 0/1, trimmed to the ink box
+        self.x_offset = x_offset  # ink box left relative to the pen position
+        self.y_offset = y_offset  # ink box top relative to the baseline (negative is up)
+        self.advance = advance
+
+    @property
+    def width(self):
+        return len(self.rows[0]) if self.rows else 0
+
+    @property
+    def height(self):
+        return len(self.rows)
+
+
+def trim(char, bitmap, origin_x, baseline, advance):
+    """Crops a full-cell bitmap to its ink box, keeping the offsets consistent."""
+    ys = [y for y, row in enumerate(bitmap) if any(row)]
+    xs = [x for row in bitmap for x, bit in enumerate(row) if bit]
+    if not ys:
+        return Glyph(char, [], 0, 0, advance)
+    top, bottom, left, right = min(ys), max(ys), min(xs), max(xs)
+    rows = [row[left:right + 1] for row in bitmap[top:bottom + 1]]
+    return Glyph(char, rows, left - origin_x, top - baseline, advance)
+
+
+# --- built-in outlines ---------------------------------------------------------------
+
+def fill_polygons(width, height, polygons):
+    """Scanline fill at pixel centres; pixels inside any polygon are ink."""
+    bitmap = [[0] * width for _ in range(height)]
+    for y in range(height):
+        cy = y + 0.5
+        for poly in polygons:
+            crossings = []
+            for (x0, y0), (x1, y1) in zip(poly, poly[1:] + poly[:1]):
+                if (y0 <= cy < y1) or (y1 <= cy < y0):
+                    crossings.append(x0 + (cy - y0) * (x1 - x0) / (y1 - y0))
+            crossings.sort()
+            for start, end in zip(crossings[0::2], crossings[1::2]):
+                for x in range(max(0, math.ceil(start - 0.5)), min(width, math.ceil(end - 0.5))):
+                    bitmap[y][x] = 1
+    return bitmap
+
+
+SEGMENTS = {
+    "0": "abcdef", "1": "bc", "2": "abged", "3": "abgcd", "4": "fgbc",
+    "5": "afgcd", "6": "afgedc", "7": "abc", "8": "abcdefg", "9": "abcdfg",
+    "-": "g",
+}
+
+
+def segment_digit(char, size):
+    """Seven-segment style glyph with bevelled segments, cap height = size."""
+    t = max(2.0, size * 0.14)  # stroke
+    w = size * 0.56
+    h = size
+    gap = t * 0.15
+    margin = size * 0.08
+
+    def horizontal(y):
+        x0, x1 = margin + gap, margin + w - gap
+        return [(x0, y), (x0 + t / 2, y - t / 2), (x1 - t / 2, y - t / 2),
+                (x1, y), (x1 - t / 2, y + t / 2), (x0 + t / 2, y + t / 2)]
+
+    def vertical(x, y0, y1):
+        y0, y1 = y0 + gap, y1 - gap
+        return [(x, y0), (x + t / 2, y0 + t / 2), (x + t / 2, y1 - t / 2),
+                (x, y1), (x - t / 2, y1 - t / 2), (x - t / 2, y0 + t / 2)]
+
+    left, right, top, mid, bottom = margin + t / 2, margin + w - t / 2, t / 2, h / 2, h - t / 2
+    shapes = {
+        "a": horizontal(top), "g": horizontal(mid), "d": horizontal(bottom),
+        "f": vertical(left, top, mid), "b": vertical(right, top, mid),
+        "e": vertical(left, mid, bottom), "c": vertical(right, mid, bottom),
+    }
+    advance = round(w + 2 * margin)
+    if char == ".":
+        dot = [(margin, h - t * 1.2), (margin + t * 1.2, h - t * 1.2), (margin + t * 1.2, h), (margin, h)]
+        return trim(char, fill_polygons(advance, size, [dot]), 0, size, round(t * 1.2 + 2 * margin))
+    if char == "?":
+        x = margin + w / 2 - t * 0.6
+        dot = [(x, h - t * 1.2), (x + t * 1.2, h - t * 1.2), (x + t * 1.2, h), (x, h)]
+        polygons = [shapes["a"], shapes["b"], shapes["g"], dot]
+    else:
+        polygons = [shapes[segment] for segment in SEGMENTS[char]]
+    return trim(char, fill_polygons(advance, size, polygons), 0, size, advance)
+
+
+ARROW_ANGLES = {"↑": 0, "↗": 45, "→": 90, "↘": 135, "↓": 180}
+
+
+def block_arrow(char, size):
+    """Filled arrow in a size x size cell, rotated clockwise from pointing up."""
+    outline = [(0.0, -0.5), (0.42, -0.04), (0.12, -0.04), (0.12, 0.5),
+               (-0.12, 0.5), (-0.12, -0.04), (-0.42, -0.04)]
+    angle = math.radians(ARROW_ANGLES[char])
+    scale = size * (0.92 if ARROW_ANGLES[char] % 90 == 0 else 0.8)
+    c, s = math.cos(angle), math.sin(angle)
+    poly = [(size / 2 + (x * c - y * s) * scale, size / 2 + (x * s + y * c) * scale) for x, y in outline]
+    return trim(char, fill_polygons(size, size, [poly]), 0, size, size + size // 8)
+
+
+def builtin_glyph(atlas, char, size):
+    return block_arrow(char, size) if atlas == "ARROWS" else segment_digit(char, size)
+
+
+# --- TTF via Pillow --------------------------------------------------------------------
+
+def ttf_glyph(font, char):
+    from PIL import Image, ImageDraw
+
+    ascent, _ = font.getmetrics()
+    left, top, right, bottom = font.getbbox(char)
+    advance = round(font.getlength(char))
+    if right <= left or bottom <= top:
+        return Glyph(char, [], 0, 0, advance)
+    image = Image.new("1", (right - left, bottom - top), 0)
+    ImageDraw.Draw(image).text((-left, -top), char, font=font, fill=1)
+    bitmap = [[1 if image.getpixel((x, y)) else 0 for x in range(image.width)] for y in range(image.height)]
+    return trim(char, bitmap, -left, ascent - top, advance)
+
+
+# --- encoding and output -----------------------------------------------------------------
+
+def encode_runs(glyph):
+    bits = [bit for row in glyph.rows for bit in row]
+    runs = []
+    i = 0
+    while i < len(bits):
+        ink = bits[i]
+        length = 1
+        while i + length < len(bits) and bits[i + length] == ink and length < MAX_RUN:
+            length += 1
+        runs.append((0x80 if ink else 0) | (length - 1))
+        i += length
+    return runs
+
+
+def decode_runs(runs, count):
+    bits = []
+    for byte in runs:
+        bits.extend([1 if byte & 0x80 else 0] * ((byte & 0x7F) + 1))
+    return bits[:count]
+
+
+def build(args):
+    sections = []
+    for name, size, chars in ATLASES:
+        ttf = args.value_ttf if name == "VALUE" else args.arrow_ttf
+        font = None
+        if ttf:
+            from PIL import ImageFont
+            font = ImageFont.truetype(ttf, size)
+        glyphs = sorted((ttf_glyph(font, c) if font else builtin_glyph(name, c, size) for c in chars),
+                        key=lambda g: ord(g.char))
+        data, table = [], []
+        for glyph in glyphs:
+            runs = encode_runs(glyph)
+            assert decode_runs(runs, glyph.width * glyph.height) == [b for r in glyph.rows for b in r]
+            assert glyph.width < 256 and glyph.height < 256 and -128 <= glyph.y_offset < 128
+            table.append((glyph, len(data), len(runs)))
+            data.extend(runs)
+        raw = sum((g.width * g.height + 7) // 8 for g in glyphs)
+        sections.append((name, size, glyphs, table, data, raw, os.path.basename(ttf) if ttf else "built-in outlines"))
+    return sections
+
+
+def emit(sections):
+    out = ["// Generated by scripts/build_font_atlas.py - do not edit.", '#include "font_atlas.h"', "", "namespace", "{"]
+    for name, size, glyphs, table, data, raw, source in sections:
+        out.append(f"    // {name}: {size} px from {source}, {len(glyphs)} glyphs, {len(data)} bytes of runs ({raw} packed)")
+        out.append(f"    constexpr uint8_t {name}_RUNS[] PROGMEM = {{")
+        for i in range(0, len(data), 16):
+            out.append("        " + ", ".join(f"0x{b:02X}" for b in data[i:i + 16]) + ",")
+        out.append("    };")
+        out.append("")
+        out.append(f"    constexpr FontGlyph {name}_GLYPHS[] PROGMEM = {{")
+        for glyph, offset, _ in table:
+            out.append(f"        {{0x{ord(glyph.char):04X}, {offset}, {glyph.width}, {glyph.height}, "
+                       f"{glyph.x_offset}, {glyph.y_offset}, {glyph.advance}}}, // {glyph.char}")
+        out.append("    };")
+        out.append("")
+    out.append("}")
+    out.append("")
+    out.append("namespace Fonts")
+    out.append("{")
+    for name, size, glyphs, _, _, _, _ in sections:
+        ascent = max(-g.y_offset for g in glyphs if g.rows)
+        out.append(f"    const FontAtlas {name} = {{{name}_GLYPHS, {len(glyphs)}, {name}_RUNS, {size + size // 4}, {ascent}}};")
+    out.append("}")
+    return "\n".join(out) + "\n"
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--value-ttf", help="font for the glucose value glyphs")
+    parser.add_argument("--arrow-ttf", help="font for the trend arrow glyphs")
+    parser.add_argument("--output", default=OUTPUT)
+    args = parser.parse_args(argv)
+    with open(args.output, "w", encoding="utf-8") as f:
+        f.write(emit(build(args)))
+    print(f"font atlas: wrote {os.path.relpath(args.output, ROOT)}")
+
+
+def platformio_hook():
+    """Regenerates only when a font in assets/fonts is newer than the checked-in output."""
+    fonts = {key: os.path.join(FONT_DIR, f"{stem}.ttf") for key, stem in (("value", "value"), ("arrow", "arrows"))}
+    present = {k: p for k, p in fonts.items() if os.path.exists(p)}
+    if not present:
+        return
+    if os.path.exists(OUTPUT) and all(os.path.getmtime(p) <= os.path.getmtime(OUTPUT) for p in present.values()):
+        return
+    argv = []
+    for key, path in present.items():
+        argv += [f"--{key}-ttf", path]
+    main(argv)
+
+
+if __name__ == "__main__":
+    main()
+elif "Import" in globals():  # run by PlatformIO/SCons as an extra script
+    Import("env")  # noqa: F821
+    ROOT = env.subst("$PROJECT_DIR")  # noqa: F821
+    OUTPUT = os.path.join(ROOT, "lib", "display", "src", "font_atlases.cpp")
+    FONT_DIR = os.path.join(ROOT, "assets", "fonts")
+    platformio_hook()
@@ -0,0 +1,13 @@
+#ifndef ARDUINO_CLOCK_H
+#define ARDUINO_CLOCK_H
+
+#include <Arduino.h>
+#include "i_clock.h"
+
+class ArduinoClock : public IClock
+{
+public:
+    uint32_t millis() const override { return ::millis(); }
+};
+
+#endif // ARDUINO_CLOCK_H
@@ -0,0 +1,27 @@
+#include "arduino_i2c_bus.h"
+
+bool ArduinoI2cBus::write(uint8_t address, const uint8_t *data, size_t length)
+{
+    _wire.beginTransmission(address);
+    _wire.write(data, length);
+    return _wire.endTransmission() == 0;
+}
+
+bool ArduinoI2cBus::writeRead(uint8_t address, const uint8_t *tx, size_t txLength, uint8_t *rx, size_t rxLength)
+{
+    _wire.beginTransmission(address);
+    _wire.write(tx, txLength);
+    if (_wire.endTransmission(false) != 0) // repeated start
+    {
+        return false;
+    }
+    if (_wire.requestFrom(address, rxLength) != rxLength)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < rxLength; ++i)
+    {
+        rx[i] = static_cast<uint8_t>(_wire.read());
+    }
+    return true;
+}
@@ -0,0 +1,22 @@
+#ifndef ARDUINO_I2C_BUS_H
+#define ARDUINO_I2C_BUS_H
+
+#include <Wire.h>
+#include "i_i2c_bus.h"
+
+/**
+ * @brief II2cBus over the Arduino Wire driver.
+ */
+class ArduinoI2cBus : public II2cBus
+{
+public:
+    explicit ArduinoI2cBus(TwoWire &wire) : _wire(wire) {}
+
+    bool write(uint8_t address, const uint8_t *data, size_t length) override;
+    bool writeRead(uint8_t address, const uint8_t *tx, size_t txLength, uint8_t *rx, size_t rxLength) override;
+
+private:
+    TwoWire &_wire;
+};
+
+#endif // ARDUINO_I2C_BUS_H
@@ -0,0 +1,77 @@
+#include "esp32_dns_resolver.h"
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include "dns_message.h"
+#include "phase_timer.h"
+
+#define LOG_TAG "dns"
+#define LOG_MODULE_LEVEL LOG_LEVEL_DNS
+#include <debug_print.h>
+
+bool ESP32DnsResolver::resolve(const char *host, uint32_t &ip, uint32_t &ttlS)
+{
+    ScopedPhaseTimer timer(Phase::DnsLookup);
+    if (query(host, ip, ttlS))
+    {
+        return true;
+    }
+
+    IPAddress address;
+    if (!WiFi.hostByName(host, address))
+    {
+        return false;
+    }
+    ip = static_cast<uint32_t>(address);
+    ttlS = FALLBACK_TTL_S;
+    return true;
+}
+
+bool ESP32DnsResolver::query(const char *host, uint32_t &ip, uint32_t &ttlS)
+{
+    uint8_t message[DnsMessage::MAX_MESSAGE_SIZE];
+    const uint16_t id = static_cast<uint16_t>(esp_random()) ^ ++_nextId;
+    const size_t length = DnsMessage::buildQuery(host, id, message, sizeof(message));
+    const IPAddress server = WiFi.dnsIP();
+    if (length == 0 || static_cast<uint32_t>(server) == 0)
+    {
+        return false;
+    }
+
+    WiFiUDP udp;
+    if (!udp.begin(0))
+    {
+        return false;
+    }
+    udp.beginPacket(server, DnsMessage::PORT);
+    udp.write(message, length);
+    if (!udp.endPacket())
+    {
+        udp.stop();
+        return false;
+    }
+
+    const uint32_t start = millis();
+    bool ok = false;
+    while (millis() - start < QUERY_TIMEOUT_MS)
+    {
+        int size = udp.parsePacket();
+        if (size > 0)
+        {
+            int read = udp.read(message, sizeof(message));
+            // A stray packet with another id is ignored and we keep waiting
+            if (read > 0 && DnsMessage::parseResponse(message, static_cast<size_t>(read), id, ip, ttlS))
+            {
+                ok = true;
+                break;
+            }
+        }
+        delay(5);
+    }
+    udp.stop();
+    if (!ok)
+    {
+        LOG_DEBUG("UDP query for %s got no usable answer", host);
+    }
+    return ok;
+}
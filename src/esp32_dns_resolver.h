@@ -0,0 +1,25 @@
+#ifndef ESP32_DNS_RESOLVER_H
+#define ESP32_DNS_RESOLVER_H
+
+#include "i_dns_resolver.h"
+
+/**
+ * @brief Resolves over UDP to the DHCP-provided DNS server so the record TTL is known,
+ *        falling back to the core's resolver (with a fixed TTL) if that fails.
+ */
+class ESP32DnsResolver : public IDnsResolver
+{
+public:
+    static constexpr uint32_t QUERY_TIMEOUT_MS = 1000;
+    /// Used when only the core resolver answered and the real TTL is unknown.
+    static constexpr uint32_t FALLBACK_TTL_S = 300;
+
+    bool resolve(const char *host, uint32_t &ip, uint32_t &ttlS) override;
+
+private:
+    bool query(const char *host, uint32_t &ip, uint32_t &ttlS);
+
+    uint16_t _nextId = 0;
+};
+
+#endif // ESP32_DNS_RESOLVER_H
@@ -0,0 +1,41 @@
+#include "esp32_led_pwm.h"
+
+namespace
+{
+    constexpr uint32_t PWM_HZ = 122; // the most the 8 MHz RTC clock allows at 16 bits
+}
+
+Esp32LedPwm::Esp32LedPwm(const int (&pins)[CHANNELS])
+{
+    ledc_timer_config_t timer = {};
+    timer.speed_mode = MODE;
+    timer.duty_resolution = LEDC_TIMER_16_BIT;
+    timer.timer_num = TIMER;
+    timer.freq_hz = PWM_HZ;
+    timer.clk_cfg = LEDC_USE_RTC8M_CLK;
+    ledc_timer_config(&timer);
+
+    for (uint8_t channel = 0; channel < CHANNELS; ++channel)
+    {
+        ledc_channel_config_t config = {};
+        config.gpio_num = pins[channel];
+        config.speed_mode = MODE;
+        config.channel = static_cast<ledc_channel_t>(LEDC_CHANNEL_0 + channel);
+        config.timer_sel = TIMER;
+        config.duty = 0;
+        ledc_channel_config(&config);
+    }
+    ledc_fade_func_install(0);
+}
+
+void Esp32LedPwm::fade(Channel channel, uint16_t duty, uint32_t durationMs)
+{
+    const auto ledcChannel = static_cast<ledc_channel_t>(LEDC_CHANNEL_0 + channel);
+    if (durationMs == 0)
+    {
+        ledc_set_duty(MODE, ledcChannel, duty);
+        ledc_update_duty(MODE, ledcChannel);
+        return;
+    }
+    ledc_set_fade_time_and_start(MODE, ledcChannel, duty, durationMs, LEDC_FADE_NO_WAIT);
+}
@@ -0,0 +1,26 @@
+#ifndef ESP32_LED_PWM_H
+#define ESP32_LED_PWM_H
+
+#include <driver/ledc.h>
+#include "i_led_pwm.h"
+
+/**
+ * @brief ILedPwm on three LEDC channels with 16-bit duty and hardware fades.
+ *
+ * The timer runs from the 8 MHz RTC clock (~122 Hz at 16 bits) so fades keep going
+ * while the CPU is in light sleep; the caller must keep ESP_PD_DOMAIN_RTC8M powered.
+ */
+class Esp32LedPwm : public ILedPwm
+{
+public:
+    /// @param pins GPIOs for red, green and blue, driven active high
+    explicit Esp32LedPwm(const int (&pins)[CHANNELS]);
+
+    void fade(Channel channel, uint16_t duty, uint32_t durationMs) override;
+
+private:
+    static constexpr ledc_mode_t MODE = LEDC_LOW_SPEED_MODE;
+    static constexpr ledc_timer_t TIMER = LEDC_TIMER_0;
+};
+
+#endif // ESP32_LED_PWM_H
@@ -2,45 +2,80 @@
 #include <Arduino.h>
 #include <dexcom_constants.h>
 
-ESP32SecureClient::ESP32SecureClient()
+#define LOG_TAG "tls"
+#define LOG_MODULE_LEVEL LOG_LEVEL_SECURE_CLIENT
+#include <debug_print.h>
+
+namespace
 {
+    // Before NTP the clock reads near 1970 and cached expiries cannot be judged
+    constexpr time_t MIN_VALID_EPOCH = 8 * 3600 * 2;
+}
+
+ESP32SecureClient::ESP32SecureClient() : _rootCA(nullptr)
+{
+}
+
+bool ESP32SecureClient::attempt(const char *host, uint32_t ip, uint16_t port)
+{
+    // With an address the socket goes to it directly, while SNI and certificate
+    // validation still use the host name
+    bool ok = ip != 0 ? _client.connect(IPAddress(ip), port, host, _rootCA, nullptr, nullptr)
+                      : _client.connect(host, port);
+    if (ok)
+    {
+        LOG_DEBUG("TCP connection established");
+        if (_client.connected())
+        {
+            LOG_DEBUG("SSL/TLS handshake completed successfully");
+            return true;
+        }
+        else
+        {
+            LOG_ERROR("SSL/TLS handshake failed");
+        }
+    }
+
+    // Log the error
+    char error_buffer[100];
+    _client.lastError(error_buffer, sizeof(error_buffer));
+    LOG_ERROR("Connection failed. Error: %s", error_buffer);
+
+    return false;
 }
 
 bool ESP32SecureClient::connect(const char *host, uint16_t port)
 {
-    Serial.printf("Attempting to connect to %s:%d\n", host, port);
+    LOG_DEBUG("Attempting to connect to %s:%d", host, port);
     if (_rootCA)
     {
-        Serial.println("Using provided root CA");
+        LOG_DEBUG("Using provided root CA");
         _client.setCACert(_rootCA);
     }
     else
     {
         _client.setInsecure();
-        Serial.println("Falling back to insecure");
+        LOG_WARN("Falling back to insecure");
     }
 
-    // Single connection attempt
-    if (_client.connect(host, port))
+    uint32_t ip = 0;
+    const time_t now = time(nullptr);
+    if (_dnsCache && _dnsCache->lookup(host, now > MIN_VALID_EPOCH ? now : 0, ip))
     {
-        Serial.println("TCP connection established");
-        if (_client.connected())
+        if (attempt(host, ip, port))
         {
-            Serial.println("SSL/TLS handshake completed successfully");
             return true;
         }
-        else
-        {
-            Serial.println("SSL/TLS handshake failed");
-        }
+        // The host may have moved; forget it and let the core resolve it once
+        LOG_WARN("Cached address failed, resolving %s again", host);
+        _dnsCache->invalidate(host);
     }
-    
-    // Log the error
-    char error_buffer[100];
-    _client.lastError(error_buffer, sizeof(error_buffer));
-    Serial.printf("Connection failed. Error: %s\n", error_buffer);
-    
-    return false;
+    return attempt(host, 0, port);
+}
+
+void ESP32SecureClient::setDnsCache(std::shared_ptr<DnsCache> dnsCache)
+{
+    _dnsCache = std::move(dnsCache);
 }
 
 void ESP32SecureClient::setCACert(const char *rootCA)
@@ -83,6 +118,11 @@ bool ESP32SecureClient::connected()
     return _client.connected();
 }
 
+void ESP32SecureClient::print(const std::string& data)
+{
+    _client.print(data.c_str());
+}
+
 void ESP32SecureClient::println(const std::string& data)
 {
     _client.println(data.c_str());
@@ -3,6 +3,8 @@
 
 #include "i_secure_client.h"
 #include <WiFiClientSecure.h>
+#include <memory>
+#include "dns_cache.h"
 
 class ESP32SecureClient : public ISecureClient
 {
@@ -21,15 +23,26 @@ public:
     void setTimeout(uint32_t timeout) override;
 
     // New methods
+    void print(const std::string &data) override;
     void println(const std::string &data) override;
     void println() override;
     std::string readStringUntil(char terminator) override;
 
     void setCACert(const char *rootCA);
 
+    /**
+     * @brief Connect to cached addresses instead of resolving the host on every connect.
+     *
+     * The certificate is still checked against the host name (sent as SNI).
+     */
+    void setDnsCache(std::shared_ptr<DnsCache> dnsCache);
+
 private:
+    bool attempt(const char *host, uint32_t ip, uint16_t port);
+
     WiFiClientSecure _client;
     const char *_rootCA;
+    std::shared_ptr<DnsCache> _dnsCache;
 };
 
 #endif // ESP32_SECURE_CLIENT_H
\ No newline at end of file
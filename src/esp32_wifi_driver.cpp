@@ -0,0 +1,91 @@
+#include "esp32_wifi_driver.h"
+
+#define LOG_TAG "wifi"
+#define LOG_MODULE_LEVEL LOG_LEVEL_WIFI
+#include <debug_print.h>
+
+ESP32WifiDriver::ESP32WifiDriver(const char *ssid, const char *password)
+    : _ssid(ssid), _password(password), _status(WifiLinkStatus::Idle)
+{
+    WiFi.onEvent([this](WiFiEvent_t event, WiFiEventInfo_t info)
+                 { onEvent(event, info); });
+    WiFi.mode(WIFI_STA);
+    WiFi.setAutoReconnect(false); // WifiConnector owns reconnection
+    WiFi.persistent(false);       // don't rewrite credentials to flash on every begin()
+}
+
+void ESP32WifiDriver::onEvent(WiFiEvent_t event, WiFiEventInfo_t info)
+{
+    switch (event)
+    {
+    case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+        _status = WifiLinkStatus::Associated;
+        break;
+    case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+        _status = WifiLinkStatus::GotIp;
+        break;
+    case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+        // Our own disconnect() before a fallback is not a failure of the new attempt
+        if (info.wifi_sta_disconnected.reason != WIFI_REASON_ASSOC_LEAVE)
+        {
+            LOG_DEBUG("Disconnected, reason %d", info.wifi_sta_disconnected.reason);
+            _status = WifiLinkStatus::Failed;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void ESP32WifiDriver::beginDirect(uint8_t channel, const uint8_t bssid[6])
+{
+    _status = WifiLinkStatus::Connecting;
+    WiFi.begin(_ssid, _password, channel, bssid);
+}
+
+void ESP32WifiDriver::beginScan()
+{
+    _status = WifiLinkStatus::Connecting;
+    WiFi.begin(_ssid, _password);
+}
+
+void ESP32WifiDriver::useStaticIp(const WifiLease &lease)
+{
+    WiFi.config(IPAddress(lease.ip), IPAddress(lease.gateway), IPAddress(lease.subnet), IPAddress(lease.dns));
+}
+
+void ESP32WifiDriver::useDhcp()
+{
+    // All-zero addresses switch the station back to DHCP
+    WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);
+}
+
+void ESP32WifiDriver::disconnect()
+{
+    WiFi.disconnect();
+    _status = WifiLinkStatus::Idle;
+}
+
+WifiLinkStatus ESP32WifiDriver::status()
+{
+    return _status;
+}
+
+bool ESP32WifiDriver::currentLink(WifiCache &out)
+{
+    if (!WiFi.isConnected())
+    {
+        return false;
+    }
+    const uint8_t *bssid = WiFi.BSSID();
+    if (bssid != nullptr)
+    {
+        memcpy(out.bssid, bssid, sizeof(out.bssid));
+    }
+    out.channel = static_cast<uint8_t>(WiFi.channel());
+    out.lease.ip = static_cast<uint32_t>(WiFi.localIP());
+    out.lease.gateway = static_cast<uint32_t>(WiFi.gatewayIP());
+    out.lease.subnet = static_cast<uint32_t>(WiFi.subnetMask());
+    out.lease.dns = static_cast<uint32_t>(WiFi.dnsIP());
+    return true;
+}
@@ -0,0 +1,30 @@
+#ifndef ESP32_WIFI_DRIVER_H
+#define ESP32_WIFI_DRIVER_H
+
+#include <atomic>
+#include <WiFi.h>
+#include "i_wifi_driver.h"
+
+class ESP32WifiDriver : public IWifiDriver
+{
+public:
+    ESP32WifiDriver(const char *ssid, const char *password);
+    virtual ~ESP32WifiDriver() override = default;
+
+    void beginDirect(uint8_t channel, const uint8_t bssid[6]) override;
+    void beginScan() override;
+    void useStaticIp(const WifiLease &lease) override;
+    void useDhcp() override;
+    void disconnect() override;
+    WifiLinkStatus status() override;
+    bool currentLink(WifiCache &out) override;
+
+private:
+    void onEvent(WiFiEvent_t event, WiFiEventInfo_t info);
+
+    const char *_ssid;
+    const char *_password;
+    std::atomic<WifiLinkStatus> _status;
+};
+
+#endif // ESP32_WIFI_DRIVER_H
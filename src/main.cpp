@@ -1,6 +1,12 @@
 #include <Arduino.h>
 #include <WiFi.h>
+#include <Wire.h>
+#include <driver/rtc_io.h>
+#include <esp_sntp.h>
+#include <esp_sleep.h>
+#include <sys/time.h>
 #include <memory>
+#include <cstring>
 #include "config.h"
 #include "dexcom_constants.h"
 #include "esp32_secure_client.h"
@@ -8,106 +14,531 @@
 #include "secure_http_client.h"
 #include "arduino_json_parser.h"
 #include "json_glucose_reading_parser.h"
+#include "deferred_log.h"
+#include "phase_timer.h"
+#include "event_scheduler.h"
+#include "arduino_clock.h"
+#include "wake_planner.h"
+#include "warm_state.h"
+#include "esp32_wifi_driver.h"
+#include "wifi_connector.h"
+#include "esp32_dns_resolver.h"
+#include "dns_cache.h"
+#include "time_keeper.h"
+#include "http_date.h"
+#include "reading_pipeline.h"
+#include "arduino_i2c_bus.h"
+#include "i2c_bus_manager.h"
+#include "vcnl4040.h"
+#include "bme280.h"
+#include "esp32_led_pwm.h"
+#include "led_fader.h"
+#include "glucose_stats.h"
+#include "glucose_predictor.h"
 
-void setupSerial()
+#define LOG_TAG "main"
+#include <debug_print.h>
+
+namespace AppEvent
 {
-  Serial.begin(115200);
-  while (!Serial)
+  constexpr EventMask WIFI_UP = 1u << 0;
+  constexpr EventMask TIME_SYNCED = 1u << 1;
+  constexpr EventMask CLIENT_WANTED = 1u << 2;
+  constexpr EventMask CLIENT_READY = 1u << 3;
+  constexpr EventMask READING_DUE = 1u << 4;
+  constexpr EventMask WIFI_WANTED = 1u << 5;
+  constexpr EventMask WIFI_POLL = 1u << 6;
+  constexpr EventMask RENDERED = 1u << 7; // render task finished with the last batch
+  constexpr EventMask CLIMATE_READY = 1u << 8; // BME280 forced conversion has finished
+  constexpr EventMask WAKE_DEADLINE = 1u << 9; // WiFi or the client never came up this wake
+}
+
+constexpr uint32_t CLIENT_RETRY_MS = 30 * 1000;
+constexpr uint32_t WIFI_RETRY_MS = 30 * 1000;
+// Longest a wake may spend getting to a fetch before giving up until the planner's next retry
+constexpr uint32_t WAKE_DEADLINE_MS = 120 * 1000;
+constexpr time_t MIN_VALID_EPOCH = 8 * 3600 * 2;
+// VCNL4040 INT: open drain, active low; must be an RTC GPIO to serve as an ext0 wake source
+constexpr gpio_num_t PROXIMITY_INT_PIN = GPIO_NUM_33;
+// Night light: RGB LED on LEDC, shown while someone is near
+constexpr int LED_PINS[ILedPwm::CHANNELS] = {27, 25, 26};
+constexpr uint8_t NIGHT_BRIGHTNESS = 24; // perceptual, out of 255
+constexpr uint32_t LED_FADE_MS = 800;
+constexpr uint32_t LED_HOLD_MS = 8000;
+// A proximity wake this close to the next fetch just carries on with the fetch
+constexpr time_t MIN_RESLEEP_S = 10;
+
+// Survives deep sleep so the learned reading phase is not lost between wakes
+RTC_DATA_ATTR WakePlannerState wakePlannerState;
+WakePlanner wakePlanner(wakePlannerState);
+
+// What the proximity sensor was left doing (0 absent, 1 far, 2 near) and when the next fetch is due
+RTC_DATA_ATTR uint8_t proximityState;
+RTC_DATA_ATTR time_t nextFetchAt;
+// BME280 trimming parameters, read once per power-up
+RTC_DATA_ATTR Bme280Calibration climateCalibration;
+// Rolling 24 h statistics, updated as readings arrive
+RTC_DATA_ATTR GlucoseStatsState glucoseStatsState;
+GlucoseStats glucoseStats(glucoseStatsState);
+RTC_DATA_ATTR GlucosePredictorState glucosePredictorState;
+GlucosePredictor glucosePredictor(glucosePredictorState);
+
+// Versioned snapshot of everything a wake can reuse; restored into warmState at boot
+RTC_DATA_ATTR uint8_t warmSnapshot[WarmState::MAX_SNAPSHOT_SIZE];
+WarmState warmState;
+WarmStartPlan warmPlan{};
+TimeKeeper timeKeeper(warmState.time);
+int64_t msBeforeSync = 0;
+uint32_t millisBeforeSync = 0;
+
+auto appClock = std::make_shared<ArduinoClock>();
+EventScheduler scheduler(appClock);
+std::shared_ptr<ESP32WifiDriver> wifiDriver;
+std::shared_ptr<DnsCache> dnsCache;
+std::unique_ptr<WifiConnector> wifiConnector;
+TaskHandle_t netTaskHandle = nullptr;
+// Fetches run on core 0 next to the WiFi stack; readings are rendered on core 1
+ReadingPipeline readingPipeline;
+time_t latestReadingAt = 0;
+std::shared_ptr<SecureHttpClient> httpClient;
+std::shared_ptr<JsonGlucoseReadingParser> glucoseParser;
+std::unique_ptr<DexcomClient> dexcomClient;
+std::shared_ptr<I2cBusManager> i2cBus; // shared by the sensor drivers on both cores
+std::unique_ptr<Vcnl4040> proximity;
+std::unique_ptr<Bme280> climate;
+std::unique_ptr<LedFader> nightLight;
+
+void wakeNetTask()
+{
+  if (netTaskHandle)
   {
-    ; // wait for serial port to connect
+    xTaskNotifyGive(netTaskHandle);
   }
 }
 
+void setupSerial()
+{
+  // No wait for a host: the ESP32 UART is ready as soon as it is configured
+  Serial.begin(115200);
+  DeferredLog::instance().start();
+}
+
+time_t wallClock()
+{
+  time_t now = time(nullptr);
+  return now > MIN_VALID_EPOCH ? now : 0;
+}
+
 void WiFiEventHandler(WiFiEvent_t event)
 {
   switch (event)
   {
-  case SYSTEM_EVENT_STA_GOT_IP:
-    Serial.println("WiFi connected");
-    Serial.print("IP address: ");
-    Serial.println(WiFi.localIP());
+  case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+  case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+  case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+    scheduler.post(AppEvent::WIFI_POLL); // let the connector react without waiting for its timer
+    break;
+  default:
+    break;
+  }
+}
+
+void startWiFi()
+{
+  LOG_INFO("Connecting to WiFi...");
+  wifiConnector->start(wallClock());
+  scheduler.post(AppEvent::WIFI_POLL);
+}
+
+void pollWiFi()
+{
+  if (wifiConnector->state() == WifiConnector::State::Connected && wifiDriver->status() == WifiLinkStatus::Failed)
+  {
+    LOG_WARN("WiFi lost connection");
+    scheduler.clear(AppEvent::WIFI_UP);
+    wifiConnector->start(wallClock());
+  }
+
+  switch (wifiConnector->poll())
+  {
+  case WifiConnector::State::Connected:
+    if (!scheduler.isSet(AppEvent::WIFI_UP))
+    {
+      const auto &report = wifiConnector->report();
+      LOG_INFO("WiFi connected via %s in %lu ms, IP address: %s", WifiConnector::pathName(report.path),
+               static_cast<unsigned long>(report.totalMs), WiFi.localIP().toString().c_str());
+      scheduler.post(AppEvent::WIFI_UP);
+    }
     break;
-  case SYSTEM_EVENT_STA_DISCONNECTED:
-    Serial.println("WiFi lost connection");
-    WiFi.reconnect();
+  case WifiConnector::State::Failed:
+    LOG_WARN("WiFi connect failed, retrying later");
+    scheduler.postAfter(AppEvent::WIFI_WANTED, WIFI_RETRY_MS);
     break;
   default:
+    scheduler.postAfter(AppEvent::WIFI_POLL, WifiConnector::POLL_INTERVAL_MS);
     break;
   }
 }
 
-void connectToWiFi()
+int64_t nowMs()
 {
-  Serial.println("Connecting to WiFi...");
-  WiFi.onEvent(WiFiEventHandler);
-  WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-  while (WiFi.status() != WL_CONNECTED)
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return static_cast<int64_t>(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
+}
+
+void adjustClockMs(int32_t deltaMs)
+{
+  int64_t target = nowMs() + deltaMs;
+  struct timeval tv = {static_cast<time_t>(target / 1000), static_cast<suseconds_t>((target % 1000) * 1000)};
+  settimeofday(&tv, nullptr);
+}
+
+void onTimeSynced(struct timeval *tv)
+{
+  if (tv != nullptr)
   {
-    delay(1000);
-    Serial.print(".");
+    // How far the RTC had drifted from NTP time since the sync started
+    int64_t expectedMs = msBeforeSync + (millis() - millisBeforeSync);
+    int64_t actualMs = static_cast<int64_t>(tv->tv_sec) * 1000 + tv->tv_usec / 1000;
+    bool offsetKnown = msBeforeSync > static_cast<int64_t>(MIN_VALID_EPOCH) * 1000;
+    timeKeeper.onNtpSync(tv->tv_sec, static_cast<int32_t>(actualMs - expectedMs), offsetKnown);
+    LOG_INFO("NTP sync, RTC drift %ld ppm", static_cast<long>(timeKeeper.state().driftPpm));
   }
-  Serial.println("\nConnected to WiFi");
-  Serial.print("IP Address: ");
-  Serial.println(WiFi.localIP());
-  Serial.print("DNS server: ");
-  Serial.println(WiFi.dnsIP());
+  scheduler.post(AppEvent::TIME_SYNCED);
 }
 
-void syncTime()
+void startTimeSync()
 {
-  Serial.println("Syncing time...");
+  LOG_INFO("Syncing time...");
+  msBeforeSync = nowMs();
+  millisBeforeSync = millis();
+  sntp_set_time_sync_notification_cb(onTimeSynced);
   configTime(0, 0, "pool.ntp.org", "time.nist.gov");
-  Serial.print("Waiting for NTP time sync: ");
-  time_t now = time(nullptr);
-  while (now < 8 * 3600 * 2)
+}
+
+void createDexcomClient()
+{
+  if (!httpClient)
+  {
+    auto secureClient = std::make_shared<ESP32SecureClient>();
+    secureClient->setCACert(DexcomConst::rootCA);
+    secureClient->setTimeout(30000); // 30 seconds timeout
+    secureClient->setDnsCache(dnsCache);
+
+    httpClient = std::make_shared<SecureHttpClient>(secureClient, appClock);
+    glucoseParser = std::make_shared<JsonGlucoseReadingParser>(std::make_shared<ArduinoJsonParser>());
+  }
+
+  LOG_DEBUG("Creating DexcomClient...");
+  try
   {
-    delay(500);
-    Serial.print(".");
-    now = time(nullptr);
+    const char *cachedSession = warmPlan.reuseSession ? warmState.sessionId : "";
+    warmPlan.reuseSession = false; // only worth trying once
+    dexcomClient = std::make_unique<DexcomClient>(httpClient, glucoseParser,
+                                                  DEXCOM_USERNAME, DEXCOM_ACCOUNT_ID, DEXCOM_PASSWORD, true,
+                                                  cachedSession);
+    LOG_INFO("DexcomClient created successfully");
+    scheduler.post(AppEvent::CLIENT_READY);
   }
-  Serial.println("");
-  struct tm timeinfo;
-  gmtime_r(&now, &timeinfo);
-  Serial.print("Current time: ");
-  Serial.println(asctime(&timeinfo));
+  catch (const std::exception &e)
+  {
+    LOG_ERROR("Error initializing DexcomClient: %s", e.what());
+    scheduler.postAfter(AppEvent::CLIENT_WANTED, CLIENT_RETRY_MS);
+  }
+}
+
+void printPhaseLine(const char *line, size_t length)
+{
+  Serial.write(reinterpret_cast<const uint8_t *>(line), length);
+  Serial.println();
 }
 
-void resolveDexcomHost()
+/// Phase lines are longer than a deferred record's strings, so they go out directly with the ring flushed.
+void dumpPhaseTimings()
 {
-  IPAddress ip;
-  if (WiFi.hostByName(DexcomConst::DEXCOM_BASE_URL_OUS, ip))
+  DeferredLog::instance().stop();
+  PhaseTiming::dump(printPhaseLine);
+  DeferredLog::instance().start();
+}
+
+void saveWarmState()
+{
+  if (dexcomClient && dexcomClient->sessionId() != warmState.sessionId)
   {
-    Serial.print(DexcomConst::DEXCOM_BASE_URL_OUS);
-    Serial.print(" resolved to: ");
-    Serial.println(ip);
+    warmState.setSession(dexcomClient->sessionId().c_str(), time(nullptr));
   }
-  else
+  if (warmState.save(warmSnapshot, sizeof(warmSnapshot)) == 0)
+  {
+    std::memset(warmSnapshot, 0, sizeof(warmSnapshot));
+  }
+}
+
+void lightSleepMs(uint32_t ms)
+{
+  if (ms == 0)
+  {
+    return;
+  }
+  // LEDC runs from the RTC 8 MHz clock, so fades carry on while the CPU sleeps
+  esp_sleep_pd_config(ESP_PD_DOMAIN_RTC8M, ESP_PD_OPTION_ON);
+  esp_sleep_enable_timer_wakeup(static_cast<uint64_t>(ms) * 1000ULL);
+  esp_light_sleep_start();
+}
+
+void showNightLight(const GlucoseReading &reading)
+{
+  if (nightLight)
+  {
+    nightLight->show(reading.getMgDl(), reading.getTrend(), NIGHT_BRIGHTNESS, LED_FADE_MS);
+  }
+}
+
+/// Newest reading kept in RTC memory; timestamp 0 if there is none.
+GlucoseReading newestStoredReading()
+{
+  GlucoseReading newest(0, DexcomConst::None, 0);
+  for (const GlucoseReading &reading : warmState.historyReadings()) // oldest first
+  {
+    newest = reading;
+  }
+  return newest;
+}
+
+/// Lights the LED with the newest reading kept in RTC memory.
+void showStoredReading()
+{
+  showNightLight(newestStoredReading());
+}
+
+/// Keeps a lit LED on for a while, then fades it out; the CPU light-sleeps throughout.
+void holdNightLight()
+{
+  if (nightLight && nightLight->lit())
+  {
+    lightSleepMs(LED_FADE_MS + LED_HOLD_MS);
+    lightSleepMs(nightLight->off(LED_FADE_MS));
+  }
+}
+
+void onProximityEvent(Vcnl4040::Event event)
+{
+  if (event == Vcnl4040::Event::Approach)
+  {
+    LOG_INFO("Proximity: approach");
+    showStoredReading();
+  }
+  else if (event == Vcnl4040::Event::Leave)
   {
-    Serial.print("DNS lookup failed for ");
-    Serial.println(DexcomConst::DEXCOM_BASE_URL_OUS);
+    LOG_INFO("Proximity: leave");
   }
 }
 
-void fetchAndPrintGlucoseReading(DexcomClient &dexcomClient)
+void setupProximity(esp_sleep_wakeup_cause_t cause)
 {
+  proximity = std::make_unique<Vcnl4040>(i2cBus);
+  if (cause == ESP_SLEEP_WAKEUP_UNDEFINED || proximityState == 0)
+  {
+    if (!proximity->begin())
+    {
+      LOG_WARN("VCNL4040 not found, proximity wake disabled");
+      proximity.reset();
+    }
+    return;
+  }
+  // The sensor kept measuring through deep sleep; no need to reprogram it
+  proximity->resume(proximityState == 2 ? Vcnl4040::Proximity::Near : Vcnl4040::Proximity::Far);
+  if (cause == ESP_SLEEP_WAKEUP_EXT0)
+  {
+    onProximityEvent(proximity->handleInterrupt());
+  }
+}
+
+void startClimateSample(esp_sleep_wakeup_cause_t cause)
+{
+  if (cause == ESP_SLEEP_WAKEUP_UNDEFINED)
+  {
+    climateCalibration.clear();
+  }
+  climate = std::make_unique<Bme280>(i2cBus, climateCalibration);
+  if (!climate->begin() || !climate->startMeasurement())
+  {
+    LOG_WARN("BME280 not available");
+    climate.reset();
+    return;
+  }
+  // The conversion runs while WiFi comes up
+  scheduler.postAfter(AppEvent::CLIMATE_READY, (Bme280::MEASUREMENT_TIME_US + 999) / 1000);
+}
+
+void readClimate()
+{
+  Bme280Reading reading;
+  if (!climate || !climate->read(reading))
+  {
+    LOG_WARN("BME280 read failed");
+    return;
+  }
+  // Sign printed on its own so -0.50 C does not lose it to the integer division
+  const unsigned long centiC = static_cast<unsigned long>(abs(reading.temperature));
+  LOG_INFO("Climate: %s%lu.%02lu C, %lu Pa, %lu.%01lu %%RH", reading.temperature < 0 ? "-" : "", centiC / 100,
+           centiC % 100, static_cast<unsigned long>(reading.pressure >> 8),
+           static_cast<unsigned long>(reading.humidity >> 10),
+           static_cast<unsigned long>((reading.humidity & 0x3FF) * 10 >> 10));
+}
+
+void armProximityWake()
+{
+  if (!proximity)
+  {
+    proximityState = 0;
+    return;
+  }
+  if (digitalRead(PROXIMITY_INT_PIN) == LOW)
+  {
+    onProximityEvent(proximity->handleInterrupt()); // handle it now rather than waking straight back up
+  }
+  proximityState = proximity->state() == Vcnl4040::Proximity::Near ? 2 : 1;
+  rtc_gpio_pullup_en(PROXIMITY_INT_PIN);
+  esp_sleep_enable_ext0_wakeup(PROXIMITY_INT_PIN, 0);
+}
+
+void sleepUntilNextReading(uint32_t seconds)
+{
+  LOG_INFO("Next fetch in %lu s", static_cast<unsigned long>(seconds));
+  saveWarmState();
+  nextFetchAt = time(nullptr) + seconds;
+#ifdef DISABLE_DEEP_SLEEP
+  scheduler.postAfter(AppEvent::READING_DUE, seconds * 1000);
+  scheduler.postAfter(AppEvent::WAKE_DEADLINE, seconds * 1000 + WAKE_DEADLINE_MS);
+#else
+  holdNightLight();
+  armProximityWake();
+  DeferredLog::instance().stop(); // flush queued log lines before RAM is lost
+  Serial.flush();
+  // The night light may have held the CPU for several seconds; keep the planned fetch time
+  const time_t now = time(nullptr);
+  const uint64_t remainingS = nextFetchAt > now ? static_cast<uint64_t>(nextFetchAt - now) : 1;
+  esp_sleep_enable_timer_wakeup(remainingS * 1000000ULL);
+  esp_deep_sleep_start();
+#endif
+}
+
+void checkServerDate()
+{
+  if (!httpClient)
+  {
+    return;
+  }
+  // Free cross-check of the RTC against the Share server's clock, as of when the Date arrived
+  time_t serverTime = HttpDate::parse(httpClient->lastDateHeader().c_str());
+  const uint32_t sinceDateMs = appClock->millis() - httpClient->lastDateReceivedMs();
+  TimeKeeper::DateCheck check = timeKeeper.onHttpDate(serverTime, nowMs() - sinceDateMs);
+  if (check.stepMs != 0)
+  {
+    LOG_WARN("Clock off by %ld ms per server Date, stepping", static_cast<long>(check.stepMs));
+    adjustClockMs(check.stepMs);
+  }
+}
+
+void fetchGlucoseReadings()
+{
+  scheduler.cancelTimer(AppEvent::WAKE_DEADLINE); // the wake now ends once the batch is rendered
+  ReadingBatch batch;
   try
   {
-    auto reading = dexcomClient.getLatestGlucoseReading();
-    if (reading)
+    // Only the window not already cached from earlier wakes
+    uint16_t minutes = warmState.plan(time(nullptr), true).fetchMinutes;
+    batch.readings = dexcomClient->getGlucoseReadings(minutes, DexcomConst::MAX_MAX_COUNT);
+    batch.ok = true;
+    warmState.mergeHistory(batch.readings);
+    latestReadingAt = batch.readings.empty() ? 0 : batch.readings.front().getTimestamp(); // newest first
+  }
+  catch (const DexcomError &e)
+  {
+    LOG_ERROR("Error: %s", e.what());
+    latestReadingAt = 0;
+  }
+  if (!readingPipeline.publish(std::move(batch)))
+  {
+    scheduler.post(AppEvent::RENDERED); // render task is stuck; do not hold the wake open for it
+  }
+  checkServerDate();
+}
+
+void renderReadings(ReadingBatch &batch)
+{
+  if (!batch.ok)
+  {
+    LOG_WARN("Fetch failed, keeping the last screen");
+  }
+  else
+  {
+    // Only the window since the last cached reading is fetched, so an empty batch just
+    // means nothing new yet; the newest reading from earlier wakes still stands
+    const GlucoseReading reading = batch.readings.empty() ? newestStoredReading() : batch.readings.front();
+    if (batch.readings.empty())
     {
-      Serial.print("Last glucose reading: ");
-      Serial.print(reading->getMmolL());
-      Serial.println(" mmol/L");
+      LOG_INFO("No new reading since the last fetch");
     }
     else
     {
-      Serial.println("No current reading available");
+      LOG_INFO("Last glucose reading: %.1f mmol/L", reading.getMmolL());
+    }
+    glucoseStats.addAll(batch.readings);
+    const GlucoseAlert alert = glucosePredictor.addAll(batch.readings, time(nullptr));
+    const GlucosePrediction outlook = glucosePredictor.predict();
+    if (outlook.valid)
+    {
+      LOG_INFO("Projected: %u mg/dL in 15 min, %u in 30 min", outlook.in15, outlook.in30);
+    }
+    if (alert != GlucoseAlert::None)
+    {
+      LOG_WARN("Alert: %s predicted", alert == GlucoseAlert::PredictedLow ? "low" : "high");
+    }
+    glucoseStats.evict(time(nullptr));
+    const GlucoseSummary stats = glucoseStats.summary();
+    // Two lines: a deferred record holds at most DeferredLog::MAX_ARGS arguments
+    LOG_INFO("24 h: %u readings, mean %u.%u mg/dL, CV %u.%u%%", stats.count, stats.meanTenths / 10,
+             stats.meanTenths % 10, stats.cvPermille / 10, stats.cvPermille % 10);
+    LOG_INFO("24 h: GMI %u.%02u%%, TIR %u.%u%%", stats.gmiHundredths / 100, stats.gmiHundredths % 100,
+             stats.timeInRangePermille() / 10, stats.timeInRangePermille() % 10);
+    if (reading.getTimestamp() == 0)
+    {
+      LOG_INFO("No current reading available");
+    }
+    else if (proximity && proximity->state() == Vcnl4040::Proximity::Near)
+    {
+      showNightLight(reading);
     }
   }
-  catch (const DexcomError &e)
+  scheduler.post(AppEvent::RENDERED);
+}
+
+void finishWake()
+{
+  dumpPhaseTimings();
+  LOG_INFO("Free heap: %lu", static_cast<unsigned long>(ESP.getFreeHeap()));
+  sleepUntilNextReading(wakePlanner.onWake(time(nullptr), latestReadingAt));
+}
+
+void abandonWake()
+{
+  LOG_WARN("No fetch before the wake deadline, sleeping until the next retry");
+  dumpPhaseTimings();
+  sleepUntilNextReading(wakePlanner.onWake(time(nullptr), 0));
+}
+
+void runScheduler(ReadingPipeline &pipeline)
+{
+  netTaskHandle = xTaskGetCurrentTaskHandle();
+  scheduler.setWakeHook(wakeNetTask);
+  while (pipeline.running())
   {
-    Serial.print("Error: ");
-    Serial.println(e.what());
+    uint32_t waitMs = scheduler.runOnce();
+    TickType_t ticks = waitMs == EventScheduler::NO_DEADLINE ? portMAX_DELAY : pdMS_TO_TICKS(waitMs);
+    // Sleep until the next timer or until a callback posts an event
+    ulTaskNotifyTake(pdTRUE, ticks);
   }
 }
 
@@ -115,56 +546,79 @@ void setup()
 {
   setupSerial();
 
-  connectToWiFi();
-
-  syncTime();
-
-  resolveDexcomHost();
-
-  auto secureClient = std::make_shared<ESP32SecureClient>();
-  secureClient->setCACert(DexcomConst::rootCA);
-  secureClient->setTimeout(30000); // 30 seconds timeout
-
-  auto httpClient = std::make_shared<SecureHttpClient>(secureClient);
-  
-  // Create the parser components
-  auto jsonParser = std::make_shared<ArduinoJsonParser>();
-  auto glucoseParser = std::make_shared<JsonGlucoseReadingParser>(jsonParser);
+  const esp_sleep_wakeup_cause_t wakeCause = esp_sleep_get_wakeup_cause();
+  if (wakeCause == ESP_SLEEP_WAKEUP_UNDEFINED)
+  {
+    wakePlanner.reset(); // Cold boot: RTC memory holds garbage
+    glucoseStats.clear();
+    glucosePredictor.clear();
+  }
+  else if (!warmState.load(warmSnapshot, sizeof(warmSnapshot)))
+  {
+    LOG_INFO("No usable warm state, cold start");
+  }
+  const bool clockValid = time(nullptr) > MIN_VALID_EPOCH;
+  if (clockValid)
+  {
+    // Correct for the drift measured between earlier NTP syncs
+    int32_t correctionMs = timeKeeper.pendingCorrectionMs(time(nullptr));
+    if (correctionMs != 0)
+    {
+      adjustClockMs(correctionMs);
+      timeKeeper.noteCorrection(correctionMs);
+    }
+  }
+  nightLight = std::make_unique<LedFader>(std::make_shared<Esp32LedPwm>(LED_PINS));
+  Wire.begin();
+  i2cBus = std::make_shared<I2cBusManager>(std::make_shared<ArduinoI2cBus>(Wire));
+  i2cBus->enableBursts(Bme280::ADDRESS);
+  setupProximity(wakeCause);
+  if (wakeCause == ESP_SLEEP_WAKEUP_EXT0 && clockValid && time(nullptr) + MIN_RESLEEP_S < nextFetchAt)
+  {
+    // Woken only by the proximity sensor: nothing to fetch yet, so no WiFi either
+    sleepUntilNextReading(static_cast<uint32_t>(nextFetchAt - time(nullptr)));
+    return;
+  }
+  warmPlan = warmState.plan(time(nullptr), clockValid);
 
-  Serial.println("Creating DexcomClient...");
-  
-  try {
-    DexcomClient dexcomClient(httpClient, glucoseParser, 
-                             DEXCOM_USERNAME, DEXCOM_ACCOUNT_ID, DEXCOM_PASSWORD, true);
-    Serial.println("DexcomClient created successfully");
+  wifiDriver = std::make_shared<ESP32WifiDriver>(WIFI_SSID, WIFI_PASSWORD);
+  wifiConnector = std::make_unique<WifiConnector>(wifiDriver, appClock, warmState.wifi);
+  WiFi.onEvent(WiFiEventHandler);
+  // The Share host is resolved on the first TLS connect and then served from RTC memory
+  dnsCache = std::make_shared<DnsCache>(std::make_shared<ESP32DnsResolver>(), warmState.dns);
+  scheduler.addTask("wifi_start", AppEvent::WIFI_WANTED, startWiFi, AppEvent::WIFI_WANTED);
+  scheduler.addTask("wifi_poll", AppEvent::WIFI_POLL, pollWiFi, AppEvent::WIFI_POLL);
 
-    Serial.println("Attempting to fetch glucose reading...");
-    fetchAndPrintGlucoseReading(dexcomClient);
-    Serial.println("Fetch attempt completed");
+  // Only sync when the drift-based error estimate says the RTC can no longer be trusted
+  if (timeKeeper.needsSync(clockValid ? time(nullptr) : 0))
+  {
+    scheduler.addTask("time_sync", AppEvent::WIFI_UP, startTimeSync, 0, true);
   }
-  catch (const DexcomError &e) {
-    Serial.print("Error initializing DexcomClient: ");
-    Serial.println(e.what());
-    // Stay in error state
-    while (true) {
-      delay(1000);
-      Serial.println("Fatal initialization error, system halted");
-    }
+  // TLS certificate validation needs a valid clock
+  scheduler.addTask("dexcom_client", AppEvent::WIFI_UP | AppEvent::TIME_SYNCED | AppEvent::CLIENT_WANTED,
+                    createDexcomClient, AppEvent::CLIENT_WANTED);
+  scheduler.addTask("fetch", AppEvent::WIFI_UP | AppEvent::CLIENT_READY | AppEvent::READING_DUE,
+                    fetchGlucoseReadings, AppEvent::READING_DUE);
+  scheduler.addTask("finish", AppEvent::RENDERED, finishWake, AppEvent::RENDERED);
+  scheduler.addTask("deadline", AppEvent::WAKE_DEADLINE, abandonWake, AppEvent::WAKE_DEADLINE);
+  scheduler.addTask("climate", AppEvent::CLIMATE_READY, readClimate, 0, true);
+  startClimateSample(wakeCause);
+
+  if (clockValid)
+  {
+    scheduler.post(AppEvent::TIME_SYNCED); // RTC kept time across a soft reset
   }
-  catch (const std::exception &e) {
-    Serial.print("Unexpected error: ");
-    Serial.println(e.what());
-    // Stay in error state
-    while (true) {
-      delay(1000);
-      Serial.println("Fatal system error, system halted");
-    }
+  scheduler.post(AppEvent::WIFI_WANTED | AppEvent::CLIENT_WANTED | AppEvent::READING_DUE);
+  scheduler.postAfter(AppEvent::WAKE_DEADLINE, WAKE_DEADLINE_MS);
+
+  if (!readingPipeline.start(runScheduler, renderReadings))
+  {
+    LOG_ERROR("Could not start the fetch/render tasks");
   }
 }
 
 void loop()
 {
-  // Main loop code (if needed)
-  delay(10000); // Wait for 10 seconds
-  Serial.printf("Free heap in loop: %d\n", ESP.getFreeHeap());
+  // All work happens on the pipeline's pinned tasks
+  vTaskDelete(nullptr);
 }
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include "deferred_log.h"
+
+namespace {
+void discardSink(const char*, size_t) {}
+}
+
+/**
+ * Measures the producer-side cost of a deferred log call against formatting the
+ * same line synchronously with snprintf (which is the floor for a direct printf).
+ */
+TEST(DeferredLogBench, OverheadPerCall) {
+    constexpr int ITERATIONS = 200000;
+    DeferredLog log(discardSink);
+    const char* endpoint = "Publisher/ReadPublisherLatestGlucoseValues";
+
+    double deferredNs = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        log.write("[D][dexcom] Sending request to %s (%d)\n", endpoint, i);
+        if (log.pending() == DeferredLog::CAPACITY) {
+            auto pause = std::chrono::steady_clock::now();
+            log.drain();
+            start += std::chrono::steady_clock::now() - pause; // exclude consumer work
+        }
+    }
+    deferredNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    char line[DeferredLog::MAX_LINE_LENGTH];
+    int sink = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        sink += std::snprintf(line, sizeof(line), "[D][dexcom] Sending request to %s (%d)\n", endpoint, i);
+    }
+    double syncNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    printf("[bench] deferred log: %.1f ns/call producer side, snprintf %.1f ns/call (%d), dropped %u\n",
+           deferredNs / ITERATIONS, syncNs / ITERATIONS, sink > 0, log.dropped());
+    EXPECT_EQ(0u, log.dropped());
+}
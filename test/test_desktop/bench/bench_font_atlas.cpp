@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include "font_atlas.h"
+
+/**
+ * Draws glucose values and trend arrows across the panel straight from the RLE atlases
+ * and reports glyph throughput alongside the flash footprint of the atlases.
+ */
+TEST(FontAtlasBench, GlyphsPerMillisecond) {
+    constexpr int ITERATIONS = 2000;
+    auto fb = std::make_unique<Framebuffer>();
+    const char* values[] = {"104", "187", "52", "9.6", "13.2", "399"};
+
+    size_t glyphs = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        const int16_t x = static_cast<int16_t>((i * 37) % 600);
+        const int16_t y = static_cast<int16_t>(80 + (i * 53) % 380);
+        const char* value = values[i % 6];
+        const int16_t end = TextRenderer::drawText(*fb, Fonts::VALUE, x, y, value, Framebuffer::Color::Black);
+        TextRenderer::drawText(*fb, Fonts::ARROWS, end, y, "\xE2\x86\x98", Framebuffer::Color::Black);
+        for (const char* p = value; *p != '\0'; ++p) {
+            ++glyphs;
+        }
+        ++glyphs;
+        fb->dirty().clear();
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    size_t flash = 0;
+    for (const FontAtlas* atlas : {&Fonts::VALUE, &Fonts::ARROWS}) {
+        const FontGlyph& last = atlas->glyphs[atlas->glyphCount - 1];
+        flash += atlas->glyphCount * sizeof(FontGlyph) + last.offset + static_cast<size_t>(last.width) * last.height / 8;
+    }
+    printf("[bench] font atlas: %zu glyphs in %.2f ms (%.0f glyphs/ms), atlases ~%zu bytes of flash\n",
+           glyphs, ms, glyphs / ms, flash);
+    EXPECT_GT(glyphs, 0u);
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include "framebuffer.h"
+
+/**
+ * Fills and blits across the panel at byte-aligned and unaligned offsets and reports
+ * pixel throughput for each path.
+ */
+TEST(FramebufferBench, FillAndBlitThroughput) {
+    constexpr int ITERATIONS = 200;
+    Framebuffer fb;
+    uint8_t sprite[64 * 48 / 8];
+    for (size_t i = 0; i < sizeof(sprite); ++i) {
+        sprite[i] = static_cast<uint8_t>(i * 37);
+    }
+
+    auto rate = [](double pixels, std::chrono::steady_clock::duration elapsed) {
+        return pixels / std::chrono::duration<double>(elapsed).count() / 1e6;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        fb.fillRect(Rect{static_cast<int16_t>(i & 7), 0, 790, 480},
+                    (i & 1) ? Framebuffer::Color::Black : Framebuffer::Color::White);
+    }
+    const double fillRate = rate(790.0 * 480 * ITERATIONS, std::chrono::steady_clock::now() - start);
+
+    uint64_t blitted = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        for (int16_t y = 0; y + 48 <= 480; y += 48) {
+            for (int16_t x = 0; x + 64 <= 800; x += 64) {
+                fb.blit(sprite, 8, 0, Rect{x, y, 64, 48}, Framebuffer::BlitMode::Copy);
+                blitted += 64 * 48;
+            }
+        }
+    }
+    const double alignedRate = rate(static_cast<double>(blitted), std::chrono::steady_clock::now() - start);
+
+    blitted = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        for (int16_t y = 0; y + 48 <= 480; y += 48) {
+            for (int16_t x = 3; x + 64 <= 800; x += 64) {
+                fb.blit(sprite, 8, 1, Rect{x, y, 63, 48}, Framebuffer::BlitMode::Set);
+                blitted += 63 * 48;
+            }
+        }
+    }
+    const double unalignedRate = rate(static_cast<double>(blitted), std::chrono::steady_clock::now() - start);
+
+    printf("[bench] framebuffer: fillRect %.0f Mpx/s, aligned blit %.0f Mpx/s, unaligned blit %.0f Mpx/s (%zu dirty)\n",
+           fillRate, alignedRate, unalignedRate, fb.dirty().count());
+    EXPECT_GT(fillRate, 0.0);
+}
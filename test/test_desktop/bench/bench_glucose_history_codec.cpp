@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "glucose_history_codec.h"
+#include "glucose_reading.h"
+
+/**
+ * Encodes and decodes a year of synthetic 5-minute readings and reports the
+ * compression ratio against the in-memory GlucoseReading size and the codec throughput.
+ */
+TEST(GlucoseHistoryCodecBench, YearOfSyntheticReadings) {
+    constexpr size_t READINGS_PER_YEAR = 365 * 288;
+    constexpr time_t START = 1609459200;
+
+    std::mt19937 rng(42);
+    std::normal_distribution<double> step(0.0, 2.5);
+    std::uniform_int_distribution<int> jitter(-2, 2);
+    std::uniform_int_distribution<int> gapChance(0, 999);
+
+    std::vector<GlucoseReading> readings;
+    readings.reserve(READINGS_PER_YEAR);
+    double value = 120.0;
+    time_t timestamp = START;
+    for (size_t i = 0; i < READINGS_PER_YEAR; ++i) {
+        value = std::min(400.0, std::max(40.0, value + step(rng)));
+        timestamp += 300 + jitter(rng) + (gapChance(rng) == 0 ? 1800 : 0);
+        auto trend = static_cast<DexcomConst::TrendDirection>(1 + (i / 6) % 7);
+        readings.emplace_back(static_cast<uint16_t>(value), trend, timestamp);
+    }
+
+    std::vector<uint8_t> buffer(GlucoseCodec::maxEncodedSize(readings.size()));
+
+    auto encodeStart = std::chrono::steady_clock::now();
+    GlucoseHistoryEncoder encoder(buffer.data(), buffer.size());
+    for (const auto& r : readings) {
+        ASSERT_TRUE(encoder.append(r));
+    }
+    auto encodeEnd = std::chrono::steady_clock::now();
+
+    uint64_t checksum = 0;
+    size_t decoded = 0;
+    auto decodeStart = std::chrono::steady_clock::now();
+    for (const GlucoseReading& r : GlucoseHistoryDecoder(encoder.data(), encoder.size())) {
+        checksum += r.getValue() + static_cast<uint64_t>(r.getTimestamp());
+        ++decoded;
+    }
+    auto decodeEnd = std::chrono::steady_clock::now();
+    ASSERT_EQ(readings.size(), decoded);
+
+    const double rawBytes = static_cast<double>(readings.size() * sizeof(GlucoseReading));
+    const double encodeSec = std::chrono::duration<double>(encodeEnd - encodeStart).count();
+    const double decodeSec = std::chrono::duration<double>(decodeEnd - decodeStart).count();
+
+    printf("[bench] glucose codec: %zu readings, %zu -> %zu bytes (ratio %.2fx, %.2f B/reading)\n",
+           readings.size(), static_cast<size_t>(rawBytes), encoder.size(),
+           rawBytes / encoder.size(), static_cast<double>(encoder.size()) / readings.size());
+    printf("[bench] glucose codec: encode %.1f MB/s, decode %.1f MB/s (raw reading bytes, checksum %llu)\n",
+           rawBytes / encodeSec / 1e6, rawBytes / decodeSec / 1e6, static_cast<unsigned long long>(checksum));
+
+    EXPECT_LT(encoder.size() * 4, static_cast<size_t>(rawBytes));
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "cgm_day.h"
+#include "glucose_predictor.h"
+
+/**
+ * Reports the update cost and, per fit configuration, the 15 and 30 minute mean
+ * absolute error on the day trace next to the no-change baseline.
+ */
+TEST(GlucosePredictorBench, UpdateCostAndAccuracy) {
+    constexpr size_t DAY = sizeof(CGM_DAY) / sizeof(CGM_DAY[0]);
+    constexpr size_t DAYS = 365;
+    constexpr time_t START = 1700000000;
+
+    std::vector<GlucoseReading> year;
+    year.reserve(DAY * DAYS);
+    for (size_t i = 0; i < DAY * DAYS; ++i) {
+        year.emplace_back(CGM_DAY[i % DAY], DexcomConst::Flat, START + static_cast<time_t>(i) * 300);
+    }
+    GlucosePredictorState state{};
+    GlucosePredictor predictor(state);
+    uint32_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& r : year) {
+        checksum += predictor.update(r).in15;
+    }
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    printf("[bench] glucose predictor: %.1f ns per update over a year of readings (checksum %u)\n", ns / year.size(),
+           checksum);
+
+    auto score = [&](uint8_t points, uint16_t smoothingQ8, const char* name) {
+        GlucosePredictorState s{};
+        GlucosePredictor p(s, GlucosePredictor::DEFAULT_LOW, GlucosePredictor::DEFAULT_HIGH,
+                           GlucosePredictor::DEFAULT_LOOKAHEAD_MIN, points, smoothingQ8);
+        long error15 = 0, error30 = 0;
+        int n = 0;
+        for (size_t i = 0; i < DAY; ++i) {
+            const GlucosePrediction pr = p.update(year[i]);
+            if (pr.valid && i + 6 < DAY) {
+                error15 += std::abs(static_cast<int>(pr.in15) - CGM_DAY[i + 3]);
+                error30 += std::abs(static_cast<int>(pr.in30) - CGM_DAY[i + 6]);
+                ++n;
+            }
+        }
+        printf("[bench] glucose predictor: %-22s MAE %5.1f mg/dL at 15 min, %5.1f at 30 min\n", name,
+               static_cast<double>(error15) / n, static_cast<double>(error30) / n);
+    };
+    long base15 = 0, base30 = 0;
+    for (size_t i = 0; i + 6 < DAY; ++i) {
+        base15 += std::abs(static_cast<int>(CGM_DAY[i]) - CGM_DAY[i + 3]);
+        base30 += std::abs(static_cast<int>(CGM_DAY[i]) - CGM_DAY[i + 6]);
+    }
+    printf("[bench] glucose predictor: %-22s MAE %5.1f mg/dL at 15 min, %5.1f at 30 min\n", "no change:",
+           static_cast<double>(base15) / (DAY - 6), static_cast<double>(base30) / (DAY - 6));
+    score(3, 256, "3 points:");
+    score(4, 256, "4 points (default):");
+    score(6, 256, "6 points:");
+    score(4, 128, "4 points, EMA 0.5:");
+    EXPECT_GT(checksum, 0u);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <memory>
+#include "bme280.h"
+#include "fake_i2c_bus.h"
+#include "i2c_bus_manager.h"
+#include "timed_i2c_bus.h"
+#include "vcnl4040.h"
+
+namespace {
+
+void populate(FakeI2cBus& sim) {
+    auto& vcnl = sim.device(Vcnl4040::ADDRESS);
+    vcnl[Vcnl4040::REG_ID] = Vcnl4040::DEVICE_ID & 0xFF;
+    vcnl[Vcnl4040::REG_ID + 1] = Vcnl4040::DEVICE_ID >> 8;
+    vcnl[Vcnl4040::REG_INT_FLAG + 1] = Vcnl4040::FLAG_PS_CLOSE >> 8;
+    auto& bme = sim.device(Bme280::ADDRESS);
+    bme[Bme280::REG_ID] = Bme280::CHIP_ID;
+    for (int i = 0; i < 8; ++i) {
+        bme[Bme280::REG_DATA + i] = static_cast<uint8_t>(0x40 + i);
+    }
+}
+
+struct Occupancy {
+    uint32_t transactions;
+    uint32_t standardUs;
+    uint32_t fastUs;
+};
+
+/**
+ * Runs one proximity-wake cycle (INT flag, BME280 ID check, trigger, status poll and
+ * result read) against the simulator at 100 kHz and 400 kHz.
+ */
+template <typename Cycle>
+Occupancy measure(Cycle cycle) {
+    Occupancy result{};
+    for (uint32_t hz : {TimedI2cBus::STANDARD_HZ, TimedI2cBus::FAST_HZ}) {
+        auto sim = std::make_shared<FakeI2cBus>();
+        populate(*sim);
+        auto timed = std::make_shared<TimedI2cBus>(sim, hz);
+        cycle(timed);
+        result.transactions = timed->transactions();
+        (hz == TimedI2cBus::STANDARD_HZ ? result.standardUs : result.fastUs) = timed->busTimeUs();
+    }
+    return result;
+}
+
+void report(const char* name, const Occupancy& o) {
+    printf("[bench] i2c wake cycle, %-26s %2u transactions, %5u us at 100 kHz, %4u us at 400 kHz\n", name,
+           o.transactions, o.standardUs, o.fastUs);
+}
+
+}  // namespace
+
+TEST(I2cBusBench, OccupancyPerWakeCycle) {
+    // A driver that addresses every register on its own, one transaction each
+    const Occupancy naive = measure([](std::shared_ptr<TimedI2cBus> bus) {
+        uint8_t value;
+        uint8_t reg = Vcnl4040::REG_INT_FLAG;
+        bus->writeRead(Vcnl4040::ADDRESS, &reg, 1, &value, 1);
+        bus->writeRead(Vcnl4040::ADDRESS, &reg, 1, &value, 1);
+        reg = Bme280::REG_ID;
+        bus->writeRead(Bme280::ADDRESS, &reg, 1, &value, 1);
+        const uint8_t trigger[] = {Bme280::REG_CTRL_MEAS, Bme280::CTRL_MEAS_FORCED};
+        bus->write(Bme280::ADDRESS, trigger, sizeof(trigger));
+        reg = Bme280::REG_STATUS;
+        bus->writeRead(Bme280::ADDRESS, &reg, 1, &value, 1);
+        for (uint8_t i = 0; i < Bme280::DATA_LENGTH; ++i) {
+            reg = static_cast<uint8_t>(Bme280::REG_DATA + i);
+            bus->writeRead(Bme280::ADDRESS, &reg, 1, &value, 1);
+        }
+    });
+
+    // The drivers as written, each call or batch run one transaction per operation
+    const Occupancy drivers = measure([](std::shared_ptr<TimedI2cBus> bus) {
+        auto manager = std::make_shared<I2cBusManager>(bus);
+        Vcnl4040 proximity(manager);
+        proximity.resume(Vcnl4040::Proximity::Near);  // flag says close: no edge change to write
+        proximity.handleInterrupt();
+        Bme280Calibration calibration{};
+        calibration.magic = Bme280Calibration::MAGIC;
+        Bme280 climate(manager, calibration);
+        climate.begin();
+        climate.startMeasurement();
+        Bme280Reading reading;
+        climate.read(reading);
+    });
+
+    // Bursts enabled for the BME280, as main.cpp does: status and results in one read
+    const Occupancy batched = measure([](std::shared_ptr<TimedI2cBus> bus) {
+        auto manager = std::make_shared<I2cBusManager>(bus);
+        manager->enableBursts(Bme280::ADDRESS);
+        Vcnl4040 proximity(manager);
+        proximity.resume(Vcnl4040::Proximity::Near);
+        proximity.handleInterrupt();
+        Bme280Calibration calibration{};
+        calibration.magic = Bme280Calibration::MAGIC;
+        Bme280 climate(manager, calibration);
+        climate.begin();
+        climate.startMeasurement();
+        Bme280Reading reading;
+        climate.read(reading);
+    });
+
+    report("per-register:", naive);
+    report("drivers:", drivers);
+    report("drivers + BME280 bursts:", batched);
+    EXPECT_LT(drivers.standardUs, naive.standardUs);
+    EXPECT_LT(batched.transactions, drivers.transactions);
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "reading_pipeline.h"
+
+/**
+ * Publishes a day of readings per batch at a steady rate and reports the latency from
+ * publish() on the producer thread to the consumer callback, plus raw batch throughput.
+ */
+TEST(ReadingPipelineBench, EndToEndLatency) {
+    constexpr uint32_t PACED = 2000;
+    constexpr uint32_t BURST = 50000;
+    ReadingPipeline pipeline;
+    std::vector<uint64_t> latencies;
+    latencies.reserve(PACED + BURST);
+    std::atomic<uint32_t> consumed{0};
+    std::atomic<bool> done{false};
+
+    ReadingBatch day;
+    for (int i = 0; i < 288; ++i) {
+        day.readings.emplace_back(120, DexcomConst::TrendDirection::Flat, 1700000000 - i * 300);
+    }
+
+    double burstSec = 0;
+    ASSERT_TRUE(pipeline.start(
+        [&](ReadingPipeline& p) {
+            for (uint32_t i = 0; i < PACED; ++i) {
+                ReadingBatch batch;
+                batch.readings = day.readings; // the parser's allocation, outside the measurement
+                batch.ok = true;
+                p.publish(std::move(batch));
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < BURST; ++i) {
+                while (!p.publish(ReadingBatch{})) {
+                    std::this_thread::yield();
+                }
+            }
+            while (consumed.load() < PACED + BURST) {
+                std::this_thread::yield();
+            }
+            burstSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            done = true;
+            while (p.running()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        },
+        [&](ReadingBatch& batch) {
+            latencies.push_back(ReadingPipeline::nowUs() - batch.publishedAtUs);
+            ++consumed;
+        }));
+
+    while (!done) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    pipeline.stop();
+
+    std::vector<uint64_t> paced(latencies.begin(), latencies.begin() + PACED);
+    std::sort(paced.begin(), paced.end());
+    printf("[bench] reading pipeline: paced latency p50 %llu us, p99 %llu us, max %llu us\n",
+           static_cast<unsigned long long>(paced[PACED / 2]), static_cast<unsigned long long>(paced[PACED * 99 / 100]),
+           static_cast<unsigned long long>(paced.back()));
+    printf("[bench] reading pipeline: burst %.0f batches/s through a %zu-deep queue (%u refused and retried)\n",
+           BURST / burstSec, ReadingPipeline::DEPTH, pipeline.dropped());
+    EXPECT_EQ(PACED + BURST, latencies.size());
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include "dexcom_constants.h"
+#include "share_requests.h"
+
+/**
+ * Compares patching minutes/maxCount into the prebuilt readings URL with building the
+ * same URL by concatenation, as DexcomClient used to for every fetch.
+ */
+TEST(ShareRequestsBench, ReadingsUrlPerCall) {
+    constexpr int ITERATIONS = 200000;
+    const std::string session = "0f4c5e9a-1b2c-4d3e-8f70-123456789abc";
+    ShareRequests requests("", "acct-1", "secret");
+    requests.setSessionId(session);
+
+    size_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        const uint16_t minutes = static_cast<uint16_t>(i % DexcomConst::MAX_MINUTES + 1);
+        sink += requests.readingsUrl(minutes, static_cast<uint16_t>(minutes % DexcomConst::MAX_MAX_COUNT + 1)).size();
+    }
+    double templatedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        const uint16_t minutes = static_cast<uint16_t>(i % DexcomConst::MAX_MINUTES + 1);
+        std::string params = "sessionId=" + session + "&minutes=" + std::to_string(minutes) + "&maxCount=" +
+                             std::to_string(minutes % DexcomConst::MAX_MAX_COUNT + 1);
+        std::string url = "/ShareWebServices/Services/" + std::string(DexcomConst::DEXCOM_GLUCOSE_READINGS_ENDPOINT) +
+                          "?" + params;
+        sink += url.size();
+    }
+    double concatenatedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    printf("[bench] share requests: readings URL %.1f ns templated, %.1f ns concatenated (%d)\n",
+           templatedNs / ITERATIONS, concatenatedNs / ITERATIONS, sink > 0);
+    EXPECT_GT(sink, 0u);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * One day of 5-minute CGM values (mg/dL) from midnight, shaped like a typical trace:
+ * an overnight low around 03:15, dawn rise, three meals with the evening one going
+ * high, and an over-corrected low around 22:30. Sensor noise is included, so the
+ * predictor is tested on data that is not a clean curve.
+ */
+constexpr uint16_t CGM_DAY_INTERVAL_S = 300;
+constexpr uint16_t CGM_DAY[] = {
+    114, 116, 115, 114, 112, 113, 116, 117, 118, 118, 118, 117, 113, 116, 116, 117,
+    113, 110, 109, 110, 112, 113, 114, 112, 113, 113, 110, 112, 110, 108, 102, 95,
+    89, 83, 79, 73, 67, 61, 58, 61, 60, 63, 68, 69, 76, 85, 86, 92,
+    97, 100, 105, 108, 107, 112, 115, 117, 120, 120, 119, 116, 118, 117, 117, 115,
+    115, 117, 122, 119, 118, 122, 128, 131, 127, 124, 128, 129, 129, 133, 136, 136,
+    136, 136, 138, 137, 135, 134, 127, 129, 129, 128, 121, 144, 166, 177, 189, 200,
+    203, 210, 213, 212, 211, 209, 206, 204, 199, 194, 193, 189, 184, 183, 183, 177,
+    171, 168, 165, 162, 163, 158, 159, 153, 149, 150, 150, 149, 147, 145, 143, 142,
+    139, 138, 137, 135, 135, 135, 137, 135, 131, 129, 127, 128, 126, 126, 129, 121,
+    119, 120, 121, 121, 120, 121, 121, 135, 153, 162, 168, 173, 176, 179, 175, 177,
+    181, 177, 177, 178, 178, 178, 171, 168, 166, 166, 166, 157, 159, 154, 154, 149,
+    149, 151, 149, 147, 147, 145, 143, 145, 144, 141, 145, 139, 139, 136, 134, 134,
+    133, 133, 127, 124, 126, 123, 121, 119, 123, 124, 127, 123, 123, 120, 121, 125,
+    121, 124, 125, 123, 117, 120, 120, 118, 119, 119, 122, 118, 120, 123, 124, 121,
+    118, 120, 119, 119, 121, 153, 175, 198, 213, 231, 244, 251, 258, 264, 266, 269,
+    264, 261, 258, 253, 243, 238, 226, 218, 209, 207, 199, 194, 189, 184, 177, 172,
+    169, 161, 153, 146, 134, 120, 108, 99, 84, 72, 65, 57, 49, 45, 42, 40,
+    40, 41, 50, 56, 62, 70, 75, 84, 90, 98, 98, 105, 108, 107, 112, 113,
+};
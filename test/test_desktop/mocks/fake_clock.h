@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include "i_clock.h"
+
+/**
+ * Simulated clock for timing tests: time only moves when the test advances it.
+ */
+class FakeClock : public IClock {
+public:
+    explicit FakeClock(uint32_t startMs = 0) : now_(startMs) {}
+
+    uint32_t millis() const override { return now_; }
+
+    void advance(uint32_t ms) { now_ += ms; }
+    void set(uint32_t ms) { now_ = ms; }
+
+private:
+    uint32_t now_;
+};
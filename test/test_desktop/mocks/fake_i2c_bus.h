@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include "i_i2c_bus.h"
+
+/**
+ * Register-map simulator: each device is 256 byte registers with auto-increment, the
+ * way most I2C sensors behave. The first byte of a write selects the register and the
+ * rest are stored from there; a read returns bytes from the selected register onwards.
+ * onWrite lets a test model side effects, e.g. a conversion started by a control write.
+ */
+class FakeI2cBus : public II2cBus {
+public:
+    using Registers = std::array<uint8_t, 256>;
+    using WriteHook = std::function<void(uint8_t address, uint8_t reg, uint8_t value, Registers& regs)>;
+
+    Registers& device(uint8_t address) { return devices_[address]; }
+    void removeDevice(uint8_t address) { devices_.erase(address); }
+
+    bool write(uint8_t address, const uint8_t* data, size_t length) override {
+        ++transactions;
+        auto it = devices_.find(address);
+        if (it == devices_.end() || length == 0) {
+            return false; // NACK
+        }
+        bytesWritten += length;
+        for (size_t i = 1; i < length; ++i) {
+            const uint8_t reg = static_cast<uint8_t>(data[0] + i - 1);
+            it->second[reg] = data[i];
+            if (onWrite) {
+                onWrite(address, reg, data[i], it->second);
+            }
+        }
+        return true;
+    }
+
+    bool writeRead(uint8_t address, const uint8_t* tx, size_t txLength, uint8_t* rx, size_t rxLength) override {
+        ++transactions;
+        auto it = devices_.find(address);
+        if (it == devices_.end() || txLength == 0) {
+            return false;
+        }
+        bytesWritten += txLength;
+        bytesRead += rxLength;
+        for (size_t i = 0; i < rxLength; ++i) {
+            rx[i] = it->second[static_cast<uint8_t>(tx[0] + i)];
+        }
+        return true;
+    }
+
+    WriteHook onWrite;
+    int transactions = 0;
+    size_t bytesWritten = 0;
+    size_t bytesRead = 0;
+
+private:
+    std::map<uint8_t, Registers> devices_;
+};
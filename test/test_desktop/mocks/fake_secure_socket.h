@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include "i_secure_client.h"
+
+/**
+ * Scripted socket: serves a fixed byte stream and records everything written. The
+ * server side can hang up after a given number of bytes, and onConnect can load the
+ * stream for the next connection.
+ */
+class FakeSecureSocket : public ISecureClient {
+public:
+    static constexpr size_t NEVER = static_cast<size_t>(-1);
+
+    /// Bytes the server sends on the current connection, and where it hangs up.
+    void serve(const std::string& bytes, size_t closeAfter = NEVER) {
+        inbound_ = bytes;
+        pos_ = 0;
+        closeAfter_ = closeAfter;
+    }
+
+    bool connect(const char*, uint16_t) override {
+        ++connects;
+        open_ = true;
+        written.clear();
+        writtenBeforeFirstRead.clear();
+        firstRead_ = true;
+        if (onConnect) {
+            onConnect(*this);
+        }
+        return true;
+    }
+    size_t write(const uint8_t* buf, size_t size) override {
+        written.append(reinterpret_cast<const char*>(buf), size);
+        return size;
+    }
+    size_t write(const char* buf) override {
+        written += buf;
+        return std::string(buf).size();
+    }
+    int available() override { return connected() ? static_cast<int>(limit() - pos_) : 0; }
+    int read() override {
+        noteRead();
+        return available() > 0 ? static_cast<unsigned char>(inbound_[pos_++]) : -1;
+    }
+    int read(uint8_t* buf, size_t size) override {
+        size_t n = 0;
+        for (int c; n < size && (c = read()) >= 0; ++n) {
+            buf[n] = static_cast<uint8_t>(c);
+        }
+        return static_cast<int>(n);
+    }
+    void stop() override { open_ = false; }
+    bool connected() override {
+        if (pos_ >= closeAfter_) {
+            open_ = false;
+        }
+        return open_;
+    }
+    void setTimeout(uint32_t) override {}
+    void print(const std::string& data) override { written += data; }
+    void println(const std::string& data) override { written += data + "\r\n"; }
+    void println() override { written += "\r\n"; }
+    std::string readStringUntil(char terminator) override {
+        noteRead();
+        std::string line;
+        while (available() > 0) {
+            const char c = inbound_[pos_++];
+            line += c;
+            if (c == terminator) {
+                break;
+            }
+        }
+        return line;
+    }
+
+    /// Requests written on the current connection.
+    size_t requestsWritten() const {
+        size_t count = 0;
+        for (size_t at = written.find(" HTTP/1.1\r\n"); at != std::string::npos;
+             at = written.find(" HTTP/1.1\r\n", at + 1)) {
+            ++count;
+        }
+        return count;
+    }
+
+    std::string written;
+    std::string writtenBeforeFirstRead;
+    int connects = 0;
+    std::function<void(FakeSecureSocket&)> onConnect;
+
+private:
+    size_t limit() const { return closeAfter_ < inbound_.size() ? closeAfter_ : inbound_.size(); }
+    void noteRead() {
+        if (firstRead_) {
+            firstRead_ = false;
+            writtenBeforeFirstRead = written;
+        }
+    }
+
+    std::string inbound_;
+    size_t pos_ = 0;
+    size_t closeAfter_ = NEVER;
+    bool open_ = false;
+    bool firstRead_ = true;
+};
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <gmock/gmock.h>
+#include "i_dns_resolver.h"
+
+class MockDnsResolver : public IDnsResolver
+{
+public:
+    MOCK_METHOD(bool, resolve, (const char* host, uint32_t& ip, uint32_t& ttlS), (override));
+};
@@ -5,6 +5,7 @@
 #include <string>
 #include <map>
 #include <optional>
+#include <vector>
 #include <cstdint>
 
 class MockHttpClient : public IHttpClient {
@@ -15,4 +16,5 @@ public:
     MOCK_METHOD(HttpResponse, send, (const HttpRequest& request), (override));
     MOCK_METHOD(HttpResponse, get, (const std::string& url, (const std::map<std::string, std::string>&) headers), (override));
     MOCK_METHOD(HttpResponse, post, (const std::string& url, const std::string& body, (const std::map<std::string, std::string>&) headers), (override));
+    MOCK_METHOD(std::vector<HttpResponse>, sendPipelined, (const std::vector<HttpRequest>& requests), (override));
 };
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <gmock/gmock.h>
+#include "i_i2c_bus.h"
+
+class MockI2cBus : public II2cBus
+{
+public:
+    MOCK_METHOD(bool, write, (uint8_t address, const uint8_t* data, size_t length), (override));
+    MOCK_METHOD(bool, writeRead, (uint8_t address, const uint8_t* tx, size_t txLength, uint8_t* rx, size_t rxLength),
+                (override));
+    MOCK_METHOD(bool, writeBatch, (uint8_t address, const I2cWrite* writes, size_t count), (override));
+};
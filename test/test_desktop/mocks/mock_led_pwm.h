@@ -0,0 +1,10 @@
+#pragma once
+
+#include <gmock/gmock.h>
+#include "i_led_pwm.h"
+
+class MockLedPwm : public ILedPwm
+{
+public:
+    MOCK_METHOD(void, fade, (Channel channel, uint16_t duty, uint32_t durationMs), (override));
+};
@@ -16,6 +16,7 @@ public:
     MOCK_METHOD(void, stop, (), (override));
     MOCK_METHOD(bool, connected, (), (override));
     MOCK_METHOD(void, setTimeout, (uint32_t timeout), (override));
+    MOCK_METHOD(void, print, (const std::string& data), (override));
     MOCK_METHOD(void, println, (const std::string& data), (override));
     MOCK_METHOD(void, println, (), (override));
     MOCK_METHOD(std::string, readStringUntil, (char terminator), (override));
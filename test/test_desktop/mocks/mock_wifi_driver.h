@@ -0,0 +1,16 @@
+#pragma once
+
+#include <gmock/gmock.h>
+#include "i_wifi_driver.h"
+
+class MockWifiDriver : public IWifiDriver
+{
+public:
+    MOCK_METHOD(void, beginDirect, (uint8_t channel, const uint8_t bssid[6]), (override));
+    MOCK_METHOD(void, beginScan, (), (override));
+    MOCK_METHOD(void, useStaticIp, (const WifiLease& lease), (override));
+    MOCK_METHOD(void, useDhcp, (), (override));
+    MOCK_METHOD(void, disconnect, (), (override));
+    MOCK_METHOD(WifiLinkStatus, status, (), (override));
+    MOCK_METHOD(bool, currentLink, (WifiCache& out), (override));
+};
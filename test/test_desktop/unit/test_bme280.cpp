@@ -0,0 +1,257 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include "bme280.h"
+#include "fake_i2c_bus.h"
+#include "i2c_bus_manager.h"
+
+namespace {
+
+// Worked example from the BME280 datasheet (section 8.1), humidity from a typical part
+Bme280Calibration exampleCalibration() {
+    Bme280Calibration cal;
+    cal.T1 = 27504; cal.T2 = 26435; cal.T3 = -1000;
+    cal.P1 = 36477; cal.P2 = -10685; cal.P3 = 3024; cal.P4 = 2855; cal.P5 = 140;
+    cal.P6 = -7; cal.P7 = 15500; cal.P8 = -14600; cal.P9 = 6000;
+    cal.H1 = 75; cal.H2 = 362; cal.H3 = 0; cal.H4 = 313; cal.H5 = 50; cal.H6 = 30;
+    cal.magic = Bme280Calibration::MAGIC;
+    return cal;
+}
+
+void putLe(uint8_t* p, int value) {
+    p[0] = value & 0xFF;
+    p[1] = (value >> 8) & 0xFF;
+}
+
+// Inverse of Bme280::parseCalibration, to load a calibration into the simulated part
+void storeCalibration(const Bme280Calibration& cal, FakeI2cBus::Registers& regs) {
+    uint8_t* tp = &regs[Bme280::REG_CALIB_TP];
+    const int tpWords[] = {cal.T1, cal.T2, cal.T3, cal.P1, cal.P2, cal.P3, cal.P4, cal.P5, cal.P6, cal.P7, cal.P8, cal.P9};
+    for (int i = 0; i < 12; ++i) {
+        putLe(tp + 2 * i, tpWords[i]);
+    }
+    tp[25] = cal.H1;
+    uint8_t* h = &regs[Bme280::REG_CALIB_H];
+    putLe(h, cal.H2);
+    h[2] = cal.H3;
+    h[3] = (cal.H4 >> 4) & 0xFF;
+    h[4] = ((cal.H5 & 0x0F) << 4) | (cal.H4 & 0x0F);
+    h[5] = (cal.H5 >> 4) & 0xFF;
+    h[6] = static_cast<uint8_t>(cal.H6);
+}
+
+// Floating-point formulas from the datasheet (section 8.1), used as the reference
+double referenceTemperature(int32_t adcT, const Bme280Calibration& c, double& tFine) {
+    const double var1 = (adcT / 16384.0 - c.T1 / 1024.0) * c.T2;
+    const double d = adcT / 131072.0 - c.T1 / 8192.0;
+    tFine = var1 + d * d * c.T3;
+    return tFine / 5120.0;
+}
+
+double referencePressure(int32_t adcP, const Bme280Calibration& c, double tFine) {
+    double var1 = tFine / 2.0 - 64000.0;
+    double var2 = var1 * var1 * c.P6 / 32768.0;
+    var2 = var2 + var1 * c.P5 * 2.0;
+    var2 = var2 / 4.0 + c.P4 * 65536.0;
+    var1 = (c.P3 * var1 * var1 / 524288.0 + c.P2 * var1) / 524288.0;
+    var1 = (1.0 + var1 / 32768.0) * c.P1;
+    double p = 1048576.0 - adcP;
+    p = (p - var2 / 4096.0) * 6250.0 / var1;
+    var1 = c.P9 * p * p / 2147483648.0;
+    var2 = p * c.P8 / 32768.0;
+    return p + (var1 + var2 + c.P7) / 16.0;
+}
+
+double referenceHumidity(int32_t adcH, const Bme280Calibration& c, double tFine) {
+    double h = tFine - 76800.0;
+    h = (adcH - (c.H4 * 64.0 + c.H5 / 16384.0 * h)) *
+        (c.H2 / 65536.0 * (1.0 + c.H6 / 67108864.0 * h * (1.0 + c.H3 / 67108864.0 * h)));
+    h = h * (1.0 - c.H1 * h / 524288.0);
+    return h < 0 ? 0 : (h > 100 ? 100 : h);
+}
+
+}  // namespace
+
+TEST(Bme280CompensationTest, MatchesDatasheetExample) {
+    const Bme280Calibration cal = exampleCalibration();
+    int32_t tFine = 0;
+    EXPECT_EQ(2508, Bme280::compensateTemperature(519888, cal, tFine));
+    EXPECT_EQ(128422, tFine);
+    // 100653.27 Pa with the float formula
+    EXPECT_NEAR(100653.27, Bme280::compensatePressure(415148, cal, tFine) / 256.0, 0.5);
+}
+
+TEST(Bme280CompensationTest, IntegerFormulasTrackFloatReference) {
+    const Bme280Calibration cal = exampleCalibration();
+    for (int32_t adcT = 400000; adcT <= 600000; adcT += 25000) {
+        double refFine = 0;
+        const double refT = referenceTemperature(adcT, cal, refFine);
+        int32_t tFine = 0;
+        const int32_t t = Bme280::compensateTemperature(adcT, cal, tFine);
+        EXPECT_NEAR(refT, t / 100.0, 0.01) << adcT;
+
+        for (int32_t adcP = 250000; adcP <= 450000; adcP += 50000) {
+            EXPECT_NEAR(referencePressure(adcP, cal, refFine), Bme280::compensatePressure(adcP, cal, tFine) / 256.0,
+                        1.0)
+                << adcT << " " << adcP;
+        }
+        for (int32_t adcH = 20000; adcH <= 40000; adcH += 5000) {
+            EXPECT_NEAR(referenceHumidity(adcH, cal, refFine), Bme280::compensateHumidity(adcH, cal, tFine) / 1024.0,
+                        0.05)
+                << adcT << " " << adcH;
+        }
+    }
+}
+
+TEST(Bme280CompensationTest, HumidityIsClampedToValidRange) {
+    const Bme280Calibration cal = exampleCalibration();
+    int32_t tFine = 0;
+    Bme280::compensateTemperature(519888, cal, tFine);
+    EXPECT_EQ(0u, Bme280::compensateHumidity(0, cal, tFine));
+    EXPECT_EQ(100u * 1024, Bme280::compensateHumidity(65535, cal, tFine));
+}
+
+TEST(Bme280CompensationTest, ParsesSignedNibblePackedCoefficients) {
+    Bme280Calibration cal = exampleCalibration();
+    cal.H4 = -300;
+    cal.H5 = -7;
+    cal.H6 = -12;
+    cal.T3 = -1;
+    FakeI2cBus::Registers regs{};
+    storeCalibration(cal, regs);
+
+    Bme280Calibration parsed;
+    Bme280::parseCalibration(&regs[Bme280::REG_CALIB_TP], &regs[Bme280::REG_CALIB_H], parsed);
+    EXPECT_TRUE(parsed.valid());
+    EXPECT_EQ(cal.T1, parsed.T1);
+    EXPECT_EQ(cal.T3, parsed.T3);
+    EXPECT_EQ(cal.P9, parsed.P9);
+    EXPECT_EQ(cal.H1, parsed.H1);
+    EXPECT_EQ(cal.H2, parsed.H2);
+    EXPECT_EQ(-300, parsed.H4);
+    EXPECT_EQ(-7, parsed.H5);
+    EXPECT_EQ(-12, parsed.H6);
+}
+
+/**
+ * Drives the driver against a simulated BME280: calibration and chip ID in the
+ * register map, and a forced-mode write to ctrl_meas "converting" the raw ADC values
+ * below into the data registers before dropping back to sleep mode.
+ */
+class Bme280Test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto& regs = bus_->device(Bme280::ADDRESS);
+        regs[Bme280::REG_ID] = Bme280::CHIP_ID;
+        storeCalibration(exampleCalibration(), regs);
+        // Skipped channels read 0x80000 until the first conversion
+        regs[Bme280::REG_DATA + 0] = 0x80;
+        regs[Bme280::REG_DATA + 3] = 0x80;
+        bus_->onWrite = [this](uint8_t, uint8_t reg, uint8_t value, FakeI2cBus::Registers& r) {
+            if (reg == Bme280::REG_CTRL_MEAS && (value & 0x03) == Bme280::MODE_FORCED) {
+                ++conversions_;
+                r[Bme280::REG_DATA + 0] = adcP_ >> 12;
+                r[Bme280::REG_DATA + 1] = (adcP_ >> 4) & 0xFF;
+                r[Bme280::REG_DATA + 2] = (adcP_ & 0x0F) << 4;
+                r[Bme280::REG_DATA + 3] = adcT_ >> 12;
+                r[Bme280::REG_DATA + 4] = (adcT_ >> 4) & 0xFF;
+                r[Bme280::REG_DATA + 5] = (adcT_ & 0x0F) << 4;
+                r[Bme280::REG_DATA + 6] = adcH_ >> 8;
+                r[Bme280::REG_DATA + 7] = adcH_ & 0xFF;
+                r[reg] = value & ~0x03;  // back to sleep once done
+            }
+        };
+    }
+
+    std::shared_ptr<FakeI2cBus> bus_ = std::make_shared<FakeI2cBus>();
+    Bme280Calibration calibration_{};  // stands in for the RTC_DATA_ATTR copy
+    int32_t adcT_ = 519888;
+    int32_t adcP_ = 415148;
+    int32_t adcH_ = 30000;
+    int conversions_ = 0;
+};
+
+TEST_F(Bme280Test, ColdBeginLoadsCalibrationAndConfiguresHumidity) {
+    Bme280 sensor(bus_, calibration_);
+    ASSERT_TRUE(sensor.begin());
+    EXPECT_TRUE(calibration_.valid());
+    EXPECT_EQ(27504, calibration_.T1);
+    EXPECT_EQ(313, calibration_.H4);
+    EXPECT_EQ(Bme280::OSRS_X1, bus_->device(Bme280::ADDRESS)[Bme280::REG_CTRL_HUM]);
+}
+
+TEST_F(Bme280Test, WarmBeginOnlyChecksTheChipId) {
+    ASSERT_TRUE(Bme280(bus_, calibration_).begin());
+    const int coldTransactions = bus_->transactions;
+    bus_->transactions = 0;
+
+    Bme280 afterWake(bus_, calibration_);
+    ASSERT_TRUE(afterWake.begin());
+    EXPECT_EQ(1, bus_->transactions);
+    EXPECT_GT(coldTransactions, bus_->transactions);
+}
+
+TEST_F(Bme280Test, ForcedMeasurementIsReadInOneBurst) {
+    auto manager = std::make_shared<I2cBusManager>(bus_);
+    manager->enableBursts(Bme280::ADDRESS);
+    Bme280 sensor(manager, calibration_);
+    ASSERT_TRUE(sensor.begin());
+
+    ASSERT_TRUE(sensor.startMeasurement());
+    EXPECT_EQ(1, conversions_);
+    EXPECT_FALSE(sensor.measuring());
+    bus_->transactions = 0;
+    bus_->bytesRead = 0;
+
+    // Status and data coalesced into one read
+    Bme280Reading reading{};
+    ASSERT_TRUE(sensor.read(reading));
+    EXPECT_EQ(1, bus_->transactions);
+    EXPECT_EQ(Bme280::REG_DATA + Bme280::DATA_LENGTH - Bme280::REG_STATUS, bus_->bytesRead);
+    EXPECT_EQ(1u, manager->coalescedReads());
+    EXPECT_EQ(2508, reading.temperature);
+    EXPECT_NEAR(100653.27, reading.pressure / 256.0, 0.5);
+    int32_t tFine = 0;
+    Bme280::compensateTemperature(adcT_, calibration_, tFine);
+    EXPECT_EQ(Bme280::compensateHumidity(adcH_, calibration_, tFine), reading.humidity);
+}
+
+TEST_F(Bme280Test, ReadFailsWhileConverting) {
+    Bme280 sensor(bus_, calibration_);
+    ASSERT_TRUE(sensor.begin());
+    ASSERT_TRUE(sensor.startMeasurement());
+    bus_->device(Bme280::ADDRESS)[Bme280::REG_STATUS] = Bme280::STATUS_MEASURING;
+    Bme280Reading reading{};
+    EXPECT_FALSE(sensor.read(reading));
+
+    bus_->device(Bme280::ADDRESS)[Bme280::REG_STATUS] = 0;
+    EXPECT_TRUE(sensor.read(reading));
+}
+
+TEST_F(Bme280Test, ReadFailsBeforeAnyConversion) {
+    Bme280 sensor(bus_, calibration_);
+    ASSERT_TRUE(sensor.begin());
+    Bme280Reading reading{};
+    EXPECT_FALSE(sensor.read(reading));
+}
+
+TEST_F(Bme280Test, RejectsMissingOrForeignChip) {
+    bus_->device(Bme280::ADDRESS)[Bme280::REG_ID] = 0x58;  // BMP280
+    EXPECT_FALSE(Bme280(bus_, calibration_).begin());
+    EXPECT_FALSE(calibration_.valid());
+
+    bus_->removeDevice(Bme280::ADDRESS);
+    EXPECT_FALSE(Bme280(bus_, calibration_).begin());
+}
+
+TEST_F(Bme280Test, FailedConfigurationDropsTheCachedCalibration) {
+    // Reads still work but writes NACK: a half-initialised sensor must not look cached
+    class WriteNackBus : public FakeI2cBus {
+    public:
+        explicit WriteNackBus(const FakeI2cBus& other) : FakeI2cBus(other) {}
+        bool write(uint8_t, const uint8_t*, size_t) override { return false; }
+    };
+    auto bus = std::make_shared<WriteNackBus>(*bus_);
+    EXPECT_FALSE(Bme280(bus, calibration_).begin());
+    EXPECT_FALSE(calibration_.valid());
+}
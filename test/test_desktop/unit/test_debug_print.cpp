@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#define LOG_TAG "test"
+#define LOG_MODULE_LEVEL LOG_LEVEL_WARN
+#include "debug_print.h"
+
+namespace {
+int evaluations = 0;
+
+int countedArgument() {
+    return ++evaluations;
+}
+}
+
+TEST(DebugPrintTest, LevelsAboveModuleThresholdAreDisabled) {
+    EXPECT_TRUE(LOG_ENABLED(LOG_LEVEL_ERROR));
+    EXPECT_TRUE(LOG_ENABLED(LOG_LEVEL_WARN));
+    EXPECT_FALSE(LOG_ENABLED(LOG_LEVEL_INFO));
+    EXPECT_FALSE(LOG_ENABLED(LOG_LEVEL_DEBUG));
+    EXPECT_FALSE(LOG_ENABLED(LOG_LEVEL_VERBOSE));
+}
+
+TEST(DebugPrintTest, DisabledLevelsDoNotEvaluateArguments) {
+    evaluations = 0;
+    LOG_INFO("%d", countedArgument());
+    LOG_DEBUG("%d", countedArgument());
+    LOG_VERBOSE("%d", countedArgument());
+    EXPECT_EQ(0, evaluations);
+
+    LOG_WARN("%d", countedArgument());
+    EXPECT_EQ(1, evaluations);
+}
+
+TEST(DebugPrintTest, FormatWithoutArgumentsCompiles) {
+    LOG_ERROR("no arguments");
+    LOG_DEBUG("no arguments");
+}
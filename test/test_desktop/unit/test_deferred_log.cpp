@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include "deferred_log.h"
+
+namespace {
+std::vector<std::string> captured;
+
+void captureSink(const char* line, size_t length) {
+    captured.emplace_back(line, length);
+}
+}
+
+class DeferredLogTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        captured.clear();
+    }
+
+    DeferredLog log_{captureSink};
+};
+
+TEST_F(DeferredLogTest, FormatsOnDrainNotOnWrite) {
+    EXPECT_TRUE(log_.write("value=%d", 42));
+    EXPECT_TRUE(captured.empty());
+    EXPECT_EQ(1u, log_.pending());
+
+    EXPECT_EQ(1u, log_.drain());
+    ASSERT_EQ(1u, captured.size());
+    EXPECT_EQ("value=42", captured[0]);
+    EXPECT_EQ(0u, log_.pending());
+}
+
+TEST_F(DeferredLogTest, FormatsCommonConversions) {
+    unsigned long big = 4000000000UL;
+    size_t count = 288;
+    log_.write("%s|%5d|%-3u|%x|%lu|%zu", "tag", -7, 3u, 255, big, count);
+    log_.write("%.2f|%c|%p|100%%", 5.5, 'Z', static_cast<void*>(nullptr));
+    log_.drain();
+    ASSERT_EQ(2u, captured.size());
+    EXPECT_EQ("tag|   -7|3  |ff|4000000000|288", captured[0]);
+    char expected[64];
+    snprintf(expected, sizeof(expected), "5.50|Z|%p|100%%", static_cast<void*>(nullptr));
+    EXPECT_EQ(expected, captured[1]);
+}
+
+TEST_F(DeferredLogTest, CopiesStringArgumentsAtWriteTime) {
+    std::string body = "before";
+    log_.write("body: %s", body.c_str());
+    body = "after, longer than before";
+    log_.drain();
+    ASSERT_EQ(1u, captured.size());
+    EXPECT_EQ("body: before", captured[0]);
+}
+
+TEST_F(DeferredLogTest, TruncatesStringsToThePool) {
+    std::string longString(500, 'x');
+    log_.write("%s|%s", longString.c_str(), "tail");
+    log_.drain();
+    ASSERT_EQ(1u, captured.size());
+    EXPECT_EQ(std::string(DeferredLog::STRING_POOL_SIZE - 1, 'x') + "|", captured[0]);
+}
+
+TEST_F(DeferredLogTest, NullStringPrintsPlaceholder) {
+    const char* missing = nullptr;
+    log_.write("%s", missing);
+    log_.drain();
+    ASSERT_EQ(1u, captured.size());
+    EXPECT_EQ("(null)", captured[0]);
+}
+
+TEST_F(DeferredLogTest, CountsDroppedMessagesWhenFull) {
+    for (size_t i = 0; i < DeferredLog::CAPACITY; ++i) {
+        EXPECT_TRUE(log_.write("%u", static_cast<unsigned>(i)));
+    }
+    EXPECT_FALSE(log_.write("overflow"));
+    EXPECT_FALSE(log_.write("overflow"));
+    EXPECT_EQ(2u, log_.dropped());
+
+    EXPECT_EQ(DeferredLog::CAPACITY, log_.drain());
+    EXPECT_EQ("0", captured.front());
+    EXPECT_TRUE(log_.write("room again"));
+}
+
+TEST_F(DeferredLogTest, BackgroundThreadDrainsAndStopFlushes) {
+    log_.start();
+    for (int i = 0; i < 1000; ++i) {
+        while (!log_.write("line %d", i)) {
+            std::this_thread::yield();
+        }
+    }
+    log_.stop();
+
+    ASSERT_EQ(1000u, captured.size());
+    EXPECT_EQ("line 0", captured.front());
+    EXPECT_EQ("line 999", captured.back());
+}
+
+TEST_F(DeferredLogTest, ConcurrentProducersLoseNothing) {
+    constexpr int PRODUCERS = 4;
+    constexpr int LINES = 500;
+    log_.start();
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([this, p]() {
+            for (int i = 0; i < LINES; ++i) {
+                while (!log_.write("%d %d %s", p, i, "payload")) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    log_.stop();
+
+    ASSERT_EQ(static_cast<size_t>(PRODUCERS * LINES), captured.size());
+    std::vector<int> next(PRODUCERS, 0);
+    for (const auto& line : captured) {
+        int p = -1;
+        int i = -1;
+        char payload[16] = {};
+        ASSERT_EQ(3, std::sscanf(line.c_str(), "%d %d %15s", &p, &i, payload)) << line;
+        ASSERT_GE(p, 0);
+        ASSERT_LT(p, PRODUCERS);
+        EXPECT_EQ(next[p]++, i); // each producer's lines arrive whole and in order
+        EXPECT_STREQ("payload", payload);
+    }
+}
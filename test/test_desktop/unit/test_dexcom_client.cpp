@@ -5,6 +5,8 @@
 #include <vector>
 #include <optional>
 #include <stdexcept>
+#include <cstdio>
+#include <map>
 #include "dexcom_client.h"
 #include "../mocks/mock_http_client.h"
 #include "../mocks/mock_glucose_reading_parser.h"
@@ -72,6 +74,11 @@ TEST_F(DexcomClientTest, SuccessfulConstructionOUSFalse) {
     const std::string dummy_account_id = ACCOUNT_ID;
     const std::string dummy_session_id = SESSION_ID;
     
+    // Not connected until the constructor connects
+    EXPECT_CALL(*mock_http_client_, isConnected())
+        .WillOnce(testing::Return(false))
+        .WillRepeatedly(testing::Return(true));
+
     // Use InSequence to enforce order of calls
     testing::InSequence seq;
     
@@ -99,6 +106,11 @@ TEST_F(DexcomClientTest, SuccessfulConstructionOUSFalseWithAccountID) {
     // Define expected responses
     const std::string dummy_session_id = SESSION_ID;
     
+    // Not connected until the constructor connects
+    EXPECT_CALL(*mock_http_client_, isConnected())
+        .WillOnce(testing::Return(false))
+        .WillRepeatedly(testing::Return(true));
+
     // Use InSequence to enforce order of calls
     testing::InSequence seq;
     
@@ -124,6 +136,11 @@ TEST_F(DexcomClientTest, SuccessfulConstructionOUSTrue) {
     const std::string dummy_account_id = ACCOUNT_ID;
     const std::string dummy_session_id = SESSION_ID;
     
+    // Not connected until the constructor connects
+    EXPECT_CALL(*mock_http_client_, isConnected())
+        .WillOnce(testing::Return(false))
+        .WillRepeatedly(testing::Return(true));
+
     // Use InSequence to enforce order of calls
     testing::InSequence seq;
     
@@ -159,6 +176,11 @@ TEST_F(DexcomClientTest, ConstructorConnectFailure) {
         return HttpResponse{401, "Unauthorized", {}};
     };
     
+    // Not connected until the constructor connects
+    EXPECT_CALL(*mock_http_client_, isConnected())
+        .WillOnce(testing::Return(false))
+        .WillRepeatedly(testing::Return(true));
+
     // Use InSequence to enforce order of calls
     testing::InSequence seq;
     
@@ -197,6 +219,11 @@ TEST_F(DexcomClientTest, ConstructorGetAccountIdFailure) {
         return HttpResponse{401, "Unauthorized", {}};
     };
     
+    // Not connected until the constructor connects
+    EXPECT_CALL(*mock_http_client_, isConnected())
+        .WillOnce(testing::Return(false))
+        .WillRepeatedly(testing::Return(true));
+
     // Use InSequence to enforce order of calls
     testing::InSequence seq;
     
@@ -239,6 +266,11 @@ TEST_F(DexcomClientTest, ConstructorGetSessionIdFailure) {
         return HttpResponse{500, "Server Error", {}};
     };
     
+    // Not connected until the constructor connects
+    EXPECT_CALL(*mock_http_client_, isConnected())
+        .WillOnce(testing::Return(false))
+        .WillRepeatedly(testing::Return(true));
+
     // Use InSequence to enforce order of calls
     testing::InSequence seq;
     
@@ -347,6 +379,11 @@ TEST_F(DexcomClientTest, GetGlucoseReadingsRecoversFromSessionError) {
     expectedReadings.push_back(GlucoseReading(120, "Flat", "Date(1609459200000)"));
     expectedReadings.push_back(GlucoseReading(118, "FortyFiveDown", "Date(1609455600000)"));
     
+    // Not connected until the constructor connects
+    EXPECT_CALL(*mock_http_client_, isConnected())
+        .WillOnce(testing::Return(false))
+        .WillRepeatedly(testing::Return(true));
+
     // Use InSequence to enforce the strict order of mock calls
     testing::InSequence seq;
     
@@ -401,6 +438,61 @@ TEST_F(DexcomClientTest, GetGlucoseReadingsRecoversFromSessionError) {
     }
 }
 
+TEST_F(DexcomClientTest, RestoredSessionSkipsLogin) {
+    const std::string rawJsonResponseString =
+        "[{\"Value\":120,\"Trend\":\"Flat\",\"WT\":\"Date(1609459200000)\"}]";
+    std::vector<GlucoseReading> expectedReadings;
+    expectedReadings.push_back(GlucoseReading(120, "Flat", "Date(1609459200000)"));
+
+    testing::InSequence seq;
+
+    // No connect and no login during construction
+    EXPECT_CALL(*mock_http_client_, connect(testing::_, testing::_)).Times(0);
+    EXPECT_CALL(*mock_http_client_, post(testing::HasSubstr(DexcomConst::DEXCOM_LOGIN_ID_ENDPOINT), testing::_, testing::_))
+        .Times(0);
+
+    dexcom_client_ = std::make_unique<DexcomClient>(mock_http_client_, mock_glucose_parser_,
+                                                 "", ACCOUNT_ID, PASSWORD, false, SESSION_ID);
+    EXPECT_EQ(dexcom_client_->sessionId(), SESSION_ID);
+
+    EXPECT_CALL(*mock_http_client_, post(testing::HasSubstr(std::string("sessionId=") + SESSION_ID), testing::_, testing::_))
+        .Times(1)
+        .WillOnce(testing::Return(HttpResponse{200, rawJsonResponseString, {}}));
+    EXPECT_CALL(*mock_glucose_parser_, parse(rawJsonResponseString))
+        .Times(1)
+        .WillOnce(testing::Return(expectedReadings));
+
+    auto actualReadings = dexcom_client_->getGlucoseReadings(60, 10);
+    ASSERT_EQ(actualReadings.size(), 1u);
+    EXPECT_EQ(actualReadings[0].getValue(), 120);
+}
+
+TEST_F(DexcomClientTest, ConstructionReusesAnOpenConnection) {
+    // Another client on the same IHttpClient has already connected
+    EXPECT_CALL(*mock_http_client_, connect(testing::_, testing::_)).Times(0);
+    ON_CALL(*mock_http_client_, post(testing::HasSubstr(DexcomConst::DEXCOM_AUTHENTICATE_ENDPOINT), testing::_, testing::_))
+        .WillByDefault(testing::Return(HttpResponse{200, "\"" + std::string(ACCOUNT_ID) + "\"", {}}));
+    ON_CALL(*mock_http_client_, post(testing::HasSubstr(DexcomConst::DEXCOM_LOGIN_ID_ENDPOINT), testing::_, testing::_))
+        .WillByDefault(testing::Return(HttpResponse{200, "\"" + std::string(SESSION_ID) + "\"", {}}));
+
+    dexcom_client_ = std::make_unique<DexcomClient>(mock_http_client_, mock_glucose_parser_, USERNAME, "", PASSWORD, false);
+    EXPECT_EQ(dexcom_client_->sessionId(), SESSION_ID);
+}
+
+TEST_F(DexcomClientTest, CredentialsAreJsonEscaped) {
+    const std::string body_tail = std::string(",\"password\":\"p\\\"w\\\\d\",\"applicationId\":\"") +
+                                  DexcomConst::DEXCOM_APPLICATION_ID + "\"}";
+    EXPECT_CALL(*mock_http_client_, post(testing::HasSubstr(DexcomConst::DEXCOM_AUTHENTICATE_ENDPOINT),
+                                         "{\"accountName\":\"a\\\"b\"" + body_tail, testing::_))
+        .WillOnce(testing::Return(HttpResponse{200, "\"" + std::string(ACCOUNT_ID) + "\"", {}}));
+    EXPECT_CALL(*mock_http_client_, post(testing::HasSubstr(DexcomConst::DEXCOM_LOGIN_ID_ENDPOINT),
+                                         "{\"accountId\":\"" + ACCOUNT_ID + "\"" + body_tail, testing::_))
+        .WillOnce(testing::Return(HttpResponse{200, "\"" + std::string(SESSION_ID) + "\"", {}}));
+
+    dexcom_client_ = std::make_unique<DexcomClient>(mock_http_client_, mock_glucose_parser_, "a\"b", "", "p\"w\\d", false);
+    EXPECT_EQ(dexcom_client_->sessionId(), SESSION_ID);
+}
+
 TEST_F(DexcomClientTest, GetGlucoseReadings_InvalidMinutes_ThrowsArgumentError) {
     // Set up successful construction expectations
     setupSuccessfulConstructionExpectations();
@@ -448,3 +540,163 @@ TEST_F(DexcomClientTest, GetGlucoseReadings_ExcessiveMaxCount_ThrowsArgumentErro
     // Test that calling getGlucoseReadings with max_count > DexcomConst::MAX_MAX_COUNT throws ArgumentError
     EXPECT_THROW(dexcom_client_->getGlucoseReadings(60, DexcomConst::MAX_MAX_COUNT + 1), ArgumentError);
 }
+
+/**
+ * Backfill against a simulated Share server: the parser mock answers each request with
+ * the server's readings inside the requested minutes window, capped at maxCount.
+ */
+class DexcomBackfillTest : public ::testing::Test {
+protected:
+    static constexpr time_t START = 1700000000;
+    static constexpr size_t SERVER_READINGS = 360;  // 30 hours
+
+    void SetUp() override {
+        http_ = std::make_shared<testing::NiceMock<MockHttpClient>>();
+        parser_ = std::make_shared<testing::NiceMock<MockGlucoseReadingParser>>();
+        ON_CALL(*http_, isConnected()).WillByDefault(testing::Return(true));
+        ON_CALL(*http_, post(testing::HasSubstr(DexcomConst::DEXCOM_GLUCOSE_READINGS_ENDPOINT), testing::_, testing::_))
+            .WillByDefault(testing::Invoke([this](const std::string& url, const std::string&,
+                                                  const std::map<std::string, std::string>&) {
+                ++requests_;
+                lastUrl_ = url;
+                return HttpResponse{200, "readings", {}};
+            }));
+        ON_CALL(*parser_, parse(testing::_)).WillByDefault(testing::Invoke([this](const std::string&) {
+            return serve();
+        }));
+        client_ = std::make_unique<DexcomClient>(http_, parser_, "", "account", "password", false, "session");
+
+        // Newest first, with a few seconds of jitter like real sensor timestamps
+        for (size_t i = 0; i < SERVER_READINGS; ++i) {
+            const size_t slot = SERVER_READINGS - 1 - i;
+            server_.emplace_back(static_cast<uint16_t>(100 + slot % 50), DexcomConst::Flat,
+                                 START + static_cast<time_t>(slot) * 300 + static_cast<time_t>(slot * 7 % 11));
+        }
+        now_ = server_.front().getTimestamp() + 40;
+    }
+
+    std::vector<GlucoseReading> serve() {
+        unsigned minutes = 0;
+        unsigned maxCount = 0;
+        sscanf(lastUrl_.c_str() + lastUrl_.find("minutes="), "minutes=%u&maxCount=%u", &minutes, &maxCount);
+        lastMinutes_ = minutes;
+        lastMaxCount_ = maxCount;
+        std::vector<GlucoseReading> window;
+        for (const auto& r : server_) {
+            if (r.getTimestamp() >= now_ - static_cast<time_t>(minutes) * 60 && window.size() < maxCount) {
+                window.push_back(r);
+            }
+        }
+        served_ = window;
+        return window;
+    }
+
+    /// The device's copy of the newest @p count readings with @p missing lost @p skip readings back.
+    std::vector<GlucoseReading> historyWithOutage(size_t count, size_t skip, size_t missing) const {
+        std::vector<GlucoseReading> history;
+        for (size_t i = 0; i < count; ++i) {
+            if (i < skip || i >= skip + missing) {
+                history.push_back(server_[i]);
+            }
+        }
+        return history;
+    }
+
+    std::shared_ptr<testing::NiceMock<MockHttpClient>> http_;
+    std::shared_ptr<testing::NiceMock<MockGlucoseReadingParser>> parser_;
+    std::unique_ptr<DexcomClient> client_;
+    std::vector<GlucoseReading> server_;
+    std::vector<GlucoseReading> served_;
+    std::string lastUrl_;
+    unsigned lastMinutes_ = 0;
+    unsigned lastMaxCount_ = 0;
+    int requests_ = 0;
+    time_t now_ = 0;
+};
+
+class DexcomBackfillOutageTest : public DexcomBackfillTest, public ::testing::WithParamInterface<size_t> {};
+
+TEST_P(DexcomBackfillOutageTest, OneRequestFillsTheHoleWithoutRefetchingOlderReadings) {
+    const size_t missing = GetParam();
+    const size_t skip = 3;
+    const size_t count = skip + missing + 20;
+    std::vector<GlucoseReading> history = historyWithOutage(count, skip, missing);
+
+    const std::vector<ReadingGap> gaps = DexcomClient::findGaps(history);
+    ASSERT_EQ(1u, gaps.size());
+    EXPECT_EQ(missing, gaps[0].missing);
+
+    EXPECT_EQ(missing, client_->backfill(history, now_));
+    EXPECT_EQ(1, requests_);
+    // Nothing from before the hole was asked for, and the count fits the window
+    ASSERT_FALSE(served_.empty());
+    EXPECT_GT(served_.back().getTimestamp(), gaps[0].after);
+    EXPECT_EQ(skip + missing, served_.size());
+    EXPECT_LE(lastMaxCount_, skip + missing + 1);
+
+    ASSERT_EQ(count, history.size());
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(server_[i].getTimestamp(), history[i].getTimestamp()) << "index " << i;
+        EXPECT_EQ(server_[i].getValue(), history[i].getValue());
+    }
+    EXPECT_TRUE(DexcomClient::findGaps(history).empty());
+}
+
+// One missed reading up to most of a day offline
+INSTANTIATE_TEST_SUITE_P(Outages, DexcomBackfillOutageTest, ::testing::Values(1, 2, 6, 12, 48, 250));
+
+TEST_F(DexcomBackfillTest, CompleteHistoryMakesNoRequest) {
+    std::vector<GlucoseReading> history(server_.begin(), server_.begin() + 50);
+    EXPECT_TRUE(DexcomClient::findGaps(history).empty());
+    EXPECT_EQ(0u, client_->backfill(history, now_));
+    EXPECT_EQ(0, requests_);
+    EXPECT_EQ(50u, history.size());
+}
+
+TEST_F(DexcomBackfillTest, SeveralHolesShareOneRequest) {
+    std::vector<GlucoseReading> history;
+    for (size_t i = 0; i < 60; ++i) {
+        if (!(i >= 5 && i < 8) && !(i >= 30 && i < 42)) {
+            history.push_back(server_[i]);
+        }
+    }
+    ASSERT_EQ(2u, DexcomClient::findGaps(history).size());
+
+    EXPECT_EQ(15u, client_->backfill(history, now_));
+    EXPECT_EQ(1, requests_);
+    EXPECT_EQ(42u, served_.size());  // up to the oldest hole, not beyond
+    ASSERT_EQ(60u, history.size());
+    EXPECT_TRUE(DexcomClient::findGaps(history).empty());
+}
+
+TEST_F(DexcomBackfillTest, HoleTheServerAlsoLacksStays) {
+    std::vector<GlucoseReading> history = historyWithOutage(40, 10, 4);
+    server_ = historyWithOutage(SERVER_READINGS, 10, 4);  // sensor signal loss
+
+    EXPECT_EQ(0u, client_->backfill(history, now_));
+    EXPECT_EQ(1, requests_);
+    EXPECT_EQ(36u, history.size());
+    EXPECT_EQ(1u, DexcomClient::findGaps(history).size());
+}
+
+TEST_F(DexcomBackfillTest, OutageLongerThanTheApiWindowIsClamped) {
+    std::vector<GlucoseReading> history = historyWithOutage(SERVER_READINGS, 2, 300);
+    ASSERT_EQ(300u, DexcomClient::findGaps(history)[0].missing);
+
+    const size_t added = client_->backfill(history, now_);
+    EXPECT_EQ(1, requests_);
+    EXPECT_EQ(static_cast<unsigned>(DexcomConst::MAX_MINUTES), lastMinutes_);
+    EXPECT_EQ(static_cast<unsigned>(DexcomConst::MAX_MAX_COUNT), lastMaxCount_);
+    EXPECT_EQ(DexcomConst::MAX_MAX_COUNT - 2u, added);  // what the last 24 hours still hold
+    EXPECT_EQ(1u, DexcomClient::findGaps(history).size());
+}
+
+TEST_F(DexcomBackfillTest, NewerReadingsFromTheWindowAreMergedToo) {
+    // The head of the history is stale as well as holed
+    std::vector<GlucoseReading> history = historyWithOutage(30, 10, 4);
+    history.erase(history.begin(), history.begin() + 2);
+    EXPECT_EQ(6u, client_->backfill(history, now_));
+    EXPECT_EQ(1, requests_);
+    ASSERT_EQ(30u, history.size());
+    EXPECT_EQ(server_.front().getTimestamp(), history.front().getTimestamp());
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cstring>
+#include <memory>
+#include "dns_cache.h"
+#include "mock_dns_resolver.h"
+
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::Return;
+using ::testing::SetArgReferee;
+using ::testing::StrEq;
+
+class DnsCacheTest : public ::testing::Test {
+protected:
+    static constexpr time_t NOW = 1700000000;
+    static constexpr const char* HOST = "shareous1.dexcom.com";
+    static constexpr uint32_t IP_A = 0x0A0B0C0D;
+    static constexpr uint32_t IP_B = 0x01020304;
+
+    void SetUp() override {
+        resolver_ = std::make_shared<MockDnsResolver>();
+        std::memset(&state_, 0xA5, sizeof(state_)); // as after a cold boot
+        cache_ = std::make_unique<DnsCache>(resolver_, state_);
+        cache_->clear();
+    }
+
+    void expectResolve(const char* host, uint32_t ip, uint32_t ttl) {
+        EXPECT_CALL(*resolver_, resolve(StrEq(host), _, _))
+            .WillOnce(DoAll(SetArgReferee<1>(ip), SetArgReferee<2>(ttl), Return(true)))
+            .RetiresOnSaturation();
+    }
+
+    std::shared_ptr<MockDnsResolver> resolver_;
+    DnsCacheState state_;
+    std::unique_ptr<DnsCache> cache_;
+};
+
+TEST_F(DnsCacheTest, HitWithinTtlSkipsResolver) {
+    expectResolve(HOST, IP_A, 300);
+    uint32_t ip = 0;
+    ASSERT_TRUE(cache_->lookup(HOST, NOW, ip));
+    EXPECT_EQ(IP_A, ip);
+
+    ip = 0;
+    ASSERT_TRUE(cache_->lookup(HOST, NOW + 299, ip));
+    EXPECT_EQ(IP_A, ip);
+    EXPECT_TRUE(cache_->contains(HOST, NOW + 299));
+}
+
+TEST_F(DnsCacheTest, ExpiredEntryIsResolvedAgain) {
+    ::testing::InSequence seq;
+    expectResolve(HOST, IP_A, 300);
+    expectResolve(HOST, IP_B, 300);
+    uint32_t ip = 0;
+    cache_->lookup(HOST, NOW, ip);
+    EXPECT_FALSE(cache_->contains(HOST, NOW + 300));
+    ASSERT_TRUE(cache_->lookup(HOST, NOW + 300, ip));
+    EXPECT_EQ(IP_B, ip);
+}
+
+TEST_F(DnsCacheTest, TtlIsClamped) {
+    expectResolve(HOST, IP_A, 0);
+    uint32_t ip = 0;
+    cache_->lookup(HOST, NOW, ip);
+    EXPECT_TRUE(cache_->contains(HOST, NOW + DnsCache::MIN_TTL_S - 1));
+
+    expectResolve("other.example", IP_B, 7 * 24 * 3600);
+    cache_->lookup("other.example", NOW, ip);
+    EXPECT_FALSE(cache_->contains("other.example", NOW + DnsCache::MAX_TTL_S));
+}
+
+TEST_F(DnsCacheTest, FailedRefreshServesStaleEntry) {
+    expectResolve(HOST, IP_A, 60);
+    uint32_t ip = 0;
+    cache_->lookup(HOST, NOW, ip);
+
+    EXPECT_CALL(*resolver_, resolve(StrEq(HOST), _, _)).WillOnce(Return(false));
+    ip = 0;
+    ASSERT_TRUE(cache_->lookup(HOST, NOW + 3600, ip));
+    EXPECT_EQ(IP_A, ip);
+}
+
+TEST_F(DnsCacheTest, FailedLookupWithoutEntryFails) {
+    EXPECT_CALL(*resolver_, resolve(_, _, _)).WillOnce(Return(false));
+    uint32_t ip = 0;
+    EXPECT_FALSE(cache_->lookup(HOST, NOW, ip));
+}
+
+TEST_F(DnsCacheTest, InvalidateForcesLookup) {
+    ::testing::InSequence seq;
+    expectResolve(HOST, IP_A, 300);
+    expectResolve(HOST, IP_B, 300);
+    uint32_t ip = 0;
+    cache_->lookup(HOST, NOW, ip);
+    cache_->invalidate(HOST);
+    EXPECT_FALSE(cache_->contains(HOST, NOW));
+    cache_->lookup(HOST, NOW + 1, ip);
+    EXPECT_EQ(IP_B, ip);
+}
+
+TEST_F(DnsCacheTest, UnknownClockBypassesCache) {
+    EXPECT_CALL(*resolver_, resolve(StrEq(HOST), _, _))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgReferee<1>(IP_A), SetArgReferee<2>(300u), Return(true)));
+    uint32_t ip = 0;
+    ASSERT_TRUE(cache_->lookup(HOST, 0, ip));
+    ASSERT_TRUE(cache_->lookup(HOST, 0, ip));
+    EXPECT_EQ(IP_A, ip);
+    EXPECT_FALSE(cache_->contains(HOST, NOW));
+}
+
+TEST_F(DnsCacheTest, FullCacheEvictsEntryExpiringFirst) {
+    static_assert(DnsCacheState::CAPACITY == 2, "test assumes two slots");
+    expectResolve("a.example", IP_A, 600);
+    expectResolve("b.example", IP_B, 120);
+    expectResolve("c.example", IP_A, 300);
+    uint32_t ip = 0;
+    cache_->lookup("a.example", NOW, ip);
+    cache_->lookup("b.example", NOW, ip);
+    cache_->lookup("c.example", NOW, ip);
+    EXPECT_TRUE(cache_->contains("a.example", NOW));
+    EXPECT_FALSE(cache_->contains("b.example", NOW));
+    EXPECT_TRUE(cache_->contains("c.example", NOW));
+}
+
+TEST_F(DnsCacheTest, EntriesSurviveRebindingToSameState) {
+    expectResolve(HOST, IP_A, 300);
+    uint32_t ip = 0;
+    cache_->lookup(HOST, NOW, ip);
+
+    // A new cache over the same (RTC-resident) state after deep sleep
+    DnsCache afterWake(resolver_, state_);
+    ip = 0;
+    ASSERT_TRUE(afterWake.lookup(HOST, NOW + 100, ip));
+    EXPECT_EQ(IP_A, ip);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#include "dns_message.h"
+
+class DnsMessageTest : public ::testing::Test {
+protected:
+    static constexpr uint16_t ID = 0xBEEF;
+
+    // Response for shareous1.dexcom.com: CNAME (TTL 300) -> A 52.1.2.3 (TTL 60)
+    std::vector<uint8_t> response() const {
+        std::vector<uint8_t> msg = {
+            0xBE, 0xEF, 0x81, 0x80, 0x00, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,
+            9, 's', 'h', 'a', 'r', 'e', 'o', 'u', 's', '1', 6, 'd', 'e', 'x', 'c', 'o', 'm', 3, 'c', 'o', 'm', 0,
+            0x00, 0x01, 0x00, 0x01,
+            // CNAME answer, name is a pointer to the question
+            0xC0, 0x0C, 0x00, 0x05, 0x00, 0x01, 0x00, 0x00, 0x01, 0x2C, 0x00, 0x06,
+            3, 'e', 'l', 'b', 0xC0, 0x16,
+            // A answer for the alias
+            0xC0, 0x2E, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x3C, 0x00, 0x04,
+            52, 1, 2, 3,
+        };
+        return msg;
+    }
+};
+
+TEST_F(DnsMessageTest, BuildsQuery) {
+    uint8_t out[DnsMessage::MAX_MESSAGE_SIZE];
+    size_t size = DnsMessage::buildQuery("shareous1.dexcom.com", ID, out, sizeof(out));
+    const std::vector<uint8_t> expected = {
+        0xBE, 0xEF, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        9, 's', 'h', 'a', 'r', 'e', 'o', 'u', 's', '1', 6, 'd', 'e', 'x', 'c', 'o', 'm', 3, 'c', 'o', 'm', 0,
+        0x00, 0x01, 0x00, 0x01,
+    };
+    ASSERT_EQ(expected.size(), size);
+    EXPECT_EQ(0, std::memcmp(expected.data(), out, size));
+}
+
+TEST_F(DnsMessageTest, RejectsMalformedHostsAndSmallBuffers) {
+    uint8_t out[64];
+    EXPECT_EQ(0u, DnsMessage::buildQuery("", ID, out, sizeof(out)));
+    EXPECT_EQ(0u, DnsMessage::buildQuery("a..b", ID, out, sizeof(out)));
+    EXPECT_EQ(0u, DnsMessage::buildQuery("shareous1.dexcom.com", ID, out, 20));
+    std::string longLabel(64, 'x');
+    EXPECT_EQ(0u, DnsMessage::buildQuery(longLabel.c_str(), ID, out, sizeof(out)));
+}
+
+TEST_F(DnsMessageTest, ParsesAddressBehindCname) {
+    auto msg = response();
+    uint32_t ip = 0;
+    uint32_t ttl = 0;
+    ASSERT_TRUE(DnsMessage::parseResponse(msg.data(), msg.size(), ID, ip, ttl));
+    const uint8_t* octets = reinterpret_cast<const uint8_t*>(&ip);
+    EXPECT_EQ(52, octets[0]);
+    EXPECT_EQ(3, octets[3]);
+    EXPECT_EQ(60u, ttl); // the shorter of the CNAME and A TTLs
+}
+
+TEST_F(DnsMessageTest, RejectsOtherQueryId) {
+    auto msg = response();
+    uint32_t ip = 0, ttl = 0;
+    EXPECT_FALSE(DnsMessage::parseResponse(msg.data(), msg.size(), ID + 1, ip, ttl));
+}
+
+TEST_F(DnsMessageTest, RejectsErrorRcode) {
+    auto msg = response();
+    msg[3] = 0x83; // NXDOMAIN
+    uint32_t ip = 0, ttl = 0;
+    EXPECT_FALSE(DnsMessage::parseResponse(msg.data(), msg.size(), ID, ip, ttl));
+}
+
+TEST_F(DnsMessageTest, RejectsEveryTruncation) {
+    auto msg = response();
+    uint32_t ip = 0, ttl = 0;
+    for (size_t size = 0; size < msg.size(); ++size) {
+        EXPECT_FALSE(DnsMessage::parseResponse(msg.data(), size, ID, ip, ttl)) << "size " << size;
+    }
+}
+
+TEST_F(DnsMessageTest, NoAddressRecordFails) {
+    auto msg = response();
+    msg[7] = 0x01; // only the CNAME answer
+    msg.resize(msg.size() - 16);
+    uint32_t ip = 0, ttl = 0;
+    EXPECT_FALSE(DnsMessage::parseResponse(msg.data(), msg.size(), ID, ip, ttl));
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "event_scheduler.h"
+#include "../mocks/fake_clock.h"
+
+namespace {
+constexpr EventMask WIFI_UP = 1u << 0;
+constexpr EventMask TIME_SYNCED = 1u << 1;
+constexpr EventMask CLIENT_READY = 1u << 2;
+constexpr EventMask READING_DUE = 1u << 3;
+
+int wakeCount = 0;
+void countWake() { ++wakeCount; }
+}
+
+class EventSchedulerTest : public ::testing::Test {
+protected:
+    std::shared_ptr<FakeClock> clock_ = std::make_shared<FakeClock>(1000);
+    EventScheduler scheduler_{clock_};
+    std::vector<std::string> trace_;
+
+    EventScheduler::TaskFn record(const std::string& name) {
+        return [this, name]() { trace_.push_back(name + "@" + std::to_string(clock_->millis())); };
+    }
+};
+
+TEST_F(EventSchedulerTest, TaskWaitsForAllPrerequisites) {
+    scheduler_.addTask("client", WIFI_UP | TIME_SYNCED, record("client"), 0, true);
+
+    scheduler_.post(WIFI_UP);
+    scheduler_.runOnce();
+    EXPECT_TRUE(trace_.empty());
+
+    scheduler_.post(TIME_SYNCED);
+    scheduler_.runOnce();
+    ASSERT_EQ(1u, trace_.size());
+    EXPECT_STREQ("client", scheduler_.lastTaskName());
+}
+
+TEST_F(EventSchedulerTest, OneShotTaskRunsOnce) {
+    scheduler_.addTask("dns", WIFI_UP, record("dns"), 0, true);
+    scheduler_.post(WIFI_UP);
+    scheduler_.runOnce();
+    scheduler_.runOnce();
+    EXPECT_EQ(1u, trace_.size());
+}
+
+TEST_F(EventSchedulerTest, ConsumedEventIsClearedAndRearmsOnRepost) {
+    scheduler_.addTask("fetch", CLIENT_READY | READING_DUE, record("fetch"), READING_DUE);
+    scheduler_.post(CLIENT_READY | READING_DUE);
+
+    scheduler_.runOnce();
+    EXPECT_EQ(1u, trace_.size());
+    EXPECT_FALSE(scheduler_.isSet(READING_DUE));
+    EXPECT_TRUE(scheduler_.isSet(CLIENT_READY));
+
+    scheduler_.runOnce();
+    EXPECT_EQ(1u, trace_.size());
+
+    scheduler_.post(READING_DUE);
+    scheduler_.runOnce();
+    EXPECT_EQ(2u, trace_.size());
+}
+
+TEST_F(EventSchedulerTest, TasksUnlockEachOtherWithinOneRun) {
+    scheduler_.addTask("fetch", CLIENT_READY | READING_DUE, record("fetch"), READING_DUE);
+    scheduler_.addTask("client", WIFI_UP, [this]() {
+        trace_.push_back("client");
+        scheduler_.post(CLIENT_READY);
+    }, 0, true);
+
+    scheduler_.post(WIFI_UP | READING_DUE);
+    scheduler_.runOnce();
+    ASSERT_EQ(2u, trace_.size());
+    EXPECT_EQ("client", trace_[0]);
+    EXPECT_EQ("fetch@1000", trace_[1]);
+}
+
+TEST_F(EventSchedulerTest, TimersFireWhenDueAndReportWait) {
+    scheduler_.addTask("fetch", READING_DUE, record("fetch"), READING_DUE);
+    EXPECT_EQ(EventScheduler::NO_DEADLINE, scheduler_.runOnce());
+
+    ASSERT_TRUE(scheduler_.postAfter(READING_DUE, 300000));
+    EXPECT_EQ(300000u, scheduler_.runOnce());
+
+    clock_->advance(299999);
+    EXPECT_EQ(1u, scheduler_.runOnce());
+    EXPECT_TRUE(trace_.empty());
+
+    clock_->advance(1);
+    EXPECT_EQ(EventScheduler::NO_DEADLINE, scheduler_.runOnce());
+    ASSERT_EQ(1u, trace_.size());
+    EXPECT_EQ("fetch@301000", trace_[0]);
+}
+
+TEST_F(EventSchedulerTest, PostAfterReplacesPendingTimerForSameEvents) {
+    scheduler_.postAfter(READING_DUE, 1000);
+    scheduler_.postAfter(READING_DUE, 5000);
+    EXPECT_EQ(5000u, scheduler_.runOnce());
+
+    scheduler_.cancelTimer(READING_DUE);
+    EXPECT_EQ(EventScheduler::NO_DEADLINE, scheduler_.runOnce());
+}
+
+TEST_F(EventSchedulerTest, TimersSurviveMillisWrapAround) {
+    clock_->set(UINT32_MAX - 100);
+    scheduler_.postAfter(READING_DUE, 200);
+    EXPECT_EQ(200u, scheduler_.runOnce());
+    clock_->advance(150); // wrapped past zero
+    EXPECT_EQ(50u, scheduler_.runOnce());
+    clock_->advance(50);
+    scheduler_.runOnce();
+    EXPECT_TRUE(scheduler_.isSet(READING_DUE));
+}
+
+TEST_F(EventSchedulerTest, TaskAndTimerTablesAreBounded) {
+    for (size_t i = 0; i < EventScheduler::MAX_TASKS; ++i) {
+        EXPECT_TRUE(scheduler_.addTask("t", WIFI_UP, [] {}, 0, true));
+    }
+    EXPECT_FALSE(scheduler_.addTask("overflow", WIFI_UP, [] {}));
+
+    for (size_t i = 0; i < EventScheduler::MAX_TIMERS; ++i) {
+        EXPECT_TRUE(scheduler_.postAfter(1u << (i + 8), 10));
+    }
+    EXPECT_FALSE(scheduler_.postAfter(1u << 31, 10));
+}
+
+TEST_F(EventSchedulerTest, PostCallsWakeHook) {
+    wakeCount = 0;
+    scheduler_.setWakeHook(countWake);
+    scheduler_.post(WIFI_UP);
+    EXPECT_EQ(1, wakeCount);
+}
+
+/**
+ * Boot sequence from main.cpp with WiFi up at +800 ms and NTP at +1500 ms:
+ * DNS runs as soon as WiFi is up, the first fetch runs the moment time is synced.
+ */
+TEST_F(EventSchedulerTest, BootSequenceRunsWorkAsSoonAsPrerequisitesAreMet) {
+    scheduler_.addTask("time_sync", WIFI_UP, record("time_sync"), 0, true);
+    scheduler_.addTask("dns", WIFI_UP, record("dns"), 0, true);
+    scheduler_.addTask("client", WIFI_UP | TIME_SYNCED, [this]() {
+        trace_.push_back("client@" + std::to_string(clock_->millis()));
+        scheduler_.post(CLIENT_READY);
+    }, 0, true);
+    scheduler_.addTask("fetch", WIFI_UP | CLIENT_READY | READING_DUE, [this]() {
+        trace_.push_back("fetch@" + std::to_string(clock_->millis()));
+        scheduler_.postAfter(READING_DUE, 300000);
+    }, READING_DUE);
+
+    scheduler_.post(READING_DUE);
+    scheduler_.runOnce();
+    EXPECT_TRUE(trace_.empty());
+
+    clock_->advance(800);
+    scheduler_.post(WIFI_UP);
+    scheduler_.runOnce();
+    EXPECT_EQ((std::vector<std::string>{"time_sync@1800", "dns@1800"}), trace_);
+
+    clock_->advance(700);
+    scheduler_.post(TIME_SYNCED);
+    uint32_t wait = scheduler_.runOnce();
+    EXPECT_EQ((std::vector<std::string>{"time_sync@1800", "dns@1800", "client@2500", "fetch@2500"}), trace_);
+    EXPECT_EQ(300000u, wait);
+}
@@ -0,0 +1,318 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "follower_poller.h"
+#include "mock_glucose_reading_parser.h"
+#include "mock_http_client.h"
+
+namespace {
+
+constexpr time_t START = 1700000000;
+constexpr time_t UPLOAD_DELAY_S = 5;  // a reading shows up on the server this long after its WT
+
+/// Value of "key":"value" in a JSON body, or empty.
+std::string field(const std::string& body, const std::string& key) {
+    const std::string marker = "\"" + key + "\":\"";
+    const size_t start = body.find(marker);
+    if (start == std::string::npos) {
+        return "";
+    }
+    const size_t from = start + marker.size();
+    return body.substr(from, body.find('"', from) - from);
+}
+
+}  // namespace
+
+/**
+ * A Share server for several accounts behind one mock connection. Account k's sensor
+ * uploads every 5 minutes at its own phase; the parser mock turns each readings
+ * response into that account's readings inside the requested window.
+ */
+class FollowerPollerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        http_ = std::make_shared<testing::NiceMock<MockHttpClient>>();
+        parser_ = std::make_shared<testing::NiceMock<MockGlucoseReadingParser>>();
+        ON_CALL(*http_, isConnected()).WillByDefault(testing::Invoke([this] { return connected_; }));
+        ON_CALL(*http_, connect(testing::_, testing::_)).WillByDefault(testing::Invoke([this](const std::string&, uint16_t) {
+            ++connects_;
+            connected_ = true;
+            return true;
+        }));
+        ON_CALL(*http_, post(testing::_, testing::_, testing::_))
+            .WillByDefault(testing::Invoke([this](const std::string& url, const std::string& body,
+                                                  const std::map<std::string, std::string>&) {
+                return respond(url, body);
+            }));
+        ON_CALL(*http_, sendPipelined(testing::_))
+            .WillByDefault(testing::Invoke([this](const std::vector<HttpRequest>& requests) {
+                ++pipelines_;
+                std::vector<HttpResponse> responses;
+                for (const auto& request : requests) {
+                    responses.push_back(respond(request.url, request.body.value_or("")));
+                }
+                return responses;
+            }));
+        ON_CALL(*parser_, parse(testing::_)).WillByDefault(testing::Invoke([this](const std::string& response) {
+            return serve(response);
+        }));
+        poller_ = std::make_unique<FollowerPoller>(http_, parser_);
+    }
+
+    time_t phaseOf(size_t account) const {
+        return samePhase_ ? 13 : static_cast<time_t>((account * 97 + 13) % 300);
+    }
+
+    void addAccounts(size_t count) {
+        for (size_t k = 0; k < count; ++k) {
+            ASSERT_EQ(static_cast<int>(k), poller_->addAccount({"follower" + std::to_string(k), "", "secret", ""}));
+        }
+        fetches_.assign(count, 0);
+        newReadings_.assign(count, 0);
+        lagTotal_.assign(count, 0);
+        newestServed_.assign(count, 0);
+        failing_.assign(count, false);
+    }
+
+    HttpResponse respond(const std::string& url, const std::string& body) {
+        ++requests_;
+        if (url.find(DexcomConst::DEXCOM_AUTHENTICATE_ENDPOINT) != std::string::npos) {
+            return HttpResponse{200, "\"acct-" + field(body, "accountName").substr(8) + "\"", {}};
+        }
+        if (url.find(DexcomConst::DEXCOM_LOGIN_ID_ENDPOINT) != std::string::npos) {
+            ++logins_;
+            expired_.erase(static_cast<unsigned>(std::stoul(field(body, "accountId").substr(5))));
+            return HttpResponse{200, "\"session-" + field(body, "accountId").substr(5) + "\"", {}};
+        }
+        unsigned account = 0;
+        unsigned minutes = 0;
+        unsigned maxCount = 0;
+        sscanf(url.c_str() + url.find("sessionId="), "sessionId=session-%u&minutes=%u&maxCount=%u", &account, &minutes,
+               &maxCount);
+        if (expired_.count(account)) {
+            ++staleFetches_;
+            return HttpResponse{500, "", {}};
+        }
+        if (failing_[account]) {
+            return HttpResponse{500, "", {}};
+        }
+        ++fetches_[account];
+        return HttpResponse{200, std::to_string(account) + " " + std::to_string(minutes) + " " + std::to_string(maxCount),
+                            {}};
+    }
+
+    std::vector<GlucoseReading> serve(const std::string& response) {
+        unsigned account = 0;
+        unsigned minutes = 0;
+        unsigned maxCount = 0;
+        sscanf(response.c_str(), "%u %u %u", &account, &minutes, &maxCount);
+        // Newest uploaded reading, then back through the window
+        const time_t phase = phaseOf(account);
+        time_t t = now_ - UPLOAD_DELAY_S;
+        t -= ((t - phase) % 300 + 300) % 300;
+        std::vector<GlucoseReading> readings;
+        for (; t >= now_ - static_cast<time_t>(minutes) * 60 && readings.size() < maxCount; t -= 300) {
+            readings.emplace_back(static_cast<uint16_t>(100 + (t / 300) % 80), DexcomConst::Flat, t);
+            if (t > newestServed_[account] && newestServed_[account] != 0) {
+                ++newReadings_[account];
+                lagTotal_[account] += now_ - t;
+            }
+        }
+        if (!readings.empty() && readings.front().getTimestamp() > newestServed_[account]) {
+            newestServed_[account] = readings.front().getTimestamp();
+        }
+        return readings;
+    }
+
+    /// Runs the poller until @p end, jumping straight to each due time.
+    void runUntil(time_t end, bool pipelined = false) {
+        while (now_ < end) {
+            if (pipelined) {
+                poller_->pollAllDue(now_);
+            } else {
+                while (poller_->pollDue(now_) >= 0) {
+                }
+            }
+            now_ = std::max(now_ + 1, poller_->nextPollAt());
+        }
+    }
+
+    std::shared_ptr<testing::NiceMock<MockHttpClient>> http_;
+    std::shared_ptr<testing::NiceMock<MockGlucoseReadingParser>> parser_;
+    std::unique_ptr<FollowerPoller> poller_;
+    time_t now_ = START;
+    bool connected_ = false;
+    bool samePhase_ = false;
+    std::set<unsigned> expired_;  // sessions the server has dropped
+    int pipelines_ = 0;
+    int connects_ = 0;
+    int requests_ = 0;
+    int logins_ = 0;
+    int staleFetches_ = 0;  // readings requests sent with a session the server dropped
+    std::vector<int> fetches_;
+    std::vector<int> newReadings_;  // readings first served after the initial fetch
+    std::vector<long> lagTotal_;    // seconds from WT to first being served, summed
+    std::vector<time_t> newestServed_;
+    std::vector<bool> failing_;
+};
+
+class FollowerPollerScaleTest : public FollowerPollerTest, public ::testing::WithParamInterface<size_t> {};
+
+TEST_P(FollowerPollerScaleTest, FollowsEveryAccountOverOneConnection) {
+    const size_t accounts = GetParam();
+    addAccounts(accounts);
+    runUntil(START + 6 * 3600);
+
+    EXPECT_EQ(1, connects_);
+    EXPECT_EQ(static_cast<int>(accounts), logins_);
+    for (size_t k = 0; k < accounts; ++k) {
+        const auto& history = poller_->history(k);
+        ASSERT_EQ(FollowerPoller::HISTORY_CAPACITY, history.size()) << "account " << k;
+        EXPECT_TRUE(DexcomClient::findGaps(history).empty()) << "account " << k;
+        EXPECT_EQ(newestServed_[k], history.front().getTimestamp());
+        EXPECT_EQ("session-" + std::to_string(k), poller_->sessionId(k));
+
+        // Each account's polls follow its own sensor's phase
+        EXPECT_EQ(static_cast<uint32_t>(phaseOf(k)), poller_->phaseSeconds(k));
+        ASSERT_GT(newReadings_[k], 60);
+        EXPECT_LT(fetches_[k], newReadings_[k] * 13 / 10) << "account " << k;
+        EXPECT_LT(lagTotal_[k] / newReadings_[k], 30) << "account " << k;
+    }
+    EXPECT_LE(poller_->footprintBytes(),
+              FollowerPoller::MAX_FOLLOWERS * sizeof(void*) + accounts * 1024);
+}
+
+INSTANTIATE_TEST_SUITE_P(Accounts, FollowerPollerScaleTest, ::testing::Values(2, 3, 4, 5, 6, 7, 8));
+
+TEST_F(FollowerPollerTest, PollsOneAccountPerCall) {
+    addAccounts(3);
+    std::set<int> polled;
+    for (int i = 0; i < 3; ++i) {
+        const int before = requests_;
+        polled.insert(poller_->pollDue(now_));
+        EXPECT_EQ(3, requests_ - before);  // authenticate, log in, readings: one account only
+    }
+    EXPECT_EQ((std::set<int>{0, 1, 2}), polled);
+    EXPECT_EQ(-1, poller_->pollDue(now_));
+}
+
+TEST_F(FollowerPollerTest, FootprintGrowsLinearly) {
+    std::vector<size_t> footprints;
+    for (size_t k = 0; k < FollowerPoller::MAX_FOLLOWERS; ++k) {
+        poller_->addAccount({"follower" + std::to_string(k), "", "secret", ""});
+        footprints.push_back(poller_->footprintBytes());
+    }
+    EXPECT_EQ(-1, poller_->addAccount({"follower8", "", "secret", ""}));
+    const size_t perAccount = footprints[1] - footprints[0];
+    for (size_t k = 1; k < footprints.size(); ++k) {
+        EXPECT_EQ(perAccount, footprints[k] - footprints[k - 1]);
+    }
+    printf("[bench] follower poller: %zu bytes per account before login\n", perAccount);
+}
+
+TEST_F(FollowerPollerTest, FailingAccountDoesNotHoldUpTheOthers) {
+    addAccounts(3);
+    runUntil(START + 1800);
+    failing_[1] = true;
+    const int healthyBefore = fetches_[0] + fetches_[2];
+    const time_t stuckAt = poller_->history(1).front().getTimestamp();
+    runUntil(START + 3600);
+
+    EXPECT_EQ(stuckAt, poller_->history(1).front().getTimestamp());
+    EXPECT_GE(fetches_[0] + fetches_[2] - healthyBefore, 2 * 5);
+    EXPECT_EQ(newestServed_[0], poller_->history(0).front().getTimestamp());
+    EXPECT_EQ(newestServed_[2], poller_->history(2).front().getTimestamp());
+
+    // Back online: the next poll catches up on everything missed
+    failing_[1] = false;
+    runUntil(START + 2 * 3600);
+    EXPECT_TRUE(DexcomClient::findGaps(poller_->history(1)).empty());
+    EXPECT_EQ(newestServed_[1], poller_->history(1).front().getTimestamp());
+    EXPECT_EQ(1, connects_);
+}
+
+TEST_F(FollowerPollerTest, RestoredSessionSkipsLogin) {
+    poller_->addAccount({"", "acct-0", "secret", "session-0"});
+    fetches_.assign(1, 0);
+    newReadings_.assign(1, 0);
+    lagTotal_.assign(1, 0);
+    newestServed_.assign(1, 0);
+    failing_.assign(1, false);
+
+    EXPECT_EQ(0, poller_->pollDue(now_));
+    EXPECT_EQ(0, logins_);
+    EXPECT_EQ(1, fetches_[0]);
+    EXPECT_EQ(FollowerPoller::HISTORY_CAPACITY, poller_->history(0).size());
+}
+
+TEST_F(FollowerPollerTest, AccountsDueTogetherShareOnePipelinedRoundTrip) {
+    samePhase_ = true;
+    addAccounts(4);
+    runUntil(START + 3 * 3600, true);
+
+    EXPECT_EQ(1, connects_);
+    EXPECT_EQ(4, logins_);
+    ASSERT_GT(newReadings_[0], 30);
+    // One pipeline per cycle for all four, instead of four round trips
+    EXPECT_GE(pipelines_, newReadings_[0]);
+    EXPECT_LT(pipelines_, newReadings_[0] * 13 / 10);
+    for (size_t k = 0; k < 4; ++k) {
+        EXPECT_TRUE(DexcomClient::findGaps(poller_->history(k)).empty());
+        EXPECT_EQ(newestServed_[k], poller_->history(k).front().getTimestamp());
+        EXPECT_EQ(newReadings_[0], newReadings_[k]);
+    }
+}
+
+TEST_F(FollowerPollerTest, ExpiredSessionInAPipelineOnlyLogsThatAccountInAgain) {
+    samePhase_ = true;
+    addAccounts(3);
+    runUntil(START + 1800, true);
+    const int loginsBefore = logins_;
+    const int pipelinesBefore = pipelines_;
+    expired_.insert(1);
+
+    runUntil(START + 3600, true);
+
+    EXPECT_EQ(loginsBefore + 1, logins_);
+    EXPECT_EQ(1, staleFetches_);  // the stale session is not retried before logging in
+    EXPECT_GT(pipelines_, pipelinesBefore);
+    for (size_t k = 0; k < 3; ++k) {
+        EXPECT_TRUE(DexcomClient::findGaps(poller_->history(k)).empty()) << "account " << k;
+        EXPECT_EQ(newestServed_[k], poller_->history(k).front().getTimestamp()) << "account " << k;
+        EXPECT_EQ(newReadings_[0], newReadings_[k]) << "account " << k;
+    }
+}
+
+TEST_F(FollowerPollerTest, DroppedPipelineKeepsSessionsAndBacksOff) {
+    samePhase_ = true;
+    addAccounts(3);
+    runUntil(START + 1800, true);
+    const int loginsBefore = logins_;
+    const int requestsBefore = requests_;
+
+    // The connection drops before any response arrives
+    EXPECT_CALL(*http_, sendPipelined(testing::_))
+        .WillOnce(testing::Return(std::vector<HttpResponse>(3, HttpResponse{500, HttpTransport::CONNECTION_CLOSED, {}})))
+        .WillRepeatedly(testing::DoDefault());
+    const time_t dropAt = poller_->nextPollAt();
+    EXPECT_EQ(3u, poller_->pollAllDue(dropAt));
+
+    EXPECT_EQ(requestsBefore, requests_);
+    EXPECT_GT(poller_->nextPollAt(), dropAt);  // rescheduled, not left due for an immediate re-login
+    for (size_t k = 0; k < 3; ++k) {
+        EXPECT_EQ("session-" + std::to_string(k), poller_->sessionId(k));
+    }
+
+    now_ = dropAt;
+    runUntil(START + 3600, true);
+    EXPECT_EQ(loginsBefore, logins_);
+    for (size_t k = 0; k < 3; ++k) {
+        EXPECT_TRUE(DexcomClient::findGaps(poller_->history(k)).empty()) << "account " << k;
+        EXPECT_EQ(newestServed_[k], poller_->history(k).front().getTimestamp()) << "account " << k;
+    }
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include "dexcom_constants.h"
+#include "font_atlas.h"
+#include "framebuffer_snapshot.h"
+
+namespace {
+
+using Color = Framebuffer::Color;
+
+/// Straightforward per-pixel decode used as the reference for the blitter.
+std::vector<bool> decode(const FontAtlas& atlas, const FontGlyph& glyph) {
+    std::vector<bool> bits;
+    const uint8_t* run = atlas.runs + glyph.offset;
+    const size_t total = static_cast<size_t>(glyph.width) * glyph.height;
+    while (bits.size() < total) {
+        bits.insert(bits.end(), (*run & 0x7F) + 1, (*run & 0x80) != 0);
+        ++run;
+    }
+    return bits;
+}
+
+size_t runPixels(const FontAtlas& atlas, const FontGlyph& glyph, size_t runBytes) {
+    size_t pixels = 0;
+    for (size_t i = 0; i < runBytes; ++i) {
+        pixels += (atlas.runs[glyph.offset + i] & 0x7F) + 1;
+    }
+    return pixels;
+}
+
+} // namespace
+
+class FontAtlasTest : public ::testing::Test {
+protected:
+    std::unique_ptr<Framebuffer> fb_ = std::make_unique<Framebuffer>();
+};
+
+TEST_F(FontAtlasTest, DecodesUtf8) {
+    const char* text = "7\xE2\x86\x97\xE2\x86";
+    EXPECT_EQ(0x37u, TextRenderer::nextCodepoint(text));
+    EXPECT_EQ(0x2197u, TextRenderer::nextCodepoint(text)); // ↗
+    EXPECT_EQ(0xFFFDu, TextRenderer::nextCodepoint(text)); // truncated sequence
+    EXPECT_EQ('\0', *text);
+}
+
+TEST_F(FontAtlasTest, CoversValuesAndTrendArrows) {
+    for (char c : std::string("0123456789.-?")) {
+        EXPECT_NE(nullptr, TextRenderer::find(Fonts::VALUE, static_cast<uint8_t>(c))) << c;
+    }
+    for (const char* arrow : DexcomConst::TREND_ARROWS) {
+        const std::string text = arrow;
+        if (text.empty() || text == "?" || text == "-") {
+            continue; // drawn from the value atlas
+        }
+        for (const char* p = arrow; *p != '\0';) {
+            EXPECT_NE(nullptr, TextRenderer::find(Fonts::ARROWS, TextRenderer::nextCodepoint(p))) << text;
+        }
+    }
+    EXPECT_EQ(nullptr, TextRenderer::find(Fonts::VALUE, 'A'));
+}
+
+TEST_F(FontAtlasTest, RunsEndExactlyAtEachGlyphBox) {
+    for (const FontAtlas* atlas : {&Fonts::VALUE, &Fonts::ARROWS}) {
+        for (uint16_t i = 0; i < atlas->glyphCount; ++i) {
+            const FontGlyph& glyph = atlas->glyphs[i];
+            if (i > 0) {
+                EXPECT_LT(atlas->glyphs[i - 1].codepoint, glyph.codepoint);
+                const FontGlyph& previous = atlas->glyphs[i - 1];
+                EXPECT_EQ(static_cast<size_t>(previous.width) * previous.height,
+                          runPixels(*atlas, previous, glyph.offset - previous.offset));
+            }
+        }
+    }
+}
+
+TEST_F(FontAtlasTest, HandEncodedRunsArePixelExact) {
+    const uint8_t runs[] = {0x82, 0x04, 0x87}; // 3 ink, 5 blank, 8 ink (wraps into row 1)
+    fb_->drawRunLength(runs, 8, 2, 8, 0, Color::Black);
+    EXPECT_EQ(0xE0, fb_->row(0)[1]);
+    EXPECT_EQ(0xFF, fb_->row(1)[1]);
+    EXPECT_EQ(0x00, fb_->row(0)[0]);
+    EXPECT_EQ(0x00, fb_->row(0)[2]);
+}
+
+TEST_F(FontAtlasTest, BlitterMatchesReferenceDecode) {
+    const FontGlyph& glyph = *TextRenderer::find(Fonts::VALUE, '8');
+    const std::vector<bool> bits = decode(Fonts::VALUE, glyph);
+    // Unaligned, clipped left, clipped bottom-right
+    const int16_t positions[][2] = {{13, 7}, {-9, 40}, {Framebuffer::WIDTH - 20, Framebuffer::HEIGHT - 30}};
+    for (const auto& pos : positions) {
+        Framebuffer fb;
+        fb.fillRect(Rect{static_cast<int16_t>(pos[0] + 4), pos[1], 6, glyph.height}, Color::Black);
+        Framebuffer before = fb;
+        fb.drawRunLength(Fonts::VALUE.runs + glyph.offset, glyph.width, glyph.height, pos[0], pos[1], Color::Black);
+        for (int y = -2; y < glyph.height + 2; ++y) {
+            for (int x = -2; x < glyph.width + 2; ++x) {
+                const int16_t px = static_cast<int16_t>(pos[0] + x);
+                const int16_t py = static_cast<int16_t>(pos[1] + y);
+                if (px < 0 || py < 0 || px >= Framebuffer::WIDTH || py >= Framebuffer::HEIGHT) {
+                    continue; // clipped
+                }
+                const bool inside = x >= 0 && y >= 0 && x < glyph.width && y < glyph.height;
+                const bool ink = inside && bits[static_cast<size_t>(y) * glyph.width + x];
+                const Color expected = ink ? Color::Black : before.getPixel(px, py);
+                ASSERT_EQ(expected, fb.getPixel(px, py)) << "at " << pos[0] << "," << pos[1] << " +" << x << "," << y;
+            }
+        }
+    }
+}
+
+TEST_F(FontAtlasTest, MeasureMatchesPenAdvance) {
+    const int16_t end = TextRenderer::drawText(*fb_, Fonts::VALUE, 10, 100, "12.7", Color::Black);
+    EXPECT_EQ(10 + TextRenderer::measure(Fonts::VALUE, "12.7"), end);
+    EXPECT_EQ(0, TextRenderer::measure(Fonts::VALUE, "AB"));
+}
+
+TEST_F(FontAtlasTest, ReadingMatchesGolden) {
+    int16_t x = TextRenderer::drawText(*fb_, Fonts::VALUE, 40, 120, "187", Color::Black);
+    TextRenderer::drawText(*fb_, Fonts::ARROWS, static_cast<int16_t>(x + 8), 110, "\xE2\x86\x97", Color::Black);
+    fb_->fillRect(Rect{40, 150, 300, 80}, Color::Black);
+    TextRenderer::drawText(*fb_, Fonts::VALUE, 52, 222, "10.4-?", Color::White);
+    TextRenderer::drawText(*fb_, Fonts::ARROWS, 360, 220, "\xE2\x86\x93\xE2\x86\x93", Color::Black);
+
+    std::string dir = __FILE__;
+    const std::string path = dir.substr(0, dir.find_last_of('/')) + "/../golden/font_reading.pbm";
+    std::vector<uint8_t> expected = FramebufferSnapshot::readFile(path);
+    if (expected.empty() || std::getenv("UPDATE_GOLDEN") != nullptr) {
+        ASSERT_TRUE(FramebufferSnapshot::writePbm(*fb_, path)) << path;
+        return;
+    }
+    EXPECT_TRUE(expected == FramebufferSnapshot::toPbm(*fb_))
+        << "text differs from " << path << "; rerun with UPDATE_GOLDEN=1 if intended";
+}
@@ -0,0 +1,267 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "framebuffer.h"
+#include "framebuffer_snapshot.h"
+
+namespace {
+
+using Color = Framebuffer::Color;
+using BlitMode = Framebuffer::BlitMode;
+
+std::string goldenPath(const char* name) {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.find_last_of('/'));
+    return dir + "/../golden/" + name;
+}
+
+/**
+ * Compares against test/test_desktop/golden/<name>. A missing golden (or UPDATE_GOLDEN
+ * set in the environment) writes the current output instead, to be inspected and committed.
+ */
+void expectMatchesGolden(const Framebuffer& fb, const char* name) {
+    const std::string path = goldenPath(name);
+    std::vector<uint8_t> expected = FramebufferSnapshot::readFile(path);
+    if (expected.empty() || std::getenv("UPDATE_GOLDEN") != nullptr) {
+        ASSERT_TRUE(FramebufferSnapshot::writePbm(fb, path)) << path;
+        return;
+    }
+    std::vector<uint8_t> actual = FramebufferSnapshot::toPbm(fb);
+    ASSERT_EQ(expected.size(), actual.size());
+    EXPECT_TRUE(expected == actual) << "framebuffer differs from " << path
+                                    << "; rerun with UPDATE_GOLDEN=1 if the change is intended";
+}
+
+// 12x10 arrow glyph, deliberately not a byte multiple wide
+const uint8_t ARROW[] = {
+    0x06, 0x00, 0x0F, 0x00, 0x1F, 0x80, 0x3F, 0xC0, 0x7F, 0xE0,
+    0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00,
+};
+
+bool sourceBit(const std::vector<uint8_t>& src, size_t stride, int x, int y) {
+    return src[y * stride + x / 8] & (0x80 >> (x % 8));
+}
+
+} // namespace
+
+TEST(FramebufferTest, StartsWhiteAndClean) {
+    Framebuffer fb;
+    EXPECT_EQ(Color::White, fb.getPixel(0, 0));
+    EXPECT_FALSE(fb.dirty().any());
+}
+
+TEST(FramebufferTest, SetPixelIsMsbFirstAndIgnoresOutOfBounds) {
+    Framebuffer fb;
+    fb.setPixel(9, 2, Color::Black);
+    EXPECT_EQ(0x40, fb.row(2)[1]);
+    EXPECT_EQ(Color::Black, fb.getPixel(9, 2));
+
+    fb.setPixel(-1, 0, Color::Black);
+    fb.setPixel(Framebuffer::WIDTH, 0, Color::Black);
+    fb.setPixel(0, Framebuffer::HEIGHT, Color::Black);
+    EXPECT_EQ(1u, fb.dirty().count());
+}
+
+TEST(FramebufferTest, FillRectMasksPartialBytes) {
+    Framebuffer fb;
+    fb.fillRect(Rect{3, 0, 15, 1}, Color::Black); // columns 3..17
+    EXPECT_EQ(0x1F, fb.row(0)[0]);
+    EXPECT_EQ(0xFF, fb.row(0)[1]);
+    EXPECT_EQ(0xC0, fb.row(0)[2]);
+    EXPECT_EQ(0x00, fb.row(0)[3]);
+
+    fb.fillRect(Rect{5, 0, 2, 1}, Color::White); // within a single byte
+    EXPECT_EQ(0x19, fb.row(0)[0]);
+}
+
+TEST(FramebufferTest, FillRectClipsToPanel) {
+    Framebuffer fb;
+    fb.fillRect(Rect{-10, -10, 20, 20}, Color::Black);
+    fb.fillRect(Rect{Framebuffer::WIDTH - 4, Framebuffer::HEIGHT - 1, 50, 50}, Color::Black);
+    EXPECT_EQ(Color::Black, fb.getPixel(9, 9));
+    EXPECT_EQ(Color::White, fb.getPixel(10, 10));
+    EXPECT_EQ(0x0F, fb.row(Framebuffer::HEIGHT - 1)[Framebuffer::STRIDE - 1]);
+}
+
+TEST(FramebufferTest, UnalignedBlitMatchesPerPixelReference) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> byte(0, 255);
+    const size_t stride = 5;
+    std::vector<uint8_t> src(stride * 9);
+    for (auto& b : src) {
+        b = static_cast<uint8_t>(byte(rng));
+    }
+
+    for (BlitMode mode : {BlitMode::Copy, BlitMode::Set, BlitMode::Clear, BlitMode::Invert}) {
+        for (int16_t dx = -3; dx < 12; ++dx) {
+            for (int16_t srcX = 0; srcX < 8; ++srcX) {
+                Framebuffer fb;
+                fb.fillRect(Rect{0, 0, 64, 16}, Color::Black);
+                fb.fillRect(Rect{4, 2, 20, 6}, Color::White); // mixed background
+                Framebuffer ref = fb;
+
+                const Rect dst{dx, 1, 27, 9};
+                fb.blit(src.data(), stride, srcX, dst, mode);
+
+                for (int y = 0; y < dst.h; ++y) {
+                    for (int x = 0; x < dst.w; ++x) {
+                        const int16_t px = static_cast<int16_t>(dst.x + x);
+                        const int16_t py = static_cast<int16_t>(dst.y + y);
+                        if (px < 0) {
+                            continue;
+                        }
+                        const bool s = sourceBit(src, stride, srcX + x, y);
+                        const bool d = ref.getPixel(px, py) == Color::Black;
+                        bool out = d;
+                        switch (mode) {
+                            case BlitMode::Copy: out = s; break;
+                            case BlitMode::Set: out = d || s; break;
+                            case BlitMode::Clear: out = d && !s; break;
+                            case BlitMode::Invert: out = d != s; break;
+                        }
+                        ref.setPixel(px, py, out ? Color::Black : Color::White);
+                    }
+                }
+                ASSERT_EQ(0, memcmp(ref.data(), fb.data(), Framebuffer::BUFFER_SIZE))
+                    << "mode " << static_cast<int>(mode) << " dx " << dx << " srcX " << srcX;
+            }
+        }
+    }
+}
+
+TEST(FramebufferTest, AlignedCopyBlitTakesWholeBytes) {
+    Framebuffer fb;
+    const uint8_t src[] = {0xA5, 0x3C, 0xFF, 0x00};
+    fb.blit(src, 2, 0, Rect{16, 4, 16, 2}, BlitMode::Copy);
+    EXPECT_EQ(0xA5, fb.row(4)[2]);
+    EXPECT_EQ(0x3C, fb.row(4)[3]);
+    EXPECT_EQ(0xFF, fb.row(5)[2]);
+    EXPECT_EQ(0x00, fb.row(5)[3]);
+}
+
+TEST(FramebufferTest, GlyphIsTransparent) {
+    Framebuffer fb;
+    fb.fillRect(Rect{0, 0, 16, 10}, Color::Black);
+    fb.drawGlyph(ARROW, 12, 10, 2, 0, Color::White);
+    EXPECT_EQ(Color::White, fb.getPixel(2 + 5, 0)); // glyph pixel knocked out
+    EXPECT_EQ(Color::Black, fb.getPixel(2 + 0, 0)); // background kept
+}
+
+TEST(FramebufferTest, LineIsBresenhamAndClipped) {
+    Framebuffer fb;
+    fb.drawLine(0, 0, 7, 3, Color::Black);
+    EXPECT_EQ(0xC0, fb.row(0)[0]);
+    EXPECT_EQ(0x30, fb.row(1)[0]);
+    EXPECT_EQ(0x0C, fb.row(2)[0]);
+    EXPECT_EQ(0x03, fb.row(3)[0]);
+
+    Framebuffer clipped;
+    clipped.drawLine(0, 10, 20, 10, Color::Black, Rect{8, 0, 8, 20});
+    EXPECT_EQ(0x00, clipped.row(10)[0]);
+    EXPECT_EQ(0xFF, clipped.row(10)[1]);
+    EXPECT_EQ(0x00, clipped.row(10)[2]);
+    EXPECT_EQ((Rect{8, 10, 8, 1}), clipped.dirty().bounds());
+}
+
+TEST(FramebufferTest, ScrollLeftShiftsOnlyTheArea) {
+    for (int16_t dx : {1, 3, 8, 13}) {
+        Framebuffer fb;
+        for (int16_t x = 0; x < 64; x += 3) {
+            fb.setPixel(x, 1, Color::Black);
+        }
+        Framebuffer before = fb;
+        const Rect area{5, 0, 50, 4};
+        fb.scrollLeft(area, dx);
+        for (int16_t x = 0; x < 64; ++x) {
+            Color expected = before.getPixel(x, 1);
+            if (x >= area.x && x < area.right()) {
+                expected = x + dx < area.right() ? before.getPixel(static_cast<int16_t>(x + dx), 1) : Color::White;
+            }
+            ASSERT_EQ(expected, fb.getPixel(x, 1)) << "dx " << dx << " x " << x;
+        }
+    }
+}
+
+TEST(FramebufferTest, ClearMarksWholePanelDirty) {
+    Framebuffer fb;
+    fb.setPixel(1, 1, Color::Black);
+    fb.clear(Color::White);
+    ASSERT_EQ(1u, fb.dirty().count());
+    EXPECT_EQ(Framebuffer::bounds(), fb.dirty()[0]);
+}
+
+TEST(FramebufferTest, ReadingScreenMatchesGolden) {
+    Framebuffer fb;
+    fb.clear(Color::White);
+    fb.drawRect(Rect{0, 0, Framebuffer::WIDTH, Framebuffer::HEIGHT}, Color::Black);
+    fb.fillRect(Rect{20, 20, 240, 120}, Color::Black);    // value panel
+    fb.fillRect(Rect{27, 27, 226, 106}, Color::White);
+    for (int i = 0; i < 3; ++i) {
+        fb.drawGlyph(ARROW, 12, 10, static_cast<int16_t>(41 + i * 17), 61, Color::Black);
+    }
+    fb.hLine(20, 300, 760, Color::Black);                 // graph target band
+    fb.hLine(20, 380, 760, Color::Black);
+    for (int16_t x = 20; x < 780; x += 13) {
+        fb.fillRect(Rect{x, static_cast<int16_t>(330 + (x * 7) % 40), 5, 5}, Color::Black);
+    }
+    fb.fillRect(Rect{600, 30, 150, 40}, Color::Black);    // inverted status chip
+    fb.blit(ARROW, 2, 0, Rect{603, 35, 12, 10}, BlitMode::Invert);
+
+    expectMatchesGolden(fb, "reading_screen.pbm");
+}
+
+TEST(SnapshotTest, PbmHeaderAndPayload) {
+    Framebuffer fb;
+    fb.setPixel(0, 0, Color::Black);
+    std::vector<uint8_t> pbm = FramebufferSnapshot::toPbm(fb);
+    const std::string header = "P4\n800 480\n";
+    ASSERT_EQ(header.size() + Framebuffer::BUFFER_SIZE, pbm.size());
+    EXPECT_EQ(header, std::string(pbm.begin(), pbm.begin() + header.size()));
+    EXPECT_EQ(0x80, pbm[header.size()]);
+}
+
+TEST(DirtyTrackerTest, WidensToByteColumnsAndClips) {
+    DirtyTracker dirty(800, 480);
+    dirty.mark(Rect{13, 5, 2, 2});
+    dirty.mark(Rect{-5, 470, 10, 50});
+    ASSERT_EQ(2u, dirty.count());
+    EXPECT_EQ((Rect{8, 5, 8, 2}), dirty[0]);
+    EXPECT_EQ((Rect{0, 470, 8, 10}), dirty[1]);
+}
+
+TEST(DirtyTrackerTest, MergesTouchingRegions) {
+    DirtyTracker dirty(800, 480);
+    dirty.mark(Rect{0, 0, 8, 8});
+    dirty.mark(Rect{100, 100, 8, 8});
+    dirty.mark(Rect{8, 0, 8, 8}); // shares an edge with the first
+    ASSERT_EQ(2u, dirty.count());
+    EXPECT_EQ(16 * 8 + 16 * 8, dirty.area()); // second region widened to columns 96..111
+}
+
+TEST(DirtyTrackerTest, BridgingRegionAbsorbsBoth) {
+    DirtyTracker dirty(800, 480);
+    dirty.mark(Rect{0, 0, 8, 8});
+    dirty.mark(Rect{32, 0, 8, 8});
+    dirty.mark(Rect{4, 2, 30, 2});
+    ASSERT_EQ(1u, dirty.count());
+    EXPECT_EQ((Rect{0, 0, 40, 8}), dirty[0]);
+}
+
+TEST(DirtyTrackerTest, OverflowMergesCheapestPair) {
+    DirtyTracker dirty(800, 480);
+    for (size_t i = 0; i < DirtyTracker::MAX_RECTS; ++i) {
+        dirty.mark(Rect{static_cast<int16_t>(i * 96), 0, 8, 8});
+    }
+    dirty.mark(Rect{0, 400, 8, 8});
+    EXPECT_EQ(DirtyTracker::MAX_RECTS, dirty.count());
+    // Everything stays covered and no regions overlap
+    for (size_t a = 0; a < dirty.count(); ++a) {
+        for (size_t b = a + 1; b < dirty.count(); ++b) {
+            EXPECT_TRUE(Rect::intersect(dirty[a], dirty[b]).empty());
+        }
+    }
+    EXPECT_EQ((Rect{0, 0, 680, 408}), dirty.bounds());
+}
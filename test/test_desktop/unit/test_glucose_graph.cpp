@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "framebuffer_snapshot.h"
+#include "glucose_graph.h"
+
+namespace {
+
+constexpr time_t START = 1700000000;
+
+/// Two days of a smooth synthetic trace with a few missed readings and timestamp jitter.
+std::vector<GlucoseReading> syntheticDay(size_t count) {
+    std::vector<GlucoseReading> readings;
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 97 == 50 || i % 97 == 51 || i % 131 == 7) {
+            continue; // dropouts
+        }
+        const double v = 140 + 90 * std::sin(i / 23.0) + 40 * std::sin(i / 7.0);
+        const time_t t = START + static_cast<time_t>(i) * 300 + static_cast<time_t>(i % 5) - 2;
+        readings.emplace_back(static_cast<uint16_t>(v), DexcomConst::TrendDirection::Flat, t);
+    }
+    return readings;
+}
+
+std::string goldenPath(const char* name) {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.find_last_of('/'));
+    return dir + "/../golden/" + name;
+}
+
+} // namespace
+
+class GlucoseGraphTest : public ::testing::Test {
+protected:
+    static constexpr Rect PLOT{60, 180, 720, 280};
+
+    // Framebuffers are 48 KB; keep them off the test stack
+    std::unique_ptr<Framebuffer> incremental_ = std::make_unique<Framebuffer>();
+    std::unique_ptr<Framebuffer> full_ = std::make_unique<Framebuffer>();
+};
+
+class GlucoseGraphPitchTest : public GlucoseGraphTest, public ::testing::WithParamInterface<int> {};
+
+TEST_F(GlucoseGraphTest, RowTableSpansThePlot) {
+    GlucoseGraph graph(*full_, PLOT, 2);
+    EXPECT_EQ(PLOT.y, graph.rowFor(GlucoseGraph::MAX_MGDL));
+    EXPECT_EQ(PLOT.bottom() - 1, graph.rowFor(GlucoseGraph::MIN_MGDL));
+    EXPECT_EQ(graph.rowFor(GlucoseGraph::MAX_MGDL), graph.rowFor(500));
+    EXPECT_EQ(graph.rowFor(GlucoseGraph::MIN_MGDL), graph.rowFor(20));
+    EXPECT_GT(graph.rowFor(100), graph.rowFor(110));
+}
+
+TEST_F(GlucoseGraphTest, AppendFillsMissedIntervalsWithGaps) {
+    GlucoseGraph graph(*full_, PLOT, 2);
+    graph.append(GlucoseReading(120, DexcomConst::TrendDirection::Flat, START));
+    graph.append(GlucoseReading(130, DexcomConst::TrendDirection::Flat, START + 901));
+    EXPECT_EQ(130, graph.slot(0));
+    EXPECT_EQ(GlucoseGraph::NO_READING, graph.slot(1));
+    EXPECT_EQ(GlucoseGraph::NO_READING, graph.slot(2));
+    EXPECT_EQ(120, graph.slot(3));
+}
+
+TEST_F(GlucoseGraphTest, IgnoresStaleAndDuplicateReadings) {
+    GlucoseGraph graph(*full_, PLOT, 2);
+    graph.append(GlucoseReading(120, DexcomConst::TrendDirection::Flat, START));
+    graph.append(GlucoseReading(150, DexcomConst::TrendDirection::Flat, START));
+    graph.append(GlucoseReading(160, DexcomConst::TrendDirection::Flat, START - 300));
+    EXPECT_EQ(120, graph.slot(0));
+    EXPECT_EQ(START, graph.newestTimestamp());
+}
+
+TEST_F(GlucoseGraphTest, PushOnlyDirtiesThePlot) {
+    GlucoseGraph graph(*full_, PLOT, 2);
+    graph.setHistory(syntheticDay(100));
+    full_->dirty().clear();
+    graph.push(180);
+    // Only the span of the 288 slots scrolls; axis and the unused left margin stay clean
+    const Rect dirty = full_->dirty().bounds();
+    EXPECT_EQ(PLOT.y, dirty.y);
+    EXPECT_EQ(PLOT.h, dirty.h);
+    EXPECT_GT(dirty.x, PLOT.x);
+    EXPECT_GE(dirty.right(), PLOT.right());
+}
+
+/**
+ * Streams readings one at a time into one graph and periodically compares it with a
+ * graph rebuilt from scratch over the same history: the pixels must be identical.
+ */
+TEST_P(GlucoseGraphPitchTest, IncrementalMatchesFullRedraw) {
+    const uint8_t pitch = static_cast<uint8_t>(GetParam());
+    const std::vector<GlucoseReading> readings = syntheticDay(600);
+
+    GlucoseGraph live(*incremental_, PLOT, pitch);
+    live.setHistory(std::vector<GlucoseReading>(readings.begin(), readings.begin() + 40));
+    for (size_t i = 40; i < readings.size(); ++i) {
+        live.append(readings[i]);
+        if (i % 61 != 0 && i + 1 != readings.size()) {
+            continue;
+        }
+        GlucoseGraph rebuilt(*full_, PLOT, pitch);
+        rebuilt.setHistory(std::vector<GlucoseReading>(readings.begin(), readings.begin() + i + 1));
+        ASSERT_EQ(0, std::memcmp(full_->data(), incremental_->data(), Framebuffer::BUFFER_SIZE))
+            << "pitch " << static_cast<int>(pitch) << " after reading " << i;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Pitches, GlucoseGraphPitchTest, ::testing::Values(1, 2, 3, 8));
+
+TEST_F(GlucoseGraphTest, FullDayMatchesGolden) {
+    GlucoseGraph graph(*full_, PLOT, 2);
+    graph.setHistory(syntheticDay(300));
+
+    const std::string path = goldenPath("glucose_graph.pbm");
+    std::vector<uint8_t> expected = FramebufferSnapshot::readFile(path);
+    if (expected.empty() || std::getenv("UPDATE_GOLDEN") != nullptr) {
+        ASSERT_TRUE(FramebufferSnapshot::writePbm(*full_, path)) << path;
+        return;
+    }
+    EXPECT_TRUE(expected == FramebufferSnapshot::toPbm(*full_))
+        << "graph differs from " << path << "; rerun with UPDATE_GOLDEN=1 if intended";
+}
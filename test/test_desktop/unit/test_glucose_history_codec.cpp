@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "glucose_history_codec.h"
+#include "glucose_reading.h"
+
+class GlucoseHistoryCodecTest : public ::testing::Test {
+protected:
+    static constexpr time_t START = 1609459200; // 2021-01-01 00:00:00 UTC
+
+    std::vector<uint8_t> buffer_ = std::vector<uint8_t>(1024);
+
+    static void expectSameReading(const GlucoseReading& expected, const GlucoseReading& actual) {
+        EXPECT_EQ(expected.getValue(), actual.getValue());
+        EXPECT_EQ(expected.getTrend(), actual.getTrend());
+        EXPECT_EQ(expected.getTimestamp(), actual.getTimestamp());
+    }
+
+    std::vector<GlucoseReading> decodeAll(const uint8_t* data, size_t size) {
+        std::vector<GlucoseReading> out;
+        GlucoseHistoryDecoder decoder(data, size);
+        for (const GlucoseReading& reading : decoder) {
+            out.push_back(reading);
+        }
+        return out;
+    }
+};
+
+TEST_F(GlucoseHistoryCodecTest, ZigZagRoundTrip) {
+    for (int64_t v : std::vector<int64_t>{0, 1, -1, 2, -2, 300, -300, INT64_MAX, INT64_MIN}) {
+        EXPECT_EQ(v, GlucoseCodec::zigZagDecode(GlucoseCodec::zigZagEncode(v)));
+    }
+    EXPECT_EQ(0u, GlucoseCodec::zigZagEncode(0));
+    EXPECT_EQ(1u, GlucoseCodec::zigZagEncode(-1));
+    EXPECT_EQ(2u, GlucoseCodec::zigZagEncode(1));
+}
+
+TEST_F(GlucoseHistoryCodecTest, VarintRoundTripAndTruncation) {
+    uint8_t bytes[10];
+    for (uint64_t v : std::vector<uint64_t>{0, 127, 128, 16384, UINT64_MAX}) {
+        size_t written = GlucoseCodec::writeVarint(v, bytes, sizeof(bytes));
+        ASSERT_GT(written, 0u);
+        uint64_t decoded = 0;
+        EXPECT_EQ(written, GlucoseCodec::readVarint(bytes, written, decoded));
+        EXPECT_EQ(v, decoded);
+        if (written > 1) {
+            EXPECT_EQ(0u, GlucoseCodec::readVarint(bytes, written - 1, decoded));
+        }
+    }
+    EXPECT_EQ(0u, GlucoseCodec::writeVarint(128, bytes, 1));
+}
+
+TEST_F(GlucoseHistoryCodecTest, EmptyStreamDecodesToNothing) {
+    GlucoseHistoryDecoder decoder(buffer_.data(), 0);
+    EXPECT_TRUE(decoder.begin() == decoder.end());
+    EXPECT_TRUE(decoder.valid());
+}
+
+TEST_F(GlucoseHistoryCodecTest, RoundTripPreservesEveryField) {
+    std::vector<GlucoseReading> readings = {
+        GlucoseReading(120, DexcomConst::TrendDirection::Flat, START),
+        GlucoseReading(125, DexcomConst::TrendDirection::FortyFiveUp, START + 300),
+        GlucoseReading(140, DexcomConst::TrendDirection::SingleUp, START + 601),
+        GlucoseReading(39, DexcomConst::TrendDirection::DoubleDown, START + 1500),
+        GlucoseReading(401, DexcomConst::TrendDirection::RateOutOfRange, START + 1799),
+    };
+
+    GlucoseHistoryEncoder encoder(buffer_.data(), buffer_.size());
+    for (const auto& r : readings) {
+        ASSERT_TRUE(encoder.append(r));
+    }
+    EXPECT_EQ(readings.size(), encoder.count());
+
+    auto decoded = decodeAll(encoder.data(), encoder.size());
+    ASSERT_EQ(readings.size(), decoded.size());
+    for (size_t i = 0; i < readings.size(); ++i) {
+        expectSameReading(readings[i], decoded[i]);
+    }
+    EXPECT_TRUE(GlucoseHistoryDecoder(encoder.data(), encoder.size()).valid());
+}
+
+TEST_F(GlucoseHistoryCodecTest, SteadyCadenceCostsTwoAndAHalfBytesPerReading) {
+    GlucoseHistoryEncoder encoder(buffer_.data(), buffer_.size());
+    ASSERT_TRUE(encoder.append(GlucoseReading(100, DexcomConst::TrendDirection::Flat, START)));
+    size_t afterFirst = encoder.size();
+
+    for (int i = 1; i <= 100; ++i) {
+        ASSERT_TRUE(encoder.append(GlucoseReading(100 + (i % 3), DexcomConst::TrendDirection::Flat, START + i * 300)));
+    }
+    // 100 records: 200 varint bytes + 50 trend bytes
+    EXPECT_EQ(250u, encoder.size() - afterFirst);
+}
+
+TEST_F(GlucoseHistoryCodecTest, AppendFailsCleanlyWhenFull) {
+    uint8_t small[8];
+    GlucoseHistoryEncoder encoder(small, sizeof(small));
+    ASSERT_TRUE(encoder.append(GlucoseReading(100, DexcomConst::TrendDirection::Flat, START)));
+    size_t used = encoder.size();
+    uint8_t trendByte = small[0];
+
+    // Huge gap and jump: needs more than the remaining bytes
+    EXPECT_FALSE(encoder.append(GlucoseReading(400, DexcomConst::TrendDirection::SingleUp, START + 100000000)));
+    EXPECT_EQ(used, encoder.size());
+    EXPECT_EQ(1u, encoder.count());
+    EXPECT_EQ(trendByte, small[0]);
+
+    auto decoded = decodeAll(encoder.data(), encoder.size());
+    ASSERT_EQ(1u, decoded.size());
+    EXPECT_EQ(100, decoded[0].getValue());
+}
+
+TEST_F(GlucoseHistoryCodecTest, ResetStartsANewStream) {
+    GlucoseHistoryEncoder encoder(buffer_.data(), buffer_.size());
+    encoder.append(GlucoseReading(100, DexcomConst::TrendDirection::Flat, START));
+    encoder.reset();
+    EXPECT_EQ(0u, encoder.size());
+    ASSERT_TRUE(encoder.append(GlucoseReading(90, DexcomConst::TrendDirection::SingleDown, START + 600)));
+
+    auto decoded = decodeAll(encoder.data(), encoder.size());
+    ASSERT_EQ(1u, decoded.size());
+    expectSameReading(GlucoseReading(90, DexcomConst::TrendDirection::SingleDown, START + 600), decoded[0]);
+}
+
+TEST_F(GlucoseHistoryCodecTest, TruncatedStreamIsReportedInvalid) {
+    GlucoseHistoryEncoder encoder(buffer_.data(), buffer_.size());
+    for (int i = 0; i < 4; ++i) {
+        encoder.append(GlucoseReading(100, DexcomConst::TrendDirection::Flat, START + i * 300));
+    }
+    GlucoseHistoryDecoder truncated(encoder.data(), 3); // first record is 1 + 5 + 2 bytes
+    EXPECT_FALSE(truncated.valid());
+    EXPECT_TRUE(truncated.begin() == truncated.end());
+}
+
+TEST_F(GlucoseHistoryCodecTest, BadTrendNibbleIsReportedInvalid) {
+    GlucoseHistoryEncoder encoder(buffer_.data(), buffer_.size());
+    encoder.append(GlucoseReading(100, DexcomConst::TrendDirection::Flat, START));
+    buffer_[0] = 0x0F;
+    EXPECT_FALSE(GlucoseHistoryDecoder(encoder.data(), encoder.size()).valid());
+}
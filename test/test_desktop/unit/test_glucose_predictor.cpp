@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "cgm_day.h"
+#include "glucose_predictor.h"
+
+namespace {
+
+constexpr time_t START = 1700000000;
+constexpr size_t CGM_DAY_SIZE = sizeof(CGM_DAY) / sizeof(CGM_DAY[0]);
+
+GlucoseReading reading(uint16_t mgdl, size_t index) {
+    return GlucoseReading(mgdl, DexcomConst::Flat, START + static_cast<time_t>(index) * 300);
+}
+
+/// First index at or after @p from whose value satisfies @p crossed, or CGM_DAY_SIZE.
+template <typename Predicate>
+size_t firstCrossing(size_t from, Predicate crossed) {
+    for (size_t i = from; i < CGM_DAY_SIZE; ++i) {
+        if (crossed(CGM_DAY[i])) {
+            return i;
+        }
+    }
+    return CGM_DAY_SIZE;
+}
+
+}  // namespace
+
+class GlucosePredictorTest : public ::testing::Test {
+protected:
+    void SetUp() override { predictor_.clear(); }
+
+    GlucosePredictorState state_;
+    GlucosePredictor predictor_{state_};
+};
+
+TEST_F(GlucosePredictorTest, ExtrapolatesAStraightLineExactly) {
+    GlucosePrediction p{};
+    for (size_t i = 0; i < 4; ++i) {
+        p = predictor_.update(reading(static_cast<uint16_t>(100 + 5 * i), i));
+    }
+    ASSERT_TRUE(p.valid);
+    EXPECT_EQ(256, p.slopeQ8);  // 1 mg/dL per minute
+    EXPECT_EQ(130, p.in15);
+    EXPECT_EQ(145, p.in30);
+    EXPECT_EQ(135, p.ahead);
+    EXPECT_EQ(GlucoseAlert::None, p.alert);
+}
+
+TEST_F(GlucosePredictorTest, NeedsThreeRecentReadings) {
+    EXPECT_FALSE(predictor_.update(reading(120, 0)).valid);
+    EXPECT_FALSE(predictor_.update(reading(121, 1)).valid);
+    EXPECT_TRUE(predictor_.update(reading(122, 2)).valid);
+    // Signal loss: the next reading starts over
+    EXPECT_FALSE(predictor_.update(reading(180, 10)).valid);
+    EXPECT_FALSE(predictor_.predict().valid);
+}
+
+TEST_F(GlucosePredictorTest, IgnoresRefetchedReadings) {
+    predictor_.update(reading(120, 0));
+    predictor_.update(reading(125, 1));
+    predictor_.update(reading(130, 2));
+    const GlucosePrediction before = predictor_.predict();
+    EXPECT_FALSE(predictor_.update(reading(50, 2)).valid);
+    EXPECT_FALSE(predictor_.update(reading(50, 1)).valid);
+    EXPECT_EQ(before.in15, predictor_.predict().in15);
+}
+
+TEST_F(GlucosePredictorTest, FallingSeriesRaisesPredictedLowOnceThenRearms) {
+    const uint16_t falling[] = {130, 124, 118, 112, 106, 100, 94, 88};
+    int alerts = 0;
+    size_t firstAlert = 0;
+    for (size_t i = 0; i < sizeof(falling) / sizeof(falling[0]); ++i) {
+        if (predictor_.update(reading(falling[i], i)).alert == GlucoseAlert::PredictedLow) {
+            ++alerts;
+            firstAlert = i;
+        }
+    }
+    EXPECT_EQ(1, alerts);
+    EXPECT_EQ(7u, firstAlert);  // 88 falling 1.2/min projects 64 in 20 minutes; 94 projected exactly 70
+
+    // Levelling off clears the latch; the next fall alerts again
+    size_t i = 8;
+    for (uint16_t v : {90, 92, 94, 95, 95}) {
+        EXPECT_EQ(GlucoseAlert::None, predictor_.update(reading(v, i++)).alert);
+    }
+    GlucoseAlert alert = GlucoseAlert::None;
+    for (uint16_t v : {88, 80, 72}) {
+        alert = predictor_.update(reading(v, i++)).alert;
+        if (alert != GlucoseAlert::None) {
+            break;
+        }
+    }
+    EXPECT_EQ(GlucoseAlert::PredictedLow, alert);
+}
+
+TEST_F(GlucosePredictorTest, BackfillOnlyReportsRecentAlerts) {
+    // Cold boot: hours of history with a fall early on, then a long flat stretch
+    std::vector<GlucoseReading> batch;  // newest first
+    const uint16_t falling[] = {130, 124, 118, 112, 106, 100, 94, 88, 84, 82};
+    const size_t flat = 60;
+    for (size_t i = 0; i < flat; ++i) {
+        batch.push_back(reading(120, sizeof(falling) / sizeof(falling[0]) + flat - 1 - i));
+    }
+    for (size_t i = sizeof(falling) / sizeof(falling[0]); i-- > 0;) {
+        batch.push_back(reading(falling[i], i));
+    }
+    const time_t now = batch.front().getTimestamp() + 60;
+    EXPECT_EQ(GlucoseAlert::None, predictor_.addAll(batch, now));
+    EXPECT_EQ(0, state_.lowLatched);  // the flat stretch cleared the old latch
+
+    // A fall in the newest readings is still reported
+    std::vector<GlucoseReading> next;
+    size_t i = sizeof(falling) / sizeof(falling[0]) + flat;
+    for (uint16_t v : {112, 104, 96, 88, 80}) {
+        next.insert(next.begin(), reading(v, i++));
+    }
+    EXPECT_EQ(GlucoseAlert::PredictedLow, predictor_.addAll(next, next.front().getTimestamp() + 60));
+}
+
+TEST_F(GlucosePredictorTest, RisingSeriesRaisesPredictedHigh) {
+    GlucoseAlert alert = GlucoseAlert::None;
+    size_t i = 0;
+    for (; i < 10 && alert == GlucoseAlert::None; ++i) {
+        alert = predictor_.update(reading(static_cast<uint16_t>(180 + 10 * i), i)).alert;
+    }
+    EXPECT_EQ(GlucoseAlert::PredictedHigh, alert);
+    EXPECT_LE(180 + 10 * (i - 1), 250u);  // raised before the value itself is high
+}
+
+TEST_F(GlucosePredictorTest, SmoothingDampsSensorNoise) {
+    GlucosePredictorState smoothState{};
+    GlucosePredictor smooth(smoothState, GlucosePredictor::DEFAULT_LOW, GlucosePredictor::DEFAULT_HIGH,
+                            GlucosePredictor::DEFAULT_LOOKAHEAD_MIN, 4, 96);
+    int rawSwing = 0;
+    int smoothSwing = 0;
+    for (size_t i = 0; i < 40; ++i) {
+        const uint16_t noisy = static_cast<uint16_t>(120 + ((i % 2) ? 6 : -6));
+        const GlucosePrediction raw = predictor_.update(reading(noisy, i));
+        const GlucosePrediction damped = smooth.update(reading(noisy, i));
+        if (i >= 10) {
+            rawSwing = std::max(rawSwing, std::abs(raw.in30 - 120));
+            smoothSwing = std::max(smoothSwing, std::abs(damped.in30 - 120));
+        }
+    }
+    EXPECT_LT(smoothSwing * 2, rawSwing);
+}
+
+/**
+ * Replays a day of noisy CGM data: the 15-minute projection must beat assuming no
+ * change, and each low or high must be announced before the value gets there.
+ */
+TEST_F(GlucosePredictorTest, AccuracyAndLeadTimeOnADayTrace) {
+    GlucoseAlert alerts[CGM_DAY_SIZE] = {};
+    long predictorError = 0;
+    long persistenceError = 0;
+    int scored = 0;
+    for (size_t i = 0; i < CGM_DAY_SIZE; ++i) {
+        const GlucosePrediction p = predictor_.update(reading(CGM_DAY[i], i));
+        alerts[i] = p.alert;
+        if (p.valid && i + 3 < CGM_DAY_SIZE) {
+            predictorError += std::abs(static_cast<int>(p.in15) - CGM_DAY[i + 3]);
+            persistenceError += std::abs(static_cast<int>(CGM_DAY[i]) - CGM_DAY[i + 3]);
+            ++scored;
+        }
+    }
+    EXPECT_LT(predictorError, persistenceError);
+    EXPECT_LT(predictorError / scored, 10);  // mean absolute error, mg/dL
+
+    // Every crossing below 70 or above 250 is preceded by the matching alert
+    for (size_t from = 1; from < CGM_DAY_SIZE;) {
+        const size_t low = firstCrossing(from, [](uint16_t v) { return v < 70; });
+        const size_t high = firstCrossing(from, [](uint16_t v) { return v > 250; });
+        const size_t crossing = std::min(low, high);
+        if (crossing == CGM_DAY_SIZE) {
+            break;
+        }
+        const GlucoseAlert expected = crossing == low ? GlucoseAlert::PredictedLow : GlucoseAlert::PredictedHigh;
+        bool announced = false;
+        for (size_t i = crossing >= 6 ? crossing - 6 : 0; i < crossing; ++i) {
+            announced = announced || alerts[i] == expected;
+        }
+        EXPECT_TRUE(announced) << "crossing at index " << crossing;
+        // Skip to the end of this excursion
+        from = crossing;
+        while (from < CGM_DAY_SIZE && (CGM_DAY[from] < 80 || CGM_DAY[from] > 240)) {
+            ++from;
+        }
+    }
+}
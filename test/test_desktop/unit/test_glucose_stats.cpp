@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "glucose_stats.h"
+
+namespace {
+
+constexpr time_t START = 1700000000;
+
+GlucoseReading reading(uint16_t mgdl, time_t at) {
+    return GlucoseReading(mgdl, DexcomConst::Flat, at);
+}
+
+// Straightforward recomputation over every reading in the window ending at `now`
+struct Reference {
+    size_t count = 0;
+    double mean = 0;
+    double sd = 0;
+    double gmi = 0;
+    double ranges[static_cast<size_t>(GlucoseRange::Count)] = {};
+};
+
+Reference bruteForce(const std::vector<GlucoseReading>& all, time_t now) {
+    Reference ref;
+    std::vector<double> values;
+    for (const auto& r : all) {
+        if (r.getTimestamp() <= now && now - r.getTimestamp() < static_cast<time_t>(GlucoseStats::WINDOW_S)) {
+            values.push_back(r.getMgDl());
+        }
+    }
+    ref.count = values.size();
+    if (values.empty()) {
+        return ref;
+    }
+    for (double v : values) {
+        ref.mean += v;
+        ref.ranges[static_cast<size_t>(GlucoseStats::rangeOf(static_cast<uint16_t>(v)))] += 1;
+    }
+    ref.mean /= values.size();
+    double squares = 0;
+    for (double v : values) {
+        squares += (v - ref.mean) * (v - ref.mean);
+    }
+    ref.sd = values.size() > 1 ? std::sqrt(squares / (values.size() - 1)) : 0;
+    ref.gmi = 3.31 + 0.02392 * ref.mean;
+    for (double& range : ref.ranges) {
+        range /= values.size();
+    }
+    return ref;
+}
+
+void expectMatches(const Reference& ref, const GlucoseSummary& s) {
+    ASSERT_EQ(ref.count, s.count);
+    EXPECT_NEAR(ref.mean * 10, s.meanTenths, 0.5);
+    EXPECT_NEAR(ref.sd * 10, s.sdTenths, 0.5);
+    if (ref.mean > 0) {
+        EXPECT_NEAR(ref.sd / ref.mean * 1000, s.cvPermille, 0.5);
+    }
+    EXPECT_NEAR(ref.gmi * 100, s.gmiHundredths, 0.5);
+    for (size_t i = 0; i < static_cast<size_t>(GlucoseRange::Count); ++i) {
+        EXPECT_NEAR(ref.ranges[i] * 1000, s.rangePermille[i], 0.5) << i;
+    }
+}
+
+}  // namespace
+
+class GlucoseStatsTest : public ::testing::Test {
+protected:
+    void SetUp() override { stats_.clear(); }
+
+    GlucoseStatsState state_;
+    GlucoseStats stats_{state_};
+};
+
+TEST_F(GlucoseStatsTest, EmptyWindowSummarisesToZero) {
+    const GlucoseSummary s = stats_.summary();
+    EXPECT_EQ(0, s.count);
+    EXPECT_EQ(0, s.meanTenths);
+    EXPECT_EQ(0, s.gmiHundredths);
+    EXPECT_EQ(0, stats_.newest());
+}
+
+TEST_F(GlucoseStatsTest, KnownValues) {
+    for (uint16_t v : {100, 120, 140, 200, 50}) {
+        ASSERT_TRUE(stats_.add(reading(v, START + 300 * stats_.count())));
+    }
+    const GlucoseSummary s = stats_.summary();
+    EXPECT_EQ(5, s.count);
+    EXPECT_EQ(1220, s.meanTenths);       // 122 mg/dL
+    EXPECT_EQ(550, s.sdTenths);          // sqrt(12080 / 4) = 54.95
+    EXPECT_EQ(450, s.cvPermille);        // 45.04 %
+    EXPECT_EQ(623, s.gmiHundredths);     // 3.31 + 0.02392 * 122 = 6.228
+    EXPECT_EQ(600, s.timeInRangePermille());
+    EXPECT_EQ(200, s.rangePermille[static_cast<size_t>(GlucoseRange::VeryLow)]);
+    EXPECT_EQ(200, s.rangePermille[static_cast<size_t>(GlucoseRange::High)]);
+}
+
+TEST_F(GlucoseStatsTest, RangeBoundariesFollowTheConsensus) {
+    EXPECT_EQ(GlucoseRange::VeryLow, GlucoseStats::rangeOf(53));
+    EXPECT_EQ(GlucoseRange::Low, GlucoseStats::rangeOf(54));
+    EXPECT_EQ(GlucoseRange::Low, GlucoseStats::rangeOf(69));
+    EXPECT_EQ(GlucoseRange::InRange, GlucoseStats::rangeOf(70));
+    EXPECT_EQ(GlucoseRange::InRange, GlucoseStats::rangeOf(180));
+    EXPECT_EQ(GlucoseRange::High, GlucoseStats::rangeOf(250));
+    EXPECT_EQ(GlucoseRange::VeryHigh, GlucoseStats::rangeOf(251));
+}
+
+TEST_F(GlucoseStatsTest, IgnoresRefetchedAndEmptyReadings) {
+    EXPECT_TRUE(stats_.add(reading(120, START)));
+    EXPECT_FALSE(stats_.add(reading(130, START)));        // same reading again
+    EXPECT_FALSE(stats_.add(reading(130, START - 300)));  // older
+    EXPECT_FALSE(stats_.add(reading(0, START + 300)));
+    EXPECT_EQ(1u, stats_.count());
+}
+
+TEST_F(GlucoseStatsTest, AddAllTakesNewestFirstBatches) {
+    std::vector<GlucoseReading> batch;
+    for (int i = 0; i < 12; ++i) {
+        batch.push_back(reading(static_cast<uint16_t>(100 + i), START - 300 * i));
+    }
+    EXPECT_EQ(12u, stats_.addAll(batch));
+    EXPECT_EQ(START, stats_.newest());
+    // The next fetch overlaps the last one
+    batch.insert(batch.begin(), reading(150, START + 300));
+    EXPECT_EQ(1u, stats_.addAll(batch));
+    EXPECT_EQ(13u, stats_.count());
+}
+
+TEST_F(GlucoseStatsTest, ReadingsAgeOutOfTheWindow) {
+    stats_.add(reading(300, START));
+    stats_.add(reading(100, START + 3600));
+    stats_.evict(START + GlucoseStats::WINDOW_S - 1);
+    EXPECT_EQ(2u, stats_.count());
+    stats_.evict(START + GlucoseStats::WINDOW_S);
+    EXPECT_EQ(1u, stats_.count());
+    EXPECT_EQ(1000, stats_.summary().meanTenths);
+    EXPECT_EQ(1000, stats_.summary().timeInRangePermille());
+}
+
+TEST_F(GlucoseStatsTest, FullRingDropsTheOldest) {
+    // One-minute readings overflow the ring well within 24 h
+    for (size_t i = 0; i < GlucoseStatsState::CAPACITY + 10; ++i) {
+        stats_.add(reading(i < 10 ? 400 : 100, START + 60 * static_cast<time_t>(i)));
+    }
+    EXPECT_EQ(GlucoseStatsState::CAPACITY, stats_.count());
+    EXPECT_EQ(1000, stats_.summary().meanTenths);
+    EXPECT_EQ(0, stats_.summary().sdTenths);
+}
+
+TEST_F(GlucoseStatsTest, MatchesBruteForceOverThreeSlidingDays) {
+    std::mt19937 rng(42);
+    std::normal_distribution<double> step(0, 6);
+    std::uniform_int_distribution<int> gap(0, 40);
+    std::vector<GlucoseReading> all;
+    double level = 140;
+    time_t t = START;
+    for (int i = 0; i < 3 * 288; ++i) {
+        t += 300;
+        if (gap(rng) == 0) {
+            t += 300 * (1 + gap(rng));  // signal loss
+        }
+        level = std::min(400.0, std::max(40.0, level + step(rng)));
+        all.push_back(reading(static_cast<uint16_t>(std::lround(level)), t));
+    }
+
+    // Feed as the device would: newest-first batches that overlap the previous fetch
+    const size_t BATCH = 12;
+    for (size_t end = 1; end <= all.size(); end += 7) {
+        std::vector<GlucoseReading> batch;
+        for (size_t i = end; i > 0 && end - i < BATCH; --i) {
+            batch.push_back(all[i - 1]);
+        }
+        stats_.addAll(batch);
+        const time_t now = all[end - 1].getTimestamp();
+        std::vector<GlucoseReading> seen(all.begin(), all.begin() + end);
+        expectMatches(bruteForce(seen, now), stats_.summary());
+        if (HasFailure()) {
+            FAIL() << "diverged after " << end << " readings";
+        }
+    }
+}
@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "fake_i2c_bus.h"
+#include "i2c_bus_manager.h"
+#include "timed_i2c_bus.h"
+
+namespace {
+
+constexpr uint8_t BURST_DEVICE = 0x76;
+constexpr uint8_t WORD_DEVICE = 0x60;
+
+// Register-map simulator that also counts writeBatch() calls
+class CountingBus : public FakeI2cBus {
+public:
+    bool writeBatch(uint8_t address, const I2cWrite* writes, size_t count) override {
+        ++batches;
+        return FakeI2cBus::writeBatch(address, writes, count);
+    }
+    int batches = 0;
+};
+
+}  // namespace
+
+class I2cBusManagerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = 0; i < 256; ++i) {
+            bus_->device(BURST_DEVICE)[i] = static_cast<uint8_t>(i);
+            bus_->device(WORD_DEVICE)[i] = static_cast<uint8_t>(0xFF - i);
+        }
+        manager_.enableBursts(BURST_DEVICE);
+    }
+
+    std::shared_ptr<CountingBus> bus_ = std::make_shared<CountingBus>();
+    I2cBusManager manager_{bus_};
+    I2cBatch batch_;
+};
+
+TEST_F(I2cBusManagerTest, CoalescesAdjacentReadsAcrossSmallGaps) {
+    uint8_t status = 0;
+    uint8_t data[8] = {};
+    ASSERT_TRUE(batch_.read(BURST_DEVICE, 0xF3, &status, 1));
+    ASSERT_TRUE(batch_.read(BURST_DEVICE, 0xF7, data, sizeof(data)));  // 3-byte gap
+
+    ASSERT_TRUE(manager_.execute(batch_));
+    EXPECT_EQ(1, bus_->transactions);
+    EXPECT_EQ(12u, bus_->bytesRead);
+    EXPECT_EQ(0xF3, status);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(0xF7 + i, data[i]);
+    }
+    EXPECT_EQ(1u, manager_.coalescedReads());
+    EXPECT_TRUE(batch_.ok(0));
+    EXPECT_TRUE(batch_.ok(1));
+}
+
+TEST_F(I2cBusManagerTest, KeepsReadsSeparateWhenTheyCannotBurst) {
+    uint8_t a = 0, b = 0, c = 0, d = 0;
+    batch_.read(BURST_DEVICE, 0x10, &a, 1);
+    batch_.read(BURST_DEVICE, 0x15, &b, 1);  // gap of 4
+    batch_.read(WORD_DEVICE, 0x08, &c, 1);   // no auto-increment
+    batch_.read(WORD_DEVICE, 0x09, &d, 1);
+
+    ASSERT_TRUE(manager_.execute(batch_));
+    EXPECT_EQ(4, bus_->transactions);
+    EXPECT_EQ(0x10, a);
+    EXPECT_EQ(0x15, b);
+    EXPECT_EQ(0xFF - 0x08, c);
+    EXPECT_EQ(0xFF - 0x09, d);
+    EXPECT_EQ(0u, manager_.coalescedReads());
+}
+
+TEST_F(I2cBusManagerTest, WritesKeepTheirOrderAndGroupPerDevice) {
+    const uint8_t one = 1, two = 2, three = 3;
+    uint8_t before = 0, after = 0;
+    batch_.read(BURST_DEVICE, 0xF2, &before, 1);
+    batch_.write(BURST_DEVICE, 0xF2, &one, 1);
+    batch_.write(BURST_DEVICE, 0xF5, &two, 1);
+    batch_.write(WORD_DEVICE, 0x03, &three, 1);
+    batch_.read(BURST_DEVICE, 0xF2, &after, 1);
+
+    ASSERT_TRUE(manager_.execute(batch_));
+    EXPECT_EQ(0xF2, before);
+    EXPECT_EQ(1, after);
+    EXPECT_EQ(2, bus_->device(BURST_DEVICE)[0xF5]);
+    EXPECT_EQ(3, bus_->device(WORD_DEVICE)[0x03]);
+    EXPECT_EQ(2, bus_->batches);  // one per device run
+}
+
+TEST_F(I2cBusManagerTest, FailureIsReportedPerOperation) {
+    uint8_t a = 0, b = 0;
+    batch_.read(0x23, 0x00, &a, 1);  // nothing at this address
+    batch_.read(BURST_DEVICE, 0x01, &b, 1);
+
+    EXPECT_FALSE(manager_.execute(batch_));
+    EXPECT_FALSE(batch_.ok(0));
+    EXPECT_TRUE(batch_.ok(1));
+    EXPECT_EQ(0x01, b);
+}
+
+TEST_F(I2cBusManagerTest, RejectsOperationsBeyondCapacity) {
+    uint8_t sink[I2cBatch::CAPACITY + 1];
+    for (size_t i = 0; i < I2cBatch::CAPACITY; ++i) {
+        EXPECT_TRUE(batch_.read(BURST_DEVICE, static_cast<uint8_t>(i), &sink[i], 1));
+    }
+    EXPECT_FALSE(batch_.read(BURST_DEVICE, 0x80, &sink[I2cBatch::CAPACITY], 1));
+    const uint8_t tooLong[I2cWrite::MAX_LENGTH] = {};
+    batch_.clear();
+    EXPECT_FALSE(batch_.write(BURST_DEVICE, 0x00, tooLong, sizeof(tooLong)));
+}
+
+TEST_F(I2cBusManagerTest, MergedBurstsStayWithinMaxBurst) {
+    uint8_t sink[4][12];
+    for (int i = 0; i < 4; ++i) {
+        batch_.read(BURST_DEVICE, static_cast<uint8_t>(i * 12), sink[i], 12);
+    }
+    ASSERT_TRUE(manager_.execute(batch_));
+    EXPECT_EQ(2, bus_->transactions);  // 24 + 24 bytes, not one 48-byte read
+    EXPECT_EQ(36, sink[3][0]);
+}
+
+namespace {
+
+// Backend that notices if two callers are ever on the bus at once
+class OverlapDetectingBus : public FakeI2cBus {
+public:
+    bool writeRead(uint8_t address, const uint8_t* tx, size_t txLength, uint8_t* rx, size_t rxLength) override {
+        if (inFlight.fetch_add(1) != 0) {
+            overlapped = true;
+        }
+        {
+            std::lock_guard<std::mutex> lock(logMutex);
+            log.push_back(address);
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(20));
+        const bool ok = FakeI2cBus::writeRead(address, tx, txLength, rx, rxLength);
+        inFlight.fetch_sub(1);
+        return ok;
+    }
+
+    std::atomic<int> inFlight{0};
+    std::atomic<bool> overlapped{false};
+    std::mutex logMutex;
+    std::vector<uint8_t> log;
+};
+
+}  // namespace
+
+TEST(I2cBusManagerConcurrencyTest, BatchesFromTwoTasksNeverInterleave) {
+    auto bus = std::make_shared<OverlapDetectingBus>();
+    bus->device(0x10);
+    bus->device(0x20);
+    bus->device(0x30);
+    I2cBusManager manager(bus);
+    constexpr int ROUNDS = 200;
+
+    // Each batch touches two devices; an interleaving would split the pair in the log
+    auto worker = [&](uint8_t first, uint8_t second) {
+        for (int i = 0; i < ROUNDS; ++i) {
+            uint8_t a, b;
+            I2cBatch batch;
+            batch.read(first, 0, &a, 1);
+            batch.read(second, 0, &b, 1);
+            EXPECT_TRUE(manager.execute(batch));
+        }
+    };
+    std::thread sensors(worker, 0x10, 0x20);
+    std::thread other(worker, 0x30, 0x10);
+    sensors.join();
+    other.join();
+
+    EXPECT_FALSE(bus->overlapped);
+    ASSERT_EQ(4u * ROUNDS, bus->log.size());
+    for (size_t i = 0; i < bus->log.size(); i += 2) {
+        const bool sensorsPair = bus->log[i] == 0x10 && bus->log[i + 1] == 0x20;
+        const bool otherPair = bus->log[i] == 0x30 && bus->log[i + 1] == 0x10;
+        EXPECT_TRUE(sensorsPair || otherPair) << i;
+    }
+}
+
+TEST(TimedI2cBusTest, CountsFramingBits) {
+    // start + address + register + data + stop
+    EXPECT_EQ(1u + 9 * 3 + 1, TimedI2cBus::transactionBits(2, 0));
+    // start + address + register, repeated start + address + 8 bytes, stop
+    EXPECT_EQ(1u + 9 * 2 + 1 + 9 * 9 + 1, TimedI2cBus::transactionBits(1, 8));
+}
+
+TEST(TimedI2cBusTest, EstimatesOccupancyAtTheConfiguredClock) {
+    auto sim = std::make_shared<FakeI2cBus>();
+    sim->device(0x76);
+    TimedI2cBus standard(sim, TimedI2cBus::STANDARD_HZ);
+    TimedI2cBus fast(sim, TimedI2cBus::FAST_HZ, 50);
+
+    const uint8_t reg = 0xF7;
+    uint8_t data[8];
+    ASSERT_TRUE(standard.writeRead(0x76, &reg, 1, data, sizeof(data)));
+    ASSERT_TRUE(fast.writeRead(0x76, &reg, 1, data, sizeof(data)));
+
+    EXPECT_EQ(1u, standard.transactions());
+    EXPECT_EQ(1020u, standard.busTimeUs());  // 102 bits at 10 us
+    EXPECT_EQ(255u + 50, fast.busTimeUs());
+    standard.reset();
+    EXPECT_EQ(0u, standard.busTimeUs());
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include "led_color.h"
+#include "led_fader.h"
+#include "mock_led_pwm.h"
+
+using ::testing::_;
+using ::testing::StrictMock;
+
+// The whole mapping is usable at compile time
+static_assert(LedColor::LIGHTNESS_LUT.front() == 0);
+static_assert(LedColor::LIGHTNESS_LUT.back() == 65535);
+static_assert(LedColor::dutyFor(120, DexcomConst::Flat, 255) == LedDuty{0, 65535, LedColor::LIGHTNESS_LUT[193]});
+
+TEST(LedColorTest, RampFollowsTheStops) {
+    for (const auto& stop : LedColor::RAMP) {
+        const LedColor::Rgb8 color = LedColor::colorFor(stop.mgdl);
+        EXPECT_EQ(stop.color.r, color.r) << stop.mgdl;
+        EXPECT_EQ(stop.color.g, color.g) << stop.mgdl;
+        EXPECT_EQ(stop.color.b, color.b) << stop.mgdl;
+    }
+    // Halfway between 180 (200,255,0) and 250 (255,120,0)
+    const LedColor::Rgb8 mid = LedColor::colorFor(215);
+    EXPECT_NEAR(228, mid.r, 1);
+    EXPECT_NEAR(188, mid.g, 1);
+}
+
+TEST(LedColorTest, RangesMapToExpectedHues) {
+    const LedDuty low = LedColor::dutyFor(50, DexcomConst::Flat, 255);
+    EXPECT_EQ(65535, low.r);
+    EXPECT_EQ(0, low.g);
+    const LedDuty inRange = LedColor::dutyFor(120, DexcomConst::Flat, 255);
+    EXPECT_EQ(0, inRange.r);
+    EXPECT_EQ(65535, inRange.g);
+    const LedDuty high = LedColor::dutyFor(180, DexcomConst::Flat, 255);
+    EXPECT_GT(high.r, 0);
+    EXPECT_EQ(65535, high.g);
+    EXPECT_EQ(0, high.b);
+}
+
+TEST(LedColorTest, ClampsToTheReportableRange) {
+    EXPECT_EQ(LedColor::dutyFor(40, DexcomConst::Flat, 200), LedColor::dutyFor(39, DexcomConst::Flat, 200));
+    EXPECT_EQ(LedColor::dutyFor(400, DexcomConst::Flat, 200), LedColor::dutyFor(401, DexcomConst::Flat, 200));
+    EXPECT_EQ(LedColor::dutyFor(40, DexcomConst::Flat, 200), LedColor::dutyFor(45, DexcomConst::DoubleDown, 200));
+}
+
+TEST(LedColorTest, NoReadingTurnsTheLedOff) {
+    EXPECT_EQ((LedDuty{0, 0, 0}), LedColor::dutyFor(0, DexcomConst::Flat, 255));
+    EXPECT_EQ((LedDuty{0, 0, 0}), LedColor::dutyFor(120, DexcomConst::Flat, 0));
+}
+
+TEST(LedColorTest, TrendShiftsTowardWhereGlucoseIsHeading) {
+    EXPECT_EQ(LedColor::dutyFor(55, DexcomConst::Flat, 128), LedColor::dutyFor(75, DexcomConst::SingleDown, 128));
+    EXPECT_EQ(LedColor::dutyFor(190, DexcomConst::Flat, 128), LedColor::dutyFor(160, DexcomConst::DoubleUp, 128));
+    EXPECT_EQ(LedColor::dutyFor(120, DexcomConst::Flat, 128), LedColor::dutyFor(120, DexcomConst::NotComputable, 128));
+}
+
+TEST(LedColorTest, LightnessLutIsMonotonicAndFineAtTheDarkEnd) {
+    for (size_t i = 1; i < LedColor::LIGHTNESS_LUT.size(); ++i) {
+        EXPECT_LE(LedColor::LIGHTNESS_LUT[i - 1], LedColor::LIGHTNESS_LUT[i]) << i;
+    }
+    // The dimmest non-zero steps stay well below what 8-bit gamma could resolve (257 per step)
+    EXPECT_GT(LedColor::LIGHTNESS_LUT[1], 0);
+    EXPECT_LT(LedColor::LIGHTNESS_LUT[1], 32);
+    // Mid lightness is ~18% luminance
+    EXPECT_NEAR(0.184 * 65535, LedColor::LIGHTNESS_LUT[512], 200);
+}
+
+TEST(LedColorTest, BrightnessRampIsSmoothAtNightLevels) {
+    uint16_t previous = 0;
+    for (int brightness = 1; brightness <= 40; ++brightness) {
+        const uint16_t green = LedColor::dutyFor(120, DexcomConst::Flat, static_cast<uint8_t>(brightness)).g;
+        EXPECT_GT(green, previous) << brightness;
+        EXPECT_LT(green - previous, 100) << brightness;
+        previous = green;
+    }
+}
+
+TEST(LedFaderTest, FadesOnlyChannelsThatChange) {
+    auto pwm = std::make_shared<StrictMock<MockLedPwm>>();
+    LedFader fader(pwm);
+
+    EXPECT_CALL(*pwm, fade(ILedPwm::GREEN, 1000, 800));
+    EXPECT_CALL(*pwm, fade(ILedPwm::BLUE, 20, 800));
+    EXPECT_EQ(800u, fader.fadeTo(LedDuty{0, 1000, 20}, 800));
+    EXPECT_TRUE(fader.lit());
+
+    EXPECT_CALL(*pwm, fade(ILedPwm::RED, 500, 300));
+    EXPECT_CALL(*pwm, fade(ILedPwm::GREEN, 900, 300));
+    EXPECT_EQ(300u, fader.fadeTo(LedDuty{500, 900, 20}, 300));
+}
+
+TEST(LedFaderTest, UnchangedTargetCostsNothing) {
+    auto pwm = std::make_shared<StrictMock<MockLedPwm>>();
+    LedFader fader(pwm);
+    EXPECT_EQ(0u, fader.off(500));
+
+    EXPECT_CALL(*pwm, fade(_, _, 500)).Times(2);  // red and green; blue stays off
+    const uint32_t first = fader.show(60, DexcomConst::Flat, 255, 500);
+    EXPECT_EQ(500u, first);
+    EXPECT_EQ(0u, fader.show(60, DexcomConst::Flat, 255, 500));
+    EXPECT_EQ(LedColor::dutyFor(60, DexcomConst::Flat, 255), fader.target());
+}
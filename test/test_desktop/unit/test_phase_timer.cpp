@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "phase_timer.h"
+#include "secure_http_client.h"
+#include "../mocks/mock_secure_client.h"
+
+namespace {
+std::vector<std::string> dumped;
+
+void captureLine(const char* line, size_t length) {
+    dumped.emplace_back(line, length);
+}
+}
+
+class PhaseTimerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        PhaseTiming::resetAll();
+        dumped.clear();
+    }
+
+    void TearDown() override {
+        PhaseTiming::resetAll();
+    }
+};
+
+TEST_F(PhaseTimerTest, BucketsArePowersOfTwo) {
+    EXPECT_EQ(0u, LatencyHistogram::bucketFor(0));
+    EXPECT_EQ(0u, LatencyHistogram::bucketFor(1));
+    EXPECT_EQ(1u, LatencyHistogram::bucketFor(2));
+    EXPECT_EQ(1u, LatencyHistogram::bucketFor(3));
+    EXPECT_EQ(10u, LatencyHistogram::bucketFor(1024));
+    EXPECT_EQ(LatencyHistogram::BUCKET_COUNT - 1, LatencyHistogram::bucketFor(UINT32_MAX));
+    EXPECT_EQ(2048u, LatencyHistogram::bucketLimit(10));
+}
+
+TEST_F(PhaseTimerTest, HistogramTracksSummaryStatistics) {
+    LatencyHistogram h;
+    for (uint32_t us : {100u, 200u, 300u, 400u, 5000u}) {
+        h.record(us);
+    }
+    EXPECT_EQ(5u, h.count());
+    EXPECT_EQ(100u, h.minMicros());
+    EXPECT_EQ(5000u, h.maxMicros());
+    EXPECT_EQ(1200u, h.meanMicros());
+    EXPECT_EQ(256u, h.percentileMicros(40));  // 100 and 200 sit below 256
+    EXPECT_EQ(512u, h.percentileMicros(80));
+    EXPECT_EQ(8192u, h.percentileMicros(100));
+
+    h.reset();
+    EXPECT_EQ(0u, h.count());
+    EXPECT_EQ(0u, h.minMicros());
+    EXPECT_EQ(0u, h.percentileMicros(50));
+}
+
+TEST_F(PhaseTimerTest, ScopedTimerRecordsOnceOnStopOrScopeExit) {
+    {
+        ScopedPhaseTimer timer(Phase::JsonDeserialize);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        timer.stop();
+        timer.stop();
+    }
+    const LatencyHistogram& h = PhaseTiming::histogram(Phase::JsonDeserialize);
+    EXPECT_EQ(1u, h.count());
+    EXPECT_GE(h.maxMicros(), 2000u);
+
+    { ScopedPhaseTimer timer(Phase::JsonDeserialize); }
+    EXPECT_EQ(2u, h.count());
+}
+
+TEST_F(PhaseTimerTest, LapRecordsCurrentPhaseAndStartsNext) {
+    {
+        ScopedPhaseTimer timer(Phase::FirstByte);
+        timer.lap(Phase::BodyRead);
+    }
+    EXPECT_EQ(1u, PhaseTiming::histogram(Phase::FirstByte).count());
+    EXPECT_EQ(1u, PhaseTiming::histogram(Phase::BodyRead).count());
+}
+
+TEST_F(PhaseTimerTest, DumpListsOnlyPhasesWithSamples) {
+    PhaseTiming::record(Phase::TlsConnect, 1500);
+    PhaseTiming::record(Phase::TlsConnect, 2500);
+    PhaseTiming::dump(captureLine);
+
+    ASSERT_EQ(1u, dumped.size());
+    EXPECT_THAT(dumped[0], ::testing::StartsWith("TlsConnect"));
+    EXPECT_THAT(dumped[0], ::testing::HasSubstr("n=2 mean=2000us min=1500us"));
+    EXPECT_THAT(dumped[0], ::testing::HasSubstr("max=2500us"));
+}
+
+TEST_F(PhaseTimerTest, SecureHttpClientRecordsRequestPhases) {
+    auto socket = std::make_shared<testing::NiceMock<MockSecureClient>>();
+    ON_CALL(*socket, connect(testing::_, testing::_)).WillByDefault(testing::Return(true));
+    ON_CALL(*socket, connected()).WillByDefault(testing::Return(true));
+    EXPECT_CALL(*socket, readStringUntil('\n'))
+        .WillOnce(testing::Return("HTTP/1.1 200 OK\r\n"))
+        .WillOnce(testing::Return("\r\n"));
+
+    SecureHttpClient client(socket);
+    ASSERT_TRUE(client.connect("example.com", 443));
+    client.get("/");
+
+    EXPECT_EQ(1u, PhaseTiming::histogram(Phase::TlsConnect).count());
+    EXPECT_EQ(1u, PhaseTiming::histogram(Phase::RequestWrite).count());
+    EXPECT_EQ(1u, PhaseTiming::histogram(Phase::FirstByte).count());
+    EXPECT_EQ(1u, PhaseTiming::histogram(Phase::BodyRead).count());
+}
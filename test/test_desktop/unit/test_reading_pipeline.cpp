@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "reading_pipeline.h"
+
+namespace {
+
+ReadingBatch makeBatch(uint16_t value, size_t count) {
+    ReadingBatch batch;
+    batch.ok = true;
+    for (size_t i = 0; i < count; ++i) {
+        batch.readings.emplace_back(value, DexcomConst::TrendDirection::Flat, static_cast<time_t>(1700000000 - i * 300));
+    }
+    return batch;
+}
+
+} // namespace
+
+TEST(ReadingPipelineTest, ConsumerReceivesTheProducersVector) {
+    ReadingPipeline pipeline;
+    std::atomic<const GlucoseReading*> published{nullptr};
+    std::atomic<const GlucoseReading*> received{nullptr};
+    std::atomic<uint32_t> sequence{0};
+
+    ASSERT_TRUE(pipeline.start(
+        [&](ReadingPipeline& p) {
+            ReadingBatch batch = makeBatch(120, 288);
+            published = batch.readings.data();
+            p.publish(std::move(batch));
+            while (p.running()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        },
+        [&](ReadingBatch& batch) {
+            received = batch.readings.data();
+            sequence = batch.sequence;
+        }));
+
+    for (int i = 0; i < 1000 && received.load() == nullptr; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    pipeline.stop();
+    EXPECT_NE(nullptr, received.load());
+    EXPECT_EQ(published.load(), received.load()); // moved, never copied
+    EXPECT_EQ(1u, sequence.load());
+}
+
+TEST(ReadingPipelineTest, StartTwiceIsRefused) {
+    ReadingPipeline pipeline;
+    auto idle = [](ReadingPipeline& p) {
+        while (p.running()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+    ASSERT_TRUE(pipeline.start(idle, [](ReadingBatch&) {}));
+    EXPECT_FALSE(pipeline.start(idle, [](ReadingBatch&) {}));
+    pipeline.stop();
+}
+
+TEST(ReadingPipelineTest, FullQueueRefusesAndKeepsBatch) {
+    ReadingPipeline pipeline; // not started: nothing consumes
+    for (size_t i = 0; i < ReadingPipeline::DEPTH; ++i) {
+        ASSERT_TRUE(pipeline.publish(makeBatch(100, 1)));
+    }
+    ReadingBatch extra = makeBatch(200, 3);
+    EXPECT_FALSE(pipeline.publish(std::move(extra)));
+    EXPECT_EQ(3u, extra.readings.size());
+    EXPECT_EQ(1u, pipeline.dropped());
+}
+
+/**
+ * A fast producer against a slowish consumer: every batch that publish() accepted is
+ * delivered exactly once, in order, including those still queued at stop().
+ */
+TEST(ReadingPipelineTest, StressDeliversAcceptedBatchesInOrder) {
+    constexpr uint32_t BATCHES = 20000;
+    ReadingPipeline pipeline;
+    std::atomic<uint32_t> accepted{0};
+    std::atomic<bool> producerDone{false};
+    std::vector<uint32_t> seen;
+    seen.reserve(BATCHES);
+
+    ASSERT_TRUE(pipeline.start(
+        [&](ReadingPipeline& p) {
+            for (uint32_t i = 0; i < BATCHES; ++i) {
+                while (!p.publish(makeBatch(static_cast<uint16_t>(40 + i % 360), 4))) {
+                    std::this_thread::yield(); // consumer is behind; retry
+                }
+                ++accepted;
+            }
+            producerDone = true;
+            while (p.running()) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        },
+        [&](ReadingBatch& batch) {
+            seen.push_back(batch.sequence);
+            if (batch.sequence % 1000 == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        }));
+
+    while (!producerDone) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    pipeline.stop();
+
+    ASSERT_EQ(accepted.load(), seen.size());
+    for (size_t i = 0; i < seen.size(); ++i) {
+        ASSERT_EQ(i + 1, seen[i]);
+    }
+}
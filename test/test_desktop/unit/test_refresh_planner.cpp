@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include "framebuffer.h"
+#include "glucose_graph.h"
+#include "refresh_planner.h"
+#include "screen_state.h"
+
+class RefreshPlannerTest : public ::testing::Test {
+protected:
+    static constexpr time_t T0 = 1700000000;
+    static constexpr int32_t PANEL = Framebuffer::WIDTH * Framebuffer::HEIGHT;
+
+    void SetUp() override {
+        planner_.reset();
+    }
+
+    DirtyTracker dirtyArea(int16_t w, int16_t h) {
+        DirtyTracker dirty(Framebuffer::WIDTH, Framebuffer::HEIGHT);
+        dirty.mark(Rect{0, 0, w, h});
+        return dirty;
+    }
+
+    /// Brings the planner to "panel freshly fully refreshed at T0 showing hash 1".
+    void fullRefreshAt(time_t now) {
+        planner_.onRefreshed(RefreshKind::Full, 1, PANEL, now);
+    }
+
+    RefreshPlannerState state_{};
+    RefreshPlanner planner_{state_, PANEL};
+};
+
+TEST_F(RefreshPlannerTest, ColdStartNeedsFullRefresh) {
+    EXPECT_TRUE(planner_.changed(0));
+    EXPECT_EQ(RefreshKind::Full, planner_.plan(dirtyArea(16, 16), T0));
+    EXPECT_EQ(RefreshKind::Full, planner_.plan(dirtyArea(16, 16), 0));
+}
+
+TEST_F(RefreshPlannerTest, UnchangedHashSkipsRefresh) {
+    fullRefreshAt(T0);
+    EXPECT_FALSE(planner_.changed(1));
+    EXPECT_TRUE(planner_.changed(2));
+}
+
+TEST_F(RefreshPlannerTest, NothingDirtyMeansNoRefresh) {
+    fullRefreshAt(T0);
+    DirtyTracker clean(Framebuffer::WIDTH, Framebuffer::HEIGHT);
+    EXPECT_EQ(RefreshKind::None, planner_.plan(clean, T0 + 300));
+}
+
+TEST_F(RefreshPlannerTest, SmallChangesArePartial) {
+    fullRefreshAt(T0);
+    EXPECT_EQ(RefreshKind::Partial, planner_.plan(dirtyArea(200, 100), T0 + 300));
+}
+
+TEST_F(RefreshPlannerTest, LargeChangeIsFull) {
+    fullRefreshAt(T0);
+    EXPECT_EQ(RefreshKind::Full, planner_.plan(dirtyArea(800, 300), T0 + 300));
+}
+
+TEST_F(RefreshPlannerTest, GhostingBudgetForcesFullRefresh) {
+    fullRefreshAt(T0);
+    const DirtyTracker dirty = dirtyArea(400, 240); // a quarter of the panel
+    int partials = 0;
+    time_t now = T0;
+    while (planner_.plan(dirty, now += 300) == RefreshKind::Partial) {
+        planner_.onRefreshed(RefreshKind::Partial, static_cast<uint32_t>(partials + 2), dirty.area(), now);
+        ASSERT_LT(++partials, 50);
+    }
+    EXPECT_EQ((RefreshPlanner::GHOSTING_LIMIT) / planner_.partialCost(dirty.area()), partials);
+
+    planner_.onRefreshed(RefreshKind::Full, 99, dirty.area(), now);
+    EXPECT_EQ(0, state_.ghosting);
+    EXPECT_EQ(RefreshKind::Partial, planner_.plan(dirty, now + 300));
+}
+
+TEST_F(RefreshPlannerTest, PartialCountIsCapped) {
+    fullRefreshAt(T0);
+    const DirtyTracker tiny = dirtyArea(8, 1);
+    for (uint8_t i = 0; i < RefreshPlanner::MAX_PARTIALS; ++i) {
+        ASSERT_EQ(RefreshKind::Partial, planner_.plan(tiny, T0 + i));
+        planner_.onRefreshed(RefreshKind::Partial, i + 2u, tiny.area(), T0 + i);
+    }
+    EXPECT_EQ(RefreshKind::Full, planner_.plan(tiny, T0 + 100));
+}
+
+TEST_F(RefreshPlannerTest, OldFullRefreshIsRenewed) {
+    fullRefreshAt(T0);
+    const DirtyTracker dirty = dirtyArea(8, 8);
+    EXPECT_EQ(RefreshKind::Partial, planner_.plan(dirty, T0 + RefreshPlanner::MAX_FULL_INTERVAL_S - 1));
+    EXPECT_EQ(RefreshKind::Full, planner_.plan(dirty, T0 + RefreshPlanner::MAX_FULL_INTERVAL_S));
+    EXPECT_EQ(RefreshKind::Partial, planner_.plan(dirty, 0)); // clock unknown: no age limit
+}
+
+TEST(ScreenStateTest, HashTracksVisibleFields) {
+    auto fb = std::make_unique<Framebuffer>();
+    GlucoseGraph graph(*fb, Rect{60, 180, 720, 280}, 2);
+    const time_t t = 1700000000;
+    GlucoseReading reading(123, DexcomConst::TrendDirection::Flat, t);
+    graph.append(reading);
+
+    const uint32_t base = ScreenState::capture(reading, t + 30, graph).hash();
+    EXPECT_EQ(base, ScreenState::capture(reading, t + 59, graph).hash()); // same displayed minute
+    EXPECT_NE(base, ScreenState::capture(reading, t + 60, graph).hash());
+
+    GlucoseReading rising(123, DexcomConst::TrendDirection::SingleUp, t);
+    EXPECT_NE(base, ScreenState::capture(rising, t + 30, graph).hash());
+
+    GlucoseReading next(124, DexcomConst::TrendDirection::Flat, t + 300);
+    graph.append(next);
+    EXPECT_NE(ScreenState::capture(reading, t + 30, graph).hash(), base); // graph tail moved
+}
@@ -2,9 +2,12 @@
 #include <gmock/gmock.h>
 #include "secure_http_client.h"
 #include "../mocks/mock_secure_client.h"
+#include "../mocks/fake_secure_socket.h"
+#include "../mocks/fake_clock.h"
 #include <memory>
 #include <string>
 #include <sstream>
+#include <vector>
 
 class SecureHttpClientTest : public ::testing::Test
 {
@@ -207,7 +210,7 @@ TEST_F(SecureHttpClientTest, Post_Success)
     EXPECT_CALL(*mock_secure_client_, println("Content-Type: application/json")).Times(1);
     EXPECT_CALL(*mock_secure_client_, println("Content-Length: " + std::to_string(requestBody.length()))).Times(1);
     EXPECT_CALL(*mock_secure_client_, println()).Times(1);
-    EXPECT_CALL(*mock_secure_client_, println(requestBody)).Times(1);
+    EXPECT_CALL(*mock_secure_client_, print(requestBody)).Times(1);
 
     // Setup HTTP response
     {
@@ -375,7 +378,7 @@ TEST_F(SecureHttpClientTest, PostNon200Response)
     EXPECT_CALL(*mock_secure_client_, println("Content-Type: application/json")).Times(1);
     EXPECT_CALL(*mock_secure_client_, println("Content-Length: " + std::to_string(requestBody.length()))).Times(1);
     EXPECT_CALL(*mock_secure_client_, println()).Times(1);
-    EXPECT_CALL(*mock_secure_client_, println(requestBody)).Times(1);
+    EXPECT_CALL(*mock_secure_client_, print(requestBody)).Times(1);
 
     // Return a 500 Internal Server Error response
     {
@@ -525,3 +528,249 @@ TEST_F(SecureHttpClientTest, MalformedStatusLine)
     // Verify: Status code should be 500 (internal error) due to parsing failure
     EXPECT_EQ(500, response.statusCode);
 }
+
+TEST_F(SecureHttpClientTest, RemembersLastDateHeader)
+{
+    ON_CALL(*mock_secure_client_, connect(testing::_, 443)).WillByDefault(testing::Return(true));
+    http_client_->connect("example.com", 443);
+    EXPECT_EQ("", http_client_->lastDateHeader());
+
+    ON_CALL(*mock_secure_client_, available()).WillByDefault(testing::Return(0));
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(*mock_secure_client_, readStringUntil('\n'))
+            .WillOnce(testing::Return("HTTP/1.1 200 OK\r\n"));
+        EXPECT_CALL(*mock_secure_client_, readStringUntil('\n'))
+            .WillOnce(testing::Return("Date: Tue, 14 Nov 2023 22:13:20 GMT\r\n"));
+        EXPECT_CALL(*mock_secure_client_, readStringUntil('\n'))
+            .WillOnce(testing::Return("\r\n"));
+        // A later response without the header keeps the previous value
+        EXPECT_CALL(*mock_secure_client_, readStringUntil('\n'))
+            .WillOnce(testing::Return("HTTP/1.1 200 OK\r\n"));
+        EXPECT_CALL(*mock_secure_client_, readStringUntil('\n'))
+            .WillOnce(testing::Return("\r\n"));
+    }
+
+    http_client_->get("/first");
+    EXPECT_EQ("Tue, 14 Nov 2023 22:13:20 GMT", http_client_->lastDateHeader());
+    http_client_->get("/second");
+    EXPECT_EQ("Tue, 14 Nov 2023 22:13:20 GMT", http_client_->lastDateHeader());
+}
+
+TEST_F(SecureHttpClientTest, TimestampsDateHeaderOnArrival)
+{
+    auto clock = std::make_shared<FakeClock>(1000);
+    SecureHttpClient client(mock_secure_client_, clock);
+    ON_CALL(*mock_secure_client_, connect(testing::_, 443)).WillByDefault(testing::Return(true));
+    client.connect("example.com", 443);
+    EXPECT_EQ(0u, client.lastDateReceivedMs());
+
+    ON_CALL(*mock_secure_client_, available()).WillByDefault(testing::Return(0));
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(*mock_secure_client_, readStringUntil('\n'))
+            .WillOnce(testing::Return("HTTP/1.1 200 OK\r\n"));
+        EXPECT_CALL(*mock_secure_client_, readStringUntil('\n'))
+            .WillOnce(testing::Return("Date: Tue, 14 Nov 2023 22:13:20 GMT\r\n"));
+        EXPECT_CALL(*mock_secure_client_, readStringUntil('\n'))
+            .WillOnce(testing::Return("\r\n"));
+        // A slow response without the header arrives 4 s later
+        EXPECT_CALL(*mock_secure_client_, readStringUntil('\n'))
+            .WillOnce(testing::DoAll(testing::InvokeWithoutArgs([&clock]() { clock->advance(4000); }),
+                                     testing::Return("HTTP/1.1 200 OK\r\n")));
+        EXPECT_CALL(*mock_secure_client_, readStringUntil('\n'))
+            .WillOnce(testing::Return("\r\n"));
+    }
+
+    clock->advance(250);
+    client.get("/login");
+    EXPECT_EQ(1250u, client.lastDateReceivedMs());
+    client.get("/readings");
+    EXPECT_EQ(1250u, client.lastDateReceivedMs()); // still when the Date itself arrived
+}
+
+namespace
+{
+    std::string okResponse(const std::string &body, const std::string &extraHeader = "")
+    {
+        return "HTTP/1.1 200 OK\r\n" + extraHeader + "Content-Length: " + std::to_string(body.size()) +
+               "\r\n\r\n" + body;
+    }
+
+    std::vector<HttpRequest> readingsRequests(size_t count)
+    {
+        std::vector<HttpRequest> requests;
+        for (size_t i = 0; i < count; ++i)
+        {
+            requests.push_back(HttpRequest{"/readings?n=" + std::to_string(i), "POST", {}, std::string("{}")});
+        }
+        return requests;
+    }
+}
+
+class SecureHttpClientPipelineTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        socket_ = std::make_shared<FakeSecureSocket>();
+        http_client_ = std::make_unique<SecureHttpClient>(socket_);
+        http_client_->connect("example.com", 443);
+    }
+
+    std::shared_ptr<FakeSecureSocket> socket_;
+    std::unique_ptr<SecureHttpClient> http_client_;
+};
+
+TEST_F(SecureHttpClientPipelineTest, WritesAllRequestsBeforeReadingAndMatchesResponsesInOrder)
+{
+    socket_->serve(okResponse("[1]") + okResponse("[22,23]") + okResponse(""));
+
+    std::vector<HttpResponse> responses = http_client_->sendPipelined(readingsRequests(3));
+
+    ASSERT_EQ(3u, responses.size());
+    EXPECT_EQ("[1]", responses[0].body);
+    EXPECT_EQ("[22,23]", responses[1].body);
+    EXPECT_EQ("", responses[2].body);
+    for (const auto &response : responses)
+    {
+        EXPECT_EQ(200, response.statusCode);
+    }
+    // One round trip: every request was on the wire before the first response was read
+    EXPECT_NE(std::string::npos, socket_->writtenBeforeFirstRead.find("/readings?n=2"));
+    EXPECT_EQ(1, socket_->connects);
+    EXPECT_TRUE(http_client_->isConnected());
+}
+
+TEST_F(SecureHttpClientPipelineTest, BodiesAreFollowedDirectlyByTheNextRequest)
+{
+    socket_->serve(okResponse("[1]") + okResponse("[2]"));
+
+    http_client_->sendPipelined(readingsRequests(2));
+
+    // No CRLF after a body: it would sit in front of the next request line
+    EXPECT_EQ("POST /readings?n=0 HTTP/1.1\r\nHost: example.com\r\nContent-Length: 2\r\n\r\n{}"
+              "POST /readings?n=1 HTTP/1.1\r\nHost: example.com\r\nContent-Length: 2\r\n\r\n{}",
+              socket_->written);
+}
+
+TEST_F(SecureHttpClientPipelineTest, UnframedResponseDropsTheConnectionInsteadOfSwallowingTheRest)
+{
+    const std::string chunked = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n3\r\n[1]\r\n0\r\n\r\n";
+    socket_->serve(chunked + okResponse("[2]") + okResponse("[3]"));
+    socket_->onConnect = [](FakeSecureSocket &socket)
+    {
+        socket.serve(okResponse("[1]") + okResponse("[2]") + okResponse("[3]"));
+    };
+
+    std::vector<HttpResponse> responses = http_client_->sendPipelined(readingsRequests(3));
+
+    // Re-sent on a new connection rather than read as one response with the others in its body
+    ASSERT_EQ(3u, responses.size());
+    EXPECT_EQ("[1]", responses[0].body);
+    EXPECT_EQ("[2]", responses[1].body);
+    EXPECT_EQ("[3]", responses[2].body);
+    EXPECT_EQ(2, socket_->connects);
+    EXPECT_EQ(3u, socket_->requestsWritten());
+}
+
+TEST_F(SecureHttpClientPipelineTest, UnframedLastResponseIsReadToTheEnd)
+{
+    socket_->serve(okResponse("[1]") + "HTTP/1.1 200 OK\r\n\r\n[2]");
+
+    std::vector<HttpResponse> responses = http_client_->sendPipelined(readingsRequests(2));
+
+    EXPECT_EQ("[1]", responses[0].body);
+    EXPECT_EQ(200, responses[1].statusCode);
+    EXPECT_EQ("[2]", responses[1].body);
+    EXPECT_EQ(1, socket_->connects);
+}
+
+TEST_F(SecureHttpClientPipelineTest, FailureStatusOnlyAffectsItsOwnRequest)
+{
+    const std::string expired = "{\"Code\":\"SessionIdNotFound\"}";
+    socket_->serve(okResponse("[1]") + "HTTP/1.1 500 Internal Server Error\r\nContent-Length: " +
+                   std::to_string(expired.size()) + "\r\n\r\n" + expired + okResponse("[3]"));
+
+    std::vector<HttpResponse> responses = http_client_->sendPipelined(readingsRequests(3));
+
+    EXPECT_EQ(200, responses[0].statusCode);
+    EXPECT_EQ(500, responses[1].statusCode);
+    EXPECT_EQ(expired, responses[1].body);
+    EXPECT_EQ(200, responses[2].statusCode);
+    EXPECT_EQ("[3]", responses[2].body);
+    EXPECT_EQ(1, socket_->connects);
+}
+
+TEST_F(SecureHttpClientPipelineTest, DroppedConnectionResendsOnlyTheUnansweredRequests)
+{
+    const std::string first = okResponse("[1]");
+    socket_->serve(first + okResponse("[2]"), first.size() + 10); // hangs up inside the second response
+    socket_->onConnect = [](FakeSecureSocket &socket)
+    {
+        socket.serve(okResponse("[2]") + okResponse("[3]"));
+    };
+
+    std::vector<HttpResponse> responses = http_client_->sendPipelined(readingsRequests(3));
+
+    EXPECT_EQ("[1]", responses[0].body);
+    EXPECT_EQ("[2]", responses[1].body);
+    EXPECT_EQ("[3]", responses[2].body);
+    EXPECT_EQ(2, socket_->connects);
+    EXPECT_EQ(2u, socket_->requestsWritten()); // the new connection only carried 1 and 2
+    EXPECT_EQ(std::string::npos, socket_->written.find("/readings?n=0"));
+}
+
+TEST_F(SecureHttpClientPipelineTest, GivesUpAfterOneResendWithoutLosingAnsweredResponses)
+{
+    socket_->serve(okResponse("[1]"));
+    socket_->onConnect = [](FakeSecureSocket &socket)
+    {
+        socket.serve(okResponse("[2]"), 0); // accepts, then hangs up straight away
+    };
+    socket_->connects = 0;
+
+    std::vector<HttpResponse> responses = http_client_->sendPipelined(readingsRequests(3));
+
+    EXPECT_EQ(200, responses[0].statusCode);
+    EXPECT_EQ("[1]", responses[0].body);
+    EXPECT_EQ(500, responses[1].statusCode);
+    EXPECT_EQ(500, responses[2].statusCode);
+    EXPECT_EQ(1, socket_->connects);
+}
+
+TEST_F(SecureHttpClientPipelineTest, ConnectionCloseHeaderEndsThePipeline)
+{
+    socket_->serve(okResponse("[1]", "Connection: close\r\n") + okResponse("[ignored]"));
+    socket_->onConnect = [](FakeSecureSocket &socket)
+    {
+        socket.serve(okResponse("[2]") + okResponse("[3]"));
+    };
+
+    std::vector<HttpResponse> responses = http_client_->sendPipelined(readingsRequests(3));
+
+    EXPECT_EQ("[1]", responses[0].body);
+    EXPECT_EQ("[2]", responses[1].body);
+    EXPECT_EQ("[3]", responses[2].body);
+    EXPECT_EQ(2, socket_->connects);
+}
+
+TEST_F(SecureHttpClientPipelineTest, SplitsLongBatchesIntoRoundsOfMaxDepth)
+{
+    std::string all;
+    for (int i = 0; i < 10; ++i)
+    {
+        all += okResponse("[" + std::to_string(i) + "]");
+    }
+    socket_->serve(all);
+
+    std::vector<HttpResponse> responses = http_client_->sendPipelined(readingsRequests(10));
+
+    ASSERT_EQ(10u, responses.size());
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ("[" + std::to_string(i) + "]", responses[i].body);
+    }
+    EXPECT_EQ(std::string::npos, socket_->writtenBeforeFirstRead.find("/readings?n=8"));
+    EXPECT_EQ(10u, socket_->requestsWritten());
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "dexcom_constants.h"
+#include "share_requests.h"
+
+namespace {
+constexpr char SESSION_ID[] = "0f4c5e9a-1b2c-4d3e-8f70-123456789abc";
+}  // namespace
+
+TEST(ShareRequestsTest, BuildsTheEndpointUrlsAndBodiesOnce) {
+    ShareRequests requests("alice", "", "hunter2");
+    EXPECT_EQ(std::string("/ShareWebServices/Services/") + DexcomConst::DEXCOM_AUTHENTICATE_ENDPOINT,
+              requests.authenticateUrl());
+    EXPECT_EQ(std::string("/ShareWebServices/Services/") + DexcomConst::DEXCOM_LOGIN_ID_ENDPOINT, requests.loginUrl());
+    EXPECT_EQ(std::string("{\"accountName\":\"alice\",\"password\":\"hunter2\",\"applicationId\":\"") +
+                  DexcomConst::DEXCOM_APPLICATION_ID + "\"}",
+              requests.authenticateBody());
+
+    requests.setAccountId("acct-1");
+    EXPECT_EQ(std::string("{\"accountId\":\"acct-1\",\"password\":\"hunter2\",\"applicationId\":\"") +
+                  DexcomConst::DEXCOM_APPLICATION_ID + "\"}",
+              requests.loginBody());
+
+    // Repeated use hands back the same prebuilt strings
+    const char* authenticate = requests.authenticateBody().data();
+    const char* login = requests.loginBody().data();
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(authenticate, requests.authenticateBody().data());
+        EXPECT_EQ(login, requests.loginBody().data());
+    }
+}
+
+TEST(ShareRequestsTest, EscapesQuotesAndBackslashesInCredentials) {
+    ShareRequests requests("bob \"the\" user", "", "pa\"ss\\word");
+    EXPECT_NE(std::string::npos, requests.authenticateBody().find("\"accountName\":\"bob \\\"the\\\" user\""));
+    EXPECT_NE(std::string::npos, requests.authenticateBody().find("\"password\":\"pa\\\"ss\\\\word\","));
+}
+
+TEST(ShareRequestsTest, EscapesControlCharacters) {
+    std::string out;
+    ShareRequests::appendJsonString(out, std::string("a\nb\tc\r\x01\x1f") + "\xc3\xa9");
+    EXPECT_EQ("\"a\\nb\\tc\\r\\u0001\\u001f\xc3\xa9\"", out);
+}
+
+TEST(ShareRequestsTest, PatchesMinutesAndMaxCountIntoTheReadingsUrl) {
+    ShareRequests requests("", "acct-1", "secret");
+    requests.setSessionId(SESSION_ID);
+    const std::string prefix = std::string("/ShareWebServices/Services/") +
+                               DexcomConst::DEXCOM_GLUCOSE_READINGS_ENDPOINT + "?sessionId=" + SESSION_ID;
+
+    const std::string& url = requests.readingsUrl(DexcomConst::MAX_MINUTES, DexcomConst::MAX_MAX_COUNT);
+    EXPECT_EQ(prefix + "&minutes=1440&maxCount=288", url);
+    const char* buffer = url.data();
+    EXPECT_EQ(prefix + "&minutes=10&maxCount=1", requests.readingsUrl(10, 1));
+    EXPECT_EQ(prefix + "&minutes=1&maxCount=0", requests.readingsUrl(1, 0));
+    EXPECT_EQ(buffer, requests.readingsUrl(65535, 65535).data());
+
+    // A new session rebuilds the prefix
+    requests.setSessionId("s2");
+    EXPECT_NE(std::string::npos, requests.readingsUrl(5, 2).find("?sessionId=s2&minutes=5&maxCount=2"));
+}
+
+TEST(ShareRequestsTest, ReadingsUrlDoesNotAllocate) {
+    ShareRequests requests("", "acct-1", "secret");
+    requests.setSessionId(SESSION_ID);
+
+    // The URL is the only storage readingsUrl() writes, so an unmoved buffer means no allocation
+    const std::string& first = requests.readingsUrl(1, 1);
+    const char* buffer = first.data();
+    const size_t capacity = first.capacity();
+    for (uint16_t minutes = 1; minutes <= DexcomConst::MAX_MINUTES; ++minutes) {
+        const std::string& url =
+            requests.readingsUrl(minutes, static_cast<uint16_t>(minutes % DexcomConst::MAX_MAX_COUNT + 1));
+        ASSERT_EQ(buffer, url.data());
+        ASSERT_EQ(capacity, url.capacity());
+    }
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "spsc_queue.h"
+
+TEST(SpscQueueTest, FifoUntilFull) {
+    SpscQueue<int, 4> queue;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.push(int(i)));
+    }
+    int rejected = 99;
+    EXPECT_FALSE(queue.push(std::move(rejected)));
+    EXPECT_EQ(4u, queue.size());
+
+    int out = -1;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.pop(out));
+        EXPECT_EQ(i, out);
+    }
+    EXPECT_FALSE(queue.pop(out));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTest, MovesWithoutCopying) {
+    SpscQueue<std::unique_ptr<int>, 2> queue; // would not compile if the queue copied
+    auto item = std::make_unique<int>(7);
+    int* raw = item.get();
+    ASSERT_TRUE(queue.push(std::move(item)));
+    EXPECT_EQ(nullptr, item);
+
+    std::unique_ptr<int> out;
+    ASSERT_TRUE(queue.pop(out));
+    EXPECT_EQ(raw, out.get());
+}
+
+TEST(SpscQueueTest, FailedPushLeavesItemWithCaller) {
+    SpscQueue<std::vector<int>, 2> queue;
+    queue.push(std::vector<int>{1});
+    queue.push(std::vector<int>{2});
+    std::vector<int> kept{3, 4, 5};
+    EXPECT_FALSE(queue.push(std::move(kept)));
+    EXPECT_EQ(3u, kept.size());
+}
+
+TEST(SpscQueueTest, CountersWrapAroundTheSlots) {
+    SpscQueue<uint32_t, 4> queue;
+    uint32_t out = 0;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(queue.push(uint32_t(i)));
+        ASSERT_TRUE(queue.pop(out));
+        ASSERT_EQ(i, out);
+    }
+}
+
+/**
+ * One producer and one consumer thread hammer a tiny queue; every item must arrive
+ * exactly once and in order.
+ */
+TEST(SpscQueueTest, StressTwoThreadsKeepOrder) {
+    constexpr uint32_t COUNT = 500000;
+    SpscQueue<uint32_t, 8> queue;
+
+    std::thread producer([&queue]() {
+        for (uint32_t i = 0; i < COUNT;) {
+            if (queue.push(uint32_t(i))) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    uint32_t out = 0;
+    bool inOrder = true;
+    while (expected < COUNT) {
+        if (queue.pop(out)) {
+            inOrder = inOrder && out == expected;
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(inOrder);
+    EXPECT_TRUE(queue.empty());
+}
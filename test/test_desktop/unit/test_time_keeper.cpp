@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "time_keeper.h"
+#include "http_date.h"
+
+class TimeKeeperTest : public ::testing::Test {
+protected:
+    static constexpr time_t T0 = 1700000000;
+
+    void SetUp() override {
+        keeper_.reset();
+    }
+
+    TimeKeeperState state_{};
+    TimeKeeper keeper_{state_};
+};
+
+TEST_F(TimeKeeperTest, NeverSyncedNeedsSync) {
+    EXPECT_TRUE(keeper_.needsSync(T0));
+    EXPECT_TRUE(keeper_.needsSync(0));
+    EXPECT_EQ(UINT32_MAX, keeper_.estimatedErrorMs(T0));
+}
+
+TEST_F(TimeKeeperTest, UnmeasuredDriftUsesConservativeRate) {
+    keeper_.onNtpSync(T0, 0, false);
+    EXPECT_FALSE(keeper_.needsSync(T0 + 60));
+    EXPECT_EQ(TimeKeeper::NTP_ERROR_MS + 60, keeper_.estimatedErrorMs(T0 + 60));
+    // 1000 ppm reaches the 5 s limit after ~82 minutes
+    EXPECT_FALSE(keeper_.needsSync(T0 + 4900));
+    EXPECT_TRUE(keeper_.needsSync(T0 + 4950));
+    EXPECT_EQ(0, keeper_.pendingCorrectionMs(T0 + 4950));
+}
+
+TEST_F(TimeKeeperTest, LearnsDriftFromConsecutiveSyncs) {
+    keeper_.onNtpSync(T0, 0);
+    // RTC lost 720 ms over 2 hours: 100 ppm slow
+    keeper_.onNtpSync(T0 + 7200, 720);
+    EXPECT_TRUE(state_.driftKnown);
+    EXPECT_EQ(100, state_.driftPpm);
+
+    // With drift known only the 50 ppm residual counts: 5 s takes ~27 hours
+    EXPECT_FALSE(keeper_.needsSync(T0 + 7200 + 24 * 3600));
+    EXPECT_TRUE(keeper_.needsSync(T0 + 7200 + 28 * 3600));
+}
+
+TEST_F(TimeKeeperTest, ShortIntervalsDoNotUpdateDrift) {
+    keeper_.onNtpSync(T0, 0);
+    keeper_.onNtpSync(T0 + 60, 400); // would be a wild 6667 ppm
+    EXPECT_FALSE(state_.driftKnown);
+}
+
+TEST_F(TimeKeeperTest, CorrectionFollowsDriftAndAccountsForWhatWasApplied) {
+    keeper_.onNtpSync(T0, 0);
+    keeper_.onNtpSync(T0 + 10000, -2000); // RTC 200 ppm fast
+    ASSERT_EQ(-200, state_.driftPpm);
+
+    EXPECT_EQ(-600, keeper_.pendingCorrectionMs(T0 + 10000 + 3000));
+    keeper_.noteCorrection(-600);
+    EXPECT_EQ(0, keeper_.pendingCorrectionMs(T0 + 10000 + 3000));
+    EXPECT_EQ(-200, keeper_.pendingCorrectionMs(T0 + 10000 + 4000));
+}
+
+TEST_F(TimeKeeperTest, DriftEstimateIncludesAppliedCorrection) {
+    keeper_.onNtpSync(T0, 0);
+    keeper_.onNtpSync(T0 + 10000, 1000); // 100 ppm
+    keeper_.noteCorrection(990);          // predicted and applied over the next 9900 s
+    // Residual of +110 ms on top of what was applied: 1100 ms over 10000 s = 110 ppm
+    keeper_.onNtpSync(T0 + 20000, 110);
+    EXPECT_EQ((3 * 100 + 110) / 4, state_.driftPpm);
+    EXPECT_EQ(0, state_.appliedMs);
+}
+
+TEST_F(TimeKeeperTest, MaxIntervalForcesSyncEvenWithTinyError) {
+    keeper_.onNtpSync(T0, 0);
+    keeper_.onNtpSync(T0 + 7200, 0);
+    EXPECT_TRUE(keeper_.needsSync(T0 + 7200 + TimeKeeper::MAX_SYNC_INTERVAL_S + 1));
+}
+
+TEST_F(TimeKeeperTest, AgreeingHttpDateTightensTheBound) {
+    keeper_.onNtpSync(T0, 0, false);
+    const time_t later = T0 + 4000; // bound now 4.1 s
+    auto check = keeper_.onHttpDate(later, static_cast<int64_t>(later) * 1000 + 300);
+    EXPECT_TRUE(check.consistent);
+    EXPECT_EQ(0, check.stepMs);
+    EXPECT_EQ(TimeKeeper::HTTP_DATE_ERROR_MS, keeper_.estimatedErrorMs(later));
+    // The deadline moved out accordingly
+    EXPECT_FALSE(keeper_.needsSync(T0 + 6000));
+}
+
+TEST_F(TimeKeeperTest, AgreeingHttpDateNeverLoosensTheBound) {
+    keeper_.onNtpSync(T0, 0, false);
+    keeper_.onHttpDate(T0 + 10, static_cast<int64_t>(T0 + 10) * 1000);
+    EXPECT_EQ(TimeKeeper::NTP_ERROR_MS + 10, keeper_.estimatedErrorMs(T0 + 10));
+}
+
+TEST_F(TimeKeeperTest, ContradictingHttpDateStepsAndForcesSync) {
+    keeper_.onNtpSync(T0, 0, false);
+    const time_t local = T0 + 600;
+    // Server says 30 s later than we think
+    auto check = keeper_.onHttpDate(local + 30, static_cast<int64_t>(local) * 1000);
+    EXPECT_FALSE(check.consistent);
+    EXPECT_EQ(30500, check.stepMs);
+    EXPECT_TRUE(keeper_.needsSync(local + 31));
+}
+
+TEST_F(TimeKeeperTest, SmallDisagreementWithinBoundsIsIgnored) {
+    keeper_.onNtpSync(T0, 0, false);
+    const time_t local = T0 + 3000; // bound 3.1 s
+    auto check = keeper_.onHttpDate(local + 3, static_cast<int64_t>(local) * 1000);
+    EXPECT_FALSE(check.consistent);
+    EXPECT_EQ(0, check.stepMs);
+}
+
+TEST(HttpDateTest, ParsesImfFixdate) {
+    EXPECT_EQ(784111777, HttpDate::parse("Sun, 06 Nov 1994 08:49:37 GMT"));
+    EXPECT_EQ(1700000000, HttpDate::parse("Tue, 14 Nov 2023 22:13:20 GMT"));
+    EXPECT_EQ(951782400, HttpDate::parse("Tue, 29 Feb 2000 00:00:00 GMT"));
+}
+
+TEST(HttpDateTest, RejectsOtherFormats) {
+    EXPECT_EQ(0, HttpDate::parse(nullptr));
+    EXPECT_EQ(0, HttpDate::parse(""));
+    EXPECT_EQ(0, HttpDate::parse("Sunday, 06-Nov-94 08:49:37 GMT"));
+    EXPECT_EQ(0, HttpDate::parse("Sun, 06 Nov 1994 08:49:37 PST"));
+    EXPECT_EQ(0, HttpDate::parse("Sun, 06 Foo 1994 08:49:37 GMT"));
+    EXPECT_EQ(0, HttpDate::parse("Sun, 06 Nov 1994 25:49:37 GMT"));
+}
+
+TEST(HttpDateTest, DaysFromCivil) {
+    EXPECT_EQ(0, HttpDate::daysFromCivil(1970, 1, 1));
+    EXPECT_EQ(11016, HttpDate::daysFromCivil(2000, 2, 29));
+}
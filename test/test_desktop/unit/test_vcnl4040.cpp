@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <map>
+#include <memory>
+#include "mock_i2c_bus.h"
+#include "vcnl4040.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+
+/**
+ * The mock bus is backed by a register map: batched writes land in it, reads come
+ * out of it, and reading INT_FLAG clears it like the real part does.
+ */
+class Vcnl4040Test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        registers_[Vcnl4040::REG_ID] = Vcnl4040::DEVICE_ID;
+        ON_CALL(*bus_, writeRead(Vcnl4040::ADDRESS, _, 1, _, 2))
+            .WillByDefault(Invoke([this](uint8_t, const uint8_t* tx, size_t, uint8_t* rx, size_t) {
+                const uint16_t value = registers_[tx[0]];
+                rx[0] = value & 0xFF;
+                rx[1] = value >> 8;
+                if (tx[0] == Vcnl4040::REG_INT_FLAG) {
+                    registers_[tx[0]] = 0;
+                }
+                return true;
+            }));
+        ON_CALL(*bus_, writeBatch(Vcnl4040::ADDRESS, _, _))
+            .WillByDefault(Invoke([this](uint8_t, const I2cWrite* writes, size_t count) {
+                if (failNextBatch_) {
+                    failNextBatch_ = false;
+                    return false;
+                }
+                ++batches_;
+                for (size_t i = 0; i < count; ++i) {
+                    EXPECT_EQ(3, writes[i].length);
+                    registers_[writes[i].bytes[0]] = writes[i].bytes[1] | (writes[i].bytes[2] << 8);
+                    ++registerWrites_;
+                }
+                return true;
+            }));
+    }
+
+    uint16_t interruptMode() {
+        return registers_[Vcnl4040::REG_PS_CONF1_2] & Vcnl4040::PS_INT_MASK;
+    }
+
+    std::shared_ptr<NiceMock<MockI2cBus>> bus_ = std::make_shared<NiceMock<MockI2cBus>>();
+    std::map<uint8_t, uint16_t> registers_;
+    int batches_ = 0;
+    int registerWrites_ = 0;
+    bool failNextBatch_ = false;
+    Vcnl4040 sensor_{bus_, 150, 90};
+};
+
+TEST_F(Vcnl4040Test, BeginProgramsThresholdsAndApproachInterruptInOneBatch) {
+    ASSERT_TRUE(sensor_.begin());
+    EXPECT_EQ(1, batches_);
+    EXPECT_EQ(4, registerWrites_);
+    EXPECT_EQ(90, registers_[Vcnl4040::REG_PS_THDL]);
+    EXPECT_EQ(150, registers_[Vcnl4040::REG_PS_THDH]);
+    EXPECT_EQ(Vcnl4040::PS_INT_CLOSE, interruptMode());
+    EXPECT_EQ(0, registers_[Vcnl4040::REG_PS_CONF1_2] & Vcnl4040::PS_SD);
+    EXPECT_EQ(Vcnl4040::PS_DUTY_1_320, registers_[Vcnl4040::REG_PS_CONF1_2] & Vcnl4040::PS_DUTY_1_320);
+    EXPECT_EQ(0x0004, registers_[Vcnl4040::REG_PS_CONF1_2] & Vcnl4040::PS_IT_MASK); // PS_IT = 2T
+}
+
+TEST_F(Vcnl4040Test, BeginRejectsWrongDevice) {
+    registers_[Vcnl4040::REG_ID] = 0x1234;
+    EXPECT_FALSE(sensor_.begin());
+    EXPECT_EQ(0, batches_);
+}
+
+TEST_F(Vcnl4040Test, ApproachThenLeaveFlipsTheArmedEdge) {
+    ASSERT_TRUE(sensor_.begin());
+
+    registers_[Vcnl4040::REG_INT_FLAG] = Vcnl4040::FLAG_PS_CLOSE;
+    EXPECT_EQ(Vcnl4040::Event::Approach, sensor_.handleInterrupt());
+    EXPECT_EQ(Vcnl4040::Proximity::Near, sensor_.state());
+    EXPECT_EQ(Vcnl4040::PS_INT_AWAY, interruptMode());
+    EXPECT_EQ(0, registers_[Vcnl4040::REG_INT_FLAG]); // read cleared it, releasing INT
+
+    registers_[Vcnl4040::REG_INT_FLAG] = Vcnl4040::FLAG_PS_AWAY;
+    EXPECT_EQ(Vcnl4040::Event::Leave, sensor_.handleInterrupt());
+    EXPECT_EQ(Vcnl4040::Proximity::Far, sensor_.state());
+    EXPECT_EQ(Vcnl4040::PS_INT_CLOSE, interruptMode());
+}
+
+TEST_F(Vcnl4040Test, RepeatedFlagForCurrentStateWritesNothing) {
+    ASSERT_TRUE(sensor_.begin());
+    const int writes = registerWrites_;
+    registers_[Vcnl4040::REG_INT_FLAG] = Vcnl4040::FLAG_PS_AWAY; // already far
+    EXPECT_EQ(Vcnl4040::Event::None, sensor_.handleInterrupt());
+    EXPECT_EQ(Vcnl4040::Event::None, sensor_.handleInterrupt()); // spurious wake, no flags
+    EXPECT_EQ(writes, registerWrites_);
+}
+
+TEST_F(Vcnl4040Test, ShadowSkipsUnchangedThresholds) {
+    ASSERT_TRUE(sensor_.begin());
+    const int writes = registerWrites_;
+    EXPECT_TRUE(sensor_.setThresholds(150, 90));
+    EXPECT_EQ(writes, registerWrites_);
+    EXPECT_TRUE(sensor_.setThresholds(150, 70));
+    EXPECT_EQ(writes + 1, registerWrites_);
+    EXPECT_EQ(70, registers_[Vcnl4040::REG_PS_THDL]);
+    EXPECT_FALSE(sensor_.setThresholds(60, 70)); // no hysteresis
+}
+
+TEST_F(Vcnl4040Test, FailedBatchForcesRewrite) {
+    ASSERT_TRUE(sensor_.begin());
+    failNextBatch_ = true;
+    EXPECT_FALSE(sensor_.setThresholds(200, 100));
+    EXPECT_TRUE(sensor_.setThresholds(150, 90)); // back to the old values, but unknown on the device
+    EXPECT_EQ(150, registers_[Vcnl4040::REG_PS_THDH]);
+}
+
+TEST_F(Vcnl4040Test, ResumeAfterDeepSleepTouchesNoRegisters) {
+    EXPECT_CALL(*bus_, writeBatch(_, _, _)).Times(0);
+    EXPECT_CALL(*bus_, writeRead(_, _, _, _, _)).Times(0);
+    sensor_.resume(Vcnl4040::Proximity::Near);
+    EXPECT_EQ(Vcnl4040::Proximity::Near, sensor_.state());
+}
+
+TEST_F(Vcnl4040Test, ShutdownSetsPsSd) {
+    ASSERT_TRUE(sensor_.begin());
+    EXPECT_TRUE(sensor_.shutdown());
+    EXPECT_EQ(Vcnl4040::PS_SD, registers_[Vcnl4040::REG_PS_CONF1_2] & Vcnl4040::PS_SD);
+}
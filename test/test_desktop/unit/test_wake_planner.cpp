@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "wake_planner.h"
+
+class WakePlannerTest : public ::testing::Test {
+protected:
+    static constexpr time_t B = 1699999800; // on a 5-minute boundary
+
+    void SetUp() override {
+        planner_.reset();
+    }
+
+    WakePlannerState state_{};
+    WakePlanner planner_{state_};
+
+    // WT timestamps (seconds) from a recorded Share history: phase 137 s past the
+    // 5-minute boundary with the usual +-2 s jitter
+    const std::vector<time_t> recorded_ = {
+        B + 137, B + 436, B + 738, B + 1037, B + 1335,
+        B + 1637, B + 1938, B + 2236, B + 2537, B + 2839,
+    };
+};
+
+TEST_F(WakePlannerTest, UnknownPhaseFallsBackToNominalInterval) {
+    EXPECT_EQ(B + 300, planner_.nextExpectedAfter(B));
+}
+
+TEST_F(WakePlannerTest, LearnsPhaseFromRecordedSeries) {
+    for (time_t t : recorded_) {
+        planner_.observeReading(t);
+    }
+    EXPECT_NEAR(137, static_cast<int>(planner_.phaseSeconds()), 2);
+}
+
+TEST_F(WakePlannerTest, PhaseAveragingHandlesWrapAroundTheInterval) {
+    // Phase sits right at the 5-minute boundary, jittering either side of it
+    for (time_t t : {B + 299, B + 601, B + 899, B + 1201}) {
+        planner_.observeReading(t);
+    }
+    uint32_t phase = planner_.phaseSeconds();
+    EXPECT_TRUE(phase >= 298 || phase <= 2) << phase;
+}
+
+TEST_F(WakePlannerTest, LargeShiftReseedsPhase) {
+    planner_.observeReading(B + 137);
+    planner_.observeReading(B + 300 + 250); // new sensor, new phase
+    EXPECT_EQ(250u, planner_.phaseSeconds());
+}
+
+TEST_F(WakePlannerTest, SleepsUntilShortlyAfterNextExpectedReading) {
+    // Woke at B + 160 and found the reading taken at ...137
+    uint32_t sleepS = planner_.onWake(B + 160, B + 137);
+    time_t wakeAt = B + 160 + sleepS;
+    EXPECT_GT(wakeAt, B + 437);
+    EXPECT_LE(wakeAt, B + 437 + WakePlanner::INITIAL_MARGIN_S);
+}
+
+TEST_F(WakePlannerTest, NeverTargetsTheSlotAlreadyFetched) {
+    // Clock says we are a little before phase + margin, but that reading is already in hand
+    uint32_t sleepS = planner_.onWake(B + 140, B + 137);
+    EXPECT_GT(sleepS, 250u);
+}
+
+TEST_F(WakePlannerTest, PhaseAndMarginPastTheSlotEndKeepTheNearestArrival) {
+    // Reading at ...290 plus a 30 s margin is fetchable at the next slot's +20 s
+    planner_.observeReading(B + 290);
+    state_.marginS = 30;
+    EXPECT_EQ(B + 620, planner_.nextExpectedAfter(B + 600));
+    EXPECT_EQ(B + 620, planner_.nextExpectedAfter(B + 615));
+    EXPECT_EQ(B + 920, planner_.nextExpectedAfter(B + 621));
+
+    // Retries exhausted at B + 760: wait for the reading fetchable at B + 920, not B + 1220
+    for (uint8_t i = 0; i < WakePlanner::MAX_RETRIES; ++i) {
+        planner_.onWake(B + 700, 0);
+    }
+    EXPECT_EQ(160u, planner_.onWake(B + 760, 0));
+}
+
+TEST_F(WakePlannerTest, LateReadingTriggersEscalatingRetries) {
+    planner_.onWake(B + 160, B + 137);
+    for (uint8_t i = 0; i < WakePlanner::MAX_RETRIES; ++i) {
+        EXPECT_EQ(WakePlanner::RETRY_DELAYS_S[i], planner_.onWake(B + 460 + i, B + 137));
+    }
+    // Retries exhausted: wait for the next slot instead
+    uint32_t sleepS = planner_.onWake(B + 700, B + 137);
+    EXPECT_GT(sleepS, 100u);
+    EXPECT_EQ(0, state_.retries);
+}
+
+TEST_F(WakePlannerTest, MarginWidensAfterRetryAndShrinksWhenOnTime) {
+    planner_.onWake(B + 160, B + 137);
+    uint16_t margin = state_.marginS;
+
+    planner_.onWake(B + 457, B + 137); // late
+    planner_.onWake(B + 472, B + 436); // found on retry
+    EXPECT_EQ(margin + WakePlanner::MARGIN_STEP_S, state_.marginS);
+
+    uint16_t widened = state_.marginS;
+    planner_.onWake(B + 770, B + 738);
+    EXPECT_EQ(widened - 1, state_.marginS);
+}
+
+TEST_F(WakePlannerTest, MarginIsBounded) {
+    for (int i = 0; i < 200; ++i) {
+        planner_.onWake(B + 160 + i * 300, B + 137 + i * 300);
+    }
+    EXPECT_EQ(WakePlanner::MIN_MARGIN_S, state_.marginS);
+}
+
+/**
+ * Replays the recorded series: every planned wake must land after the reading it is
+ * waiting for and less than a margin later, so one fetch per reading suffices.
+ */
+TEST_F(WakePlannerTest, ReplayNeedsOneWakePerReading) {
+    time_t now = recorded_[0] + 5;
+    time_t latest = 0;
+    size_t next = 0;
+    int wakes = 0;
+
+    while (next < recorded_.size()) {
+        while (next < recorded_.size() && recorded_[next] <= now) {
+            latest = recorded_[next++];
+        }
+        ++wakes;
+        now += planner_.onWake(now, latest);
+    }
+    EXPECT_LE(wakes, static_cast<int>(recorded_.size()) + 1);
+}
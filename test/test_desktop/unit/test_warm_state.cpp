@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#include "warm_state.h"
+
+class WarmStateTest : public ::testing::Test {
+protected:
+    static constexpr time_t NOW = 1700000000;
+
+    std::vector<uint8_t> image_ = std::vector<uint8_t>(WarmState::MAX_SNAPSHOT_SIZE);
+
+    static std::vector<GlucoseReading> series(size_t count, time_t newest) {
+        // Newest first, as the Share API returns them
+        std::vector<GlucoseReading> readings;
+        for (size_t i = 0; i < count; ++i) {
+            readings.emplace_back(static_cast<uint16_t>(100 + (i % 17) * 3),
+                                  DexcomConst::TrendDirection::Flat,
+                                  newest - static_cast<time_t>(i) * 300);
+        }
+        return readings;
+    }
+
+    static std::vector<GlucoseReading> decoded(const WarmState& state) {
+        return std::vector<GlucoseReading>(state.historyReadings().begin(), state.historyReadings().end());
+    }
+
+    WarmState populated() const {
+        WarmState state;
+        state.setSession("12345678-90ab-cdef-1234-567890abcdef", NOW - 600);
+        std::strcpy(state.dns.entries[0].host, "shareous1.dexcom.com");
+        state.dns.entries[0].ip = 0x0A00A8C0;
+        state.dns.entries[0].expiresAt = NOW + 240;
+        const uint8_t bssid[6] = {0xDE, 0xAD, 0xBE, 0xEF, 0x00, 0x01};
+        std::memcpy(state.wifi.bssid, bssid, sizeof(bssid));
+        state.wifi.channel = 11;
+        state.wifi.lease = WifiLease{0x6401A8C0, 0x0101A8C0, 0x00FFFFFF, 0x0101A8C0, static_cast<uint32_t>(NOW - 7200)};
+        state.time = TimeKeeperState{static_cast<uint32_t>(NOW - 3600), static_cast<uint32_t>(NOW - 600), 1500, -120, -42, 1};
+        state.setHistory(series(36, NOW - 100));
+        return state;
+    }
+};
+
+TEST_F(WarmStateTest, RoundTripPreservesEveryField) {
+    WarmState original = populated();
+    size_t size = original.save(image_.data(), image_.size());
+    ASSERT_GT(size, 0u);
+
+    WarmState restored;
+    ASSERT_TRUE(restored.load(image_.data(), size));
+    EXPECT_STREQ(original.sessionId, restored.sessionId);
+    EXPECT_EQ(original.sessionCreatedAt, restored.sessionCreatedAt);
+    EXPECT_EQ(0, std::memcmp(&original.dns, &restored.dns, sizeof(original.dns)));
+    EXPECT_EQ(0, std::memcmp(&original.wifi, &restored.wifi, sizeof(original.wifi)));
+    EXPECT_EQ(original.time.lastSyncAt, restored.time.lastSyncAt);
+    EXPECT_EQ(original.time.lastCheckAt, restored.time.lastCheckAt);
+    EXPECT_EQ(original.time.checkErrorMs, restored.time.checkErrorMs);
+    EXPECT_EQ(original.time.driftPpm, restored.time.driftPpm);
+    EXPECT_EQ(original.time.appliedMs, restored.time.appliedMs);
+    EXPECT_EQ(original.time.driftKnown, restored.time.driftKnown);
+    EXPECT_EQ(36u, restored.historyCount);
+
+    auto before = decoded(original);
+    auto after = decoded(restored);
+    ASSERT_EQ(before.size(), after.size());
+    for (size_t i = 0; i < before.size(); ++i) {
+        EXPECT_EQ(before[i].getValue(), after[i].getValue());
+        EXPECT_EQ(before[i].getTimestamp(), after[i].getTimestamp());
+    }
+}
+
+TEST_F(WarmStateTest, SnapshotIsCompact) {
+    WarmState state = populated();
+    size_t size = state.save(image_.data(), image_.size());
+    // Fixed fields plus ~2.5 bytes per packed reading
+    EXPECT_LT(size, 150u + 36u * 3u);
+}
+
+TEST_F(WarmStateTest, EmptyStateRoundTrips) {
+    WarmState empty;
+    size_t size = empty.save(image_.data(), image_.size());
+    ASSERT_GT(size, 0u);
+    WarmState restored = populated();
+    ASSERT_TRUE(restored.load(image_.data(), size));
+    EXPECT_EQ('\0', restored.sessionId[0]);
+    EXPECT_EQ(0u, restored.historyCount);
+    EXPECT_EQ(0, restored.newestReading());
+}
+
+TEST_F(WarmStateTest, SaveFailsWhenBufferTooSmall) {
+    WarmState state = populated();
+    EXPECT_EQ(0u, state.save(image_.data(), 16));
+}
+
+TEST_F(WarmStateTest, RejectsCorruptedImage) {
+    WarmState state = populated();
+    size_t size = state.save(image_.data(), image_.size());
+    image_[size / 2] ^= 0x01;
+
+    WarmState restored;
+    EXPECT_FALSE(restored.load(image_.data(), size));
+    EXPECT_EQ('\0', restored.sessionId[0]);
+    EXPECT_EQ(0, restored.wifi.channel);
+}
+
+TEST_F(WarmStateTest, RejectsOtherVersionsAndGarbage) {
+    WarmState state = populated();
+    size_t size = state.save(image_.data(), image_.size());
+
+    std::vector<uint8_t> otherVersion = image_;
+    otherVersion[2] = WarmState::VERSION + 1;
+    WarmState restored;
+    EXPECT_FALSE(restored.load(otherVersion.data(), size));
+
+    // Cold-boot RTC memory is arbitrary
+    std::vector<uint8_t> garbage(image_.size(), 0xA5);
+    EXPECT_FALSE(restored.load(garbage.data(), garbage.size()));
+    EXPECT_FALSE(restored.load(nullptr, 0));
+}
+
+TEST_F(WarmStateTest, RejectsTruncatedImage) {
+    WarmState state = populated();
+    size_t size = state.save(image_.data(), image_.size());
+    WarmState restored;
+    EXPECT_FALSE(restored.load(image_.data(), size - 1));
+}
+
+TEST_F(WarmStateTest, HistoryKeepsNewestReadingsThatFit) {
+    WarmState state;
+    // A full day of noisy readings does not pack into the history buffer
+    std::vector<GlucoseReading> day;
+    for (size_t i = 0; i < 2000; ++i) {
+        day.emplace_back(static_cast<uint16_t>(40 + (i * 7919) % 360),
+                         DexcomConst::TrendDirection::Flat, NOW - static_cast<time_t>(i) * 300);
+    }
+    size_t stored = state.setHistory(day);
+    ASSERT_GT(stored, 0u);
+    ASSERT_LT(stored, day.size());
+    EXPECT_LE(state.historySize, WarmState::HISTORY_CAPACITY);
+
+    auto readings = decoded(state);
+    ASSERT_EQ(stored, readings.size());
+    EXPECT_EQ(NOW, readings.back().getTimestamp());
+    for (size_t i = 1; i < readings.size(); ++i) {
+        EXPECT_EQ(300, readings[i].getTimestamp() - readings[i - 1].getTimestamp());
+    }
+}
+
+TEST_F(WarmStateTest, MergeAppendsOnlyNewerReadings) {
+    WarmState state;
+    state.setHistory(series(10, NOW - 600));
+    // Overlaps the two newest stored readings and adds two new ones
+    size_t stored = state.mergeHistory(series(4, NOW));
+    EXPECT_EQ(12u, stored);
+    EXPECT_EQ(NOW, state.newestReading());
+}
+
+TEST_F(WarmStateTest, PlanSkipsStepsThatAreStillValid) {
+    WarmState state = populated();
+    WarmStartPlan plan = state.plan(NOW, true);
+    EXPECT_TRUE(plan.reuseSession);
+    EXPECT_EQ(6, plan.fetchMinutes); // newest reading 100 s old, plus one interval
+}
+
+TEST_F(WarmStateTest, PlanRedoesExpiredSteps) {
+    WarmState state = populated();
+    const time_t later = NOW + WarmState::SESSION_MAX_AGE_S;
+    WarmStartPlan plan = state.plan(later, true);
+    EXPECT_FALSE(plan.reuseSession);
+    EXPECT_EQ((WarmState::SESSION_MAX_AGE_S + 100) / 60 + 5, plan.fetchMinutes);
+}
+
+TEST_F(WarmStateTest, PlanWithoutValidClockTrustsNothingTimed) {
+    WarmState state = populated();
+    WarmStartPlan plan = state.plan(0, false);
+    EXPECT_FALSE(plan.reuseSession);
+    EXPECT_EQ(DexcomConst::MAX_MINUTES, plan.fetchMinutes);
+}
+
+TEST_F(WarmStateTest, ClearedStatePlansAColdStart) {
+    WarmState state;
+    WarmStartPlan plan = state.plan(NOW, true);
+    EXPECT_FALSE(plan.reuseSession);
+    EXPECT_EQ(DexcomConst::MAX_MINUTES, plan.fetchMinutes);
+}
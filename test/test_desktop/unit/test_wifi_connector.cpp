@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cstring>
+#include <memory>
+#include "wifi_connector.h"
+#include "phase_timer.h"
+#include "mock_wifi_driver.h"
+#include "fake_clock.h"
+
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+using Path = WifiConnectReport::Path;
+
+class WifiConnectorTest : public ::testing::Test {
+protected:
+    static constexpr time_t NOW = 1700000000;
+
+    void SetUp() override {
+        driver_ = std::make_shared<NiceMock<MockWifiDriver>>();
+        clock_ = std::make_shared<FakeClock>(1000);
+        std::memset(&cache_, 0, sizeof(cache_));
+        connector_ = std::make_unique<WifiConnector>(driver_, clock_, cache_);
+
+        ON_CALL(*driver_, status()).WillByDefault([this]() { return status_; });
+        ON_CALL(*driver_, currentLink(_)).WillByDefault([this](WifiCache& out) {
+            out = live_;
+            return true;
+        });
+
+        const uint8_t bssid[6] = {0x10, 0x20, 0x30, 0x40, 0x50, 0x60};
+        std::memcpy(live_.bssid, bssid, sizeof(bssid));
+        live_.channel = 6;
+        live_.lease = WifiLease{0x6401A8C0, 0x0101A8C0, 0x00FFFFFF, 0x0101A8C0, 0};
+    }
+
+    void cacheAp(uint32_t leaseAge) {
+        cache_ = live_;
+        cache_.lease.obtainedAt = static_cast<uint32_t>(NOW - leaseAge);
+    }
+
+    // Runs the poll loop the way main does until the connector settles
+    WifiConnector::State runUntilSettled(uint32_t limitMs = 30000) {
+        for (uint32_t t = 0; t < limitMs; t += WifiConnector::POLL_INTERVAL_MS) {
+            auto state = connector_->poll();
+            if (state != WifiConnector::State::Connecting) {
+                return state;
+            }
+            clock_->advance(WifiConnector::POLL_INTERVAL_MS);
+        }
+        return connector_->state();
+    }
+
+    std::shared_ptr<NiceMock<MockWifiDriver>> driver_;
+    std::shared_ptr<FakeClock> clock_;
+    WifiCache cache_{};
+    WifiCache live_{};
+    WifiLinkStatus status_ = WifiLinkStatus::Connecting;
+    std::unique_ptr<WifiConnector> connector_;
+};
+
+TEST_F(WifiConnectorTest, EmptyCacheScansWithDhcp) {
+    EXPECT_CALL(*driver_, useDhcp()).Times(1);
+    EXPECT_CALL(*driver_, beginScan()).Times(1);
+    EXPECT_CALL(*driver_, beginDirect(_, _)).Times(0);
+    connector_->start(NOW);
+
+    clock_->advance(3000);
+    status_ = WifiLinkStatus::GotIp;
+    EXPECT_EQ(WifiConnector::State::Connected, connector_->poll());
+    EXPECT_EQ(Path::Scan, connector_->report().path);
+    EXPECT_EQ(3000u, connector_->report().totalMs);
+
+    // Cache now describes the live link with a fresh lease
+    EXPECT_EQ(6, cache_.channel);
+    EXPECT_EQ(live_.lease.ip, cache_.lease.ip);
+    EXPECT_EQ(static_cast<uint32_t>(NOW + 3), cache_.lease.obtainedAt);
+}
+
+TEST_F(WifiConnectorTest, FreshLeaseJoinsDirectlyWithStaticIp) {
+    cacheAp(3600);
+    EXPECT_CALL(*driver_, useStaticIp(testing::Field(&WifiLease::ip, live_.lease.ip))).Times(1);
+    EXPECT_CALL(*driver_, beginDirect(6, _)).Times(1);
+    EXPECT_CALL(*driver_, beginScan()).Times(0);
+    connector_->start(NOW);
+
+    clock_->advance(150);
+    status_ = WifiLinkStatus::Associated;
+    connector_->poll();
+    clock_->advance(50);
+    status_ = WifiLinkStatus::GotIp;
+    EXPECT_EQ(WifiConnector::State::Connected, connector_->poll());
+
+    const auto& report = connector_->report();
+    EXPECT_EQ(Path::DirectStatic, report.path);
+    EXPECT_EQ(0, report.fallbacks);
+    EXPECT_EQ(150u, report.associateMs);
+    EXPECT_EQ(50u, report.addressMs);
+    EXPECT_EQ(200u, report.totalMs);
+    // Reusing a lease must not make it look newer than it is
+    EXPECT_EQ(static_cast<uint32_t>(NOW - 3600), cache_.lease.obtainedAt);
+}
+
+TEST_F(WifiConnectorTest, OldLeaseJoinsDirectlyWithDhcp) {
+    cacheAp(WifiConnector::LEASE_MAX_AGE_S);
+    EXPECT_CALL(*driver_, useStaticIp(_)).Times(0);
+    EXPECT_CALL(*driver_, useDhcp()).Times(1);
+    EXPECT_CALL(*driver_, beginDirect(6, _)).Times(1);
+    connector_->start(NOW);
+
+    status_ = WifiLinkStatus::GotIp;
+    EXPECT_EQ(WifiConnector::State::Connected, connector_->poll());
+    EXPECT_EQ(Path::DirectDhcp, connector_->report().path);
+    EXPECT_EQ(static_cast<uint32_t>(NOW), cache_.lease.obtainedAt);
+}
+
+TEST_F(WifiConnectorTest, UnknownWallClockDoesNotTrustLease) {
+    cacheAp(60);
+    EXPECT_CALL(*driver_, useStaticIp(_)).Times(0);
+    connector_->start(0);
+    EXPECT_EQ(Path::DirectDhcp, connector_->report().path);
+
+    status_ = WifiLinkStatus::GotIp;
+    connector_->poll();
+    EXPECT_EQ(0u, cache_.lease.obtainedAt);
+}
+
+TEST_F(WifiConnectorTest, RejectedDirectJoinFallsBackToScan) {
+    cacheAp(60);
+    connector_->start(NOW);
+
+    ::testing::InSequence seq;
+    EXPECT_CALL(*driver_, disconnect()).Times(1);
+    EXPECT_CALL(*driver_, useDhcp()).Times(1);
+    EXPECT_CALL(*driver_, beginScan()).Times(1);
+
+    clock_->advance(300);
+    status_ = WifiLinkStatus::Failed;
+    EXPECT_EQ(WifiConnector::State::Connecting, connector_->poll());
+    EXPECT_EQ(Path::Scan, connector_->report().path);
+    EXPECT_EQ(1, connector_->report().fallbacks);
+    EXPECT_EQ(0, cache_.channel); // stale AP is forgotten
+
+    status_ = WifiLinkStatus::Connecting;
+    clock_->advance(2500);
+    status_ = WifiLinkStatus::GotIp;
+    EXPECT_EQ(WifiConnector::State::Connected, connector_->poll());
+    EXPECT_EQ(2800u, connector_->report().totalMs);
+    EXPECT_EQ(6, cache_.channel);
+}
+
+TEST_F(WifiConnectorTest, SilentDirectJoinTimesOutToScan) {
+    cacheAp(60);
+    EXPECT_CALL(*driver_, beginScan()).Times(1);
+    connector_->start(NOW);
+
+    // The AP never answers; the connector must not wait for a scan-length timeout
+    clock_->advance(WifiConnector::DIRECT_TIMEOUT_MS - 1);
+    EXPECT_EQ(Path::DirectStatic, (connector_->poll(), connector_->report().path));
+    clock_->advance(1);
+    connector_->poll();
+    EXPECT_EQ(Path::Scan, connector_->report().path);
+}
+
+TEST_F(WifiConnectorTest, AssociatedWithoutAddressTimesOutToScan) {
+    cacheAp(60);
+    connector_->start(NOW);
+    status_ = WifiLinkStatus::Associated;
+    EXPECT_CALL(*driver_, beginScan()).Times(1);
+    runUntilSettled(WifiConnector::DIRECT_TIMEOUT_MS + WifiConnector::POLL_INTERVAL_MS);
+    EXPECT_EQ(Path::Scan, connector_->report().path);
+}
+
+TEST_F(WifiConnectorTest, ScanTimeoutFailsAndCanRestart) {
+    connector_->start(NOW);
+    EXPECT_EQ(WifiConnector::State::Failed, runUntilSettled());
+    EXPECT_GE(connector_->report().totalMs, WifiConnector::SCAN_TIMEOUT_MS);
+
+    EXPECT_CALL(*driver_, beginScan()).Times(1);
+    connector_->start(NOW);
+    EXPECT_EQ(WifiConnector::State::Connecting, connector_->state());
+    status_ = WifiLinkStatus::GotIp;
+    EXPECT_EQ(WifiConnector::State::Connected, connector_->poll());
+}
+
+TEST_F(WifiConnectorTest, RecordsPhaseTimings) {
+    PhaseTiming::resetAll();
+    cacheAp(60);
+    connector_->start(NOW);
+    clock_->advance(120);
+    status_ = WifiLinkStatus::Associated;
+    connector_->poll();
+    clock_->advance(10);
+    status_ = WifiLinkStatus::GotIp;
+    connector_->poll();
+
+    EXPECT_EQ(1u, PhaseTiming::histogram(Phase::WifiAssociate).count());
+    EXPECT_EQ(120000u, PhaseTiming::histogram(Phase::WifiAssociate).maxMicros());
+    EXPECT_EQ(10000u, PhaseTiming::histogram(Phase::WifiAddress).maxMicros());
+}